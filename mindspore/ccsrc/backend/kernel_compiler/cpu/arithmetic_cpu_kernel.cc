@@ -14,46 +14,12 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
-#include <thread>
+#include <algorithm>
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void Add(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] + (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] - (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Mul(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] * (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Div(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    auto div_number = is_number ? *input2 : input2[i];
-    if (div_number == 0) {
-      MS_LOG(EXCEPTION) << "Cannot divided by 0!";
-    }
-    out[i] = input1[i] / div_number;
-  }
-}
-}  // namespace
-
 void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -63,24 +29,21 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     operate_type_ = SUB;
   } else if (kernel_name == prim::kPrimMul->name()) {
     operate_type_ = MUL;
-  } else if (kernel_name == "Div") {
+  } else if (kernel_name == "Div" || kernel_name == "RealDiv") {
     operate_type_ = DIV;
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << kernel_name;
   }
 
   auto shape0 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   auto shape1 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
-  if (shape1.size() == 0) {
-    is_number_ = true;
-  } else {
-    is_number_ = false;
-    if (shape0.size() != shape1.size()) {
-      MS_LOG(EXCEPTION) << "Input0 and input1 must has the same shape";
-    }
-    for (size_t i = 0; i < shape0.size(); ++i) {
-      if (shape0[i] != shape1[i]) {
-        MS_LOG(EXCEPTION) << "Input0 and input1 must has the same shape";
-      }
-    }
+  if (!broadcast_plan_.Init(shape0, shape1)) {
+    MS_LOG(EXCEPTION) << "Input0 shape " << shape0 << " and input1 shape " << shape1 << " can not be broadcast";
+  }
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  if (output_shape != broadcast_plan_.output_shape()) {
+    MS_LOG(EXCEPTION) << "Output shape " << output_shape << " is not the broadcast shape "
+                      << broadcast_plan_.output_shape() << " of inputs";
   }
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
@@ -97,8 +60,11 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
     LaunchKernel<float>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt64) {
     LaunchKernel<int64_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
   } else {
-    MS_LOG(EXCEPTION) << "Only support int32, float32, but actual data type is " << TypeIdLabel(dtype_);
+    MS_LOG(EXCEPTION) << "Only support float16, float32, int32, int64, but actual data type is "
+                      << TypeIdLabel(dtype_);
   }
   return true;
 }
@@ -108,29 +74,26 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
   T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
-  auto lens = inputs[0]->size / sizeof(T);
+  auto lens = broadcast_plan_.output_size();
   MS_LOG(INFO) << "lens=" << lens;
 
-  const size_t thread_num = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(Add<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(Sub<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(Mul<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == DIV) {
-      threads.emplace_back(std::thread(Div<T>, input1, input2, output, start, end, is_number_));
+  if (operate_type_ == ADD) {
+    CPUKernelUtils::ParallelFor(
+      [&](size_t start, size_t end) { broadcast_plan_.Run(input1, input2, output, start, end, AddFunc()); }, lens);
+  } else if (operate_type_ == SUB) {
+    CPUKernelUtils::ParallelFor(
+      [&](size_t start, size_t end) { broadcast_plan_.Run(input1, input2, output, start, end, SubFunc()); }, lens);
+  } else if (operate_type_ == MUL) {
+    CPUKernelUtils::ParallelFor(
+      [&](size_t start, size_t end) { broadcast_plan_.Run(input1, input2, output, start, end, MulFunc()); }, lens);
+  } else if (operate_type_ == DIV) {
+    // check the divisor once up front, the inner loops stay free of branches
+    auto input2_end = input2 + inputs[1]->size / sizeof(T);
+    if (std::find(input2, input2_end, static_cast<T>(0)) != input2_end) {
+      MS_LOG(EXCEPTION) << "Cannot divided by 0!";
     }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+    CPUKernelUtils::ParallelFor(
+      [&](size_t start, size_t end) { broadcast_plan_.Run(input1, input2, output, start, end, DivFunc()); }, lens);
   }
 }
 }  // namespace kernel
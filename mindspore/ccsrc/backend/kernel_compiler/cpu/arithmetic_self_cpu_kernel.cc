@@ -15,7 +15,6 @@
  */
 #include "backend/kernel_compiler/cpu/arithmetic_self_cpu_kernel.h"
 #include <cmath>
-#include <thread>
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -24,15 +23,13 @@ namespace kernel {
 namespace {
 template <typename T>
 void Square(const T *in, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = in[i] * in[i];
-  }
+  ElementwiseUnary(in + start, out + start, end - start, SquareFunc());
 }
 
 template <typename T>
 void Sqrt(const T *in, T *out, size_t start, size_t end) {
   for (size_t i = start; i < end; i++) {
-    out[i] = sqrtf(in[i]);
+    out[i] = static_cast<T>(sqrtf(static_cast<float>(in[i])));
   }
 }
 }  // namespace
@@ -54,9 +51,14 @@ bool ArithmeticSelfCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inpu
   if (dtype_ == kNumberTypeFloat32) {
     LaunchKernel<float>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt32) {
-    LaunchKernel<float>(inputs, outputs);
+    LaunchKernel<int>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt64) {
+    LaunchKernel<int64_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
   } else {
-    MS_LOG(EXCEPTION) << "Only support float32, int32, but actual data type is " << TypeIdLabel(dtype_);
+    MS_LOG(EXCEPTION) << "Only support float16, float32, int32, int64, but actual data type is "
+                      << TypeIdLabel(dtype_);
   }
   return true;
 }
@@ -69,22 +71,10 @@ void ArithmeticSelfCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs
   auto lens = inputs[0]->size / sizeof(T);
   MS_LOG(INFO) << "lens=" << lens;
 
-  const size_t thread_num = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == SQUARE) {
-      threads.emplace_back(std::thread(Square<T>, input, output, start, end));
-    } else if (operate_type_ == SQRT) {
-      threads.emplace_back(std::thread(Sqrt<T>, input, output, start, end));
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  if (operate_type_ == SQUARE) {
+    CPUKernelUtils::ParallelFor([&](size_t start, size_t end) { Square<T>(input, output, start, end); }, lens);
+  } else if (operate_type_ == SQRT) {
+    CPUKernelUtils::ParallelFor([&](size_t start, size_t end) { Sqrt<T>(input, output, start, end); }, lens);
   }
 }
 }  // namespace kernel
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include <algorithm>
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -76,5 +78,31 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, size_t min_grain_size) {
+  if (count == 0) {
+    return;
+  }
+  min_grain_size = min_grain_size < 1 ? 1 : min_grain_size;
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t thread_num = std::min(thread_pool.GetSyncRunThreadNum(), (count + min_grain_size - 1) / min_grain_size);
+  if (thread_num <= 1) {
+    task(0, count);
+    return;
+  }
+  size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  std::vector<common::Task> tasks;
+  size_t start = 0;
+  while (start < count) {
+    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
+    auto block = [&task, start, end]() {
+      task(start, end);
+      return common::SUCCESS;
+    };
+    tasks.emplace_back(block);
+    start += once_compute_size;
+  }
+  (void)thread_pool.SyncRun(tasks);
+}
 }  // namespace kernel
 }  // namespace mindspore
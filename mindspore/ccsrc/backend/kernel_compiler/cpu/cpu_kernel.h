@@ -52,6 +52,8 @@ const char SIZE[] = "size";
 const char USE_NESTEROV[] = "use_nesterov";
 const char GROUP[] = "group";
 enum OperateType { ADD = 0, SUB, MUL, DIV, SQUARE, SQRT };
+// The minimum element number computed by one task of ParallelFor, smaller inputs run on the calling thread.
+constexpr size_t kDefaultGrainSize = 16384;
 
 class CPUKernel : public kernel::KernelMod {
  public:
@@ -76,12 +78,15 @@ class CPUKernel : public kernel::KernelMod {
   std::vector<size_t> workspace_size_list_;
 };
 
+using CTask = std::function<void(size_t, size_t)>;
 class CPUKernelUtils {
  public:
   static void ExpandDimsTo4(std::vector<size_t> *shape);
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // Split [0, count) into tasks of at least min_grain_size and run them on the shared thread pool.
+  static void ParallelFor(const CTask &task, size_t count, size_t min_grain_size = kDefaultGrainSize);
 };
 }  // namespace kernel
 }  // namespace mindspore
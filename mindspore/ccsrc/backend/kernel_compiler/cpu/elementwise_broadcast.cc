@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/elementwise_broadcast.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+enum BroadcastPattern { kNoBroadcast = 0, kBroadcastInput0, kBroadcastInput1 };
+}  // namespace
+
+bool BroadcastPlan::Init(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1) {
+  size_t rank = std::max(shape0.size(), shape1.size());
+  std::vector<size_t> aligned0(rank, 1);
+  std::vector<size_t> aligned1(rank, 1);
+  std::copy(shape0.begin(), shape0.end(), aligned0.begin() + (rank - shape0.size()));
+  std::copy(shape1.begin(), shape1.end(), aligned1.begin() + (rank - shape1.size()));
+
+  output_shape_.assign(rank, 1);
+  output_size_ = 1;
+  dims_.clear();
+  std::vector<size_t> extents0;
+  std::vector<size_t> extents1;
+  int last_pattern = -1;
+  for (size_t i = 0; i < rank; ++i) {
+    if (aligned0[i] != aligned1[i] && aligned0[i] != 1 && aligned1[i] != 1) {
+      return false;
+    }
+    size_t dim = aligned0[i] == 1 ? aligned1[i] : aligned0[i];
+    output_shape_[i] = dim;
+    output_size_ *= dim;
+    if (dim == 1) {
+      continue;
+    }
+    int pattern = kNoBroadcast;
+    if (aligned0[i] == 1) {
+      pattern = kBroadcastInput0;
+    } else if (aligned1[i] == 1) {
+      pattern = kBroadcastInput1;
+    }
+    if (pattern == last_pattern) {
+      dims_.back() *= dim;
+      extents0.back() *= aligned0[i];
+      extents1.back() *= aligned1[i];
+    } else {
+      dims_.push_back(dim);
+      extents0.push_back(aligned0[i]);
+      extents1.push_back(aligned1[i]);
+      last_pattern = pattern;
+    }
+  }
+  if (dims_.empty()) {
+    dims_.push_back(1);
+    extents0.push_back(1);
+    extents1.push_back(1);
+  }
+
+  strides0_.assign(dims_.size(), 0);
+  strides1_.assign(dims_.size(), 0);
+  size_t stride0 = 1;
+  size_t stride1 = 1;
+  for (size_t i = dims_.size(); i > 0; --i) {
+    strides0_[i - 1] = (extents0[i - 1] == 1 && dims_[i - 1] != 1) ? 0 : stride0;
+    strides1_[i - 1] = (extents1[i - 1] == 1 && dims_[i - 1] != 1) ? 0 : stride1;
+    stride0 *= extents0[i - 1];
+    stride1 *= extents1[i - 1];
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,216 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_H_
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+// 128-bit vector type of T, mapped by the compiler onto SSE on x86 and NEON on arm.
+template <typename T>
+struct SimdVector {
+  static constexpr bool kEnabled = false;
+  using Type = T;
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+template <>
+struct SimdVector<float> {
+  static constexpr bool kEnabled = true;
+  typedef float Type __attribute__((vector_size(16)));
+};
+
+template <>
+struct SimdVector<int32_t> {
+  static constexpr bool kEnabled = true;
+  typedef int32_t Type __attribute__((vector_size(16)));
+};
+
+template <>
+struct SimdVector<int64_t> {
+  static constexpr bool kEnabled = true;
+  typedef int64_t Type __attribute__((vector_size(16)));
+};
+#endif
+
+// The functors are applied to both scalars and SimdVector types.
+struct AddFunc {
+  template <typename T>
+  T operator()(const T &a, const T &b) const {
+    return a + b;
+  }
+};
+
+struct SubFunc {
+  template <typename T>
+  T operator()(const T &a, const T &b) const {
+    return a - b;
+  }
+};
+
+struct MulFunc {
+  template <typename T>
+  T operator()(const T &a, const T &b) const {
+    return a * b;
+  }
+};
+
+struct DivFunc {
+  template <typename T>
+  T operator()(const T &a, const T &b) const {
+    return a / b;
+  }
+};
+
+struct SquareFunc {
+  template <typename T>
+  T operator()(const T &a) const {
+    return a * a;
+  }
+};
+
+template <typename T>
+typename SimdVector<T>::Type LoadVector(const T *addr) {
+  typename SimdVector<T>::Type value;
+  memcpy(&value, addr, sizeof(value));
+  return value;
+}
+
+template <typename T>
+void StoreVector(T *addr, const typename SimdVector<T>::Type &value) {
+  memcpy(addr, &value, sizeof(value));
+}
+
+template <typename T>
+typename SimdVector<T>::Type SplatVector(T scalar) {
+  typename SimdVector<T>::Type value;
+  for (size_t i = 0; i < sizeof(value) / sizeof(T); ++i) {
+    value[i] = scalar;
+  }
+  return value;
+}
+
+// out[i] = op(a[i * a_step], b[i * b_step]) for i in [0, count), the steps are 0 or 1.
+template <typename T, typename Op>
+void ElementwiseBinary(const T *a, size_t a_step, const T *b, size_t b_step, T *out, size_t count, const Op &op) {
+  size_t i = 0;
+  if constexpr (SimdVector<T>::kEnabled) {
+    using Vector = typename SimdVector<T>::Type;
+    constexpr size_t kLanes = sizeof(Vector) / sizeof(T);
+    if (a_step != 0 && b_step != 0) {
+      for (; i + kLanes <= count; i += kLanes) {
+        StoreVector(out + i, op(LoadVector(a + i), LoadVector(b + i)));
+      }
+    } else if (a_step != 0) {
+      Vector vb = SplatVector(*b);
+      for (; i + kLanes <= count; i += kLanes) {
+        StoreVector(out + i, op(LoadVector(a + i), vb));
+      }
+    } else if (b_step != 0) {
+      Vector va = SplatVector(*a);
+      for (; i + kLanes <= count; i += kLanes) {
+        StoreVector(out + i, op(va, LoadVector(b + i)));
+      }
+    }
+  }
+  for (; i < count; ++i) {
+    out[i] = op(a[i * a_step], b[i * b_step]);
+  }
+}
+
+// out[i] = op(in[i]) for i in [0, count).
+template <typename T, typename Op>
+void ElementwiseUnary(const T *in, T *out, size_t count, const Op &op) {
+  size_t i = 0;
+  if constexpr (SimdVector<T>::kEnabled) {
+    using Vector = typename SimdVector<T>::Type;
+    constexpr size_t kLanes = sizeof(Vector) / sizeof(T);
+    for (; i + kLanes <= count; i += kLanes) {
+      StoreVector(out + i, op(LoadVector(in + i)));
+    }
+  }
+  for (; i < count; ++i) {
+    out[i] = op(in[i]);
+  }
+}
+
+// Iteration plan of a NumPy style broadcast between two inputs. Adjacent dimensions sharing the same broadcast
+// pattern are collapsed, so equal shapes and tensor-scalar pairs run as one contiguous inner loop.
+class BroadcastPlan {
+ public:
+  BroadcastPlan() = default;
+  ~BroadcastPlan() = default;
+
+  // Return false when the two shapes can not be broadcast.
+  bool Init(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1);
+  const std::vector<size_t> &output_shape() const { return output_shape_; }
+  size_t output_size() const { return output_size_; }
+
+  // Compute the output elements [start, end).
+  template <typename T, typename Op>
+  void Run(const T *input0, const T *input1, T *output, size_t start, size_t end, const Op &op) const {
+    if (start >= end) {
+      return;
+    }
+    size_t rank = dims_.size();
+    size_t inner = dims_[rank - 1];
+    size_t inner_step0 = strides0_[rank - 1];
+    size_t inner_step1 = strides1_[rank - 1];
+    std::vector<size_t> index(rank, 0);
+    size_t offset0 = 0;
+    size_t offset1 = 0;
+    size_t remain = start;
+    for (size_t i = rank; i > 0; --i) {
+      index[i - 1] = remain % dims_[i - 1];
+      remain /= dims_[i - 1];
+      offset0 += index[i - 1] * strides0_[i - 1];
+      offset1 += index[i - 1] * strides1_[i - 1];
+    }
+    size_t pos = start;
+    while (pos < end) {
+      size_t count = std::min(inner - index[rank - 1], end - pos);
+      ElementwiseBinary(input0 + offset0, inner_step0, input1 + offset1, inner_step1, output + pos, count, op);
+      pos += count;
+      index[rank - 1] += count;
+      offset0 += count * inner_step0;
+      offset1 += count * inner_step1;
+      for (size_t i = rank - 1; i > 0 && index[i] == dims_[i]; --i) {
+        offset0 -= dims_[i] * strides0_[i];
+        offset1 -= dims_[i] * strides1_[i];
+        index[i] = 0;
+        index[i - 1]++;
+        offset0 += strides0_[i - 1];
+        offset1 += strides1_[i - 1];
+      }
+    }
+  }
+
+ private:
+  std::vector<size_t> output_shape_;
+  size_t output_size_{0};
+  // collapsed output dimensions and the input strides on them, a stride is 0 where the input is broadcast
+  std::vector<size_t> dims_;
+  std::vector<size_t> strides0_;
+  std::vector<size_t> strides1_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_H_
@@ -18,12 +18,12 @@
 
 #include <vector>
 #include <memory>
-#include <thread>
 #include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -117,22 +117,14 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   }
 
  protected:
+  // element_per_compute is the element number processed by func for one unit of total_compute_size, such as the
+  // outer dim size when func updates a row for each index.
   template <typename T>
   void MultiThreadCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
-                          size_t total_compute_size) const {
-    const size_t kThreadNum = 24;
-    std::vector<std::thread> threads;
-    threads.reserve(kThreadNum);
-    size_t start = 0;
-    size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
-    while (start < total_compute_size) {
-      size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-      threads.emplace_back(std::thread(func, params, start, end));
-      start += once_compute_size;
-    }
-    for (size_t i = 0; i < threads.size(); ++i) {
-      threads[i].join();
-    }
+                          size_t total_compute_size, size_t element_per_compute = 1) const {
+    size_t min_grain_size = kDefaultGrainSize / (element_per_compute > 0 ? element_per_compute : 1);
+    CPUKernelUtils::ParallelFor([&func, params](size_t start, size_t end) { func(params, start, end); },
+                                total_compute_size, min_grain_size);
   }
 
  private:
@@ -169,8 +161,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     }
     size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
     size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<std::thread> threads;
-    threads.reserve(param.thread_num_);
+    std::vector<common::Task> tasks;
+    tasks.reserve(param.thread_num_);
     segments.reserve(param.thread_num_);
 
     size_t current_indices_offset = 0;
@@ -184,14 +176,15 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
       segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
       segments[i]->indices_size_ = indices_size;
-      threads.emplace_back(
-        std::thread(CalculateEachBucketSize<T>, segments[i], param.max_index_, segment_bucket_sizes[i].get()));
+      auto segment = segments[i];
+      auto each_bucket_size = segment_bucket_sizes[i].get();
+      tasks.emplace_back([segment, &param, each_bucket_size]() {
+        CalculateEachBucketSize<T>(segment, param.max_index_, each_bucket_size);
+        return common::SUCCESS;
+      });
       current_indices_offset += indices_size;
     }
-
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      threads[i].join();
-    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
   }
 
   template <typename T>
@@ -259,17 +252,19 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       }
       each_thread_buckets.emplace_back(thread_buckets);
     }
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num);
     current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
-      threads.emplace_back(
-        std::thread(CopySegmentIndicesToBucket<T>, param, segments[i], current_indices_offset, each_thread_buckets[i]));
+      auto &segment = segments[i];
+      auto &thread_buckets = each_thread_buckets[i];
+      tasks.emplace_back([&param, &segment, current_indices_offset, &thread_buckets]() {
+        CopySegmentIndicesToBucket<T>(param, segment, current_indices_offset, thread_buckets);
+        return common::SUCCESS;
+      });
       current_indices_offset += segments[i]->indices_size_;
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
-    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
   }
 
   template <typename T>
@@ -377,8 +372,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
     auto &reduced_buckets = *reduced_buckets_ptr;
     size_t thread_num = buckets.size();
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num);
 
     size_t current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
@@ -386,16 +381,19 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
       reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
       reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      if (param.use_sort_reduce_) {
-        threads.emplace_back(std::thread(SortAndReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      } else {
-        threads.emplace_back(std::thread(ReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      }
+      auto &bucket = buckets[i];
+      auto &reduced_bucket = reduced_buckets[i];
+      tasks.emplace_back([&param, &bucket, &reduced_bucket]() {
+        if (param.use_sort_reduce_) {
+          SortAndReduceBucketSparseGradient<T>(param, bucket, reduced_bucket);
+        } else {
+          ReduceBucketSparseGradient<T>(param, bucket, reduced_bucket);
+        }
+        return common::SUCCESS;
+      });
       current_indices_offset += buckets[i]->indices_size_;
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
-    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
   }
 
   template <typename T>
@@ -0,0 +1,165 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/thread_pool.h"
+#include <algorithm>
+#include <string>
+#include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+constexpr size_t kMaxThreadNum = 64;
+constexpr char kThreadNumEnv[] = "MS_CPU_KERNEL_THREAD_NUM";
+
+size_t GetConfigThreadNum() {
+  size_t thread_num = std::thread::hardware_concurrency();
+  auto env_thread_num = GetEnv(kThreadNumEnv);
+  if (!env_thread_num.empty()) {
+    try {
+      int config_num = std::stoi(env_thread_num);
+      if (config_num > 0) {
+        thread_num = IntToSize(config_num);
+      } else {
+        MS_LOG(WARNING) << "Invalid " << kThreadNumEnv << " " << env_thread_num << ", use the core number instead.";
+      }
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Invalid " << kThreadNumEnv << " " << env_thread_num << ", use the core number instead.";
+    }
+  }
+  thread_num = thread_num < 1 ? 1 : thread_num;
+  return std::min(thread_num, kMaxThreadNum);
+}
+}  // namespace
+
+ThreadPool::ThreadPool() {
+  max_thread_num_ = GetConfigThreadNum();
+  // The calling thread of SyncRun works too, so one less thread is created.
+  for (size_t i = 1; i < max_thread_num_; ++i) {
+    sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this));
+  }
+  MS_LOG(INFO) << "Cpu kernel thread pool created, thread num " << max_thread_num_;
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    exit_run_ = true;
+  }
+  job_cond_var_.notify_all();
+  for (auto &thread : sync_run_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  sync_run_threads_.clear();
+}
+
+ThreadPool &ThreadPool::GetInstance() {
+  static ThreadPool instance;
+  return instance;
+}
+
+void ThreadPool::RunJob(const SyncJobPtr &job) {
+  while (true) {
+    size_t task_index = job->next_task_.fetch_add(1);
+    if (task_index >= job->task_num_) {
+      return;
+    }
+    try {
+      if ((*job->tasks_)[task_index]() != SUCCESS) {
+        job->succeed_ = false;
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job->mutex_);
+      job->succeed_ = false;
+      if (job->exception_ == nullptr) {
+        job->exception_ = std::current_exception();
+      }
+    }
+    if (job->finished_task_.fetch_add(1) + 1 == job->task_num_) {
+      std::lock_guard<std::mutex> lock(job->mutex_);
+      job->cond_var_.notify_all();
+    }
+  }
+}
+
+void ThreadPool::SyncRunLoop() {
+  while (true) {
+    SyncJobPtr job;
+    {
+      std::unique_lock<std::mutex> lock(job_mutex_);
+      job_cond_var_.wait(lock, [this] { return exit_run_ || !job_queue_.empty(); });
+      if (exit_run_) {
+        return;
+      }
+      job = job_queue_.front();
+      if (job->next_task_ >= job->task_num_) {
+        job_queue_.pop_front();
+        continue;
+      }
+    }
+    RunJob(job);
+  }
+}
+
+bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
+  if (tasks.empty()) {
+    return true;
+  }
+  if (tasks.size() == 1 || sync_run_threads_.empty()) {
+    bool succeed = true;
+    for (auto &task : tasks) {
+      if (task() != SUCCESS) {
+        succeed = false;
+      }
+    }
+    return succeed;
+  }
+
+  auto job = std::make_shared<SyncJob>(&tasks);
+  {
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    job_queue_.push_back(job);
+  }
+  if (tasks.size() - 1 >= sync_run_threads_.size()) {
+    job_cond_var_.notify_all();
+  } else {
+    for (size_t i = 1; i < tasks.size(); ++i) {
+      job_cond_var_.notify_one();
+    }
+  }
+
+  RunJob(job);
+  {
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    auto iter = std::find(job_queue_.begin(), job_queue_.end(), job);
+    if (iter != job_queue_.end()) {
+      (void)job_queue_.erase(iter);
+    }
+  }
+  {
+    std::unique_lock<std::mutex> lock(job->mutex_);
+    job->cond_var_.wait(lock, [&job] { return job->finished_task_ == job->task_num_; });
+  }
+  if (job->exception_ != nullptr) {
+    std::rethrow_exception(job->exception_);
+  }
+  return job->succeed_;
+}
+}  // namespace common
+}  // namespace mindspore
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+using Task = std::function<int()>;
+constexpr int SUCCESS = 0;
+constexpr int FAIL = 1;
+
+// A process-wide pool of persistent worker threads used by the cpu kernels and by the parallel infer of the graphs.
+// The thread number defaults to the number of cores, and can be set by the env MS_CPU_KERNEL_THREAD_NUM.
+class ThreadPool {
+ public:
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  static ThreadPool &GetInstance();
+  // Run the tasks on the pool and the calling thread, return after all the tasks are finished.
+  // The calling thread only takes the tasks of its own call, it does not run the tasks of other calls. As it runs
+  // every task no pool thread has taken, SyncRun can be nested in a task without waiting for a free pool thread.
+  bool SyncRun(const std::vector<Task> &tasks);
+  size_t GetSyncRunThreadNum() const { return max_thread_num_; }
+
+ private:
+  struct SyncJob {
+    explicit SyncJob(const std::vector<Task> *tasks) : tasks_(tasks), task_num_(tasks->size()) {}
+    const std::vector<Task> *tasks_;
+    size_t task_num_;
+    std::atomic<size_t> next_task_{0};
+    std::atomic<size_t> finished_task_{0};
+    std::atomic<bool> succeed_{true};
+    std::exception_ptr exception_{nullptr};
+    std::mutex mutex_;
+    std::condition_variable cond_var_;
+  };
+  using SyncJobPtr = std::shared_ptr<SyncJob>;
+
+  ThreadPool();
+  void SyncRunLoop();
+  static void RunJob(const SyncJobPtr &job);
+
+  size_t max_thread_num_{1};
+  bool exit_run_{false};
+  std::mutex job_mutex_;
+  std::condition_variable job_cond_var_;
+  std::deque<SyncJobPtr> job_queue_;
+  std::vector<std::thread> sync_run_threads_;
+};
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
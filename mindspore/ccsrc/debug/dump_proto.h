@@ -25,7 +25,8 @@ std::string GetFuncGraphProtoString(const FuncGraphPtr &func_graph);
 
 std::string GetOnnxProtoString(const FuncGraphPtr &func_graph);
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph);
+// Export a graph in MindIR format, the weights are exported without their data when with_param_data is false
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool with_param_data = true);
 
 void DumpIRProto(const FuncGraphPtr &func_graph, const std::string &suffix);
 }  // namespace mindspore
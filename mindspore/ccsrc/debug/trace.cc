@@ -524,6 +524,7 @@ void GetEvalStackInfo(std::ostringstream &oss) {
 
 // trace the graph evaluator stack
 static std::stack<std::pair<abstract::EvaluatorPtr, abstract::AnfNodeConfigPtr>> graph_infer_stack;
+static thread_local bool trace_provider_disabled = false;
 // trace the cnode infer debug info
 static std::vector<abstract::AnfNodeConfigPtr> cnode_debug_stack{};
 
@@ -561,10 +562,17 @@ void ClearTraceStack() {
   cnode_debug_stack.clear();
 }
 
+TraceProviderDisabler::TraceProviderDisabler() : disabled_(trace_provider_disabled) { trace_provider_disabled = true; }
+
+TraceProviderDisabler::~TraceProviderDisabler() { trace_provider_disabled = disabled_; }
+
 // Register trace provider to LogWriter.
 struct TraceProviderRegister {
   TraceProviderRegister() {
     LogWriter::set_trace_provider([](std::ostringstream &oss) {
+      if (trace_provider_disabled) {
+        return;
+      }
       TraceGraphEval();
       GetEvalStackInfo(oss);
     });
@@ -43,6 +43,17 @@ std::vector<abstract::AnfNodeConfigPtr> &GetCNodeDebugStack();
 std::stack<std::pair<abstract::EvaluatorPtr, abstract::AnfNodeConfigPtr>> &GetCurrenGraphInferStack();
 std::string GetAbstractStr(const abstract::AbstractBasePtr &abs);
 void ClearTraceStack();
+
+// The exceptions raised on the current thread while a TraceProviderDisabler lives do not dump the evaluation trace.
+// The threads inferring cnodes in parallel use it, the trace stacks belong to the thread running the analysis.
+class TraceProviderDisabler {
+ public:
+  TraceProviderDisabler();
+  ~TraceProviderDisabler();
+
+ private:
+  bool disabled_;
+};
 }  // namespace trace
 }  // namespace mindspore
 
@@ -19,6 +19,7 @@
 #include <deque>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <algorithm>
 
 #include "ir/anf.h"
@@ -32,7 +33,7 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, std::vector<PrimitivePtr>{prim});
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +60,7 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, prims);
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -133,8 +134,10 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
     // apply transform on this node
     bool change = false;
     if (is_match) {
+      transform->match_count_++;
       auto ret = (*transform)(optimizer, node);
       if (ret != nullptr && ret != node) {
+        transform->hit_count_++;
         change = true;
         changes = true;
 #ifdef ENABLE_PROFILE
@@ -179,6 +182,134 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   return changes;
 }
 
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    auto &prims = list_[i]->primitives_;
+    if (prims.empty()) {
+      // selected by its predicate only, so it is tried on every node
+      other_transforms_.push_back(i);
+      for (auto &iter : prim_transforms_) {
+        iter.second.push_back(i);
+      }
+      continue;
+    }
+    for (auto &prim : prims) {
+      MS_EXCEPTION_IF_NULL(prim);
+      auto iter = prim_transforms_.find(prim->name());
+      if (iter == prim_transforms_.end()) {
+        iter = prim_transforms_.emplace(prim->name(), other_transforms_).first;
+      }
+      if (iter->second.empty() || iter->second.back() != i) {
+        iter->second.push_back(i);
+      }
+    }
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::SelectTransforms(const AnfNodePtr &node) const {
+  if (node->isa<CNode>()) {
+    auto prim = GetValueNode<PrimitivePtr>(node->cast<CNodePtr>()->input(0));
+    if (prim != nullptr) {
+      auto iter = prim_transforms_.find(prim->name());
+      if (iter != prim_transforms_.end()) {
+        return iter->second;
+      }
+    }
+  }
+  return other_transforms_;
+}
+
+bool SubstitutionList::ApplyTransforms(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                                       std::vector<bool> *hits) const {
+#ifdef ENABLE_PROFILE
+  double start = GetTime();
+#endif
+  FuncGraphManagerPtr manager = optimizer->manager();
+  auto seen = NewSeenGeneration();
+  // 1024 is for the initial capacity of deque
+  std::deque<AnfNodePtr> todo(1024);
+  todo.clear();
+  todo.push_back(root_node);
+  bool changes = false;
+
+  auto &all_nodes = manager->all_nodes();
+  while (!todo.empty()) {
+    AnfNodePtr node = todo.front();
+    todo.pop_front();
+
+    // check whether this node has been matched.
+    if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
+      continue;
+    }
+    node->seen_ = seen;
+
+    // apply the first transform which changes this node
+    AnfNodePtr new_node = nullptr;
+    for (auto i : SelectTransforms(node)) {
+      auto &transform = list_[i];
+      if (!transform->predicate_(node)) {
+        continue;
+      }
+      transform->match_count_++;
+      auto ret = (*transform)(optimizer, node);
+      if (ret != nullptr && ret != node) {
+        transform->hit_count_++;
+        (*hits)[i] = true;
+#ifdef ENABLE_PROFILE
+        double t = GetTime();
+#endif
+        (void)manager->Replace(node, ret);
+#ifdef ENABLE_PROFILE
+        MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
+#endif
+        new_node = ret;
+        break;
+      }
+    }
+
+    if (new_node == nullptr) {
+      // find success, and add them to todo list
+      if (IsValueNode<FuncGraph>(node)) {
+        todo.push_back(GetValueNode<FuncGraphPtr>(node)->output());
+      }
+      if (node->isa<CNode>()) {
+        auto &inputs = node->cast<CNodePtr>()->inputs();
+        (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
+      }
+      continue;
+    }
+
+    // the new node is tried again against all the transforms before its inputs are visited, and its users may now
+    // be matched by a transform
+    changes = true;
+    if (new_node->seen_ == seen) {
+      new_node->seen_--;
+    }
+    todo.push_front(new_node);
+    auto &node_users = manager->node_users();
+    auto users = node_users.find(new_node);
+    if (users != node_users.end()) {
+      for (auto &use : users->second) {
+        auto use_node = use.first;
+        if (use_node == nullptr) {
+          continue;
+        }
+        todo.push_back(use_node);
+        if (use_node->seen_ == seen) {
+          use_node->seen_--;
+        }
+      }
+    }
+  }
+
+#ifdef ENABLE_PROFILE
+  MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+#endif
+  return changes;
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -194,27 +325,34 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
     }
   }
 
-  bool loop = false;
-  bool changes = false;
+  // record the status of each transform
+  auto record_status = [&status, &space, &optimizer, this](size_t i, bool change) {
+    if (optimizer->is_on_debug_) {
+      status[list_[i]->name_ + std::to_string(i)].push_back(change);
+      space = std::max(list_[i]->name_.size(), space);
+    }
+  };
 
-  do {
-    loop = false;
+  bool changes = false;
+  if (is_once_) {
+    // each transform goes through the graph once, in the order of the list
     for (size_t i = 0; i < list_.size(); i++) {
       auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
       changes = changes || change;
-      loop = loop || change;
-
-      // record the status of each transform
-      if (optimizer->is_on_debug_) {
-        status[list_[i]->name_ + std::to_string(i)].push_back(change);
-        space = std::max(list_[i]->name_.size(), space);
-      }
-    }
-
-    if (is_once_) {
-      break;
+      record_status(i, change);
     }
-  } while (loop);
+  } else {
+    // all the transforms go through the graph together, until none of them changes it
+    bool loop = false;
+    do {
+      std::vector<bool> hits(list_.size(), false);
+      loop = ApplyTransforms(optimizer, func_graph->output(), &hits);
+      changes = changes || loop;
+      for (size_t i = 0; i < list_.size(); i++) {
+        record_status(i, hits[i]);
+      }
+    } while (loop);
+  }
 
   // display the status of each transform
   if (optimizer->is_on_debug_) {
@@ -228,7 +366,7 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
       for (auto change : status[name + std::to_string(i)]) {
         ss << change << " ";
       }
-      ss << std::endl;
+      ss << "\tmatch: " << list_[i]->match_count_ << ", hit: " << list_[i]->hit_count_ << std::endl;
     }
     MS_LOG(DEBUG) << ss.str();
   }
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -42,9 +43,18 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // the primitives of the cnodes this Substitution can be applied to, empty if only predicate_ selects the nodes
+  std::vector<PrimitivePtr> primitives_;
+  // number of nodes selected by predicate_ and number of nodes changed by transform_, for profiling
+  size_t match_count_{0};
+  size_t hit_count_{0};
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
-               const RenormAction &renorm_action)
-      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
+               const RenormAction &renorm_action, const std::vector<PrimitivePtr> &primitives = {})
+      : transform_(transform),
+        name_(name),
+        predicate_(predicate),
+        renorm_action_(renorm_action),
+        primitives_(primitives) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node);
 };
@@ -61,15 +71,23 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
   bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // apply all the Substitutions in one traversal of the graph, each node is only given to the Substitutions which
+  // may match it, and only the users of the changed nodes are visited again
+  bool ApplyTransforms(const OptimizerPtr &optimizer, const AnfNodePtr &root_node, std::vector<bool> *hits) const;
+  // indexes in list_ of the Substitutions which may match a node
+  const std::vector<size_t> &SelectTransforms(const AnfNodePtr &node) const;
   std::vector<SubstitutionPtr> list_;
+  // indexes of the Substitutions tried on the cnodes of each primitive, in the order of list_, and of the
+  // Substitutions tried on the other nodes, the ones selected by their predicate only
+  std::unordered_map<std::string, std::vector<size_t>> prim_transforms_;
+  std::vector<size_t> other_transforms_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
 };
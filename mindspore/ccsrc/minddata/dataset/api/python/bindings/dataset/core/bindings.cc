@@ -47,6 +47,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
                     .def("set_callback_timeout", &ConfigManager::set_callback_timeout)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("set_enable_image_fusion", &ConfigManager::set_enable_image_fusion)
+                    .def("get_enable_image_fusion", &ConfigManager::enable_image_fusion)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
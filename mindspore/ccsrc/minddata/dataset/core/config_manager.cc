@@ -32,6 +32,8 @@ ConfigManager::ConfigManager()
       seed_(kCfgDefaultSeed),
       monitor_sampling_interval_(kCfgMonitorSamplingInterval),
       callback_timout_(kCfgCallbackTimeout),
+      enable_autotune_(false),
+      enable_image_fusion_(false),
       cache_host_(kCfgDefaultCacheHost),
       cache_port_(kCfgDefaultCachePort) {
   auto env_cache_host = std::getenv("MS_CACHE_HOST");
@@ -71,6 +73,8 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
   set_cache_host(j.value("cacheHost", cache_host_));
   set_cache_port(j.value("cachePort", cache_port_));
+  set_enable_autotune(j.value("enableAutotune", enable_autotune_));
+  set_enable_image_fusion(j.value("enableImageFusion", enable_image_fusion_));
   return Status::OK();
 }
 
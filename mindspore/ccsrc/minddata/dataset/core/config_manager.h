@@ -143,6 +143,22 @@ class ConfigManager {
   // @return The timeout DSWaitedCallback would wait for before raising an error
   int32_t callback_timeout() const { return callback_timout_; }
 
+  // setter function
+  // @param enable - Whether the pipeline autotuner runs while the execution tree is executing
+  void set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+  // getter function
+  // @return T/F if the pipeline autotuner is enabled
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param enable - Whether TensorOpFusionPass fuses whole image augmentation chains into a FusedImageOp
+  void set_enable_image_fusion(bool enable) { enable_image_fusion_ = enable; }
+
+  // getter function
+  // @return T/F if the image augmentation chains are fused
+  bool enable_image_fusion() const { return enable_image_fusion_; }
+
  private:
   int32_t rows_per_buffer_;
   int32_t num_parallel_workers_;
@@ -151,6 +167,8 @@ class ConfigManager {
   uint32_t seed_;
   uint32_t monitor_sampling_interval_;
   uint32_t callback_timout_;
+  bool enable_autotune_;
+  bool enable_image_fusion_;
   std::string cache_host_;
   int32_t cache_port_;
 
@@ -99,6 +99,76 @@ Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, Tenso
 
   return Status::OK();
 }
+Status Tensor::CreateEmpty(const TensorShape &shape, const DataType &type, const std::shared_ptr<MemoryPool> &pool,
+                           TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Invalid shape.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "The type should be numeric.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+  int64_t byte_size = (*out)->SizeInBytes();
+  // Don't allocate if we have a tensor with no elements.
+  if (byte_size != 0) {
+    RETURN_IF_NOT_OK((*out)->AllocateBuffer(byte_size));
+  }
+  return Status::OK();
+}
+
+Status Tensor::CreateFromStringTensors(const std::vector<TensorPtr> &items, const TensorShape &shape, TensorPtr *out) {
+  dsize_t num_elements = 0;
+  dsize_t strings_length = 0;
+  for (const auto &item : items) {
+    RETURN_UNEXPECTED_IF_NULL(item);
+    CHECK_FAIL_RETURN_UNEXPECTED(item->type() == DataType::DE_STRING, "Input tensors should be of type string.");
+    dsize_t n = item->shape().NumOfElements();
+    if (n == 0) continue;
+    auto offset_arr = reinterpret_cast<const offset_t *>(item->data_);
+    num_elements += n;
+    strings_length += offset_arr[n] - offset_arr[0];
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    !shape.known() || num_elements == shape.NumOfElements(),
+    "Number of elements in the input tensors does not match the number of elements of the shape required");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, TensorShape({num_elements}), DataType(DataType::DE_STRING));
+  if (num_elements == 0) {
+    if (shape.known()) {
+      return (*out)->Reshape(shape);
+    }
+    return Status::OK();
+  }
+
+  // Same layout as CreateFromVector: offset array with one extra entry, followed by the null-terminated strings.
+  // Each input already stores its strings back to back, so only its offsets need to be rebased.
+  dsize_t num_bytes = (num_elements + 1) * kOffsetSize + strings_length;
+  RETURN_IF_NOT_OK((*out)->AllocateBuffer(num_bytes));
+  auto offset_arr = reinterpret_cast<offset_t *>((*out)->data_);
+  auto offset = static_cast<offset_t>((*out)->GetStringsBuffer() - (*out)->data_);
+  dsize_t i = 0;
+  for (const auto &item : items) {
+    dsize_t n = item->shape().NumOfElements();
+    if (n == 0) continue;
+    auto src_offset_arr = reinterpret_cast<const offset_t *>(item->data_);
+    offset_t first = src_offset_arr[0];
+    offset_t length = src_offset_arr[n] - first;
+    for (dsize_t k = 0; k < n; k++) {
+      offset_arr[i++] = offset + (src_offset_arr[k] - first);
+    }
+    int ret_code = memcpy_s((*out)->data_ + offset, num_bytes - offset, item->data_ + first, length);
+    CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy strings into tensor.");
+    offset += length;
+  }
+  // store one more offset value so we can get the length of the last string
+  offset_arr[i] = offset;
+  (*out)->data_end_ = (*out)->data_ + offset;
+
+  if (shape.known()) {
+    RETURN_IF_NOT_OK((*out)->Reshape(shape));
+  }
+  return Status::OK();
+}
+
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, TensorPtr *out) {
   RETURN_IF_NOT_OK(CreateEmpty(shape, type, out));
   if (src != nullptr) {
@@ -57,6 +57,7 @@ namespace dataset {
 class Tensor;
 template <typename T>
 class Allocator;
+class MemoryPool;
 
 using CharAllocPtr = std::unique_ptr<Allocator<unsigned char>>;
 using TensorAllocPtr = std::shared_ptr<Allocator<Tensor>>;  // An allocator shared_ptr for Tensors
@@ -91,6 +92,16 @@ class Tensor {
   /// \return Status code
   static Status CreateEmpty(const TensorShape &shape, const DataType &type, TensorPtr *out);
 
+  /// Create a numeric tensor with type and shape whose data is allocated from the given memory pool instead of the
+  /// global one. The data is handed back to the pool when the tensor is destroyed.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] pool memory pool for the data of the tensor
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateEmpty(const TensorShape &shape, const DataType &type, const std::shared_ptr<MemoryPool> &pool,
+                            TensorPtr *out);
+
   /// Create a numeric tensor from a pointer in memory. Length of the source data is determined from the shape and type.
   /// Data will be copied into the new created tensor.
   /// \param[in] shape shape of the output tensor
@@ -110,6 +121,14 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a string tensor holding the elements of the given string tensors one after another. The offsets and
+  /// strings of each input are copied as a block, so no per element string is built.
+  /// \param[in] items string tensors to be concatenated
+  /// \param[in] shape shape of the output tensor, must hold the total number of elements of the inputs
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromStringTensors(const std::vector<TensorPtr> &items, const TensorShape &shape, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
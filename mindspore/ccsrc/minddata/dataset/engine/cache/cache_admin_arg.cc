@@ -19,6 +19,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include <cerrno>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <cstdlib>
@@ -62,6 +63,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["--shared_memory_size"] = ArgValue::kArgSharedMemorySize;
   arg_map_["-l"] = ArgValue::kArgLogLevel;
   arg_map_["--minloglevel"] = ArgValue::kArgLogLevel;
+  arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -175,6 +177,10 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
           AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdGenerateSession));
         break;
       }
+      case ArgValue::kArgListSessions: {
+        RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdListSessions));
+        break;
+      }
       case ArgValue::kArgHelp: {
         command_id_ = CommandId::kCmdHelp;
         break;
@@ -273,6 +279,10 @@ Status CacheAdminArgHandler::RunCommand() {
       std::cout << "Drop session successful" << std::endl;
       break;
     }
+    case CommandId::kCmdListSessions: {
+      RETURN_IF_NOT_OK(ListSessions());
+      break;
+    }
     default: {
       RETURN_STATUS_UNEXPECTED("Invalid cache admin command id.");
       break;
@@ -282,6 +292,35 @@ Status CacheAdminArgHandler::RunCommand() {
   return Status::OK();
 }
 
+Status CacheAdminArgHandler::ListSessions() {
+  CacheClientGreeter comm(hostname_, port_, 1);
+  RETURN_IF_NOT_OK(comm.ServiceStart());
+  auto rq = std::make_shared<ListSessionsRequest>();
+  RETURN_IF_NOT_OK(comm.HandleRequest(rq));
+  RETURN_IF_NOT_OK(rq->Wait());
+  const auto &caches = rq->GetCaches();
+  if (caches.empty()) {
+    std::cout << "No active sessions." << std::endl;
+    return Status::OK();
+  }
+  // Hit rates are the share of the row lookups served from each tier, a miss is a row not in the cache.
+  auto rate = [](int64_t n, int64_t total) { return total > 0 ? 100.0 * n / total : 0.0; };
+  std::cout << std::left << std::setw(12) << "Session" << std::setw(22) << "Cache id" << std::right << std::setw(12)
+            << "Mem rows" << std::setw(12) << "Zip rows" << std::setw(12) << "Disk rows" << std::setw(10) << "Mem hit"
+            << std::setw(10) << "Zip hit" << std::setw(10) << "Disk hit" << std::setw(10) << "Miss" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  for (const auto &cache : caches) {
+    const auto &st = cache.stat;
+    int64_t lookups = st.num_mem_hit + st.num_compressed_hit + st.num_disk_hit + st.num_miss;
+    std::cout << std::left << std::setw(12) << cache.session_id << std::setw(22) << cache.connection_id << std::right
+              << std::setw(12) << st.num_mem_cached << std::setw(12) << st.num_compressed_cached << std::setw(12)
+              << st.num_disk_cached << std::setw(9) << rate(st.num_mem_hit, lookups) << "%" << std::setw(9)
+              << rate(st.num_compressed_hit, lookups) << "%" << std::setw(9) << rate(st.num_disk_hit, lookups) << "%"
+              << std::setw(9) << rate(st.num_miss, lookups) << "%" << std::endl;
+  }
+  return Status::OK();
+}
+
 Status CacheAdminArgHandler::StartServer() {
   // There currently does not exist any "install path" or method to identify which path the installed binaries will
   // exist in. As a temporary approach, we will assume that the server binary shall exist in the same path as the
@@ -388,6 +427,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "               [ [-p | --port] <port number> ]\n";
   std::cerr << "               [ [-g | --generate_session] ]\n";
   std::cerr << "               [ [-d | --destroy_session] <session id> ]\n";
+  std::cerr << "               [--list_sessions]\n";
   std::cerr << "               [ [-w | --workers] <number of workers> ]\n";
   std::cerr << "               [ [-s | --spilldir] <spilling directory> ]\n";
   std::cerr << "               [ [-m | --shared_memory_size] <shared memory size> ]\n";
@@ -240,14 +240,48 @@ Status FetchSchemaRequest::PostReply() {
 
 std::unordered_map<std::string, int32_t> FetchSchemaRequest::GetColumnMap() { return column_name_id_map_; }
 
+namespace {
+void ParseServiceStat(const ServiceStatMsg *msg, CacheServiceStat *stat) {
+  stat->num_disk_cached = msg->num_disk_cached();
+  stat->num_mem_cached = msg->num_mem_cached();
+  stat->avg_cache_sz = msg->avg_cache_sz();
+  stat->max_row_id = msg->max_row_id();
+  stat->min_row_id = msg->min_row_id();
+  stat->cache_service_state = msg->state();
+  stat->num_compressed_cached = msg->num_compressed_cached();
+  stat->mem_bytes = msg->mem_bytes();
+  stat->compressed_bytes = msg->compressed_bytes();
+  stat->disk_bytes = msg->disk_bytes();
+  stat->num_mem_hit = msg->num_mem_hit();
+  stat->num_compressed_hit = msg->num_compressed_hit();
+  stat->num_disk_hit = msg->num_disk_hit();
+  stat->num_miss = msg->num_miss();
+}
+}  // namespace
+
 Status GetStatRequest::PostReply() {
   auto *msg = flatbuffers::GetRoot<ServiceStatMsg>(reply_.result().data());
-  stat_.num_disk_cached = msg->num_disk_cached();
-  stat_.num_mem_cached = msg->num_mem_cached();
-  stat_.avg_cache_sz = msg->avg_cache_sz();
-  stat_.max_row_id = msg->max_row_id();
-  stat_.min_row_id = msg->min_row_id();
-  stat_.cache_service_state = msg->state();
+  ParseServiceStat(msg, &stat_);
+  return Status::OK();
+}
+
+Status ListSessionsRequest::PostReply() {
+  auto *msg = flatbuffers::GetRoot<ListSessionsMsg>(reply_.result().data());
+  caches_.clear();
+  if (msg->caches() == nullptr) {
+    return Status::OK();
+  }
+  auto num_caches = msg->caches()->size();
+  caches_.reserve(num_caches);
+  for (auto i = 0; i < num_caches; ++i) {
+    auto cache = msg->caches()->Get(i);
+    CHECK_FAIL_RETURN_UNEXPECTED(cache->stat() != nullptr, "Missing cache statistics");
+    CacheStatEntry entry{};
+    entry.session_id = cache->session_id();
+    entry.connection_id = cache->connection_id();
+    ParseServiceStat(cache->stat(), &entry.stat);
+    caches_.push_back(entry);
+  }
   return Status::OK();
 }
 }  // namespace dataset
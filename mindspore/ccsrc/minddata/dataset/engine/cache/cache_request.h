@@ -44,6 +44,21 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_compressed_cached;
+  int64_t mem_bytes;
+  int64_t compressed_bytes;
+  int64_t disk_bytes;
+  int64_t num_mem_hit;
+  int64_t num_compressed_hit;
+  int64_t num_disk_hit;
+  int64_t num_miss;
+};
+
+/// \brief Statistics of one cache returned by ListSessionsRequest
+struct CacheStatEntry {
+  session_id_type session_id;
+  connection_id_type connection_id;
+  CacheServiceStat stat;
 };
 
 /// \brief CacheClient communicates with CacheServer using Requests.
@@ -65,6 +80,7 @@ class BaseRequest {
     kAllocateSharedBlock = 11,
     kFreeSharedBlock = 12,
     kStopService = 13,
+    kListSessions = 14,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -349,6 +365,22 @@ class AllocateSharedBlockRequest : public BaseRequest {
   }
 };
 
+/// \brief Request the statistics of all the caches of the server
+class ListSessionsRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  ListSessionsRequest() : BaseRequest(RequestType::kListSessions) {}
+  ~ListSessionsRequest() = default;
+
+  /// \brief Override base function to process the result.
+  Status PostReply() override;
+
+  const std::vector<CacheStatEntry> &GetCaches() const { return caches_; }
+
+ private:
+  std::vector<CacheStatEntry> caches_;
+};
+
 class ShutdownRequest : public BaseRequest {
  public:
   friend class CacheServer;
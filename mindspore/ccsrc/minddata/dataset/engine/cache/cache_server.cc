@@ -325,6 +325,26 @@ Status CacheServer::BatchFetchRows(CacheService *cs, CacheRequest *rq, CacheRepl
   return Status::OK();
 }
 
+inline flatbuffers::Offset<ServiceStatMsg> ServiceStatToMsg(flatbuffers::FlatBufferBuilder *fbb,
+                                                                const CacheService::ServiceStat &svc_stat) {
+  ServiceStatMsgBuilder bld(*fbb);
+  bld.add_num_disk_cached(svc_stat.stat_.num_disk_cached);
+  bld.add_num_mem_cached(svc_stat.stat_.num_mem_cached);
+  bld.add_avg_cache_sz(svc_stat.stat_.average_cache_sz);
+  bld.add_max_row_id(svc_stat.max_);
+  bld.add_min_row_id(svc_stat.min_);
+  bld.add_state(svc_stat.state_);
+  bld.add_num_compressed_cached(svc_stat.stat_.num_compressed_cached);
+  bld.add_mem_bytes(svc_stat.stat_.mem_bytes);
+  bld.add_compressed_bytes(svc_stat.stat_.compressed_bytes);
+  bld.add_disk_bytes(svc_stat.stat_.disk_bytes);
+  bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+  bld.add_num_compressed_hit(svc_stat.stat_.num_compressed_hit);
+  bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+  bld.add_num_miss(svc_stat.num_miss_);
+  return bld.Finish();
+}
+
 inline Status GetStat(CacheService *cs, CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   if (cs == nullptr) {
@@ -334,20 +354,35 @@ inline Status GetStat(CacheService *cs, CacheRequest *rq, CacheReply *reply) {
     CacheService::ServiceStat svc_stat;
     RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
     flatbuffers::FlatBufferBuilder fbb;
-    ServiceStatMsgBuilder bld(fbb);
-    bld.add_num_disk_cached(svc_stat.stat_.num_disk_cached);
-    bld.add_num_mem_cached(svc_stat.stat_.num_mem_cached);
-    bld.add_avg_cache_sz(svc_stat.stat_.average_cache_sz);
-    bld.add_max_row_id(svc_stat.max_);
-    bld.add_min_row_id(svc_stat.min_);
-    bld.add_state(svc_stat.state_);
-    auto offset = bld.Finish();
+    auto offset = ServiceStatToMsg(&fbb, svc_stat);
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
   }
   return Status::OK();
 }
 
+Status CacheServer::ListSessions(CacheReply *reply) {
+  SharedLock lck(&rwLock_);
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<CacheStatMsg>> caches;
+  for (auto &cs : all_caches_) {
+    CacheService::ServiceStat svc_stat;
+    RETURN_IF_NOT_OK(cs.second->GetStat(&svc_stat));
+    auto stat_off = ServiceStatToMsg(&fbb, svc_stat);
+    CacheStatMsgBuilder bld(fbb);
+    bld.add_session_id(GetSessionID(cs.first));
+    bld.add_connection_id(cs.first);
+    bld.add_stat(stat_off);
+    caches.push_back(bld.Finish());
+  }
+  auto v_off = fbb.CreateVector(caches);
+  ListSessionsMsgBuilder bld(fbb);
+  bld.add_caches(v_off);
+  fbb.Finish(bld.Finish());
+  reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
+  return Status::OK();
+}
+
 inline Status CacheSchema(CacheService *cs, CacheRequest *rq) {
   auto connection_id = rq->connection_id();
   if (cs == nullptr) {
@@ -493,6 +528,10 @@ Status CacheServer::ServerRequest(int32_t worker_id) {
         cache_req->rc_ = FreeSharedMemory(&rq);
         break;
       }
+      case BaseRequest::RequestType::kListSessions: {
+        cache_req->rc_ = ListSessions(&reply);
+        break;
+      }
       case BaseRequest::RequestType::kStopService: {
         // This command shutdowns everything.
         cache_req->rc_ = GlobalShutdown();
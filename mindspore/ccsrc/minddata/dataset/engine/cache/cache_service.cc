@@ -26,7 +26,8 @@ CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool genera
       next_id_(0),
       generate_id_(generate_id),
       schema_key_(-1),
-      st_(generate_id ? State::kBuildPhase : State::kNone) {}
+      st_(generate_id ? State::kBuildPhase : State::kNone),
+      num_miss_(0) {}
 CacheService::~CacheService() { (void)ServiceStop(); }
 bool CacheService::UseArena() {
   // If fixed size, use Arena instead of the pool from global context.
@@ -173,14 +174,17 @@ Status CacheService::Purge() {
   map_.reset();
   map_ = std::move(new_map);
   next_id_ = 0;
+  num_miss_ = 0;
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   return Status::OK();
 }
 Status CacheService::GetStat(CacheService::ServiceStat *out) {
   SharedLock rw(&rw_lock_);
   RETURN_UNEXPECTED_IF_NULL(out);
+  // The pool keeps running counters so its statistics are cheap to get even while the cache is being built.
+  out->stat_ = cp_->GetStat();
+  out->num_miss_ = num_miss_;
   if (st_ == State::kNone || st_ == State::kFetchPhase) {
-    out->stat_ = cp_->GetStat();
     out->state_ = static_cast<ServiceStat::state_type>(st_);
     auto it = map_->begin();
     if (it != map_->end()) {
@@ -217,6 +221,7 @@ Status CacheService::PreBatchFetch(const std::vector<row_id_type> &v, std::vecto
       (*out).emplace_back(key, sz);
       (*mem_sz) += sz;
     } else {
+      ++num_miss_;
       (*out).emplace_back(-1, 0);
     }
   }
@@ -97,12 +97,13 @@ class CacheService : public Service {
   class ServiceStat {
    public:
     using state_type = std::underlying_type<State>::type;
-    ServiceStat() : min_(0), max_(0), state_(0) {}
+    ServiceStat() : min_(0), max_(0), state_(0), num_miss_(0) {}
     ~ServiceStat() = default;
     CachePool::CacheStat stat_{};
     row_id_type min_;
     row_id_type max_;
     state_type state_;
+    int64_t num_miss_;
   };
   /// \brief Statistics for the current service
   /// \param[in/out] A pointer to a pre-allocated ServiceStat structure
@@ -148,6 +149,7 @@ class CacheService : public Service {
   std::atomic<CachePool::key_type> schema_key_;
   std::string cookie_;
   State st_;
+  std::atomic<int64_t> num_miss_;  // Rows asked for but not in the cache
 
   /// \brief Private function to generate a row id
   /// \return Row id assigned.
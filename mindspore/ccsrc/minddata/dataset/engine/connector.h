@@ -174,6 +174,19 @@ class Connector {
     return capacity;
   }
 
+  // Change the capacity of every internal queue while the connector is in use.
+  // @param queue_capacity The new number of element (DataBuffer) for each queue.
+  // @return Status - The error code return
+  Status Resize(int32_t queue_capacity) {
+    if (queue_capacity <= 0) {
+      RETURN_STATUS_UNEXPECTED("Connector queue capacity must be greater than 0.");
+    }
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -26,9 +26,15 @@
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
+#include "minddata/dataset/util/recycle_pool.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Released batch buffers kept for reuse for each worker and each queued batch, enough for a few columns per batch
+constexpr size_t kRecycledBuffersPerBatch = 4;
+}  // namespace
+
 BatchOp::Builder::Builder(int32_t batch_size) : builder_drop_(false), builder_pad_(false), builder_pad_map_({}) {
   builder_batch_size_ = batch_size;
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
@@ -74,7 +80,9 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       pyfunc_column_names_(cols_to_map),
       batch_size_func_(batch_size_func),
       batch_map_func_(batch_map_func),
-      pad_info_(pad_map) {
+      pad_info_(pad_map),
+      batch_buffer_pool_(std::make_shared<RecyclePool>(static_cast<size_t>(num_workers + op_queue_size) *
+                                                kRecycledBuffersPerBatch)) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 #else
@@ -85,7 +93,9 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       drop_(drop),
       pad_(pad),
       pyfunc_column_names_(cols_to_map),
-      pad_info_(pad_map) {
+      pad_info_(pad_map),
+      batch_buffer_pool_(std::make_shared<RecyclePool>(static_cast<size_t>(num_workers + op_queue_size) *
+                                                kRecycledBuffersPerBatch)) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 #endif
@@ -155,7 +165,7 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size) {
+                          dsize_t batch_size, const std::shared_ptr<MemoryPool> &buffer_pool) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
@@ -180,7 +190,11 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
 
     std::shared_ptr<Tensor> new_tensor;
     if (first_type.IsNumeric()) {  // numeric tensor
-      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+      if (buffer_pool != nullptr) {
+        RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, buffer_pool, &new_tensor));
+      } else {
+        RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+      }
       dsize_t j = 0;
       for (auto row : **src) {
         std::shared_ptr<Tensor> old_tensor = row.at(i);  // row j, column i
@@ -196,14 +210,18 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
         }
       }
     } else {  // handle string column differently
-      std::vector<std::string> strings;
-      for (dsize_t j = 0; j < batch_size; j++) {
-        std::shared_ptr<Tensor> old_tensor = (*src)->at(j).at(i);
-        for (auto itr = old_tensor->begin<std::string_view>(); itr != old_tensor->end<std::string_view>(); itr++) {
-          strings.emplace_back(*itr);
+      std::vector<std::shared_ptr<Tensor>> strings;
+      strings.reserve(batch_size);
+      for (const auto &row : **src) {
+        std::shared_ptr<Tensor> old_tensor = row.at(i);
+        if (old_tensor->shape() != first_shape) {
+          RETURN_STATUS_UNEXPECTED(
+            "Invalid data, expect same shape for each data row, but got inconsistent data shapes in column " +
+            std::to_string(i));
         }
+        strings.push_back(std::move(old_tensor));
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromVector(strings, new_shape, &new_tensor));
+      RETURN_IF_NOT_OK(Tensor::CreateFromStringTensors(strings, new_shape, &new_tensor));
     }
     batched_row.emplace_back(new_tensor);
   }
@@ -241,7 +259,7 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), batch_buffer_pool_));
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
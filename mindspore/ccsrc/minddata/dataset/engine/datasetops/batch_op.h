@@ -202,14 +202,16 @@ class BatchOp : public ParallelOp {
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
-  // batch the rows in src table then put it to dest table
+  // batch the rows in src table then put it to dest table, each row of a numeric column is copied into its slice of
+  // the batched tensor
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
-  // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param dsize_t batch_size - number of rows in src
+  // @param const std::shared_ptr<MemoryPool> &buffer_pool - pool recycling the buffers of the numeric batched tensors,
+  //     the global pool is used if it is null
   // @return Status - The error code return
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size);
+                          dsize_t batch_size, const std::shared_ptr<MemoryPool> &buffer_pool = nullptr);
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -276,6 +278,7 @@ class BatchOp : public ParallelOp {
   PadInfo pad_info_;                               // column names to perform padding on
   std::unique_ptr<ChildIterator> child_iterator_;  // child iterator for fetching TensorRows 1 by 1
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
+  std::shared_ptr<MemoryPool> batch_buffer_pool_;  // recycles the buffers of batched tensors released downstream
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
   py::function batch_map_func_;   // Function pointer of per batch map function
@@ -158,6 +158,7 @@ Status CacheOp::WaitForCachingAllRows() {
   num_rows_ = max_key - min_key + 1;
   MS_LOG(INFO) << "Number of rows cached: " << num_rows_;
   MS_LOG(INFO) << "Number of rows cached in memory : " << stat.num_mem_cached;
+  MS_LOG(INFO) << "Number of rows compressed in memory : " << stat.num_compressed_cached;
   MS_LOG(INFO) << "Number of rows spilled to disk : " << stat.num_disk_cached;
   MS_LOG(INFO) << "Average cache size : " << stat.avg_cache_sz;
   // Now all rows are cached and we have done a sync point check up. Next phase is
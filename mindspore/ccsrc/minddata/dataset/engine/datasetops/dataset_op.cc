@@ -219,6 +219,14 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   }
 }
 
+// Changes the capacity of the output connector, the configured oc_queue_size_ is kept for printing and prepare
+Status DatasetOp::ResizeConnector(int32_t op_connector_size) {
+  if (out_connector_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Operator " + std::to_string(operator_id_) + " does not have an output connector.");
+  }
+  return out_connector_->Resize(op_connector_size);
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   // When show_all is false, we display a 1 liner piece of text for the op.
@@ -293,6 +293,11 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  /// \brief Change the capacity of the output connector while the op is running
+  /// \param[in] op_connector_size The new capacity of each queue of the output connector
+  /// \return Status The status code returned
+  Status ResizeConnector(int32_t op_connector_size);
+
   /// \brief Getter function
   /// \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
@@ -17,6 +17,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <vector>
 #include "minddata/dataset/core/config_manager.h"
 
@@ -35,6 +36,16 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// With the autotuner enabled, spare workers are launched so that the tuner can grow the op at run time
+int32_t NumLaunchedWorkers(int32_t num_workers) {
+  if (!GlobalContext::config_manager()->enable_autotune()) {
+    return num_workers;
+  }
+  return std::max(num_workers, static_cast<int32_t>(std::thread::hardware_concurrency()));
+}
+}  // namespace
+
 // Builder constructor. Creates the builder object.
 MapOp::Builder::Builder() {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
@@ -63,10 +74,12 @@ Status MapOp::Builder::Build(std::shared_ptr<MapOp> *ptr) {
 // Constructor of MapOp
 MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size)
-    : ParallelOp(num_workers, op_connector_size),
+    : ParallelOp(NumLaunchedWorkers(num_workers), op_connector_size),
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
-      out_columns_(out_col_names) {
+      out_columns_(out_col_names),
+      num_active_workers_(num_workers),
+      num_computing_workers_(0) {
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
@@ -90,6 +103,7 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
     // Call the super class for displaying any common detailed info
     ParallelOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
+    out << "\nActive workers: " << num_active_workers_;
     out << "\nInput column names:";
     for (size_t i = 0; i < in_columns_.size(); i++) {
       out << " " << in_columns_[i];
@@ -165,6 +179,7 @@ Status MapOp::operator()() {
   RETURN_IF_NOT_OK(callback_manager_.Init(this));
   Status rc = local_queues_.Register(tree_->AllTasks());
   RETURN_IF_NOT_OK(wait_for_workers_post_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(active_workers_cv_.Register(tree_->AllTasks()->GetIntrpService()));
   if (rc.IsError()) {
     TaskManager::FindMe()->Post();
     return rc;
@@ -243,6 +258,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
   std::unique_ptr<DataBuffer> in_buffer;
   std::vector<std::shared_ptr<MapJob>> job_list;
+  Status rc;
   // Fetch next data buffer and map job list
   RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_buffer, &job_list));
 
@@ -274,7 +290,10 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     CHECK_FAIL_RETURN_UNEXPECTED(in_buffer->NumRows() * in_buffer->NumCols() != 0, "MapOp got an empty DataBuffer.");
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list));
+    RETURN_IF_NOT_OK(AcquireComputeTurn());
+    rc = WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list);
+    ReleaseComputeTurn();
+    RETURN_IF_NOT_OK(rc);
     // Replace the TensorTable in DataBuffer with the new one.
     in_buffer->set_tensor_table(std::move(new_tensor_table));
     // Push the buffer onto the connector for next operator to consume.
@@ -285,6 +304,30 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
+Status MapOp::AcquireComputeTurn() {
+  std::unique_lock<std::mutex> lck(active_workers_mux_);
+  RETURN_IF_NOT_OK(active_workers_cv_.Wait(&lck, [this]() { return num_computing_workers_ < num_active_workers_; }));
+  num_computing_workers_++;
+  return Status::OK();
+}
+
+void MapOp::ReleaseComputeTurn() {
+  std::unique_lock<std::mutex> lck(active_workers_mux_);
+  num_computing_workers_--;
+  active_workers_cv_.NotifyOne();
+}
+
+Status MapOp::SetNumActiveWorkers(int32_t num_workers) {
+  if (num_workers < 1 || num_workers > num_workers_) {
+    RETURN_STATUS_UNEXPECTED("Invalid number of active workers " + std::to_string(num_workers) +
+                             " for MapOp, it should be between 1 and " + std::to_string(num_workers_) + ".");
+  }
+  std::unique_lock<std::mutex> lck(active_workers_mux_);
+  num_active_workers_ = num_workers;
+  active_workers_cv_.NotifyAll();
+  return Status::OK();
+}
+
 Status MapOp::WorkerCompute(DataBuffer *in_buffer, TensorQTable *new_tensor_table,
                             const std::vector<std::shared_ptr<MapJob>> &job_list) {
   int32_t num_rows = in_buffer->NumRows();
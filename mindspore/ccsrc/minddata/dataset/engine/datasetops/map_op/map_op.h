@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -27,6 +28,7 @@
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/cond_var.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/wait_post.h"
 
@@ -142,7 +144,8 @@ class MapOp : public ParallelOp {
   // @param in_col_names A list of input column names (should match the input/output \p tensorFuncs).
   // @param out_col_names A list of output column names (should match the input/output \p tensorFuncs).
   // @param tensor_funcs A list of TensorOp pointers for MapOp to apply to each data.
-  // @param num_workers The number of worker threads.
+  // @param num_workers The number of worker threads. When the autotuner is enabled, spare workers are launched up to
+  //     the number of hardware threads and num_workers of them are active.
   // @param op_connector_size The size of each queue in the connector.
   MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
         std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size);
@@ -177,6 +180,21 @@ class MapOp : public ParallelOp {
   // @return the number of threads consuming data from previous op's output Connector.
   int32_t num_consumers() const override;
 
+  // Getter
+  // @return The number of workers allowed to run the TensorOps at the same time
+  int32_t num_workers() const override { return num_active_workers_; }
+
+  // Getter
+  // @return The number of worker threads launched, the upper bound of the active workers
+  int32_t max_num_workers() const { return num_workers_; }
+
+  // Change the number of workers allowed to run the TensorOps at the same time, it can be called while the op is
+  // running. Every launched worker keeps its local queue, the inactive ones wait before computing their next buffer,
+  // so the order of the output buffers does not change.
+  // @param num_workers - The number of active workers, from 1 to max_num_workers()
+  // @return Status The error code return
+  Status SetNumActiveWorkers(int32_t num_workers);
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -234,6 +252,17 @@ class MapOp : public ParallelOp {
   // Count number of workers that have signaled master
   std::atomic_int num_workers_paused_;
 
+  // Number of workers allowed to compute at the same time, at most num_workers_
+  std::atomic_int num_active_workers_;
+
+  // Number of workers computing a buffer, guarded by active_workers_mux_
+  int32_t num_computing_workers_;
+
+  std::mutex active_workers_mux_;
+
+  // Wakes up the workers waiting for their turn to compute
+  CondVar active_workers_cv_;
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -242,6 +271,13 @@ class MapOp : public ParallelOp {
   // @return Status The error code return
   Status WorkerEntry(int32_t worker_id) override;  //  In: workerId assigned by tree_
 
+  // Block the worker until fewer than num_active_workers_ workers are computing, then count it as computing.
+  // @return Status The error code return
+  Status AcquireComputeTurn();
+
+  // Count the worker as no longer computing and wake up a waiting one
+  void ReleaseComputeTurn();
+
   // Private function for worker thread to perform TensorOp's compute function and get the result.
   // @param in_buffer A raw pointer to the DataBuffer. A raw pointer is fine because this function doesn't manage memory
   //     and is not shared with other threads.
@@ -268,7 +268,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
     auto rc = shard_reader_->GetNextById(row_id, worker_id);
     auto task_type = rc.first;
-    auto tupled_buffer = rc.second;
+    const auto &tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
       TensorRow tensor_row;
       RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, {}, mindrecord::json(), task_type));
@@ -277,8 +277,8 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
     if (tupled_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+        const mindrecord::json &columns_json = std::get<1>(tupled_row);
         TensorRow tensor_row;
         RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
         tensor_table->push_back(std::move(tensor_row));
@@ -30,6 +30,7 @@
 #include "mindspore/ccsrc/minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/core/config_manager.h"
 
 namespace mindspore {
 namespace dataset {
@@ -150,6 +151,11 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    auto_tune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*auto_tune_)));
+  }
+
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
     // An inlined operator is one that has an output connector size of 0, and it does not
@@ -24,6 +24,7 @@
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/util/status.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 
 namespace mindspore {
 namespace dataset {
@@ -269,6 +270,7 @@ class ExecutionTree {
   TreeState tree_state_;                                 // Tracking the current tree state
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> auto_tune_;                  // Pipeline autotuner, created when the tree is launched
   bool optimize_;                                        // Flag to enable optional optimizations
 };
 }  // namespace dataset
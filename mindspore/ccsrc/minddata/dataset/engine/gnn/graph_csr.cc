@@ -0,0 +1,195 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <string>
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+Status GraphCsr::Build(const std::unordered_map<NodeType, std::vector<NodeIdType>> &node_type_map,
+                       const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map,
+                       const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_feature_map) {
+  CHECK_FAIL_RETURN_UNEXPECTED(node_id_map.size() < static_cast<size_t>(std::numeric_limits<DenseIdType>::max()),
+                               "Too many nodes: " + std::to_string(node_id_map.size()));
+  std::vector<NodeType> node_types;
+  for (const auto &itr : node_type_map) {
+    node_types.push_back(itr.first);
+  }
+  std::sort(node_types.begin(), node_types.end());
+
+  node_ids_.reserve(node_id_map.size());
+  dense_ids_.reserve(node_id_map.size());
+  for (const auto &type : node_types) {
+    std::vector<NodeIdType> ids = node_type_map.at(type);
+    std::sort(ids.begin(), ids.end());
+    DenseIdType begin = num_nodes();
+    for (const auto &id : ids) {
+      // A node id loaded twice is only kept once in node_id_map
+      if (dense_ids_.emplace(id, num_nodes()).second) {
+        node_ids_.push_back(id);
+      }
+    }
+    type_ranges_[type] = {begin, num_nodes()};
+  }
+
+  for (const auto &type : node_types) {
+    RETURN_IF_NOT_OK(BuildAdjacency(type, node_id_map));
+  }
+  for (const auto &itr : node_id_map) {
+    RETURN_IF_NOT_OK(itr.second->ClearNeighbors());
+  }
+
+  std::set<FeatureType> feature_types;
+  for (const auto &itr : node_feature_map) {
+    feature_types.insert(itr.second.begin(), itr.second.end());
+  }
+  for (const auto &feature_type : feature_types) {
+    std::vector<NodeType> types_with_feature;
+    for (const auto &type : node_types) {
+      auto itr = node_feature_map.find(type);
+      if (itr != node_feature_map.end() && itr->second.count(feature_type) > 0) {
+        types_with_feature.push_back(type);
+      }
+    }
+    RETURN_IF_NOT_OK(BuildFeatureBlock(feature_type, types_with_feature, node_id_map));
+  }
+  MS_LOG(INFO) << "Graph storage built, nodes: " << num_nodes() << ", neighbor types: " << adjacency_.size()
+               << ", feature blocks: " << feature_blocks_.size();
+  return Status::OK();
+}
+
+Status GraphCsr::BuildAdjacency(NodeType neighbor_type,
+                                const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map) {
+  Adjacency adjacency;
+  adjacency.offsets.reserve(node_ids_.size() + 1);
+  adjacency.offsets.push_back(0);
+  std::vector<NodeIdType> neighbors;
+  for (const auto &id : node_ids_) {
+    RETURN_IF_NOT_OK(node_id_map.at(id)->GetAllNeighbors(neighbor_type, &neighbors, true));
+    size_t begin = adjacency.neighbors.size();
+    for (const auto &neighbor : neighbors) {
+      DenseIdType dense_id;
+      RETURN_IF_NOT_OK(GetDenseId(neighbor, &dense_id));
+      adjacency.neighbors.push_back(dense_id);
+    }
+    std::sort(adjacency.neighbors.begin() + begin, adjacency.neighbors.end());
+    adjacency.offsets.push_back(static_cast<int64_t>(adjacency.neighbors.size()));
+  }
+  if (!adjacency.neighbors.empty()) {
+    adjacency.neighbors.shrink_to_fit();
+    adjacency_[neighbor_type] = std::move(adjacency);
+  }
+  return Status::OK();
+}
+
+Status GraphCsr::BuildFeatureBlock(FeatureType feature_type, const std::vector<NodeType> &node_types,
+                                   const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map) {
+  // The rows take the type and shape of the first feature found. Features of another type or shape stay in the nodes
+  std::shared_ptr<Tensor> first;
+  size_t num_rows = 0;
+  std::shared_ptr<Feature> feature;
+  for (const auto &type : node_types) {
+    auto range = type_ranges_[type];
+    for (DenseIdType i = range.first; i < range.second; ++i) {
+      if (node_id_map.at(node_ids_[i])->GetFeatures(feature_type, &feature).IsError()) {
+        continue;
+      }
+      if (first == nullptr) {
+        first = feature->Value();
+      } else if (feature->Value()->type() != first->type() || feature->Value()->shape() != first->shape()) {
+        MS_LOG(INFO) << "Feature type " << feature_type << " has several shapes, it is kept in the nodes.";
+        return Status::OK();
+      }
+      num_rows++;
+    }
+  }
+  if (first == nullptr || first->type() == DataType::DE_STRING) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "Too many features: " + std::to_string(num_rows));
+
+  size_t row_size = static_cast<size_t>(first->SizeInBytes());
+  auto block = std::make_unique<FeatureBlock>(first->type(), first->shape(), row_size, node_ids_.size());
+  block->data_.resize(num_rows * row_size);
+  int32_t row = 0;
+  for (const auto &type : node_types) {
+    auto range = type_ranges_[type];
+    for (DenseIdType i = range.first; i < range.second; ++i) {
+      const std::shared_ptr<Node> &node = node_id_map.at(node_ids_[i]);
+      if (node->GetFeatures(feature_type, &feature).IsError()) {
+        continue;
+      }
+      if (row_size > 0) {
+        (void)memcpy(block->data_.data() + static_cast<size_t>(row) * row_size, feature->Value()->GetBuffer(),
+                     row_size);
+      }
+      block->rows_[i] = row++;
+      RETURN_IF_NOT_OK(node->RemoveFeature(feature_type));
+    }
+  }
+  feature_blocks_[feature_type] = std::move(block);
+  return Status::OK();
+}
+
+Status GraphCsr::GetDenseId(NodeIdType id, DenseIdType *dense_id) const {
+  auto itr = dense_ids_.find(id);
+  if (itr == dense_ids_.end()) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *dense_id = itr->second;
+  return Status::OK();
+}
+
+std::pair<DenseIdType, DenseIdType> GraphCsr::GetTypeRange(NodeType type) const {
+  auto itr = type_ranges_.find(type);
+  if (itr == type_ranges_.end()) {
+    return {0, 0};
+  }
+  return itr->second;
+}
+
+const DenseIdType *GraphCsr::GetNeighbors(DenseIdType node, NodeType neighbor_type, int64_t *num) const {
+  auto itr = adjacency_.find(neighbor_type);
+  if (itr == adjacency_.end()) {
+    *num = 0;
+    return nullptr;
+  }
+  const Adjacency &adjacency = itr->second;
+  *num = adjacency.offsets[node + 1] - adjacency.offsets[node];
+  return adjacency.neighbors.data() + adjacency.offsets[node];
+}
+
+bool GraphCsr::IsNeighbor(DenseIdType node, NodeType neighbor_type, DenseIdType other) const {
+  int64_t num = 0;
+  const DenseIdType *neighbors = GetNeighbors(node, neighbor_type, &num);
+  return num > 0 && std::binary_search(neighbors, neighbors + num, other);
+}
+
+const GraphCsr::FeatureBlock *GraphCsr::GetFeatureBlock(FeatureType type) const {
+  auto itr = feature_blocks_.find(type);
+  return itr == feature_blocks_.end() ? nullptr : itr->second.get();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
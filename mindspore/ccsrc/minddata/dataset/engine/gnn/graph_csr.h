@@ -0,0 +1,145 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// Index of a node in the flat arrays of GraphCsr
+using DenseIdType = int32_t;
+
+// Compressed sparse row storage of the adjacency and the node features of a graph.
+// Node ids are remapped to dense ids [0, num_nodes). Nodes of a type get a contiguous range of dense ids, in the
+// order of their node ids, so that the nodes of a type can be sampled by drawing an integer in the range.
+// For each neighbor type, the neighbors of node i are neighbors[offsets[i], offsets[i + 1]), sorted, which makes
+// the neighbors of a node a contiguous array and membership a binary search.
+// Features which have the same type and shape for every node are stored as a columnar block of rows, in server
+// mode these are the locations of the features in the shared memory.
+class GraphCsr {
+ public:
+  // Rows of one feature type, row i is the feature of the node with dense id i
+  class FeatureBlock {
+   public:
+    FeatureBlock(DataType type, TensorShape shape, size_t row_size, size_t num_nodes)
+        : type_(type), shape_(std::move(shape)), row_size_(row_size), rows_(num_nodes, -1) {}
+
+    ~FeatureBlock() = default;
+
+    // @param DenseIdType node - dense id of the node
+    // @return const uchar * - The feature of the node, nullptr if the node does not have this feature
+    const uchar *Row(DenseIdType node) const {
+      return rows_[node] < 0 ? nullptr : data_.data() + static_cast<size_t>(rows_[node]) * row_size_;
+    }
+
+    DataType type() const { return type_; }
+
+    const TensorShape &shape() const { return shape_; }
+
+    size_t row_size() const { return row_size_; }
+
+   private:
+    friend class GraphCsr;
+    DataType type_;
+    TensorShape shape_;
+    size_t row_size_;
+    std::vector<int32_t> rows_;  // dense id to row in data_, -1 if the node does not have the feature
+    std::vector<uchar> data_;
+  };
+
+  GraphCsr() = default;
+
+  ~GraphCsr() = default;
+
+  // Build the storage from the loaded nodes. The neighbors and the features which are moved to the storage are
+  // released from the nodes afterwards.
+  // @param node_type_map - node ids of each type
+  // @param node_id_map - nodes connected to their neighbors, with their features
+  // @param node_feature_map - feature types of each node type
+  // @return Status - The error code return
+  Status Build(const std::unordered_map<NodeType, std::vector<NodeIdType>> &node_type_map,
+               const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map,
+               const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_feature_map);
+
+  // @return int32_t - Number of nodes
+  int32_t num_nodes() const { return static_cast<int32_t>(node_ids_.size()); }
+
+  // Find the dense id of a node
+  // @param NodeIdType id - node id
+  // @param DenseIdType *dense_id - Returned dense id
+  // @return Status - The error code return
+  Status GetDenseId(NodeIdType id, DenseIdType *dense_id) const;
+
+  // @param DenseIdType dense_id - dense id of a node
+  // @return NodeIdType - The node id
+  NodeIdType GetNodeId(DenseIdType dense_id) const { return node_ids_[dense_id]; }
+
+  // Range of the dense ids of the nodes of a type
+  // @param NodeType type - node type
+  // @return std::pair<DenseIdType, DenseIdType> - [begin, end), empty if there is no node of this type
+  std::pair<DenseIdType, DenseIdType> GetTypeRange(NodeType type) const;
+
+  // Neighbors of a node, as sorted dense ids
+  // @param DenseIdType node - dense id of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int64_t *num - Returned number of neighbors
+  // @return const DenseIdType * - The neighbors of the node
+  const DenseIdType *GetNeighbors(DenseIdType node, NodeType neighbor_type, int64_t *num) const;
+
+  // @param DenseIdType node - dense id of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param DenseIdType other - dense id of the other node
+  // @return bool - Whether other is a neighbor of node
+  bool IsNeighbor(DenseIdType node, NodeType neighbor_type, DenseIdType other) const;
+
+  // @param FeatureType type - feature type
+  // @return const FeatureBlock * - The rows of the feature, nullptr if the feature is kept in the nodes
+  const FeatureBlock *GetFeatureBlock(FeatureType type) const;
+
+ private:
+  struct Adjacency {
+    std::vector<int64_t> offsets;  // num_nodes + 1 offsets in neighbors
+    std::vector<DenseIdType> neighbors;
+  };
+
+  Status BuildAdjacency(NodeType neighbor_type,
+                        const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map);
+
+  Status BuildFeatureBlock(FeatureType feature_type, const std::vector<NodeType> &node_types,
+                           const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &node_id_map);
+
+  std::vector<NodeIdType> node_ids_;
+  std::unordered_map<NodeIdType, DenseIdType> dense_ids_;
+  std::unordered_map<NodeType, std::pair<DenseIdType, DenseIdType>> type_ranges_;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+  std::unordered_map<FeatureType, std::unique_ptr<FeatureBlock>> feature_blocks_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -24,9 +25,50 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
+namespace {
+// Batches smaller than this run on fewer threads, starting a thread costs more than sampling them
+constexpr size_t kMinBatchSize = 64;
+// Up to this number of samples, samples out of many more items are drawn and redrawn when already taken, instead of
+// shuffling all the items
+constexpr int64_t kMaxSparseSamples = 64;
+constexpr int64_t kSparseSampleRatio = 4;
+// A walk step draws a neighbor and accepts it with the ratio of its weight to the largest weight, as long as the
+// largest weight is at most this times the smallest one. Otherwise it builds the distribution over all neighbors.
+constexpr float kMaxRejectionRatio = 8.0;
+
+// Draw samples_num of [0, num) without replacement, and start over from all of [0, num) once they are all drawn
+template <typename F>
+void SampleIndices(int64_t num, int32_t samples_num, std::mt19937 *rnd, std::vector<int64_t> *scratch, F emit) {
+  int64_t left = samples_num;
+  while (left > 0) {
+    int64_t round = std::min(left, num);
+    if (round <= kMaxSparseSamples && round * kSparseSampleRatio <= num) {
+      std::uniform_int_distribution<int64_t> distribution(0, num - 1);
+      scratch->clear();
+      while (static_cast<int64_t>(scratch->size()) < round) {
+        int64_t index = distribution(*rnd);
+        if (std::find(scratch->begin(), scratch->end(), index) == scratch->end()) {
+          scratch->push_back(index);
+          emit(index);
+        }
+      }
+    } else {
+      scratch->resize(num);
+      std::iota(scratch->begin(), scratch->end(), 0);
+      for (int64_t i = 0; i < round; ++i) {
+        std::uniform_int_distribution<int64_t> distribution(i, num - 1);
+        std::swap((*scratch)[i], (*scratch)[distribution(*rnd)]);
+        emit((*scratch)[i]);
+      }
+    }
+    left -= round;
+  }
+}
+}  // namespace
 
 GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode)
     : dataset_file_(dataset_file),
@@ -95,6 +137,58 @@ Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t
   return Status::OK();
 }
 
+Status GraphDataImpl::CreateNodeIdTensor(size_t num_rows, size_t row_size, std::shared_ptr<Tensor> *out,
+                                         NodeIdType **data) {
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(num_rows), static_cast<dsize_t>(row_size)}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  uchar *start = nullptr;
+  TensorShape remaining = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(tensor->StartAddrOfIndex({0}, &start, &remaining));
+  *data = reinterpret_cast<NodeIdType *>(start);
+  *out = std::move(tensor);
+  return Status::OK();
+}
+
+Status GraphDataImpl::ParallelFor(size_t total, int32_t num_workers,
+                                  const std::function<Status(size_t begin, size_t end, std::mt19937 *rnd)> &func) {
+  size_t num_batches =
+    std::min(static_cast<size_t>(std::max(num_workers, 1)), (total + kMinBatchSize - 1) / kMinBatchSize);
+  num_batches = std::max(num_batches, static_cast<size_t>(1));
+  std::vector<uint32_t> seeds(num_batches);
+  {
+    std::unique_lock<std::mutex> lck(rnd_mux_);
+    for (auto &seed : seeds) {
+      seed = rnd_();
+    }
+  }
+  size_t batch_size = (total + num_batches - 1) / num_batches;
+  auto run_batch = [&func, &seeds, batch_size, total](size_t batch) -> Status {
+    std::mt19937 rnd(seeds[batch]);
+    return func(batch * batch_size, std::min(total, (batch + 1) * batch_size), &rnd);
+  };
+  if (num_batches == 1) {
+    return run_batch(0);
+  }
+  TaskGroup vg;
+  for (size_t batch = 0; batch < num_batches; ++batch) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("GraphSampler", [&run_batch, batch]() {
+      TaskManager::FindMe()->Post();
+      return run_batch(batch);
+    }));
+  }
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  return vg.GetTaskErrorIfAny();
+}
+
+Status GraphDataImpl::GetDenseIds(const std::vector<NodeIdType> &node_list, std::vector<DenseIdType> *dense_list) {
+  dense_list->resize(node_list.size());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    RETURN_IF_NOT_OK(csr_.GetDenseId(node_list[i], &(*dense_list)[i]));
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
   auto itr = edge_type_map_.find(edge_type);
   if (itr == edge_type_map_.end()) {
@@ -133,19 +227,28 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   CHECK_FAIL_RETURN_UNEXPECTED(!node_list.empty(), "Input node_list is empty.");
   RETURN_IF_NOT_OK(CheckNeighborType(neighbor_type));
 
-  std::vector<std::vector<NodeIdType>> neighbors;
-  size_t max_neighbor_num = 0;
-  neighbors.resize(node_list.size());
-  for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
-    max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
-  }
-
-  RETURN_IF_NOT_OK(ComplementVector<NodeIdType>(&neighbors, max_neighbor_num, kDefaultNodeId));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors, DataType(DataType::DE_INT32), out));
-
+  std::vector<DenseIdType> dense_list;
+  RETURN_IF_NOT_OK(GetDenseIds(node_list, &dense_list));
+  int64_t max_neighbor_num = 0;
+  for (const auto &node : dense_list) {
+    int64_t num = 0;
+    (void)csr_.GetNeighbors(node, neighbor_type, &num);
+    max_neighbor_num = std::max(max_neighbor_num, num);
+  }
+
+  // Each row is the node followed by its neighbors, filled with kDefaultNodeId
+  size_t row_size = static_cast<size_t>(max_neighbor_num) + 1;
+  NodeIdType *data = nullptr;
+  RETURN_IF_NOT_OK(CreateNodeIdTensor(node_list.size(), row_size, out, &data));
+  for (size_t i = 0; i < dense_list.size(); ++i) {
+    NodeIdType *row = data + i * row_size;
+    int64_t num = 0;
+    const DenseIdType *neighbors = csr_.GetNeighbors(dense_list[i], neighbor_type, &num);
+    row[0] = node_list[i];
+    std::transform(neighbors, neighbors + num, row + 1, [this](DenseIdType n) { return csr_.GetNodeId(n); });
+    std::fill(row + 1 + num, row + row_size, kDefaultNodeId);
+  }
+  (*out)->Squeeze();
   return Status::OK();
 }
 
@@ -181,53 +284,105 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
+  std::vector<DenseIdType> dense_list;
+  RETURN_IF_NOT_OK(GetDenseIds(node_list, &dense_list));
+
+  // Each row is the node followed by the neighbors sampled at each hop
+  size_t row_size = 1;
+  size_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  NodeIdType *data = nullptr;
+  RETURN_IF_NOT_OK(CreateNodeIdTensor(node_list.size(), row_size, out, &data));
+
+  auto sample = [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    std::vector<int64_t> scratch;
+    std::vector<DenseIdType> input_list;
+    std::vector<DenseIdType> sampled;
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      NodeIdType *row = data + node_idx * row_size;
+      *row++ = node_list[node_idx];
+      input_list.assign(1, dense_list[node_idx]);
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        sampled.clear();
+        for (const auto &node : input_list) {
+          int64_t num = 0;
+          // kDefaultNodeId stands for a missing node in dense ids too
+          const DenseIdType *neighbors =
+            node == kDefaultNodeId ? nullptr : csr_.GetNeighbors(node, neighbor_types[i], &num);
+          if (num == 0) {
+            // If there are no neighbors, they are filled with kDefaultNodeId
+            sampled.insert(sampled.end(), neighbor_nums[i], kDefaultNodeId);
+            continue;
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          SampleIndices(num, neighbor_nums[i], rnd, &scratch,
+                        [&sampled, neighbors](int64_t index) { sampled.push_back(neighbors[index]); });
         }
+        for (const auto &node : sampled) {
+          *row++ = node == kDefaultNodeId ? kDefaultNodeId : csr_.GetNodeId(node);
+        }
+        input_list.swap(sampled);
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
+  (*out)->Squeeze();
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                                     size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
-                                     int32_t samples_num, std::vector<NodeIdType> *out_samples) {
-  CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  size_t index = *start_index;
-  for (size_t i = index; i < shuffled_ids.size(); ++i) {
-    ++index;
-    if (exclude_data.find(data[shuffled_ids[i]]) != exclude_data.end()) {
-      continue;
+void GraphDataImpl::NegativeSample(DenseIdType node, NodeType neg_neighbor_type, int32_t samples_num,
+                                   std::mt19937 *rnd, std::vector<DenseIdType> *candidates,
+                                   std::vector<int64_t> *scratch, NodeIdType *out) {
+  auto range = csr_.GetTypeRange(neg_neighbor_type);
+  int64_t num = 0;
+  const DenseIdType *neighbors = csr_.GetNeighbors(node, neg_neighbor_type, &num);
+  auto excluded = [node, neighbors, num](DenseIdType candidate) {
+    return candidate == node || std::binary_search(neighbors, neighbors + num, candidate);
+  };
+  // The node and its neighbors are excluded, neighbors are sorted but an edge may be loaded several times
+  int64_t num_excluded = 0;
+  for (int64_t i = 0; i < num; ++i) {
+    if (i == 0 || neighbors[i] != neighbors[i - 1]) {
+      num_excluded++;
     }
-    out_samples->emplace_back(data[shuffled_ids[i]]);
-    if (out_samples->size() >= samples_num) {
-      break;
+  }
+  if (node >= range.first && node < range.second && !std::binary_search(neighbors, neighbors + num, node)) {
+    num_excluded++;
+  }
+  int64_t num_candidates = range.second - range.first;
+  int64_t num_left = num_candidates - num_excluded;
+  if (num_left <= 0) {
+    MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << csr_.GetNodeId(node)
+                  << " neg_neighbor_type:" << neg_neighbor_type;
+    // If there are no negative neighbors, they are filled with kDefaultNodeId
+    std::fill(out, out + samples_num, kDefaultNodeId);
+    return;
+  }
+
+  candidates->clear();
+  if (samples_num <= kMaxSparseSamples && samples_num * kSparseSampleRatio <= num_left &&
+      num_left * 2 >= num_candidates) {
+    // Most nodes of the type are negative neighbors, draw nodes of the type and redraw the excluded or taken ones
+    std::uniform_int_distribution<DenseIdType> distribution(range.first, range.second - 1);
+    while (static_cast<int32_t>(candidates->size()) < samples_num) {
+      DenseIdType candidate = distribution(*rnd);
+      if (!excluded(candidate) && std::find(candidates->begin(), candidates->end(), candidate) == candidates->end()) {
+        candidates->push_back(candidate);
+      }
     }
+    std::transform(candidates->begin(), candidates->end(), out, [this](DenseIdType n) { return csr_.GetNodeId(n); });
+    return;
   }
-  *start_index = index;
-  return Status::OK();
+  for (DenseIdType candidate = range.first; candidate < range.second; ++candidate) {
+    if (!excluded(candidate)) {
+      candidates->push_back(candidate);
+    }
+  }
+  SampleIndices(static_cast<int64_t>(candidates->size()), samples_num, rnd, scratch,
+                [this, &out, candidates](int64_t index) { *out++ = csr_.GetNodeId((*candidates)[index]); });
 }
 
 Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node_list, NodeIdType samples_num,
@@ -235,57 +390,33 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   CHECK_FAIL_RETURN_UNEXPECTED(!node_list.empty(), "Input node_list is empty.");
   RETURN_IF_NOT_OK(CheckSamplesNum(samples_num));
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
-
-  const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-  std::vector<NodeIdType> shuffled_id(all_nodes.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  size_t start_index = 0;
-  bool need_shuffle = false;
-
-  std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
-  neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    std::transform(neighbors.begin(), neighbors.end(),
-                   std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                   [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
-                                        &neg_neighbors_vec[node_idx]));
-        if (start_index >= shuffled_id.size()) {
-          start_index = start_index % shuffled_id.size();
-          need_shuffle = true;
-        }
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
-      }
-    }
-    if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-      start_index = 0;
-      need_shuffle = false;
+  std::vector<DenseIdType> dense_list;
+  RETURN_IF_NOT_OK(GetDenseIds(node_list, &dense_list));
+
+  // Each row is the node followed by its negative neighbors
+  size_t row_size = static_cast<size_t>(samples_num) + 1;
+  NodeIdType *data = nullptr;
+  RETURN_IF_NOT_OK(CreateNodeIdTensor(node_list.size(), row_size, out, &data));
+  auto sample = [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    std::vector<DenseIdType> candidates;
+    std::vector<int64_t> scratch;
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      NodeIdType *row = data + node_idx * row_size;
+      row[0] = node_list[node_idx];
+      NegativeSample(dense_list[node_idx], neg_neighbor_type, samples_num, rnd, &candidates, &scratch, row + 1);
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
+  (*out)->Squeeze();
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -333,20 +464,25 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-        RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-        if (!node->GetFeatures(f_type, &feature).IsOk()) {
+    const GraphCsr::FeatureBlock *block = csr_.GetFeatureBlock(f_type);
+    if (block != nullptr) {
+      RETURN_IF_NOT_OK(CopyFeatureRows(nodes, *block, default_feature->Value(), fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        std::shared_ptr<Feature> feature;
+        if (*node_itr == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+          RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
+          if (!node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(nodes->shape());
@@ -361,6 +497,31 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
   return Status::OK();
 }
 
+Status GraphDataImpl::CopyFeatureRows(const std::shared_ptr<Tensor> &nodes, const GraphCsr::FeatureBlock &block,
+                                      const std::shared_ptr<Tensor> &default_value,
+                                      const std::shared_ptr<Tensor> &fea_tensor) {
+  size_t row_size = block.row_size();
+  CHECK_FAIL_RETURN_UNEXPECTED(block.type() == default_value->type() && block.shape() == default_value->shape(),
+                               "Invalid feature, its type or shape does not match the default feature");
+  if (row_size == 0) {
+    return Status::OK();
+  }
+  uchar *dest = nullptr;
+  TensorShape remaining = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({0}, &dest, &remaining));
+  for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+    const uchar *src = nullptr;
+    if (*node_itr != kDefaultNodeId) {
+      DenseIdType node;
+      RETURN_IF_NOT_OK(csr_.GetDenseId(*node_itr, &node));
+      src = block.Row(node);
+    }
+    (void)memcpy(dest, src == nullptr ? default_value->GetBuffer() : src, row_size);
+    dest += row_size;
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &nodes, FeatureType type,
                                                  std::shared_ptr<Tensor> *out) {
   if (!nodes || nodes->Size() == 0) {
@@ -370,6 +531,17 @@ Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &
   std::shared_ptr<Tensor> fea_tensor;
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_INT64), &fea_tensor));
 
+  // Features in the shared memory are located by their offset and size, -1 if the node does not have the feature
+  const GraphCsr::FeatureBlock *block = csr_.GetFeatureBlock(type);
+  if (block != nullptr) {
+    std::shared_ptr<Tensor> no_feature;
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(std::vector<int64_t>({-1, -1}), &no_feature));
+    RETURN_IF_NOT_OK(CopyFeatureRows(nodes, *block, no_feature, fea_tensor));
+    fea_tensor->Squeeze();
+    *out = std::move(fea_tensor);
+    return Status::OK();
+  }
+
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
     if (*node_itr == kDefaultNodeId) {
@@ -542,6 +714,8 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   RETURN_IF_NOT_OK(gl.InitAndLoad());
   // get all maps
   RETURN_IF_NOT_OK(gl.GetNodesAndEdges());
+  // move the neighbors and features out of the nodes into flat arrays
+  RETURN_IF_NOT_OK(csr_.Build(node_type_map_, node_id_map_, node_feature_map_));
   return Status::OK();
 }
 
@@ -611,163 +785,85 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(DenseIdType start_node, std::mt19937 *rnd,
+                                                   std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
-  auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
-  // walk simulate
-  while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
-    auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
-
+  auto walk = std::vector<NodeIdType>(1, graph_->csr_.GetNodeId(start_node));
+  walk.reserve(meta_path_.size() + 1);
+  DenseIdType prev_node = kDefaultNodeId;
+  DenseIdType cur_node = start_node;
+  for (uint32_t step = 0; step < meta_path_.size(); ++step) {
+    int64_t num = 0;
+    const DenseIdType *cur_neighbors = graph_->csr_.GetNeighbors(cur_node, meta_path_[step], &num);
     // break if no neighbors
-    if (cur_neighbors.empty()) {
+    if (num == 0) {
       break;
     }
-
     // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
-    if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+    DenseIdType next_node;
+    if (step == 0) {
+      std::uniform_int_distribution<int64_t> distribution(0, num - 1);
+      next_node = cur_neighbors[distribution(*rnd)];
     } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      next_node = StepToNextNode(prev_node, cur_neighbors, num, step, rnd);
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
+    walk.push_back(graph_->csr_.GetNodeId(next_node));
+    prev_node = cur_node;
+    cur_node = next_node;
   }
-
-  while (walk.size() - 1 < meta_path_.size()) {
-    walk.push_back(default_node_);
-  }
-
+  walk.resize(meta_path_.size() + 1, default_node_);
   *walk_path = std::move(walk);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+DenseIdType GraphDataImpl::RandomWalkBase::StepToNextNode(DenseIdType prev, const DenseIdType *neighbors, int64_t num,
+                                                          uint32_t step, std::mt19937 *rnd) {
+  const float home_weight = 1.0 / step_home_param_;
+  const float away_weight = 1.0 / step_away_param_;
+  // replace 1.0 with G[dst][dst_nbr]['weight'] for weighted graphs
+  auto weight = [this, prev, step, home_weight, away_weight](DenseIdType next) -> float {
+    if (next == prev) {
+      return home_weight;
     }
-  }
-  return Status::OK();
-}
-
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
-
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
-  // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
-  std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
-
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
-  std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
-    if (dst_nbr == src) {
-      non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
-    }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
-      // stay close, this node connect both src and dst
-      non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
-    } else {
-      // step far away
-      non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
+    // stay close if next connects both prev and the current node, step far away otherwise
+    return graph_->csr_.IsNeighbor(prev, meta_path_[step - 1], next) ? 1.0 : away_weight;
+  };
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  const float max_weight = std::max({1.0f, home_weight, away_weight});
+  const float min_weight = std::min({1.0f, home_weight, away_weight});
+  if (max_weight <= kMaxRejectionRatio * min_weight) {
+    std::uniform_int_distribution<int64_t> distribution(0, num - 1);
+    while (true) {
+      DenseIdType next = neighbors[distribution(*rnd)];
+      if (uniform(*rnd) * max_weight < weight(next)) {
+        return next;
+      }
     }
   }
-
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
-
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
-  uint32_t K = probability.size();
-  std::vector<int32_t> switch_to_large_index(K, 0);
-  std::vector<float> weight(K, .0);
-  std::vector<int32_t> smaller;
-  std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
-  for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
-    weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
-  }
-
-  while ((!smaller.empty()) && (!larger.empty())) {
-    uint32_t small = smaller.back();
-    smaller.pop_back();
-    uint32_t large = larger.back();
-    larger.pop_back();
-    switch_to_large_index[small] = large;
-    weight[large] = weight[large] + weight[small] - 1.0;
-    weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
-  }
-  return StochasticIndex(switch_to_large_index, weight);
-}
-
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
-  const uint32_t size_of_index = switch_to_large_index.size();
-
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
-  // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
-
-  if (distribution(random_device) < weight[random_idx]) {
-    return random_idx;
+  std::vector<float> cumulative(num);
+  float sum = 0.0;
+  for (int64_t i = 0; i < num; ++i) {
+    sum += weight(neighbors[i]);
+    cumulative[i] = sum;
   }
-  return switch_to_large_index[random_idx];
+  auto itr = std::upper_bound(cumulative.begin(), cumulative.end(), uniform(*rnd) * sum);
+  return neighbors[std::min(static_cast<int64_t>(itr - cumulative.begin()), num - 1)];
 }
 
-template <typename T>
-std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
-  if (sum_probability < kGnnEpsilon) {
-    sum_probability = 1.0;
-  }
-  std::vector<float> normalized_probability;
-  std::transform(non_normalized_probability.begin(), non_normalized_probability.end(),
-                 std::back_inserter(normalized_probability), [&](T value) -> float { return value / sum_probability; });
-  return normalized_probability;
+Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
+  std::vector<DenseIdType> dense_list;
+  RETURN_IF_NOT_OK(graph_->GetDenseIds(node_list_, &dense_list));
+  size_t offset = walks->size();
+  size_t num_walks = static_cast<size_t>(num_walks_) * node_list_.size();
+  walks->resize(offset + num_walks);
+  auto walk = [this, &dense_list, walks, offset](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      RETURN_IF_NOT_OK(Node2vecWalk(dense_list[i % dense_list.size()], rnd, &(*walks)[offset + i]));
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(graph_->ParallelFor(num_walks, num_workers_, walk));
+  return Status::OK();
 }
 }  // namespace gnn
 }  // namespace dataset
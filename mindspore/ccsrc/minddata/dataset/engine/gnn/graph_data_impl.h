@@ -17,7 +17,10 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -25,6 +28,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,7 +41,6 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
-using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
  public:
@@ -172,23 +175,27 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
+    // Walk num_walks times from each node of the list, the walks are split among num_workers threads
+    // @param std::vector<std::vector<NodeIdType>> *walks - Returned walks, num_walks rounds over the node list
+    // @return Status - The error code return
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
-
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
-
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
-
-    template <typename T>
-    std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
+    // @param DenseIdType start_node - dense id of the first node
+    // @param std::mt19937 *rnd - random generator of the thread
+    // @param std::vector<NodeIdType> *walk_path - Returned walk, filled with default_node after a dead end
+    // @return Status - The error code return
+    Status Node2vecWalk(DenseIdType start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
+
+    // Draw the next node of a second order walk which came from prev to the current node
+    // @param DenseIdType prev - dense id of the previous node
+    // @param const DenseIdType *neighbors - neighbors of the current node
+    // @param int64_t num - number of neighbors
+    // @param uint32_t step - index of the step in meta_path
+    // @param std::mt19937 *rnd - random generator of the thread
+    // @return DenseIdType - The next node
+    DenseIdType StepToNextNode(DenseIdType prev, const DenseIdType *neighbors, int64_t num, uint32_t step,
+                               std::mt19937 *rnd);
 
     GraphDataImpl *graph_;
     std::vector<NodeIdType> node_list_;
@@ -221,6 +228,37 @@ class GraphDataImpl : public GraphData {
   template <typename T>
   Status ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value);
 
+  // Create a [num_rows, row_size] int32 tensor which rows are filled by the caller
+  // @param size_t num_rows -
+  // @param size_t row_size -
+  // @param std::shared_ptr<Tensor> *out - Returned tensor
+  // @param NodeIdType **data - Returned address of the first row
+  // @return Status - The error code return
+  Status CreateNodeIdTensor(size_t num_rows, size_t row_size, std::shared_ptr<Tensor> *out, NodeIdType **data);
+
+  // Split [0, total) into contiguous batches which run on up to num_workers threads
+  // @param size_t total - number of items
+  // @param int32_t num_workers - number of threads
+  // @param std::function func - called with the range of a batch and a random generator seeded for the batch
+  // @return Status - The error code return
+  Status ParallelFor(size_t total, int32_t num_workers,
+                     const std::function<Status(size_t begin, size_t end, std::mt19937 *rnd)> &func);
+
+  // Copy the rows of a feature block, or the default value for the nodes which do not have the feature
+  // @param std::shared_ptr<Tensor> &nodes - List of nodes
+  // @param GraphCsr::FeatureBlock &block -
+  // @param std::shared_ptr<Tensor> &default_value -
+  // @param std::shared_ptr<Tensor> &fea_tensor - Tensor with one row per node to fill
+  // @return Status - The error code return
+  Status CopyFeatureRows(const std::shared_ptr<Tensor> &nodes, const GraphCsr::FeatureBlock &block,
+                         const std::shared_ptr<Tensor> &default_value, const std::shared_ptr<Tensor> &fea_tensor);
+
+  // Find the dense ids of a list of nodes
+  // @param std::vector<NodeIdType> &node_list -
+  // @param std::vector<DenseIdType> *dense_list - Returned dense ids
+  // @return Status - The error code return
+  Status GetDenseIds(const std::vector<NodeIdType> &node_list, std::vector<DenseIdType> *dense_list);
+
   // Get the default feature of a node
   // @param FeatureType feature_type -
   // @param std::shared_ptr<Feature> *out_feature - Returned feature
@@ -245,15 +283,16 @@ class GraphDataImpl : public GraphData {
   // @return Status - The error code return
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
-  // Negative sampling
-  // @param std::vector<NodeIdType> &input_data - The data set to be sampled
-  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
+  // Negative sampling of the nodes of a type which are neither the node nor its neighbors
+  // @param DenseIdType node - dense id of the node
+  // @param NodeType neg_neighbor_type - The type of negative neighbor
   // @param int32_t samples_num -
-  // @param std::vector<NodeIdType> *out_samples - Sampling results returned
-  // @return Status - The error code return
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                        size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                        std::vector<NodeIdType> *out_samples);
+  // @param std::mt19937 *rnd - random generator of the thread
+  // @param std::vector<DenseIdType> *candidates - scratch buffer of the thread
+  // @param std::vector<int64_t> *scratch - scratch buffer of the thread
+  // @param NodeIdType *out - Returned samples_num node ids, kDefaultNodeId if there is no negative neighbor
+  void NegativeSample(DenseIdType node, NodeType neg_neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                      std::vector<DenseIdType> *candidates, std::vector<int64_t> *scratch, NodeIdType *out);
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -261,6 +300,7 @@ class GraphDataImpl : public GraphData {
 
   std::string dataset_file_;
   int32_t num_workers_;  // The number of worker threads
+  std::mutex rnd_mux_;   // Batches draw their seed from rnd_
   std::mt19937 rnd_;
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
@@ -270,6 +310,7 @@ class GraphDataImpl : public GraphData {
 #endif
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
+  GraphCsr csr_;  // Neighbors and features of the nodes, built after loading
 
   std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
   std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edge_id_map_;
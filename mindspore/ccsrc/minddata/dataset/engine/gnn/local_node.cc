@@ -115,6 +115,19 @@ Status LocalNode::UpdateFeature(const std::shared_ptr<Feature> &feature) {
   }
 }
 
+Status LocalNode::RemoveFeature(FeatureType feature_type) {
+  if (features_.erase(feature_type) == 0) {
+    std::string err_msg = "Invalid feature type:" + std::to_string(feature_type);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+Status LocalNode::ClearNeighbors() {
+  std::unordered_map<NodeType, std::vector<std::shared_ptr<Node>>>().swap(neighbor_nodes_);
+  return Status::OK();
+}
+
 }  // namespace gnn
 }  // namespace dataset
 }  // namespace mindspore
@@ -68,6 +68,15 @@ class LocalNode : public Node {
   // @return Status - The error code return
   Status UpdateFeature(const std::shared_ptr<Feature> &feature) override;
 
+  // Remove feature of node
+  // @param FeatureType feature_type - type of feature
+  // @return Status - The error code return
+  Status RemoveFeature(FeatureType feature_type) override;
+
+  // Release the neighbors of node once they are stored in the graph
+  // @return Status - The error code return
+  Status ClearNeighbors() override;
+
  private:
   Status GetSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
                              std::vector<NodeIdType> *out);
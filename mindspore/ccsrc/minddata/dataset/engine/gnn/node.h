@@ -77,6 +77,15 @@ class Node {
   // @return Status - The error code return
   virtual Status UpdateFeature(const std::shared_ptr<Feature> &feature) = 0;
 
+  // Remove feature of node
+  // @param FeatureType feature_type - type of feature
+  // @return Status - The error code return
+  virtual Status RemoveFeature(FeatureType feature_type) = 0;
+
+  // Release the neighbors of node once they are stored in the graph
+  // @return Status - The error code return
+  virtual Status ClearNeighbors() = 0;
+
  protected:
   NodeIdType id_;
   NodeType type_;
@@ -15,44 +15,110 @@
  */
 
 #include <memory>
+#include <string>
+#include <vector>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 
 namespace mindspore {
 namespace dataset {
 
 Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
-  // Most primitive pattern: DecodeOp immediately followed by RandomCropAndResizeOp
-  // Abstract into a more general member function that can find any pattern, expressed
-  // by regular expressions, for instance.
-  // Add a list of optimisation policies. For now, just this lambda
-  auto FindPattern = [](auto &tfuncs) {
-    auto it =
-      std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
-    auto next = it + 1;
-    if (it != tfuncs.end() && next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
-      return it;
-    } else {
-      return tfuncs.end();
-    }
-  };
-
-  auto &tfuncs = node->TFuncs();
-  auto it = FindPattern(tfuncs);
-  if (it != tfuncs.end()) {
-    auto next = it + 1;
-    auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
-    tfuncs.erase(next);
-  }
-  if (modified != nullptr) {
-    *modified = true;
-  } else {
+  if (modified == nullptr) {
     RETURN_STATUS_UNEXPECTED("modified is nullptr");
   }
+  auto &tfuncs = node->TFuncs();
+  std::vector<std::shared_ptr<TensorOp>> fused;
+  fused.reserve(tfuncs.size());
+  size_t i = 0;
+  while (i < tfuncs.size()) {
+    std::shared_ptr<TensorOp> op;
+    size_t len = FuseImageChain(tfuncs, i, &op);
+    if (len == 0) {
+      fused.push_back(tfuncs[i]);
+      i++;
+      continue;
+    }
+    RETURN_UNEXPECTED_IF_NULL(op);
+    MS_LOG(INFO) << "Fused " << len << " tensor ops starting with " << tfuncs[i]->Name() << " into " << op->Name()
+                 << ".";
+    fused.push_back(op);
+    i += len;
+  }
+  tfuncs = std::move(fused);
+  *modified = true;
   return Status::OK();
 }
+
+size_t TensorOpFusionPass::FuseImageChain(const std::vector<std::shared_ptr<TensorOp>> &tfuncs, size_t pos,
+                                          std::shared_ptr<TensorOp> *op) {
+  // Pattern: [Decode] RandomCropAndResize [RandomHorizontalFlip] [Normalize] [HWC2CHW],
+  // where RandomCropDecodeResize stands for the first two.
+  auto name_at = [&tfuncs](size_t k) { return k < tfuncs.size() ? tfuncs[k]->Name() : std::string(); };
+  if (!GlobalContext::config_manager()->enable_image_fusion()) {
+    // The fused op is not bit identical to the chain, so without the option only Decode followed by
+    // RandomCropAndResize is fused
+    if (name_at(pos) != kDecodeOp || name_at(pos + 1) != kRandomCropAndResizeOp) {
+      return 0;
+    }
+    auto crop = static_cast<RandomCropAndResizeOp *>(tfuncs[pos + 1].get());
+    *op = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*crop));
+    return 2;
+  }
+  size_t end = pos;
+  bool decode = false;
+  if (name_at(end) == kDecodeOp && name_at(end + 1) == kRandomCropAndResizeOp) {
+    decode = true;
+    end++;
+  } else if (name_at(end) == kRandomCropDecodeResizeOp) {
+    decode = true;
+  } else if (name_at(end) != kRandomCropAndResizeOp) {
+    return 0;
+  }
+  auto crop = static_cast<RandomCropAndResizeOp *>(tfuncs[end].get());
+  end++;
+  RandomHorizontalFlipOp *flip = nullptr;
+  NormalizeOp *normalize = nullptr;
+  bool hwc_to_chw = false;
+  if (name_at(end) == kRandomHorizontalFlipOp) {
+    flip = static_cast<RandomHorizontalFlipOp *>(tfuncs[end++].get());
+  }
+  if (name_at(end) == kNormalizeOp) {
+    normalize = static_cast<NormalizeOp *>(tfuncs[end++].get());
+  }
+  if (name_at(end) == kHwcToChwOp) {
+    hwc_to_chw = true;
+    end++;
+  }
+  size_t len = end - pos;
+  if (len < 2) {
+    return 0;
+  }
+  if (len == 2 && decode && name_at(pos) == kDecodeOp) {
+    // Decode followed by RandomCropAndResize alone keeps its dedicated op
+    *op = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*crop));
+    return len;
+  }
+  auto fused_op = std::make_shared<FusedImageOp>(*crop, decode);
+  if (flip != nullptr) {
+    fused_op->SetHorizontalFlip(flip->probability());
+  }
+  if (normalize != nullptr && fused_op->SetNormalize(normalize->mean(), normalize->std()).IsError()) {
+    // Leave the chain untouched, Normalize will report the bad parameters when it runs
+    return 0;
+  }
+  if (hwc_to_chw) {
+    fused_op->SetHwcToChw();
+  }
+  *op = std::static_pointer_cast<TensorOp>(fused_op);
+  return len;
+}
 }  // namespace dataset
 }  // namespace mindspore
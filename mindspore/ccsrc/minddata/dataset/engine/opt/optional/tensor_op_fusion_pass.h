@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 
 namespace mindspore {
 namespace dataset {
@@ -31,6 +33,15 @@ class TensorOpFusionPass : public NodePass {
   /// \param[inout] *modified indicates whether the node has been visited
   /// \return Status The error code return
   Status RunOnNode(std::shared_ptr<MapOp> node, bool *modified) override;
+
+  /// \brief Matches the longest fusable image augmentation chain starting at pos. Unless the image fusion is
+  ///     enabled in the config manager, only Decode followed by RandomCropAndResize is matched
+  /// \param[in] tfuncs The tensor ops of the MapOp
+  /// \param[in] pos The position the chain has to start at
+  /// \param[out] op The op replacing the chain
+  /// \return size_t The number of tensor ops replaced, 0 if there is no chain at pos
+  size_t FuseImageChain(const std::vector<std::shared_ptr<TensorOp>> &tfuncs, size_t pos,
+                        std::shared_ptr<TensorOp> *op);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,296 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+AutoTune::AutoTune(ExecutionTree *tree)
+    : AutoTune(tree, static_cast<int32_t>(std::thread::hardware_concurrency()), 0) {}
+
+AutoTune::AutoTune(ExecutionTree *tree, int32_t max_workers, int64_t max_buffers)
+    : tree_(tree),
+      max_workers_(max_workers),
+      max_buffers_(max_buffers),
+      num_samples_(0),
+      step_(0),
+      bottleneck_op_id_(-1) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = cfg->monitor_sampling_interval();
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+  RETURN_IF_NOT_OK(Init());
+
+  // Keep tuning until the Task is interrupted or the iterator has received EOF
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    RETURN_IF_NOT_OK(Sample());
+    if (num_samples_ >= kSamplesPerStep) {
+      RETURN_IF_NOT_OK(Tune());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+  }
+
+  // The connector sizes and the MapOp worker counts are the ones the tree ran with, the other worker counts are
+  // recommendations for the next run
+  MS_LOG(INFO) << "AutoTune final pipeline configuration: " << GetConfig().dump();
+  return Status::OK();
+}
+
+Status AutoTune::Init() {
+  if (!op_states_.empty()) {
+    return Status::OK();
+  }
+  std::unordered_map<const DatasetOp *, int32_t> op_index;
+  int32_t total_workers = 0;
+  for (auto &op : *tree_) {
+    OpTuneState state{};
+    state.op = &op;
+    state.child_index = op.Children().empty() ? -1 : op_index[op.Children()[0].get()];
+    // DeviceQueueOp is a special op, it is not inlined but its output connector is not used.
+    state.has_connector = !op.inlined() && op.Name() != "DeviceQueueOp";
+    state.parallel = dynamic_cast<ParallelOp *>(&op) != nullptr;
+    state.num_workers = op.num_workers();
+    auto map_op = dynamic_cast<MapOp *>(&op);
+    state.max_num_workers = map_op != nullptr ? map_op->max_num_workers() : 0;
+    state.num_queues = std::max(op.num_producers(), 1);
+    state.queue_capacity = state.has_connector ? op.ConnectorCapacity() / state.num_queues : 0;
+    state.last_worker_step = -kWorkerCooldownSteps;
+    state.out_count = op.ConnectorOutBufferCount();
+    if (state.parallel) {
+      total_workers += state.num_workers;
+    }
+    op_index[&op] = static_cast<int32_t>(op_states_.size());
+    op_states_.push_back(state);
+  }
+  // The budgets never force the tuner to take resources away from the initial configuration
+  max_workers_ = std::max(max_workers_, total_workers);
+  int64_t total_buffers = TotalBuffers();
+  max_buffers_ = max_buffers_ > 0 ? std::max(max_buffers_, total_buffers) : 2 * total_buffers;
+  MS_LOG(DEBUG) << "AutoTune starts with a budget of " << max_workers_ << " workers and " << max_buffers_
+                << " buffers.";
+  return Status::OK();
+}
+
+Status AutoTune::Sample() {
+  RETURN_IF_NOT_OK(Init());
+  for (auto &state : op_states_) {
+    if (!state.has_connector) {
+      continue;
+    }
+    int32_t size = state.op->ConnectorSize();
+    int32_t capacity = state.op->ConnectorCapacity();
+    state.utilization_sum += std::min(static_cast<double>(size) / capacity, 1.0);
+    if (size == 0) {
+      state.empty_count++;
+    } else if (size >= capacity) {
+      state.full_count++;
+    }
+  }
+  num_samples_++;
+  return Status::OK();
+}
+
+Status AutoTune::Tune() {
+  if (num_samples_ == 0) {
+    return Status::OK();
+  }
+  step_++;
+  for (auto &state : op_states_) {
+    int64_t out_count = state.op->ConnectorOutBufferCount();
+    state.throughput = out_count - state.out_count;
+    state.out_count = out_count;
+  }
+
+  int32_t bottleneck = FindBottleneck();
+  bottleneck_op_id_ = bottleneck < 0 ? -1 : op_states_[bottleneck].op->id();
+  if (bottleneck >= 0) {
+    MS_LOG(DEBUG) << "AutoTune step " << step_ << " found bottleneck " << op_states_[bottleneck].op->Name() << "("
+                  << bottleneck_op_id_ << ").";
+    RETURN_IF_NOT_OK(TuneWorkers(bottleneck));
+  }
+  RETURN_IF_NOT_OK(TuneConnectors());
+
+  for (auto &state : op_states_) {
+    state.utilization_sum = 0;
+    state.empty_count = 0;
+    state.full_count = 0;
+  }
+  num_samples_ = 0;
+  return Status::OK();
+}
+
+double AutoTune::Utilization(const OpTuneState &state) const {
+  return num_samples_ == 0 ? 0 : state.utilization_sum / num_samples_;
+}
+
+double AutoTune::InputUtilization(const OpTuneState &state) const {
+  int32_t child = state.child_index;
+  // An inlined child is executed by this op, its input is the input of this op
+  while (child >= 0 && !op_states_[child].has_connector) {
+    child = op_states_[child].child_index;
+  }
+  return child < 0 ? 1.0 : Utilization(op_states_[child]);
+}
+
+int32_t AutoTune::FindBottleneck() const {
+  int32_t bottleneck = -1;
+  double max_gap = kHighUtilization - kLowUtilization;
+  for (int32_t i = 0; i < op_states_.size(); i++) {
+    const OpTuneState &state = op_states_[i];
+    if (!state.has_connector) {
+      continue;
+    }
+    double gap = InputUtilization(state) - Utilization(state);
+    // Among ops starving their consumer equally, the one with the lowest throughput is the slowest
+    if (gap > max_gap || (gap == max_gap && bottleneck >= 0 && state.throughput < op_states_[bottleneck].throughput)) {
+      max_gap = gap;
+      bottleneck = i;
+    }
+  }
+  return bottleneck;
+}
+
+Status AutoTune::TuneWorkers(int32_t bottleneck) {
+  OpTuneState &target = op_states_[bottleneck];
+  if (!target.parallel || step_ - target.last_worker_step < kWorkerCooldownSteps) {
+    return Status::OK();
+  }
+  int32_t total_workers = 0;
+  for (const auto &state : op_states_) {
+    total_workers += state.parallel ? state.num_workers : 0;
+  }
+  if (total_workers < max_workers_) {
+    bool apply = CanApplyWorkers(target, target.num_workers + 1);
+    target.num_workers++;
+    target.last_worker_step = step_;
+    RETURN_IF_NOT_OK(ApplyWorkers(target));
+    MS_LOG(INFO) << "AutoTune " << (apply ? "sets " : "recommends ") << target.num_workers << " workers for "
+                 << target.op->Name() << "(" << target.op->id() << ")" << (apply ? "." : " for the next run.");
+    return Status::OK();
+  }
+  // The CPU budget is used up, take a worker from the op that blocks the most on a full output connector
+  int32_t donor = -1;
+  for (int32_t i = 0; i < op_states_.size(); i++) {
+    const OpTuneState &state = op_states_[i];
+    if (i == bottleneck || !state.parallel || !state.has_connector || state.num_workers <= 1 ||
+        step_ - state.last_worker_step < kWorkerCooldownSteps || Utilization(state) < kHighUtilization) {
+      continue;
+    }
+    if (donor < 0 || Utilization(state) > Utilization(op_states_[donor])) {
+      donor = i;
+    }
+  }
+  if (donor >= 0) {
+    OpTuneState &donor_state = op_states_[donor];
+    // The running donor only gives up a worker when the running target can take it
+    bool apply = CanApplyWorkers(target, target.num_workers + 1);
+    donor_state.num_workers--;
+    donor_state.last_worker_step = step_;
+    target.num_workers++;
+    target.last_worker_step = step_;
+    if (apply) {
+      RETURN_IF_NOT_OK(ApplyWorkers(donor_state));
+      RETURN_IF_NOT_OK(ApplyWorkers(target));
+    }
+    MS_LOG(INFO) << "AutoTune " << (apply ? "moves" : "recommends moving") << " a worker from "
+                 << donor_state.op->Name() << "(" << donor_state.op->id() << ") to " << target.op->Name() << "("
+                 << target.op->id() << ")" << (apply ? "." : " for the next run.");
+  }
+  return Status::OK();
+}
+
+Status AutoTune::ApplyWorkers(const OpTuneState &state) {
+  if (!CanApplyWorkers(state, state.num_workers)) {
+    return Status::OK();
+  }
+  auto map_op = dynamic_cast<MapOp *>(state.op);
+  if (map_op == nullptr) {
+    return Status::OK();
+  }
+  return map_op->SetNumActiveWorkers(state.num_workers);
+}
+
+Status AutoTune::TuneConnectors() {
+  int64_t total_buffers = TotalBuffers();
+  // Connectors that stay full hold buffers their consumer is not ready for, give the memory back first
+  for (auto &state : op_states_) {
+    if (!state.has_connector || state.queue_capacity <= kMinQueueCapacity ||
+        state.full_count < kFullRatio * num_samples_) {
+      continue;
+    }
+    int32_t new_capacity = std::max(state.queue_capacity / 2, kMinQueueCapacity);
+    RETURN_IF_NOT_OK(state.op->ResizeConnector(new_capacity));
+    total_buffers -= static_cast<int64_t>(state.queue_capacity - new_capacity) * state.num_queues;
+    MS_LOG(DEBUG) << "AutoTune shrinks the connector of " << state.op->Name() << "(" << state.op->id() << ") to "
+                  << new_capacity << ".";
+    state.queue_capacity = new_capacity;
+  }
+  // Connectors that swing between empty and full absorb bursts better with more capacity
+  for (auto &state : op_states_) {
+    if (!state.has_connector || state.empty_count < kBurstRatio * num_samples_ ||
+        state.full_count < kBurstRatio * num_samples_) {
+      continue;
+    }
+    int64_t room = (max_buffers_ - total_buffers) / state.num_queues;
+    int32_t new_capacity =
+      static_cast<int32_t>(std::min<int64_t>(state.queue_capacity * 2, state.queue_capacity + room));
+    if (new_capacity <= state.queue_capacity) {
+      continue;
+    }
+    RETURN_IF_NOT_OK(state.op->ResizeConnector(new_capacity));
+    total_buffers += static_cast<int64_t>(new_capacity - state.queue_capacity) * state.num_queues;
+    MS_LOG(DEBUG) << "AutoTune grows the connector of " << state.op->Name() << "(" << state.op->id() << ") to "
+                  << new_capacity << ".";
+    state.queue_capacity = new_capacity;
+  }
+  return Status::OK();
+}
+
+int64_t AutoTune::TotalBuffers() const {
+  int64_t total = 0;
+  for (const auto &state : op_states_) {
+    total += state.has_connector ? static_cast<int64_t>(state.queue_capacity) * state.num_queues : 0;
+  }
+  return total;
+}
+
+json AutoTune::GetConfig() const {
+  json config;
+  for (const auto &state : op_states_) {
+    json op_config;
+    op_config["op_id"] = state.op->id();
+    op_config["op_type"] = state.op->Name();
+    op_config["num_workers"] = state.num_workers;
+    if (state.has_connector) {
+      op_config["op_connector_size"] = state.queue_capacity;
+    }
+    config.push_back(op_config);
+  }
+  return config;
+}
+}  // namespace dataset
+}  // namespace mindspore
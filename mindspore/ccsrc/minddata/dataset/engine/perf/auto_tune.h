@@ -0,0 +1,155 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <cstdint>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/util/status.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+
+// AutoTune is an online tuner of the pipeline. While the ExecutionTree is executing, it samples the output
+// connector size and the output buffer count of every op, the same metrics ConnectorSize and ConnectorThroughput
+// record for profiling, and periodically:
+// 1) Finds the bottleneck op, the op whose input connector stays full while its output connector stays empty.
+// 2) Moves workers towards the bottleneck op within the CPU budget. A MapOp launches spare workers when the tuner is
+//    enabled and its number of active workers is changed on the running tree, up to the workers it launched. The
+//    workers of the other ops are fixed once they run, their tuned worker counts are advisory, for the next run.
+// 3) Grows the output connectors that alternate between empty and full, and shrinks the ones that stay full,
+//    within the memory budget. Connector capacities, the prefetch size of each op, are changed on the running tree.
+// When the tree finishes, the tuned configuration is logged so that it can be reused.
+class AutoTune {
+ public:
+  // Constructor with the budgets derived from the machine and the initial pipeline
+  // @param tree - The execution tree to tune
+  explicit AutoTune(ExecutionTree *tree);
+
+  // Constructor
+  // @param tree - The execution tree to tune
+  // @param max_workers - CPU budget, the maximum number of worker threads of all parallel ops
+  // @param max_buffers - Memory budget, the maximum number of buffers held by all output connectors.
+  //     A value of 0 means twice the capacity of the connectors when the tuning starts
+  AutoTune(ExecutionTree *tree, int32_t max_workers, int64_t max_buffers);
+
+  ~AutoTune() = default;
+
+  // Functor for the tuner main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+  // Sample the connectors of every op of the tree
+  // @return Status - The error code return
+  Status Sample();
+
+  // Analyze the samples taken since the last step and adjust the pipeline
+  // @return Status - The error code return
+  Status Tune();
+
+  // Getter function
+  // @return The id of the bottleneck op found by the last step, -1 if the pipeline is consumer bound
+  int32_t bottleneck_op_id() const { return bottleneck_op_id_; }
+
+  // The tuned configuration of each op, with the op id, op type, number of workers and connector queue size. The
+  // number of workers is the one the op runs with when the tuner could switch the running op to it, a
+  // recommendation for the next run otherwise
+  // @return The configuration in json format
+  json GetConfig() const;
+
+ private:
+  // Tuning state of one op of the tree
+  struct OpTuneState {
+    DatasetOp *op;
+    int32_t child_index;       // Index of the first child in op_states_, -1 for a leaf op
+    bool has_connector;        // False for inlined ops and ops whose output connector is not used
+    bool parallel;             // Worker count can be tuned
+    int32_t num_workers;       // Tuned number of workers
+    int32_t max_num_workers;   // Largest number of workers the running op can switch to, 0 if its workers are fixed
+    int32_t queue_capacity;    // Capacity of each queue of the output connector
+    int32_t num_queues;        // Number of queues of the output connector
+    int32_t last_worker_step;  // Step of the last worker change
+    double utilization_sum;    // Sum of the sampled utilization of the output connector
+    int64_t empty_count;       // Number of samples with an empty output connector
+    int64_t full_count;        // Number of samples with a full output connector
+    int64_t out_count;         // Buffers sent out by the output connector when the step started
+    int64_t throughput;        // Buffers sent out by the output connector during the last step
+  };
+
+  // Build the tuning state from the tree, called once the tree is launched
+  Status Init();
+
+  // Average utilization of the output connector of an op in the last step, from 0 to 1
+  double Utilization(const OpTuneState &state) const;
+
+  // Average utilization of the input connector of an op in the last step. Leaf ops read from storage which is
+  // treated as an always full input.
+  double InputUtilization(const OpTuneState &state) const;
+
+  // Find the bottleneck op of the last step
+  // @return The index in op_states_, -1 if there is none
+  int32_t FindBottleneck() const;
+
+  // Move workers towards the bottleneck op
+  // @return Status - The error code return
+  Status TuneWorkers(int32_t bottleneck);
+
+  // Whether the running op can switch to the given number of workers
+  static bool CanApplyWorkers(const OpTuneState &state, int32_t num_workers) {
+    return num_workers <= state.max_num_workers;
+  }
+
+  // Switch the running op to the tuned number of workers, nothing is done if it cannot
+  // @param state - Tuning state of the op
+  // @return Status - The error code return
+  Status ApplyWorkers(const OpTuneState &state);
+
+  // Resize the output connectors
+  Status TuneConnectors();
+
+  int64_t TotalBuffers() const;
+
+  // Number of samples analyzed by one tuning step
+  static constexpr int64_t kSamplesPerStep = 20;
+  // Number of steps between two worker changes of the same op
+  static constexpr int32_t kWorkerCooldownSteps = 5;
+  // Utilization above which a connector is considered full, below kLowUtilization it is considered empty
+  static constexpr double kHighUtilization = 0.75;
+  static constexpr double kLowUtilization = 0.25;
+  // Fraction of samples a connector has to be full and empty to be considered bursty
+  static constexpr double kBurstRatio = 0.1;
+  // Fraction of samples a connector has to be full to be considered oversized
+  static constexpr double kFullRatio = 0.9;
+  static constexpr int32_t kMinQueueCapacity = 2;
+
+  ExecutionTree *tree_;
+  int32_t max_workers_;
+  int64_t max_buffers_;
+  int64_t sampling_interval_;
+  int64_t num_samples_;
+  int32_t step_;
+  int32_t bottleneck_op_id_;
+  std::vector<OpTuneState> op_states_;  // Ops in post order, same as the ExecutionTree iterator
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
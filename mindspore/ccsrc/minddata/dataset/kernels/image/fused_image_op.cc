@@ -0,0 +1,304 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int kNormalizeChannels = 3;
+
+// Images processed and time spent by the current worker thread
+struct WorkerThroughput {
+  int64_t images = 0;
+  int64_t elapsed_us = 0;
+};
+thread_local WorkerThroughput worker_throughput;
+
+// Source taps of a bilinear resize along one axis, using the same half-pixel mapping and border
+// handling as cv::resize with INTER_LINEAR. index holds two absolute source positions per output
+// position and weight the weight of the second one.
+void ComputeLinearTaps(int src_start, int src_len, int dst_len, std::vector<int> *index, std::vector<float> *weight) {
+  const double scale = static_cast<double>(src_len) / dst_len;
+  index->resize(2 * dst_len);
+  weight->resize(dst_len);
+  for (int d = 0; d < dst_len; d++) {
+    auto f = static_cast<float>((d + 0.5) * scale - 0.5);
+    int s = static_cast<int>(std::floor(f));
+    f -= s;
+    if (s < 0) {
+      s = 0;
+      f = 0;
+    }
+    if (s >= src_len - 1) {
+      s = src_len - 1;
+      f = 0;
+    }
+    (*index)[2 * d] = src_start + s;
+    (*index)[2 * d + 1] = src_start + std::min(s + 1, src_len - 1);
+    (*weight)[d] = f;
+  }
+}
+
+// Horizontal pass of one source row into a float row of the output width
+void InterpolateRow(const uint8_t *line, const std::vector<int> &x_index, const std::vector<float> &x_weight,
+                    int channels, float *dst) {
+  const int width = static_cast<int>(x_weight.size());
+  for (int dx = 0; dx < width; dx++) {
+    const uint8_t *p0 = line + x_index[2 * dx] * channels;
+    const uint8_t *p1 = line + x_index[2 * dx + 1] * channels;
+    const float w = x_weight[dx];
+    for (int c = 0; c < channels; c++) {
+      dst[dx * channels + c] = p0[c] + (p1[c] - p0[c]) * w;
+    }
+  }
+}
+
+// Vertical pass of one output row. The value is rounded the way a uint8 resize would round it before it
+// is normalized, and stored at pixel/channel strides so one routine covers the HWC and CHW layouts.
+template <typename T>
+void StoreRow(const float *row0, const float *row1, float wy, int width, int channels, bool flip, int64_t pixel_stride,
+              int64_t channel_stride, const float *scale, const float *shift, T *out) {
+  for (int dx = 0; dx < width; dx++) {
+    T *pixel = out + (flip ? width - 1 - dx : dx) * pixel_stride;
+    for (int c = 0; c < channels; c++) {
+      const int i = dx * channels + c;
+      const float v = std::floor(row0[i] + (row1[i] - row0[i]) * wy + 0.5f);
+      if constexpr (std::is_same<T, float>::value) {
+        pixel[c * channel_stride] = v * scale[c] + shift[c];
+      } else {
+        pixel[c * channel_stride] = static_cast<T>(v);
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedImageOp::FusedImageOp(const RandomCropAndResizeOp &rhs, bool decode)
+    : RandomCropAndResizeOp(rhs),
+      decode_(decode),
+      flip_(false),
+      normalize_(false),
+      hwc_to_chw_(false),
+      flip_distribution_(0.0) {
+  flip_rnd_.seed(GetSeed());
+}
+
+void FusedImageOp::SetHorizontalFlip(float probability) {
+  flip_ = true;
+  flip_distribution_ = std::bernoulli_distribution(probability);
+}
+
+Status FusedImageOp::SetNormalize(const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std) {
+  CHECK_FAIL_RETURN_UNEXPECTED(mean != nullptr && std != nullptr, "Mean or std tensor is null.");
+  CHECK_FAIL_RETURN_UNEXPECTED(mean->type() == DataType::DE_FLOAT32 && mean->Size() == kNormalizeChannels,
+                               "Mean tensor should be of size 3 and type float.");
+  CHECK_FAIL_RETURN_UNEXPECTED(std->type() == DataType::DE_FLOAT32 && std->Size() == kNormalizeChannels,
+                               "Std tensor should be of size 3 and type float.");
+  std::vector<float> scale(kNormalizeChannels);
+  std::vector<float> shift(kNormalizeChannels);
+  auto mean_it = mean->begin<float>();
+  auto std_it = std->begin<float>();
+  for (int i = 0; i < kNormalizeChannels; i++, ++mean_it, ++std_it) {
+    CHECK_FAIL_RETURN_UNEXPECTED(*std_it != 0, "Std value should not be zero.");
+    scale[i] = 1.0f / *std_it;
+    shift[i] = -*mean_it / *std_it;
+  }
+  normalize_ = true;
+  mean_ = mean;
+  std_ = std;
+  scale_ = std::move(scale);
+  shift_ = std::move(shift);
+  return Status::OK();
+}
+
+void FusedImageOp::Print(std::ostream &out) const {
+  out << Name() << ": " << target_height_ << " " << target_width_ << (decode_ ? " decode" : "")
+      << (flip_ ? " flip" : "") << (normalize_ ? " normalize" : "") << (hwc_to_chw_ ? " hwc2chw" : "");
+}
+
+Status FusedImageOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  auto start = std::chrono::steady_clock::now();
+  RETURN_IF_NOT_OK(ComputeImpl(input, output));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  RecordThroughput(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+  return Status::OK();
+}
+
+Status FusedImageOp::ComputeImpl(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> image = input;
+  int x = 0;
+  int y = 0;
+  int crop_height = 0;
+  int crop_width = 0;
+  if (decode_ && IsNonEmptyJPEG(input)) {
+    // Only the crop box is decoded, the kernel then resamples the whole decoded image
+    int h_in = 0;
+    int w_in = 0;
+    RETURN_IF_NOT_OK(GetJpegImageInfo(input, &w_in, &h_in));
+    (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &image, x, y, crop_width, crop_height));
+    x = 0;
+    y = 0;
+    crop_height = static_cast<int>(image->shape()[0]);
+    crop_width = static_cast<int>(image->shape()[1]);
+  } else {
+    if (decode_) {
+      DecodeOp op(true);
+      RETURN_IF_NOT_OK(op.Compute(input, &image));
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(image->shape().Size() >= 2, "The shape of input is abnormal");
+    (void)GetCropBox(static_cast<int>(image->shape()[0]), static_cast<int>(image->shape()[1]), &x, &y, &crop_height,
+                     &crop_width);
+  }
+  bool flip = flip_ && flip_distribution_(flip_rnd_);
+  bool fusable = image->type() == DataType::DE_UINT8 && image->Rank() == 3 &&
+                 interpolation_ == InterpolationMode::kLinear &&
+                 (!normalize_ || image->shape()[2] == kNormalizeChannels);
+  if (fusable) {
+    return FusedCompute(image, x, y, crop_height, crop_width, flip, output);
+  }
+  return UnfusedCompute(image, x, y, crop_height, crop_width, flip, output);
+}
+
+Status FusedImageOp::FusedCompute(const std::shared_ptr<Tensor> &input, int x, int y, int crop_height,
+                                  int crop_width, bool flip, std::shared_ptr<Tensor> *output) {
+  CHECK_FAIL_RETURN_UNEXPECTED(crop_height > 0 && crop_width > 0 && target_height_ > 0 && target_width_ > 0,
+                               "The crop and target height and width should be greater than 0.");
+  const int channels = static_cast<int>(input->shape()[2]);
+  const int64_t src_stride = input->shape()[1] * channels;
+  const int out_h = target_height_;
+  const int out_w = target_width_;
+
+  std::vector<int> x_index;
+  std::vector<float> x_weight;
+  std::vector<int> y_index;
+  std::vector<float> y_weight;
+  ComputeLinearTaps(x, crop_width, out_w, &x_index, &x_weight);
+  ComputeLinearTaps(y, crop_height, out_h, &y_index, &y_weight);
+
+  TensorShape shape = hwc_to_chw_ ? TensorShape{channels, out_h, out_w} : TensorShape{out_h, out_w, channels};
+  DataType type = normalize_ ? DataType(DataType::DE_FLOAT32) : DataType(DataType::DE_UINT8);
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, type, &out));
+
+  // Two horizontally resampled source rows are kept; with upscaling consecutive output rows share them,
+  // so every source row is resampled once and the working set stays within two output-width rows.
+  const int64_t row_len = static_cast<int64_t>(out_w) * channels;
+  std::vector<float> row_buffer(2 * row_len);
+  float *rows[2] = {row_buffer.data(), row_buffer.data() + row_len};
+  int tags[2] = {-1, -1};
+  const int64_t plane = static_cast<int64_t>(out_h) * out_w;
+  const int64_t pixel_stride = hwc_to_chw_ ? 1 : channels;
+  const int64_t channel_stride = hwc_to_chw_ ? plane : 1;
+  const int64_t out_row_stride = hwc_to_chw_ ? out_w : row_len;
+  const uint8_t *src = input->GetBuffer();
+  for (int dy = 0; dy < out_h; dy++) {
+    const int sy0 = y_index[2 * dy];
+    const int sy1 = y_index[2 * dy + 1];
+    if (tags[0] != sy0) {
+      if (tags[1] == sy0) {
+        std::swap(rows[0], rows[1]);
+        std::swap(tags[0], tags[1]);
+      } else {
+        InterpolateRow(src + sy0 * src_stride, x_index, x_weight, channels, rows[0]);
+        tags[0] = sy0;
+      }
+    }
+    if (tags[1] != sy1) {
+      InterpolateRow(src + sy1 * src_stride, x_index, x_weight, channels, rows[1]);
+      tags[1] = sy1;
+    }
+    if (normalize_) {
+      float *out_row = &(*out->begin<float>()) + dy * out_row_stride;
+      StoreRow(rows[0], rows[1], y_weight[dy], out_w, channels, flip, pixel_stride, channel_stride, scale_.data(),
+               shift_.data(), out_row);
+    } else {
+      uint8_t *out_row = &(*out->begin<uint8_t>()) + dy * out_row_stride;
+      StoreRow(rows[0], rows[1], y_weight[dy], out_w, channels, flip, pixel_stride, channel_stride, scale_.data(),
+               shift_.data(), out_row);
+    }
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+Status FusedImageOp::UnfusedCompute(const std::shared_ptr<Tensor> &input, int x, int y, int crop_height,
+                                    int crop_width, bool flip, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(
+    CropAndResize(input, &out, x, y, crop_height, crop_width, target_height_, target_width_, interpolation_));
+  if (flip) {
+    RETURN_IF_NOT_OK(HorizontalFlip(out, &out));
+  }
+  if (normalize_) {
+    RETURN_IF_NOT_OK(Normalize(out, &out, mean_, std_));
+  }
+  if (hwc_to_chw_) {
+    RETURN_IF_NOT_OK(HwcToChw(out, &out));
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+void FusedImageOp::RecordThroughput(int64_t elapsed_us) const {
+  WorkerThroughput &stats = worker_throughput;
+  stats.images++;
+  stats.elapsed_us += elapsed_us;
+  if (stats.images % kThroughputLogInterval == 0 && stats.elapsed_us > 0) {
+    MS_LOG(INFO) << Name() << " worker " << std::this_thread::get_id() << " processed " << stats.images
+                 << " images, throughput: " << stats.images * 1e6 / stats.elapsed_us << " images/sec.";
+  }
+}
+
+Status FusedImageOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  TensorShape out = TensorShape{target_height_, target_width_};
+  if (decode_) {
+    // Decode always produces an RGB image
+    outputs.emplace_back(hwc_to_chw_ ? TensorShape{3, target_height_, target_width_} : out.AppendDim(3));
+  } else if (inputs[0].Rank() == 2) {
+    outputs.emplace_back(out);
+  } else if (inputs[0].Rank() == 3) {
+    outputs.emplace_back(hwc_to_chw_ ? TensorShape{inputs[0][2], target_height_, target_width_}
+                                     : out.AppendDim(inputs[0][2]));
+  }
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status FusedImageOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  if (normalize_) {
+    outputs[0] = DataType(DataType::DE_FLOAT32);
+  } else if (decode_) {
+    outputs[0] = DataType(DataType::DE_UINT8);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
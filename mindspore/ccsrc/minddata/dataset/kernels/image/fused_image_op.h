@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \class FusedImageOp fused_image_op.h
+/// \brief Runs a [Decode] -> RandomCropAndResize -> [RandomHorizontalFlip] -> [Normalize] -> [HWC2CHW] chain
+///     as one op. The crop, bilinear resize, flip, normalization and layout change are done in a single pass
+///     over the output rows, so no intermediate image is materialized. Created by TensorOpFusionPass.
+class FusedImageOp : public RandomCropAndResizeOp {
+ public:
+  /// \brief Constructor
+  /// \param[in] rhs The crop-and-resize op whose parameters and random state are taken over
+  /// \param[in] decode Whether the input is an encoded image that has to be decoded first
+  FusedImageOp(const RandomCropAndResizeOp &rhs, bool decode);
+
+  ~FusedImageOp() override = default;
+
+  /// \brief Fuses a RandomHorizontalFlip into the op
+  /// \param[in] probability Probability of flipping an image
+  void SetHorizontalFlip(float probability);
+
+  /// \brief Fuses a Normalize into the op, the output becomes float32
+  /// \param[in] mean Tensor of shape <3> holding the mean of each channel
+  /// \param[in] std Tensor of shape <3> holding the std of each channel
+  /// \return Status The error code return
+  Status SetNormalize(const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
+
+  /// \brief Fuses a HWC2CHW into the op
+  void SetHwcToChw() { hwc_to_chw_ = true; }
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedImageOp; }
+
+ private:
+  // Number of images a worker processes between two throughput reports
+  static constexpr int64_t kThroughputLogInterval = 1000;
+
+  // Single pass kernel, input is a uint8 HWC image and the crop box lies within it
+  Status FusedCompute(const std::shared_ptr<Tensor> &input, int x, int y, int crop_height, int crop_width, bool flip,
+                      std::shared_ptr<Tensor> *output);
+
+  // Runs the fused ops one after another, used for inputs the single pass kernel does not handle
+  Status UnfusedCompute(const std::shared_ptr<Tensor> &input, int x, int y, int crop_height, int crop_width, bool flip,
+                        std::shared_ptr<Tensor> *output);
+
+  Status ComputeImpl(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  void RecordThroughput(int64_t elapsed_us) const;
+
+  bool decode_;
+  bool flip_;
+  bool normalize_;
+  bool hwc_to_chw_;
+  std::bernoulli_distribution flip_distribution_;
+  std::mt19937 flip_rnd_;
+  std::shared_ptr<Tensor> mean_;
+  std::shared_ptr<Tensor> std_;
+  std::vector<float> scale_;
+  std::vector<float> shift_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
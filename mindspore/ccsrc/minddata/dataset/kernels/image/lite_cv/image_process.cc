@@ -21,6 +21,18 @@
 #include <vector>
 #include <algorithm>
 
+#if defined(ENABLE_NEON)
+#include <arm_neon.h>
+#elif defined(ENABLE_SSE) || defined(__SSE2__)
+#include <immintrin.h>
+#define LITE_CV_SSE
+#if defined(__GNUC__)
+// avx2 kernels are compiled per function and picked at runtime, the library still runs on cpus without avx2
+#define LITE_CV_AVX2
+#define LITE_CV_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace mindspore {
 namespace dataset {
 
@@ -57,105 +69,135 @@ static inline void InitBilinearWeight(int *data_ptr, int16_t *weight_ptr, double
   }
 }
 
-static void ResizeBilinear3C(const unsigned char *src, int src_width, int src_height, unsigned char *dst, int dst_width,
-                             int dst_height) {
-  double scale_width = static_cast<double>(src_width) / dst_width;
-  double scale_height = static_cast<double>(src_height) / dst_height;
-
-  int *data_buf = new int[2 * dst_width + 2 * dst_height];
-
-  int *x_offset = data_buf;
-  int *y_offset = data_buf + dst_width;
-
-  int16_t *x_weight = reinterpret_cast<int16_t *>(data_buf + dst_width + dst_height);
-  int16_t *y_weight = reinterpret_cast<int16_t *>(x_weight + dst_width);
-
-  InitBilinearWeight(x_offset, x_weight, scale_width, dst_width, src_width, 3);
-  InitBilinearWeight(y_offset, y_weight, scale_height, dst_height, src_height, 1);
-
-  LiteMat x_tmp_buf0(dst_width * 3 + 1, LDataType::UINT16);
-  LiteMat x_tmp_buf1(dst_width * 3 + 1, LDataType::UINT16);
-  int16_t *row0_ptr = reinterpret_cast<int16_t *>(x_tmp_buf0.data_ptr_);
-  int16_t *row1_ptr = reinterpret_cast<int16_t *>(x_tmp_buf1.data_ptr_);
-
-  int prev_height = -2;
-
-  for (int y = 0; y < dst_height; y++) {
-    int y_span = y_offset[y];
-
-    if (y_span == prev_height) {
-    } else if (y_span == prev_height + 1) {
-      int16_t *tmp = row0_ptr;
-      row0_ptr = row1_ptr;
-      row1_ptr = tmp;
-      const unsigned char *src_start = src + 3 * src_width * (y_span + 1);
-      const int16_t *x_weight_p = x_weight;
-      int16_t *row1_ptr1 = row1_ptr;
-      for (int x = 0; x < dst_width; x++) {
-        const unsigned char *src_start_p = src_start + x_offset[x];
-        row1_ptr1[0] = (src_start_p[0] * x_weight_p[0] + src_start_p[3] * x_weight_p[1]) >> 4;
-        row1_ptr1[1] = (src_start_p[1] * x_weight_p[0] + src_start_p[4] * x_weight_p[1]) >> 4;
-        row1_ptr1[2] = (src_start_p[2] * x_weight_p[0] + src_start_p[5] * x_weight_p[1]) >> 4;
-        x_weight_p += 2;
-        row1_ptr1 += 3;
-      }
-    } else {
-      const unsigned char *src0 = src + 3 * src_width * (y_span);
-      const unsigned char *src1 = src + 3 * src_width * (y_span + 1);
-
-      const int16_t *x_weight_ptr = x_weight;
-      int16_t *row0_ptr0 = row0_ptr;
-      int16_t *row1_ptr1 = row1_ptr;
-      for (int x = 0; x < dst_width; x++) {
-        const unsigned char *src0_ptr = src0 + x_offset[x];
-        const unsigned char *src1_ptr = src1 + x_offset[x];
-
-        for (int c = 0; c < 3; c++) {
-          row0_ptr0[c] = (src0_ptr[c] * x_weight_ptr[0] + src0_ptr[c + 3] * x_weight_ptr[1]) >> 4;
-          row1_ptr1[c] = (src1_ptr[c] * x_weight_ptr[0] + src1_ptr[c + 3] * x_weight_ptr[1]) >> 4;
-        }
-
-        x_weight_ptr += 2;
-        row0_ptr0 += 3;
-        row1_ptr1 += 3;
-      }
-    }
-    prev_height = y_span;
-
-    int16_t *row0_ptr0 = row0_ptr;
-    int16_t *row1_ptr1 = row1_ptr;
-    unsigned char *dst_ptr = dst + dst_width * 3 * (y);
+#ifdef LITE_CV_AVX2
+static bool SupportAvx2() {
+  static const bool support_avx2 = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return support_avx2;
+}
+#endif
+
+// The kernels below process the longest prefix of their input that fills whole vectors and return its length, the
+// callers finish the remaining elements with the scalar code
+
+// dst = ((row0 * w0) >> 16 + (row1 * w1) >> 16 + 2) >> 2, the vertical pass of the bilinear resize
+#if defined(ENABLE_NEON)
+static int BilinearVerticalNeon(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1, unsigned char *dst,
+                                int n) {
+  const int16x8_t v_2 = vdupq_n_s16(2);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t r0 = vld1q_s16(row0 + i);
+    int16x8_t r1 = vld1q_s16(row1 + i);
+    int16x8_t t0 = vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(r0), w0), 16),
+                                vshrn_n_s32(vmull_n_s16(vget_high_s16(r0), w0), 16));
+    int16x8_t t1 = vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(r1), w1), 16),
+                                vshrn_n_s32(vmull_n_s16(vget_high_s16(r1), w1), 16));
+    int16x8_t v = vshrq_n_s16(vaddq_s16(vaddq_s16(t0, t1), v_2), 2);
+    vst1_u8(dst + i, vqmovun_s16(v));
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_SSE
+static int BilinearVerticalSse(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1, unsigned char *dst,
+                               int n) {
+  const __m128i v_w0 = _mm_set1_epi16(w0);
+  const __m128i v_w1 = _mm_set1_epi16(w1);
+  const __m128i v_2 = _mm_set1_epi16(2);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i t0 = _mm_mulhi_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + i)), v_w0);
+    __m128i t1 = _mm_mulhi_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + i)), v_w1);
+    __m128i v = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(t0, t1), v_2), 2);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(v, v));
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_AVX2
+LITE_CV_TARGET_AVX2 static int BilinearVerticalAvx2(const int16_t *row0, const int16_t *row1, int16_t w0, int16_t w1,
+                                                    unsigned char *dst, int n) {
+  const __m256i v_w0 = _mm256_set1_epi16(w0);
+  const __m256i v_w1 = _mm256_set1_epi16(w1);
+  const __m256i v_2 = _mm256_set1_epi16(2);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i t0 = _mm256_mulhi_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + i)), v_w0);
+    __m256i t1 = _mm256_mulhi_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + i)), v_w1);
+    __m256i v = _mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(t0, t1), v_2), 2);
+    // packus works within 128 bit lanes, the two low quadwords hold the 16 results
+    v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm256_castsi256_si128(v));
+  }
+  return i;
+}
+#endif
+
+static void BilinearVertical(const int16_t *row0, const int16_t *row1, const int16_t *y_weight, unsigned char *dst,
+                             int n) {
+  const int16_t w0 = y_weight[0];
+  const int16_t w1 = y_weight[1];
+  int i = 0;
+#if defined(ENABLE_NEON)
+  i = BilinearVerticalNeon(row0, row1, w0, w1, dst, n);
+#elif defined(LITE_CV_SSE)
+#ifdef LITE_CV_AVX2
+  if (SupportAvx2()) {
+    i = BilinearVerticalAvx2(row0, row1, w0, w1, dst, n);
+  }
+#endif
+  i += BilinearVerticalSse(row0 + i, row1 + i, w0, w1, dst + i, n - i);
+#endif
+  for (; i < n; i++) {
+    int16_t t0 = (int16_t)((w0 * row0[i]) >> 16);
+    int16_t t1 = (int16_t)((w1 * row1[i]) >> 16);
+    dst[i] = (unsigned char)((t0 + t1 + 2) >> 2);
+  }
+}
 
-    for (int k = 0; k < dst_width * 3; k++) {
-      int16_t t0 = (int16_t)((y_weight[0] * (int16_t)(*row0_ptr0++)) >> 16);
-      int16_t t1 = (int16_t)((y_weight[1] * (int16_t)(*row1_ptr1++)) >> 16);
-      *dst_ptr++ = (unsigned char)((t0 + t1 + 2) >> 2);
+// The horizontal pass of the bilinear resize of one source row
+template <int kChannel>
+static void BilinearHorizontal(const unsigned char *src, const int *x_offset, const int16_t *x_weight, int dst_width,
+                               int16_t *row) {
+  for (int x = 0; x < dst_width; x++) {
+    const unsigned char *src_p = src + x_offset[x];
+    const int w0 = x_weight[2 * x];
+    const int w1 = x_weight[2 * x + 1];
+    for (int c = 0; c < kChannel; c++) {
+      row[c] = (src_p[c] * w0 + src_p[c + kChannel] * w1) >> 4;
     }
-    y_weight += 2;
+    row += kChannel;
   }
-  delete[] data_buf;
 }
 
-static void ResizeBilinear1C(const unsigned char *src, int src_width, int src_height, unsigned char *dst, int dst_width,
-                             int dst_height) {
+// Resize by bilinear algorithm, the rows of src are src_stride bytes apart. Row y of the result is written at
+// dst + y * dst_stride, then row_done(y, row) is called before the next row is computed.
+template <int kChannel, typename RowDone>
+static void ResizeBilinearImpl(const unsigned char *src, int src_width, int src_height, int src_stride,
+                               unsigned char *dst, int dst_width, int dst_height, int dst_stride, RowDone row_done) {
   double scale_width = static_cast<double>(src_width) / dst_width;
   double scale_height = static_cast<double>(src_height) / dst_height;
 
-  int *data_buf = new int[2 * dst_width + 2 * dst_height];
+  std::vector<int> data_buf(2 * dst_width + 2 * dst_height);
 
-  int *x_offset = data_buf;
-  int *y_offset = data_buf + dst_width;
+  int *x_offset = data_buf.data();
+  int *y_offset = data_buf.data() + dst_width;
 
-  int16_t *x_weight = reinterpret_cast<int16_t *>(data_buf + dst_width + dst_height);
-  int16_t *y_weight = reinterpret_cast<int16_t *>(x_weight + dst_width);
+  int16_t *x_weight = reinterpret_cast<int16_t *>(data_buf.data() + dst_width + dst_height);
+  int16_t *y_weight = reinterpret_cast<int16_t *>(x_weight + dst_width * 2);
 
-  InitBilinearWeight(x_offset, x_weight, scale_width, dst_width, src_width, 1);
+  InitBilinearWeight(x_offset, x_weight, scale_width, dst_width, src_width, kChannel);
   InitBilinearWeight(y_offset, y_weight, scale_height, dst_height, src_height, 1);
 
-  LiteMat x_tmp_buf0(dst_width, LDataType::UINT16);
-  LiteMat x_tmp_buf1(dst_width, LDataType::UINT16);
-  int16_t *row0_ptr = reinterpret_cast<int16_t *>(x_tmp_buf0.data_ptr_);
-  int16_t *row1_ptr = reinterpret_cast<int16_t *>(x_tmp_buf1.data_ptr_);
+  std::vector<int16_t> x_tmp_buf0(dst_width * kChannel);
+  std::vector<int16_t> x_tmp_buf1(dst_width * kChannel);
+  int16_t *row0_ptr = x_tmp_buf0.data();
+  int16_t *row1_ptr = x_tmp_buf1.data();
 
   int prev_height = -2;
 
@@ -164,88 +206,129 @@ static void ResizeBilinear1C(const unsigned char *src, int src_width, int src_he
 
     if (y_span == prev_height) {
     } else if (y_span == prev_height + 1) {
-      int16_t *tmp = row0_ptr;
-      row0_ptr = row1_ptr;
-      row1_ptr = tmp;
-      const unsigned char *src_start = src + src_width * (y_span + 1);
-      const int16_t *x_weight_p = x_weight;
-      int16_t *row1_ptr1 = row1_ptr;
-      for (int x = 0; x < dst_width; x++) {
-        const unsigned char *src_start_p = src_start + x_offset[x];
-        row1_ptr1[x] = (src_start_p[0] * x_weight_p[0] + src_start_p[3] * x_weight_p[1]) >> 4;
-        x_weight_p += 2;
-      }
+      std::swap(row0_ptr, row1_ptr);
+      BilinearHorizontal<kChannel>(src + src_stride * (y_span + 1), x_offset, x_weight, dst_width, row1_ptr);
     } else {
-      const unsigned char *src0 = src + src_width * (y_span);
-      const unsigned char *src1 = src + src_width * (y_span + 1);
-
-      const int16_t *x_weight_ptr = x_weight;
-      int16_t *row0_ptr0 = row0_ptr;
-      int16_t *row1_ptr1 = row1_ptr;
-      for (int x = 0; x < dst_width; x++) {
-        const unsigned char *src0_ptr = src0 + x_offset[x];
-        const unsigned char *src1_ptr = src1 + x_offset[x];
-
-        row0_ptr0[x] = (src0_ptr[0] * x_weight_ptr[0] + src0_ptr[3] * x_weight_ptr[1]) >> 4;
-        row1_ptr1[x] = (src1_ptr[0] * x_weight_ptr[0] + src1_ptr[3] * x_weight_ptr[1]) >> 4;
-
-        x_weight_ptr += 2;
-      }
+      BilinearHorizontal<kChannel>(src + src_stride * y_span, x_offset, x_weight, dst_width, row0_ptr);
+      BilinearHorizontal<kChannel>(src + src_stride * (y_span + 1), x_offset, x_weight, dst_width, row1_ptr);
     }
     prev_height = y_span;
 
-    int16_t *row0_ptr0 = row0_ptr;
-    int16_t *row1_ptr1 = row1_ptr;
-    unsigned char *dst_ptr = dst + dst_width * (y);
-
-    for (int k = 0; k < dst_width; k++) {
-      int16_t t0 = (int16_t)((y_weight[0] * (int16_t)(*row0_ptr0++)) >> 16);
-      int16_t t1 = (int16_t)((y_weight[1] * (int16_t)(*row1_ptr1++)) >> 16);
-      *dst_ptr++ = (unsigned char)((t0 + t1 + 2) >> 2);
-    }
-
+    unsigned char *dst_ptr = dst + dst_stride * y;
+    BilinearVertical(row0_ptr, row1_ptr, y_weight, dst_ptr, dst_width * kChannel);
+    row_done(y, dst_ptr);
     y_weight += 2;
   }
-  delete[] data_buf;
 }
 
-bool ResizeBilinear(const LiteMat &src, LiteMat &dst, int dst_w, int dst_h) {
+// Resize the region (x, y, w, h) of src, src has been checked to be uint8 with 1 or 3 channels
+template <typename RowDone>
+static bool ResizeBilinearRegion(const LiteMat &src, int x, int y, int w, int h, unsigned char *dst, int dst_w,
+                                 int dst_h, int dst_stride, RowDone row_done) {
+  if (w < 2 || h < 2) {
+    return false;
+  }
+  const unsigned char *src_start_p = src;
+  src_start_p += (y * src.width_ + x) * src.channel_;
+  int src_stride = src.width_ * src.channel_;
+  if (src.channel_ == 3) {
+    ResizeBilinearImpl<3>(src_start_p, w, h, src_stride, dst, dst_w, dst_h, dst_stride, row_done);
+  } else {
+    ResizeBilinearImpl<1>(src_start_p, w, h, src_stride, dst, dst_w, dst_h, dst_stride, row_done);
+  }
+  return true;
+}
+
+static bool CheckResizeInput(const LiteMat &src, int dst_w, int dst_h) {
   if (dst_h <= 0 || dst_w <= 0) {
     return false;
   }
   if (src.data_type_ != LDataType::UINT8) {
     return false;
   }
-  if (src.channel_ == 3) {
-    (void)dst.Init(dst_w, dst_h, 3, LDataType::UINT8);
-    const unsigned char *src_start_p = src;
-    unsigned char *dst_start_p = dst;
-    (void)ResizeBilinear3C(src_start_p, src.width_, src.height_, dst_start_p, dst_w, dst_h);
-  } else if (src.channel_ == 1) {
-    (void)dst.Init(dst_w, dst_h, 1, LDataType::UINT8);
-    const unsigned char *src_start_p = src;
-    unsigned char *dst_start_p = dst;
-    (void)ResizeBilinear1C(src_start_p, src.width_, src.height_, dst_start_p, dst_w, dst_h);
-  } else {
+  return src.channel_ == 3 || src.channel_ == 1;
+}
+
+bool ResizeBilinear(const LiteMat &src, LiteMat &dst, int dst_w, int dst_h) {
+  if (!CheckResizeInput(src, dst_w, dst_h)) {
     return false;
   }
-  return true;
+  (void)dst.Init(dst_w, dst_h, src.channel_, LDataType::UINT8);
+  unsigned char *dst_start_p = dst;
+  return ResizeBilinearRegion(src, 0, 0, src.width_, src.height_, dst_start_p, dst_w, dst_h, dst_w * src.channel_,
+                              [](int, const unsigned char *) {});
+}
+
+bool CropResizeBilinear(const LiteMat &src, LiteMat &dst, int x, int y, int w, int h, int dst_w, int dst_h) {
+  if (!CheckResizeInput(src, dst_w, dst_h)) {
+    return false;
+  }
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || y + h > src.height_ || x + w > src.width_) {
+    return false;
+  }
+  (void)dst.Init(dst_w, dst_h, src.channel_, LDataType::UINT8);
+  unsigned char *dst_start_p = dst;
+  return ResizeBilinearRegion(src, x, y, w, h, dst_start_p, dst_w, dst_h, dst_w * src.channel_,
+                              [](int, const unsigned char *) {});
+}
+
+// Drop the alpha channel of n pixels, swapping the red and blue channels for bgr
+#if defined(ENABLE_NEON)
+static int DropAlphaNeon(const unsigned char *src, unsigned char *dst, int n, bool to_bgr) {
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x4_t rgba = vld4q_u8(src + 4 * i);
+    uint8x16x3_t out;
+    out.val[0] = to_bgr ? rgba.val[2] : rgba.val[0];
+    out.val[1] = rgba.val[1];
+    out.val[2] = to_bgr ? rgba.val[0] : rgba.val[2];
+    vst3q_u8(dst + 3 * i, out);
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_AVX2
+LITE_CV_TARGET_AVX2 static int DropAlphaAvx2(const unsigned char *src, unsigned char *dst, int n, bool to_bgr) {
+  const __m256i shuffle = to_bgr ? _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6,
+                                                    5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+                                 : _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4,
+                                                    5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+  int i = 0;
+  // 8 pixels give 24 bytes, the 8 extra bytes of each store are overwritten by the next pixels
+  for (; i + 11 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 4 * i));
+    v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle), compact);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 3 * i), v);
+  }
+  return i;
+}
+#endif
+
+static void DropAlpha(const unsigned char *src, unsigned char *dst, int n, bool to_bgr) {
+  int i = 0;
+#if defined(ENABLE_NEON)
+  i = DropAlphaNeon(src, dst, n, to_bgr);
+#elif defined(LITE_CV_AVX2)
+  if (SupportAvx2()) {
+    i = DropAlphaAvx2(src, dst, n, to_bgr);
+  }
+#endif
+  const int r = to_bgr ? 2 : 0;
+  const int b = to_bgr ? 0 : 2;
+  for (; i < n; i++) {
+    dst[3 * i] = src[4 * i + r];
+    dst[3 * i + 1] = src[4 * i + 1];
+    dst[3 * i + 2] = src[4 * i + b];
+  }
 }
 
 static bool ConvertRGBAToBGR(const unsigned char *data, LDataType data_type, int w, int h, LiteMat &mat) {
   if (data_type == LDataType::UINT8) {
     mat.Init(w, h, 3, LDataType::UINT8);
     unsigned char *ptr = mat;
-    const unsigned char *data_ptr = data;
-    for (int y = 0; y < h; y++) {
-      for (int x = 0; x < w; x++) {
-        ptr[0] = data_ptr[2];
-        ptr[1] = data_ptr[1];
-        ptr[2] = data_ptr[0];
-        ptr += 3;
-        data_ptr += 4;
-      }
-    }
+    DropAlpha(data, ptr, w * h, true);
   } else {
     return false;
   }
@@ -256,16 +339,7 @@ static bool ConvertRGBAToRGB(const unsigned char *data, LDataType data_type, int
   if (data_type == LDataType::UINT8) {
     mat.Init(w, h, 3, LDataType::UINT8);
     unsigned char *ptr = mat;
-    const unsigned char *data_ptr = data;
-    for (int y = 0; y < h; y++) {
-      for (int x = 0; x < w; x++) {
-        ptr[0] = data_ptr[0];
-        ptr[1] = data_ptr[1];
-        ptr[2] = data_ptr[2];
-        ptr += 3;
-        data_ptr += 4;
-      }
-    }
+    DropAlpha(data, ptr, w * h, false);
   } else {
     return false;
   }
@@ -309,6 +383,76 @@ bool InitFromPixel(const unsigned char *data, LPixelType pixel_type, LDataType d
   return true;
 }
 
+// dst = static_cast<float>(src * scale), computed in double like the scalar code
+#if defined(ENABLE_NEON) && defined(ENABLE_ARM64)
+static inline float32x4_t ScaleToFloat(float32x4_t v, float64x2_t v_scale) {
+  float32x2_t low = vcvt_f32_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(v)), v_scale));
+  return vcvt_high_f32_f64(low, vmulq_f64(vcvt_high_f64_f32(v), v_scale));
+}
+
+static int ConvertToNeon(const unsigned char *src, float *dst, int n, double scale) {
+  const float64x2_t v_scale = vdupq_n_f64(scale);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint16x8_t v = vmovl_u8(vld1_u8(src + i));
+    vst1q_f32(dst + i, ScaleToFloat(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), v_scale));
+    vst1q_f32(dst + i + 4, ScaleToFloat(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), v_scale));
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_SSE
+static int ConvertToSse(const unsigned char *src, float *dst, int n, double scale) {
+  const __m128d v_scale = _mm_set1_pd(scale);
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i)), zero);
+    __m128i low = _mm_unpacklo_epi16(v, zero);
+    __m128i high = _mm_unpackhi_epi16(v, zero);
+    __m128 f0 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(low), v_scale));
+    __m128 f1 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(low, 8)), v_scale));
+    __m128 f2 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(high), v_scale));
+    __m128 f3 = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(high, 8)), v_scale));
+    _mm_storeu_ps(dst + i, _mm_movelh_ps(f0, f1));
+    _mm_storeu_ps(dst + i + 4, _mm_movelh_ps(f2, f3));
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_AVX2
+LITE_CV_TARGET_AVX2 static int ConvertToAvx2(const unsigned char *src, float *dst, int n, double scale) {
+  const __m256d v_scale = _mm256_set1_pd(scale);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i)));
+    __m128 low = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)), v_scale));
+    __m128 high = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)), v_scale));
+    _mm256_storeu_ps(dst + i, _mm256_set_m128(high, low));
+  }
+  return i;
+}
+#endif
+
+static void ConvertToFloat(const unsigned char *src, float *dst, int n, double scale) {
+  int i = 0;
+#if defined(ENABLE_NEON) && defined(ENABLE_ARM64)
+  i = ConvertToNeon(src, dst, n, scale);
+#elif defined(LITE_CV_SSE)
+#ifdef LITE_CV_AVX2
+  if (SupportAvx2()) {
+    i = ConvertToAvx2(src, dst, n, scale);
+  }
+#endif
+  i += ConvertToSse(src + i, dst + i, n - i, scale);
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i] * scale);
+  }
+}
+
 bool ConvertTo(const LiteMat &src, LiteMat &dst, double scale) {
   if (src.data_type_ != LDataType::UINT8) {
     return false;
@@ -317,14 +461,7 @@ bool ConvertTo(const LiteMat &src, LiteMat &dst, double scale) {
   (void)dst.Init(src.width_, src.height_, src.channel_, LDataType::FLOAT32);
   const unsigned char *src_start_p = src;
   float *dst_start_p = dst;
-  for (int h = 0; h < src.height_; h++) {
-    for (int w = 0; w < src.width_; w++) {
-      for (int c = 0; c < src.channel_; c++) {
-        int index = (h * src.width_ + w) * src.channel_;
-        dst_start_p[index + c] = (static_cast<float>(src_start_p[index + c] * scale));
-      }
-    }
-  }
+  ConvertToFloat(src_start_p, dst_start_p, src.width_ * src.height_ * src.channel_, scale);
   return true;
 }
 
@@ -392,6 +529,91 @@ static bool CheckMeanAndStd(int channel, const std::vector<float> &mean, const s
   }
   return true;
 }
+
+// Mean and std of the channels repeated over as many floats as the widest vector holds pixels, so that vectors of
+// kNormalizeLanes * channel floats starting at a pixel are normalized with the same vectors of mean and std
+constexpr int kNormalizeLanes = 8;
+
+struct NormalizeParam {
+  NormalizeParam(int channel, const std::vector<float> &mean, const std::vector<float> &std)
+      : channel(channel), mean(channel * kNormalizeLanes, 0.0f), std(channel * kNormalizeLanes, 1.0f) {
+    for (int i = 0; i < channel * kNormalizeLanes; i++) {
+      if (!mean.empty()) {
+        this->mean[i] = mean[i % channel];
+      }
+      if (!std.empty()) {
+        this->std[i] = std[i % channel];
+      }
+    }
+  }
+  int channel;
+  std::vector<float> mean;
+  std::vector<float> std;
+};
+
+// dst = (src - mean) / std over n floats starting at a pixel, a missing mean is 0 and a missing std is 1 which give
+// the same results as leaving them out
+#if defined(ENABLE_NEON) && defined(ENABLE_ARM64)
+static int NormalizeNeon(const float *src, float *dst, int n, const NormalizeParam &param) {
+  const int period = param.channel * 4;
+  int i = 0;
+  for (; i + period <= n; i += period) {
+    for (int k = 0; k < period; k += 4) {
+      float32x4_t v = vsubq_f32(vld1q_f32(src + i + k), vld1q_f32(param.mean.data() + k));
+      vst1q_f32(dst + i + k, vdivq_f32(v, vld1q_f32(param.std.data() + k)));
+    }
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_SSE
+static int NormalizeSse(const float *src, float *dst, int n, const NormalizeParam &param) {
+  const int period = param.channel * 4;
+  int i = 0;
+  for (; i + period <= n; i += period) {
+    for (int k = 0; k < period; k += 4) {
+      __m128 v = _mm_sub_ps(_mm_loadu_ps(src + i + k), _mm_loadu_ps(param.mean.data() + k));
+      _mm_storeu_ps(dst + i + k, _mm_div_ps(v, _mm_loadu_ps(param.std.data() + k)));
+    }
+  }
+  return i;
+}
+#endif
+
+#ifdef LITE_CV_AVX2
+LITE_CV_TARGET_AVX2 static int NormalizeAvx2(const float *src, float *dst, int n, const NormalizeParam &param) {
+  const int period = param.channel * 8;
+  int i = 0;
+  for (; i + period <= n; i += period) {
+    for (int k = 0; k < period; k += 8) {
+      __m256 v = _mm256_sub_ps(_mm256_loadu_ps(src + i + k), _mm256_loadu_ps(param.mean.data() + k));
+      _mm256_storeu_ps(dst + i + k, _mm256_div_ps(v, _mm256_loadu_ps(param.std.data() + k)));
+    }
+  }
+  return i;
+}
+#endif
+
+static void NormalizeFloat(const float *src, float *dst, int n, const NormalizeParam &param) {
+  int i = 0;
+#if defined(ENABLE_NEON) && defined(ENABLE_ARM64)
+  i = NormalizeNeon(src, dst, n, param);
+#elif defined(LITE_CV_SSE)
+#ifdef LITE_CV_AVX2
+  if (SupportAvx2()) {
+    i = NormalizeAvx2(src, dst, n, param);
+  }
+#endif
+  i += NormalizeSse(src + i, dst + i, n - i, param);
+#endif
+  for (; i < n; i += param.channel) {
+    for (int c = 0; c < param.channel; c++) {
+      dst[i + c] = (src[i + c] - param.mean[c]) / param.std[c];
+    }
+  }
+}
+
 bool SubStractMeanNormalize(const LiteMat &src, LiteMat &dst, const std::vector<float> &mean,
                             const std::vector<float> &std) {
   if (src.data_type_ != LDataType::FLOAT32) {
@@ -405,37 +627,32 @@ bool SubStractMeanNormalize(const LiteMat &src, LiteMat &dst, const std::vector<
 
   const float *src_start_p = src;
   float *dst_start_p = dst;
-  if ((!mean.empty()) && std.empty()) {
-    for (int h = 0; h < src.height_; h++) {
-      for (int w = 0; w < src.width_; w++) {
-        for (int c = 0; c < src.channel_; c++) {
-          int index = (h * src.width_ + w) * src.channel_ + c;
-          dst_start_p[index] = src_start_p[index] - mean[c];
-        }
-      }
-    }
-  } else if (mean.empty() && (!std.empty())) {
-    for (int h = 0; h < src.height_; h++) {
-      for (int w = 0; w < src.width_; w++) {
-        for (int c = 0; c < src.channel_; c++) {
-          int index = (h * src.width_ + w) * src.channel_ + c;
-          dst_start_p[index] = src_start_p[index] / std[c];
-        }
-      }
-    }
-  } else if ((!mean.empty()) && (!std.empty())) {
-    for (int h = 0; h < src.height_; h++) {
-      for (int w = 0; w < src.width_; w++) {
-        for (int c = 0; c < src.channel_; c++) {
-          int index = (h * src.width_ + w) * src.channel_ + c;
-          dst_start_p[index] = (src_start_p[index] - mean[c]) / std[c];
-        }
-      }
-    }
-  } else {
+  NormalizeFloat(src_start_p, dst_start_p, src.width_ * src.height_ * src.channel_,
+                 NormalizeParam(src.channel_, mean, std));
+  return true;
+}
+
+bool ResizeBilinearNormalize(const LiteMat &src, LiteMat &dst, int dst_w, int dst_h, const std::vector<float> &mean,
+                             const std::vector<float> &std, double scale) {
+  if (!CheckResizeInput(src, dst_w, dst_h)) {
     return false;
   }
-  return true;
+  if (!CheckMeanAndStd(src.channel_, mean, std)) {
+    return false;
+  }
+  dst.Init(dst_w, dst_h, src.channel_, LDataType::FLOAT32);
+
+  // Each resized row is converted and normalized while it is still in cache
+  const int row_size = dst_w * src.channel_;
+  std::vector<unsigned char> row(row_size);
+  float *dst_start_p = dst;
+  NormalizeParam param(src.channel_, mean, std);
+  return ResizeBilinearRegion(src, 0, 0, src.width_, src.height_, row.data(), dst_w, dst_h, 0,
+                              [dst_start_p, row_size, scale, &param](int y, const unsigned char *row_p) {
+                                float *dst_row_p = dst_start_p + y * row_size;
+                                ConvertToFloat(row_p, dst_row_p, row_size, scale);
+                                NormalizeFloat(dst_row_p, dst_row_p, row_size, param);
+                              });
 }
 
 template <typename T>
@@ -445,70 +662,36 @@ static void PadWithConstant(const LiteMat &src, LiteMat &dst, const int top, con
   dst.Init(src.width_ + left + right, src.height_ + top + bottom, src.channel_, src.data_type_);
   const T *src_start_p = src;
   T *dst_start_p = dst;
-  // padd top
-  for (int h = 0; h < top; h++) {
-    for (int w = 0; w < dst.width_; w++) {
-      int index = (h * dst.width_ + w) * dst.channel_;
-      if (dst.channel_ == 1) {
-        dst_start_p[index] = fill_b_or_gray;
-      } else if (dst.channel_ == 3) {
-        dst_start_p[index] = fill_b_or_gray;
-        dst_start_p[index + 1] = fill_g;
-        dst_start_p[index + 2] = fill_r;
-      } else {
-      }
-    }
-  }
-  // padd bottom
-  for (int h = dst.height_ - bottom; h < dst.height_; h++) {
-    for (int w = 0; w < dst.width_; w++) {
-      int index = (h * dst.width_ + w) * dst.channel_;
-      if (dst.channel_ == 1) {
-        dst_start_p[index] = fill_b_or_gray;
-      } else if (dst.channel_ == 3) {
-        dst_start_p[index] = fill_b_or_gray;
-        dst_start_p[index + 1] = fill_g;
-        dst_start_p[index + 2] = fill_r;
-      } else {
-      }
+  // one row of the fill value, the borders are copied from it
+  std::vector<T> fill_row(dst.width_ * dst.channel_);
+  for (int w = 0; w < dst.width_; w++) {
+    int index = w * dst.channel_;
+    if (dst.channel_ == 1) {
+      fill_row[index] = fill_b_or_gray;
+    } else if (dst.channel_ == 3) {
+      fill_row[index] = fill_b_or_gray;
+      fill_row[index + 1] = fill_g;
+      fill_row[index + 2] = fill_r;
+    } else {
     }
   }
-
-  // padd left
-  for (int h = top; h < dst.height_ - bottom; h++) {
-    for (int w = 0; w < left; w++) {
-      int index = (h * dst.width_ + w) * dst.channel_;
-      if (dst.channel_ == 1) {
-        dst_start_p[index] = fill_b_or_gray;
-      } else if (dst.channel_ == 3) {
-        dst_start_p[index] = fill_b_or_gray;
-        dst_start_p[index + 1] = fill_g;
-        dst_start_p[index + 2] = fill_r;
-      } else {
-      }
-    }
+  const int dst_row_size = dst.width_ * dst.channel_;
+  const int src_row_size = src.width_ * src.channel_;
+  // padd top and bottom
+  for (int h = 0; h < top; h++) {
+    (void)memcpy(dst_start_p + h * dst_row_size, fill_row.data(), dst_row_size * sizeof(T));
   }
-
-  // padd right
-  for (int h = top; h < dst.height_ - bottom; h++) {
-    for (int w = dst.width_ - right; w < dst.width_; w++) {
-      int index = (h * dst.width_ + w) * dst.channel_;
-      if (dst.channel_ == 1) {
-        dst_start_p[index] = fill_b_or_gray;
-      } else if (dst.channel_ == 3) {
-        dst_start_p[index] = fill_b_or_gray;
-        dst_start_p[index + 1] = fill_g;
-        dst_start_p[index + 2] = fill_r;
-      } else {
-      }
-    }
+  for (int h = dst.height_ - bottom; h < dst.height_; h++) {
+    (void)memcpy(dst_start_p + h * dst_row_size, fill_row.data(), dst_row_size * sizeof(T));
   }
-  // image data
-  dst_start_p = dst_start_p + (top * dst.width_ + left) * dst.channel_;
+  // padd left and right, and image data
   for (int i_h = 0; i_h < src.height_; i_h++) {
-    const T *src_index_p = src_start_p + i_h * src.width_ * src.channel_;
-    T *dst_index_p = dst_start_p + i_h * dst.width_ * dst.channel_;
-    (void)memcpy(dst_index_p, src_index_p, src.width_ * src.channel_ * sizeof(T));
+    T *dst_index_p = dst_start_p + (top + i_h) * dst_row_size;
+    (void)memcpy(dst_index_p, fill_row.data(), left * dst.channel_ * sizeof(T));
+    dst_index_p += left * dst.channel_;
+    (void)memcpy(dst_index_p, src_start_p + i_h * src_row_size, src_row_size * sizeof(T));
+    dst_index_p += src_row_size;
+    (void)memcpy(dst_index_p, fill_row.data(), right * dst.channel_ * sizeof(T));
   }
 }
 
@@ -651,15 +834,24 @@ void ImplementAffine(LiteMat &src, LiteMat &out_img, double M[6], std::vector<si
   IM[5] = b2;
 
   out_img.Init(dsize[0], dsize[1], sizeof(Pixel_Type));
+  // the x terms of the source coordinates are the same for every row
+  std::vector<double> x_terms(2 * out_img.width_);
+  for (int x = 0; x < out_img.width_; x++) {
+    x_terms[2 * x] = IM[0] * x;
+    x_terms[2 * x + 1] = IM[3] * x;
+  }
+  const Pixel_Type *src_p = static_cast<Pixel_Type *>(src.data_ptr_);
   for (int y = 0; y < out_img.height_; y++) {
+    double y_term_x = IM[1] * y;
+    double y_term_y = IM[4] * y;
+    Pixel_Type *dst_p = static_cast<Pixel_Type *>(out_img.data_ptr_) + y * out_img.width_;
     for (int x = 0; x < out_img.width_; x++) {
-      int src_x = IM[0] * x + IM[1] * y + IM[2];
-      int src_y = IM[3] * x + IM[4] * y + IM[5];
+      int src_x = x_terms[2 * x] + y_term_x + IM[2];
+      int src_y = x_terms[2 * x + 1] + y_term_y + IM[5];
       if (src_x >= 0 && src_y >= 0 && src_x < src.width_ && src_y < src.height_) {
-        Pixel_Type src_pixel = static_cast<Pixel_Type *>(src.data_ptr_)[src_y * src.width_ + src_x];
-        static_cast<Pixel_Type *>(out_img.data_ptr_)[y * out_img.width_ + x] = src_pixel;
+        dst_p[x] = src_p[src_y * src.width_ + src_x];
       } else {
-        static_cast<Pixel_Type *>(out_img.data_ptr_)[y * out_img.width_ + x] = borderValue;
+        dst_p[x] = borderValue;
       }
     }
   }
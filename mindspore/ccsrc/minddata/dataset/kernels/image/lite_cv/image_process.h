@@ -53,6 +53,16 @@ struct BoxesConfig {
 ///          the channel of currently supports is 3 and 1
 bool ResizeBilinear(const LiteMat &src, LiteMat &dst, int dst_w, int dst_h);
 
+/// \brief crop the region (x, y, w, h) of image and resize it by bilinear algorithm in one pass, the same as Crop
+///          followed by ResizeBilinear, the data type of currently only supports is uint8, the channel of currently
+///          supports is 3 and 1
+bool CropResizeBilinear(const LiteMat &src, LiteMat &dst, int x, int y, int w, int h, int dst_w, int dst_h);
+
+/// \brief resize image by bilinear algorithm, convert it to float and normalize it in one pass, the same as
+///          ResizeBilinear, ConvertTo and SubStractMeanNormalize one after another
+bool ResizeBilinearNormalize(const LiteMat &src, LiteMat &dst, int dst_w, int dst_h, const std::vector<float> &mean,
+                             const std::vector<float> &std, double scale = 1.0);
+
 /// \brief Init Lite Mat from pixel, the conversion of currently supports is rbgaTorgb and rgbaTobgr
 bool InitFromPixel(const unsigned char *data, LPixelType pixel_type, LDataType data_type, int w, int h, LiteMat &m);
 
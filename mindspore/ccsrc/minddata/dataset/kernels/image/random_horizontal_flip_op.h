@@ -48,6 +48,8 @@ class RandomHorizontalFlipOp : public TensorOp {
 
   std::string Name() const override { return kRandomHorizontalFlipOp; }
 
+  float probability() const { return static_cast<float>(distribution_.p()); }
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
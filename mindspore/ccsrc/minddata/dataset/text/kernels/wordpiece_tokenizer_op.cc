@@ -33,22 +33,27 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
+      with_offsets_(with_offsets),
+      word_trie_(vocab == nullptr ? VocabTrie() : VocabTrie(vocab->vocab(), "")),
+      suffix_trie_(vocab == nullptr ? VocabTrie() : VocabTrie(vocab->vocab(), suffix_indicator)) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
+Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes,
+                                        const size_t start_rune, bool *out_found, size_t *out_end_rune) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(start_rune < runes.size(), "Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
+  // Scan the token once along the trie, the longest word which ends at a character boundary is the subword
+  const VocabTrie &trie = start_rune > 0 ? suffix_trie_ : word_trie_;
+  int32_t node = VocabTrie::kRoot;
+  for (size_t i = start_rune; i < runes.size(); i++) {
+    for (uint32_t j = runes[i].offset; j < runes[i].offset + runes[i].len; j++) {
+      node = trie.Next(node, input_token[j]);
+      if (node == VocabTrie::kNoNode) {
+        return Status::OK();
+      }
     }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
+    if (trie.IsWord(node)) {
       *out_found = true;
-      break;
+      *out_end_rune = i + 1;
     }
   }
   return Status::OK();
@@ -98,15 +103,17 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
-  int end = 0;
-  for (int start = 0; start < input_token.size();) {
+  size_t end_rune = 0;
+  for (size_t start_rune = 0; start_rune < runes.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start_rune, &found, &end_rune));
     if (found) {
+      int start = runes[start_rune].offset;
+      int end = runes[end_rune - 1].offset + runes[end_rune - 1].len;
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
       offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
-      start = end;
+      start_rune = end_rune;
     } else {
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
@@ -25,6 +25,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/text/vocab.h"
+#include "minddata/dataset/text/vocab_trie.h"
 #include "minddata/dataset/util/status.h"
 
 using cppjieba::DecodeRunesInString;
@@ -51,8 +52,8 @@ class WordpieceTokenizerOp : public TensorOp {
                     std::vector<std::string> *out_token) const;
   Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                       std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
+  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const size_t start_rune,
+                    bool *out_found, size_t *out_end_rune) const;
   Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
 
@@ -64,6 +65,9 @@ class WordpieceTokenizerOp : public TensorOp {
   const bool with_offsets_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  // Words of vocab_ which start a token, and words which continue a token with suffix_indicator_ removed
+  const VocabTrie word_trie_;
+  const VocabTrie suffix_trie_;
 };
 }  // namespace dataset
 }  // namespace mindspore
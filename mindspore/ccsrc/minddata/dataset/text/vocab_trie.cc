@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/vocab_trie.h"
+
+#include <deque>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+constexpr int32_t VocabTrie::kRoot;
+constexpr int32_t VocabTrie::kNoNode;
+
+VocabTrie::VocabTrie(const std::unordered_map<WordType, WordIdType> &words, const std::string &prefix) {
+  std::vector<std::string> keys;
+  for (const auto &p : words) {
+    if (p.first.compare(0, prefix.size(), prefix) == 0) {
+      keys.push_back(p.first.substr(prefix.size()));
+    }
+  }
+  // Sorted keys put the words below a node in a contiguous range, a word ending at the node comes first in its range
+  std::sort(keys.begin(), keys.end());
+
+  struct Range {
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  // Nodes in breadth first order, with the range of keys below each of them
+  std::deque<Range> pending = {{0, keys.size(), 0}};
+  child_begin_.push_back(0);
+  while (!pending.empty()) {
+    Range range = pending.front();
+    pending.pop_front();
+    size_t i = range.begin;
+    bool is_word = false;
+    while (i < range.end && keys[i].size() == range.depth) {
+      is_word = true;
+      ++i;
+    }
+    is_word_.push_back(is_word ? 1 : 0);
+    while (i < range.end) {
+      uint8_t c = static_cast<uint8_t>(keys[i][range.depth]);
+      size_t j = i + 1;
+      while (j < range.end && static_cast<uint8_t>(keys[j][range.depth]) == c) {
+        ++j;
+      }
+      labels_.push_back(c);
+      pending.push_back({i, j, range.depth + 1});
+      i = j;
+    }
+    child_begin_.push_back(static_cast<int32_t>(labels_.size()));
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
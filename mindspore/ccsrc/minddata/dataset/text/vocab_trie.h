@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+// Byte-wise prefix trie over the words of a vocab, so that all the words which prefix a text are found in a single
+// forward scan of the text. The nodes are stored in flat arrays, the children of a node are contiguous and sorted
+// by their byte.
+class VocabTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNoNode = -1;
+
+  // Build a trie of the words of a vocab which start with prefix, with the prefix removed
+  // @param const std::unordered_map<WordType, WordIdType> &words - words of the vocab
+  // @param const std::string &prefix - only the words starting with prefix are indexed, empty for all the words
+  VocabTrie(const std::unordered_map<WordType, WordIdType> &words, const std::string &prefix);
+
+  // An empty trie, no text has a word as prefix
+  VocabTrie() : child_begin_({0, 0}), is_word_({0}) {}
+
+  ~VocabTrie() = default;
+
+  // Follow the edge of a byte
+  // @param int32_t node - current node, kRoot to start a scan
+  // @param char c - next byte of the text
+  // @return int32_t - the child node, kNoNode if no word continues with this byte
+  int32_t Next(int32_t node, char c) const {
+    auto first = labels_.begin() + child_begin_[node];
+    auto last = labels_.begin() + child_begin_[node + 1];
+    auto itr = std::lower_bound(first, last, static_cast<uint8_t>(c));
+    if (itr == last || *itr != static_cast<uint8_t>(c)) {
+      return kNoNode;
+    }
+    return child_begin_[node] + static_cast<int32_t>(itr - first) + 1;
+  }
+
+  // @param int32_t node - a node returned by Next
+  // @return bool - whether the bytes from the root to the node are a word
+  bool IsWord(int32_t node) const { return is_word_[node] != 0; }
+
+ private:
+  // Nodes are numbered in breadth first order, so the children of node i are the nodes
+  // [child_begin_[i] + 1, child_begin_[i + 1] + 1) and labels_[j] is the byte of the edge into node j + 1
+  std::vector<int32_t> child_begin_;
+  std::vector<uint8_t> labels_;
+  std::vector<uint8_t> is_word_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
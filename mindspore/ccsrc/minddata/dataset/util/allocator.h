@@ -82,6 +82,14 @@ class Allocator {
 
   void deallocate(pointer p, std::size_t n = 0) noexcept { pool_->Deallocate(p); }
 
+  /// \brief Resize a block. The pools shrink a block in place and only move it to grow.
+  Status reallocate(pointer *p, std::size_t old_n, std::size_t new_n) {
+    void *q = *p;
+    RETURN_IF_NOT_OK(pool_->Reallocate(&q, old_n * sizeof(T), new_n * sizeof(T)));
+    *p = reinterpret_cast<pointer>(q);
+    return Status::OK();
+  }
+
   size_type max_size() { return pool_->get_max_size(); }
 
  private:
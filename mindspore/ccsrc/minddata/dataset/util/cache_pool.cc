@@ -14,17 +14,44 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <functional>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/cache_pool.h"
+#include "minddata/dataset/util/lz_compressor.h"
 #include "minddata/dataset/util/services.h"
+#include "securec.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Number of compressed buffers handed to the write back task each time there is nothing left to compress
+constexpr size_t kWriteBackBatch = 16;
+constexpr int kWriteBackQueueSize = 1024;
+// A buffer which does not shrink by at least 1/kMinSaving when compressed goes to disk directly
+constexpr size_t kMinSaving = 8;
+}  // namespace
+
 CachePool::CachePool(const value_allocator &alloc, const std::string &root)
-    : alloc_(alloc), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {}
+    : alloc_(alloc), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+  ResetStat();
+}
+
+void CachePool::ResetStat() {
+  num_hot_ = 0;
+  num_warm_ = 0;
+  num_cold_ = 0;
+  hot_bytes_ = 0;
+  warm_bytes_ = 0;
+  cold_bytes_ = 0;
+  total_sz_ = 0;
+  num_hot_hit_ = 0;
+  num_warm_hit_ = 0;
+  num_cold_hit_ = 0;
+}
 
 Status CachePool::DoServiceStart() {
   tree_ = std::make_shared<data_index>();
+  ResetStat();
   // If we are given a disk path, set up the StorageManager
   if (!root_.toString().empty()) {
     Path spill = GetSpillPath();
@@ -32,25 +59,44 @@ Status CachePool::DoServiceStart() {
     sm_ = std::make_shared<StorageManager>(spill);
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << common::SafeCStr(spill.toString());
+    // Compressed buffers are moved to disk in the background
+    write_back_grp_ = std::make_unique<TaskGroup>();
+    write_back_que_ = std::make_unique<Queue<key_type>>(kWriteBackQueueSize);
+    RETURN_IF_NOT_OK(write_back_que_->Register(write_back_grp_.get()));
+    RETURN_IF_NOT_OK(write_back_grp_->CreateAsyncTask("CachePool write back", std::bind(&CachePool::WriteBack, this)));
   }
   return Status::OK();
 }
 Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
+  // Stop the write back task first. It uses the storage manager and the tree.
+  if (write_back_grp_ != nullptr) {
+    rc = write_back_grp_->ServiceStop();
+    if (rc.IsError()) {
+      rc2 = rc;
+    }
+  }
+  write_back_grp_.reset();
+  write_back_que_.reset();
   if (sm_ != nullptr) {
     rc = sm_->ServiceStop();
-    if (rc.IsError()) {
+    if (rc.IsError() && rc2.IsOk()) {
       rc2 = rc;
     }
   }
   sm_.reset();
   for (auto &bl : *tree_) {
     if (bl.ptr != nullptr) {
-      alloc_.deallocate(bl.ptr, bl.sz);
+      alloc_.deallocate(bl.ptr, bl.csz > 0 ? bl.csz : bl.sz);
     }
   }
   tree_.reset();
+  {
+    std::lock_guard<std::mutex> lck(demote_mux_);
+    hot_keys_.clear();
+    warm_keys_.clear();
+  }
   if (!root_.toString().empty()) {
     Path spill = GetSpillPath();
     auto it = Path::DirIterator::OpenDirectory(&spill);
@@ -77,8 +123,8 @@ Status CachePool::Insert(const std::vector<ReadableSlice> &buf, CachePool::key_t
     sz += v.GetSize();
   }
   bl.sz = sz;
-  try {
-    bl.ptr = alloc_.allocate(sz);
+  bl.ptr = Allocate(sz);
+  if (bl.ptr != nullptr) {
     // We will do a piecewise copy.
     WritableSlice dest(bl.ptr, bl.sz);
     size_t pos = 0;
@@ -95,35 +141,235 @@ Status CachePool::Insert(const std::vector<ReadableSlice> &buf, CachePool::key_t
       bl.ptr = nullptr;
       return rc;
     }
-  } catch (std::bad_alloc &e) {
-    if (sm_ != nullptr) {
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
-    } else {
-      return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  } else {
+    // Nothing left to demote. Compress this buffer and keep it in memory if it fits, or else on disk.
+    std::vector<base_type> raw(sz);
+    size_t pos = 0;
+    for (auto &v : buf) {
+      if (v.GetSize() > 0) {
+        (void)memcpy_s(raw.data() + pos, sz - pos, v.GetPointer(), v.GetSize());
+        pos += v.GetSize();
+      }
+    }
+    std::vector<base_type> packed(LZCompressor::MaxCompressedSize(sz));
+    bl.csz = LZCompressor::Compress(raw.data(), sz, packed.data());
+    try {
+      bl.ptr = alloc_.allocate(bl.csz);
+      (void)memcpy_s(bl.ptr, bl.csz, packed.data(), bl.csz);
+    } catch (std::bad_alloc &e) {
+      if (sm_ != nullptr) {
+        RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, {ReadableSlice(packed.data(), bl.csz)}));
+      } else {
+        return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+      }
     }
   }
+  pointer ptr = bl.ptr;
+  size_t csz = bl.csz;
   rc = tree_->insert(bl, key);
-  if (rc.IsError() && bl.ptr != nullptr) {
-    alloc_.deallocate(bl.ptr, sz);
+  if (rc.IsError()) {
+    if (ptr != nullptr) {
+      alloc_.deallocate(ptr, csz > 0 ? csz : sz);
+    }
+    return rc;
+  }
+  total_sz_ += sz;
+  if (ptr == nullptr) {
+    ++num_cold_;
+    cold_bytes_ += csz;
+  } else if (csz > 0) {
+    ++num_warm_;
+    warm_bytes_ += csz;
+    std::lock_guard<std::mutex> lck(demote_mux_);
+    warm_keys_.push_back(*key);
+  } else {
+    ++num_hot_;
+    hot_bytes_ += sz;
+    std::lock_guard<std::mutex> lck(demote_mux_);
+    hot_keys_.push_back(*key);
   }
   return rc;
 }
+CachePool::pointer CachePool::Allocate(size_t sz) {
+  do {
+    try {
+      return alloc_.allocate(sz);
+    } catch (std::bad_alloc &e) {
+      // Make some room and try again
+    }
+  } while (Demote(sz));
+  return nullptr;
+}
+bool CachePool::Demote(size_t sz) {
+  size_t freed = 0;
+  while (freed < sz) {
+    key_type key;
+    {
+      std::lock_guard<std::mutex> lck(demote_mux_);
+      if (hot_keys_.empty()) {
+        break;
+      }
+      key = hot_keys_.front();
+      hot_keys_.pop_front();
+    }
+    size_t n = 0;
+    Status rc = Compress(key, &n);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to compress buffer " << key << ". " << rc.ToString();
+      break;
+    }
+    freed += n;
+  }
+  if (freed == 0 && write_back_que_ != nullptr) {
+    // Everything in memory is compressed already. The oldest compressed buffers go to disk and give back their
+    // memory to the next inserts.
+    std::vector<key_type> keys;
+    {
+      std::lock_guard<std::mutex> lck(demote_mux_);
+      while (keys.size() < kWriteBackBatch && !warm_keys_.empty()) {
+        keys.push_back(warm_keys_.front());
+        warm_keys_.pop_front();
+      }
+    }
+    for (auto key : keys) {
+      Status rc = write_back_que_->Add(key);
+      if (rc.IsError()) {
+        break;
+      }
+    }
+  }
+  return freed > 0;
+}
+Status CachePool::Compress(key_type key, size_t *freed) {
+  RETURN_UNEXPECTED_IF_NULL(freed);
+  *freed = 0;
+  pointer ptr = nullptr;
+  size_t sz = 0;
+  {
+    auto r = tree_->Search(key);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    ptr = r.first->ptr;
+    sz = r.first->sz;
+  }
+  // Nobody else demotes the buffer, its memory stays put until we change it. Compress it without any lock.
+  std::vector<base_type> packed(LZCompressor::MaxCompressedSize(sz));
+  size_t csz = LZCompressor::Compress(ptr, sz, packed.data());
+  if (csz <= sz - sz / kMinSaving) {
+    // Shrink the buffer to its compressed form in place. There may be no room for both forms.
+    auto r = tree_->Search(key);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    auto &it = r.first;
+    UniqueLock lck(&tier_lock_);
+    RETURN_IF_NOT_OK(alloc_.reallocate(&it->ptr, sz, csz));
+    (void)memcpy_s(it->ptr, csz, packed.data(), csz);
+    it->csz = csz;
+    lck.Unlock();
+    *freed = sz - csz;
+    --num_hot_;
+    hot_bytes_ -= sz;
+    ++num_warm_;
+    warm_bytes_ += csz;
+    std::lock_guard<std::mutex> guard(demote_mux_);
+    warm_keys_.push_back(key);
+    return Status::OK();
+  }
+  // Compression does not pay off. Without a disk the buffer stays as it is.
+  if (sm_ != nullptr) {
+    StorageManager::key_type storage_key;
+    RETURN_IF_NOT_OK(sm_->Write(&storage_key, {ReadableSlice(packed.data(), csz)}));
+    RETURN_IF_NOT_OK(SwapMemory(key, nullptr, csz, storage_key));
+    *freed = sz;
+    --num_hot_;
+    hot_bytes_ -= sz;
+    ++num_cold_;
+    cold_bytes_ += csz;
+  }
+  return Status::OK();
+}
+Status CachePool::Spill(key_type key) {
+  pointer ptr = nullptr;
+  size_t csz = 0;
+  {
+    auto r = tree_->Search(key);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    ptr = r.first->ptr;
+    csz = r.first->csz;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(ptr != nullptr && csz > 0, "Buffer is not compressed in memory");
+  StorageManager::key_type storage_key;
+  RETURN_IF_NOT_OK(sm_->Write(&storage_key, {ReadableSlice(ptr, csz)}));
+  RETURN_IF_NOT_OK(SwapMemory(key, nullptr, csz, storage_key));
+  --num_warm_;
+  warm_bytes_ -= csz;
+  ++num_cold_;
+  cold_bytes_ += csz;
+  return Status::OK();
+}
+Status CachePool::SwapMemory(key_type key, pointer ptr, size_t csz, StorageManager::key_type storage_key) {
+  pointer old_ptr = nullptr;
+  size_t old_sz = 0;
+  {
+    auto r = tree_->Search(key);
+    CHECK_FAIL_RETURN_UNEXPECTED(r.second, "Key not found");
+    auto &it = r.first;
+    // Wait for the readers of the old memory
+    UniqueLock lck(&tier_lock_);
+    old_ptr = it->ptr;
+    old_sz = it->csz > 0 ? it->csz : it->sz;
+    it->ptr = ptr;
+    it->csz = csz;
+    it->storage_key = storage_key;
+  }
+  if (old_ptr != nullptr) {
+    alloc_.deallocate(old_ptr, old_sz);
+  }
+  return Status::OK();
+}
+Status CachePool::WriteBack() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    key_type key;
+    RETURN_IF_NOT_OK(write_back_que_->PopFront(&key));
+    Status rc = Spill(key);
+    if (rc.IsError()) {
+      // The buffer stays compressed in memory
+      MS_LOG(WARNING) << "Failed to write buffer " << key << " to disk. " << rc.ToString();
+    }
+  }
+}
 Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
   RETURN_UNEXPECTED_IF_NULL(dest);
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
-    if (it->ptr != nullptr) {
+    SharedLock lck(&tier_lock_);
+    if (it->ptr != nullptr && it->csz == 0) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      ++num_hot_hit_;
+    } else if (it->ptr != nullptr) {
+      CHECK_FAIL_RETURN_UNEXPECTED(dest->GetSize() >= it->sz, "Destination length is too small");
+      RETURN_IF_NOT_OK(LZCompressor::Decompress(it->ptr, it->csz,
+                                                static_cast<base_type *>(dest->GetMutablePointer()), it->sz));
+      ++num_warm_hit_;
     } else if (sm_ != nullptr) {
+      // A buffer on disk stays there. We don't need the lock for the disk read.
+      size_t csz = it->csz;
+      auto storage_key = it->storage_key;
+      lck.Unlock();
+      CHECK_FAIL_RETURN_UNEXPECTED(dest->GetSize() >= it->sz, "Destination length is too small");
+      std::vector<base_type> packed(csz);
+      WritableSlice src(packed.data(), csz);
       size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
+      RETURN_IF_NOT_OK(sm_->Read(storage_key, &src, &expectedLength));
+      if (expectedLength != csz) {
+        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << csz << "."
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      RETURN_IF_NOT_OK(
+        LZCompressor::Decompress(packed.data(), csz, static_cast<base_type *>(dest->GetMutablePointer()), it->sz));
+      ++num_cold_hit_;
     }
     if (bytesRead != nullptr) {
       *bytesRead = it->sz;
@@ -140,59 +386,26 @@ Path CachePool::GetSpillPath() const {
 }
 CachePool::CacheStat CachePool::GetStat() const {
   CacheStat cs{0};
-  int64_t total_sz = 0;
-  for (auto &it : *tree_) {
-    total_sz += it.sz;
-    if (it.ptr != nullptr) {
-      ++cs.num_mem_cached;
-    } else {
-      ++cs.num_disk_cached;
-    }
-  }
-  if (total_sz > 0) {
+  cs.num_mem_cached = num_hot_;
+  cs.num_compressed_cached = num_warm_;
+  cs.num_disk_cached = num_cold_;
+  cs.mem_bytes = hot_bytes_;
+  cs.compressed_bytes = warm_bytes_;
+  cs.disk_bytes = cold_bytes_;
+  cs.num_mem_hit = num_hot_hit_;
+  cs.num_compressed_hit = num_warm_hit_;
+  cs.num_disk_hit = num_cold_hit_;
+  int64_t total_sz = total_sz_;
+  int64_t num_cached = cs.num_mem_cached + cs.num_compressed_cached + cs.num_disk_cached;
+  if (total_sz > 0 && num_cached > 0) {
     // integer arithmetic. NO need to cast to float or double.
-    cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached);
+    cs.average_cache_sz = total_sz / num_cached;
     if (cs.average_cache_sz == 0) {
       cs.average_cache_sz = 1;
     }
   }
   return cs;
 }
-Status CachePool::Spill(CachePool::DataLocator *dl) {
-  if (sm_ == nullptr) {
-    RETURN_STATUS_UNEXPECTED("No disk storage to spill");
-  }
-  RETURN_UNEXPECTED_IF_NULL(dl);
-  RETURN_UNEXPECTED_IF_NULL(dl->ptr);
-  if (dl->storage_key == 0) {
-    ReadableSlice data(dl->ptr, dl->sz);
-    RETURN_IF_NOT_OK(sm_->Write(&dl->storage_key, {data}));
-  }
-  alloc_.deallocate(dl->ptr, dl->sz);
-  dl->ptr = nullptr;
-  return Status::OK();
-}
-Status CachePool::Locate(CachePool::DataLocator *dl) {
-  RETURN_UNEXPECTED_IF_NULL(dl);
-  if (dl->ptr == nullptr) {
-    if (sm_ == nullptr) {
-      RETURN_STATUS_UNEXPECTED("No disk storage to locate the data");
-    }
-    try {
-      dl->ptr = alloc_.allocate(dl->sz);
-      WritableSlice dest(dl->ptr, dl->sz);
-      Status rc = Read(dl->storage_key, &dest);
-      if (rc.IsError()) {
-        alloc_.deallocate(dl->ptr, dl->sz);
-        dl->ptr = nullptr;
-        return rc;
-      }
-    } catch (const std::bad_alloc &e) {
-      return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
-    }
-  }
-  return Status::OK();
-}
 size_t CachePool::GetSize(CachePool::key_type key) const {
   auto r = tree_->Search(key);
   if (r.second) {
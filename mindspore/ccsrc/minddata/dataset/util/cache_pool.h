@@ -16,15 +16,20 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/lock.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/storage_manager.h"
 #include "minddata/dataset/util/auto_index.h"
+#include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
@@ -32,6 +37,12 @@ namespace dataset {
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). Every buffer insert will return a generated key which can be used to
 /// restore the buffer.
+///
+/// Buffers are kept in three tiers. A new buffer goes to the hot tier, in memory as is. When the memory runs out,
+/// the oldest hot buffers are compressed in place (the warm tier) to make room, and once there is nothing left to
+/// compress the oldest warm buffers are written to disk (the cold tier) by a background task. Only the disk location
+/// of a cold buffer stays in memory. Buffers are demoted in insertion order which fits the scan of a whole dataset
+/// once per epoch: every buffer is read once between two reads of the same buffer.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -42,34 +53,40 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
-  // An internal class to locate the whereabouts of a backed up buffer which can be either in
+  // An internal class to locate the whereabouts of a backed up buffer which can be either in memory (compressed
+  // or not) or on disk (compressed).
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), csz(0), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      csz = other.csz;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.csz = 0;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        csz = other.csz;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.csz = 0;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
     size_t sz;
+    size_t csz;  // Compressed size. 0 if the buffer is in memory uncompressed.
     StorageManager::key_type storage_key;
   };
 
@@ -78,11 +95,18 @@ class CachePool : public Service {
   using bl_alloc_type = typename value_allocator::template rebind<DataLocator>::other;
 
   /// \brief Simple statistics returned from CachePool like how many elements are cached in memory and
-  /// how many elements are spilled to disk.
+  /// how many elements are spilled to disk, and how many reads were served from each tier.
   struct CacheStat {
     int64_t num_mem_cached;
     int64_t num_disk_cached;
     int64_t average_cache_sz;
+    int64_t num_compressed_cached;
+    int64_t mem_bytes;
+    int64_t compressed_bytes;
+    int64_t disk_bytes;
+    int64_t num_mem_hit;
+    int64_t num_compressed_hit;
+    int64_t num_disk_hit;
   };
 
   /// \brief Constructor
@@ -114,10 +138,6 @@ class CachePool : public Service {
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
-  Status Spill(DataLocator *dl);
-
-  Status Locate(DataLocator *dl);
-
   size_t GetSize(key_type key) const;
 
   /// \brief Get statistics.
@@ -134,6 +154,48 @@ class CachePool : public Service {
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
+  // Readers hold it shared while they use the memory of a buffer. A demotion holds it exclusively to change it.
+  mutable RWLock tier_lock_;
+  std::mutex demote_mux_;
+  std::deque<key_type> hot_keys_;   // Buffers in memory uncompressed, oldest first.
+  std::deque<key_type> warm_keys_;  // Buffers in memory compressed, oldest first.
+  std::unique_ptr<TaskGroup> write_back_grp_;
+  std::unique_ptr<Queue<key_type>> write_back_que_;
+  std::atomic<int64_t> num_hot_;
+  std::atomic<int64_t> num_warm_;
+  std::atomic<int64_t> num_cold_;
+  std::atomic<int64_t> hot_bytes_;
+  std::atomic<int64_t> warm_bytes_;
+  std::atomic<int64_t> cold_bytes_;
+  std::atomic<int64_t> total_sz_;
+  mutable std::atomic<int64_t> num_hot_hit_;
+  mutable std::atomic<int64_t> num_warm_hit_;
+  mutable std::atomic<int64_t> num_cold_hit_;
+
+  /// \brief Allocate memory for a buffer, demoting other buffers if there is not enough memory.
+  /// \return nullptr if there is still not enough memory
+  pointer Allocate(size_t sz);
+
+  /// \brief Make room in memory by demoting the oldest buffers.
+  /// \param[in] sz Number of bytes wanted
+  /// \return True if some memory was given back
+  bool Demote(size_t sz);
+
+  /// \brief Compress a hot buffer in place. If it does not compress well it goes to disk directly.
+  /// \param[in] key Key of the buffer
+  /// \param[out] freed Number of bytes given back
+  Status Compress(key_type key, size_t *freed);
+
+  /// \brief Move a warm buffer to disk. Run by the write back task.
+  Status Spill(key_type key);
+
+  /// \brief The write back task
+  Status WriteBack();
+
+  /// \brief Swap the memory of a buffer and free the old memory
+  Status SwapMemory(key_type key, pointer ptr, size_t csz, StorageManager::key_type storage_key);
+
+  void ResetStat();
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/lz_compressor.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint8_t kMethodStored = 0;
+constexpr uint8_t kMethodLZ = 1;
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 12;
+constexpr size_t kMinCompressSize = 32;
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t v;
+  (void)memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t Hash(uint32_t v) { return (v * 2654435761u) >> (32 - kHashBits); }
+
+// Write a length which does not fit in the 4 bits of the token
+inline uint8_t *WriteLength(uint8_t *op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<uint8_t>(len);
+  return op;
+}
+
+inline Status ReadLength(const uint8_t **ip, const uint8_t *end, size_t *len) {
+  uint8_t b;
+  do {
+    if (*ip >= end) {
+      RETURN_STATUS_UNEXPECTED("Corrupted compressed block: truncated length");
+    }
+    b = *(*ip)++;
+    *len += b;
+  } while (b == 255);
+  return Status::OK();
+}
+
+size_t Store(const uint8_t *src, size_t sz, uint8_t *dest) {
+  dest[0] = kMethodStored;
+  if (sz > 0) {
+    (void)memcpy(dest + 1, src, sz);
+  }
+  return sz + 1;
+}
+}  // namespace
+
+size_t LZCompressor::Compress(const uint8_t *src, size_t sz, uint8_t *dest) {
+  if (sz < kMinCompressSize) {
+    return Store(src, sz, dest);
+  }
+  // Positions are stored plus one so that zero means an empty slot
+  std::vector<uint32_t> table(1u << kHashBits, 0);
+  uint8_t *op = dest;
+  *op++ = kMethodLZ;
+  // Never produce more than the stored form, which is one byte more than the input
+  const uint8_t *op_limit = dest + sz;
+  size_t anchor = 0;
+  size_t ip = 0;
+  const size_t match_limit = sz - kMinMatch;
+  auto emit = [&op, &op_limit, src](size_t lit_start, size_t lit_len, size_t offset, size_t match_len) -> bool {
+    // token + literal length + literals + offset + match length
+    size_t need = 1 + lit_len / 255 + 1 + lit_len + 2 + match_len / 255 + 1;
+    if (op + need > op_limit) {
+      return false;
+    }
+    uint8_t *token = op++;
+    *token = static_cast<uint8_t>((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15) {
+      op = WriteLength(op, lit_len - 15);
+    }
+    if (lit_len > 0) {
+      (void)memcpy(op, src + lit_start, lit_len);
+      op += lit_len;
+    }
+    if (offset == 0) {
+      return true;
+    }
+    *op++ = static_cast<uint8_t>(offset & 0xff);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    size_t ml = match_len - kMinMatch;
+    *token |= static_cast<uint8_t>(ml >= 15 ? 15 : ml);
+    if (ml >= 15) {
+      op = WriteLength(op, ml - 15);
+    }
+    return true;
+  };
+
+  while (ip <= match_limit) {
+    uint32_t v = Read32(src + ip);
+    uint32_t h = Hash(v);
+    size_t ref = table[h];
+    table[h] = static_cast<uint32_t>(ip + 1);
+    if (ref > 0 && ip + 1 - ref <= kMaxOffset && Read32(src + ref - 1) == v) {
+      --ref;
+      size_t len = kMinMatch;
+      while (ip + len < sz && src[ref + len] == src[ip + len]) {
+        ++len;
+      }
+      if (!emit(anchor, ip - anchor, ip - ref, len)) {
+        return Store(src, sz, dest);
+      }
+      ip += len;
+      anchor = ip;
+      continue;
+    }
+    // Skip faster over data which does not compress
+    ip += 1 + ((ip - anchor) >> 6);
+  }
+  if (!emit(anchor, sz - anchor, 0, 0)) {
+    return Store(src, sz, dest);
+  }
+  return static_cast<size_t>(op - dest);
+}
+
+Status LZCompressor::Decompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz) {
+  CHECK_FAIL_RETURN_UNEXPECTED(sz > 0, "Corrupted compressed block: empty");
+  if (src[0] == kMethodStored) {
+    CHECK_FAIL_RETURN_UNEXPECTED(sz - 1 == dest_sz, "Corrupted compressed block: size mismatch");
+    if (dest_sz > 0) {
+      (void)memcpy(dest, src + 1, dest_sz);
+    }
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(src[0] == kMethodLZ, "Corrupted compressed block: unknown method");
+  const uint8_t *ip = src + 1;
+  const uint8_t *end = src + sz;
+  uint8_t *op = dest;
+  uint8_t *op_end = dest + dest_sz;
+  while (ip < end) {
+    uint8_t token = *ip++;
+    size_t lit_len = token >> 4;
+    if (lit_len == 15) {
+      RETURN_IF_NOT_OK(ReadLength(&ip, end, &lit_len));
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(lit_len <= static_cast<size_t>(end - ip) &&
+                                   lit_len <= static_cast<size_t>(op_end - op),
+                                 "Corrupted compressed block: literals out of bound");
+    if (lit_len > 0) {
+      (void)memcpy(op, ip, lit_len);
+      ip += lit_len;
+      op += lit_len;
+    }
+    if (ip == end) {
+      break;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(end - ip >= 2, "Corrupted compressed block: truncated offset");
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    size_t match_len = token & 0x0f;
+    if (match_len == 15) {
+      RETURN_IF_NOT_OK(ReadLength(&ip, end, &match_len));
+    }
+    match_len += kMinMatch;
+    CHECK_FAIL_RETURN_UNEXPECTED(offset > 0 && offset <= static_cast<size_t>(op - dest) &&
+                                   match_len <= static_cast<size_t>(op_end - op),
+                                 "Corrupted compressed block: match out of bound");
+    // A match overlapping the output repeats its first offset bytes, copy it in growing non overlapping pieces
+    const uint8_t *match = op - offset;
+    while (match_len > 0) {
+      size_t n = std::min(match_len, static_cast<size_t>(op - match));
+      (void)memcpy(op, match, n);
+      op += n;
+      match_len -= n;
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(op == op_end, "Corrupted compressed block: size mismatch");
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LZ_COMPRESSOR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LZ_COMPRESSOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A fast LZ77 block compressor in the spirit of LZ4. It trades compression ratio for speed: a single hash
+/// probe per position, no entropy coding. Each compressed block starts with a one byte method so that incompressible
+/// input is stored as is and costs one byte only.
+class LZCompressor {
+ public:
+  /// \brief Upper bound of the compressed size of a buffer
+  /// \param sz Size of the uncompressed buffer
+  /// \return Size to reserve for the compressed buffer
+  static size_t MaxCompressedSize(size_t sz) { return sz + sz / 255 + 16; }
+
+  /// \brief Compress a buffer
+  /// \param src Uncompressed buffer
+  /// \param sz Size of the uncompressed buffer
+  /// \param dest Compressed buffer of at least MaxCompressedSize(sz) bytes
+  /// \return Size of the compressed buffer
+  static size_t Compress(const uint8_t *src, size_t sz, uint8_t *dest);
+
+  /// \brief Decompress a buffer
+  /// \param src Compressed buffer
+  /// \param sz Size of the compressed buffer
+  /// \param dest Uncompressed buffer
+  /// \param dest_sz Size of the uncompressed buffer, which must be known by the caller
+  /// \return Status object
+  static Status Decompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LZ_COMPRESSOR_H_
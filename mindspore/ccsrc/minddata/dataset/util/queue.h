@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -44,7 +45,12 @@ class Queue {
   using const_reference = const T &;
 
   explicit Queue(int sz)
-      : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+      : sz_(sz),
+        arr_sz_(sz),
+        arr_(Services::GetAllocator<T>()),
+        head_(0),
+        tail_(0),
+        my_name_(Services::GetUniqueID()) {
     Status rc = arr_.allocate(sz);
     if (rc.IsError()) {
       MS_LOG(ERROR) << "Fail to create a queue.";
@@ -71,9 +77,9 @@ class Queue {
   Status Add(const_reference ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
-      auto k = tail_++ % sz_;
+      auto k = tail_++ % arr_sz_;
       *(arr_[k]) = ele;
       empty_cv_.NotifyAll();
       _lock.unlock();
@@ -86,9 +92,9 @@ class Queue {
   Status Add(T &&ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
-      auto k = tail_++ % sz_;
+      auto k = tail_++ % arr_sz_;
       *(arr_[k]) = std::forward<T>(ele);
       empty_cv_.NotifyAll();
       _lock.unlock();
@@ -102,9 +108,9 @@ class Queue {
   Status EmplaceBack(Ts &&... args) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
-      auto k = tail_++ % sz_;
+      auto k = tail_++ % arr_sz_;
       new (arr_[k]) T(std::forward<Ts>(args)...);
       empty_cv_.NotifyAll();
       _lock.unlock();
@@ -120,7 +126,7 @@ class Queue {
     // Block when empty
     Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
     if (rc.IsOk()) {
-      auto k = head_++ % sz_;
+      auto k = head_++ % arr_sz_;
       *p = std::move(*(arr_[k]));
       full_cv_.NotifyAll();
       _lock.unlock();
@@ -130,12 +136,41 @@ class Queue {
     return rc;
   }
 
+  // Change the capacity of the queue while producers and consumers may be using it. The queued elements are
+  // kept in order. When shrinking below the number of queued elements, producers block until consumers have
+  // drained the queue below the new capacity.
+  Status Resize(size_t sz) {
+    if (sz == 0) {
+      RETURN_STATUS_UNEXPECTED("Queue capacity must be greater than 0.");
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (sz == sz_) {
+      return Status::OK();
+    }
+    size_t n = size();
+    size_t arr_sz = std::max(sz, n);
+    MemGuard<T, Allocator<T>> new_arr(Services::GetAllocator<T>());
+    RETURN_IF_NOT_OK(new_arr.allocate(arr_sz));
+    for (size_t i = 0; i < n; ++i) {
+      *(new_arr[i]) = std::move(*(arr_[(head_ + i) % arr_sz_]));
+    }
+    arr_ = std::move(new_arr);
+    arr_sz_ = arr_sz;
+    sz_ = sz;
+    head_ = 0;
+    tail_ = n;
+    MS_LOG(DEBUG) << "Resize Q with uuid " << my_name_ << " to size " << sz_ << ".";
+    // Producers blocked on a full queue may proceed if it grew
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, drain them. We won't call PopFront directly
     // because we have got the lock already. We will deadlock if we call PopFront
     for (auto i = head_; i < tail_; ++i) {
-      auto k = i % sz_;
+      auto k = i % arr_sz_;
       auto val = std::move(*(arr_[k]));
       // Let val go out of scope and its destructor will be invoked automatically.
       // But our compiler may complain val is not in use. So let's do some useless
@@ -159,7 +194,8 @@ class Queue {
   }
 
  private:
-  size_t sz_;
+  size_t sz_;      // capacity seen by the producers
+  size_t arr_sz_;  // number of slots allocated, larger than sz_ until a shrinking queue is drained
   MemGuard<T, Allocator<T>> arr_;
   size_t head_;
   size_t tail_;
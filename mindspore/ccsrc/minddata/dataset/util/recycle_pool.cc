@@ -0,0 +1,139 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/recycle_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+RecyclePool::RecyclePool(size_t max_cached_blocks)
+    : max_cached_blocks_(max_cached_blocks),
+      num_cached_blocks_(0),
+      cached_bytes_(0),
+      in_use_bytes_(0),
+      hit_count_(0),
+      miss_count_(0) {}
+
+RecyclePool::~RecyclePool() {
+  for (auto &entry : free_blocks_) {
+    for (auto *header : entry.second) {
+      free(header);
+    }
+  }
+}
+
+Status RecyclePool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  {
+    std::lock_guard<std::mutex> lck(mux_);
+    auto it = free_blocks_.find(n);
+    if (it != free_blocks_.end() && !it->second.empty()) {
+      BlockHeader *header = it->second.back();
+      it->second.pop_back();
+      num_cached_blocks_--;
+      cached_bytes_ -= n;
+      in_use_bytes_ += n;
+      hit_count_++;
+      *p = header + 1;
+      return Status::OK();
+    }
+    in_use_bytes_ += n;
+    miss_count_++;
+  }
+  void *q = nullptr;
+  Status rc = DeMalloc(sizeof(BlockHeader) + n, &q, false);
+  if (rc.IsError()) {
+    std::lock_guard<std::mutex> lck(mux_);
+    in_use_bytes_ -= n;
+    return rc;
+  }
+  auto *header = reinterpret_cast<BlockHeader *>(q);
+  header->size = n;
+  *p = header + 1;
+  return Status::OK();
+}
+
+Status RecyclePool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (old_sz >= new_sz) {
+    // Do nothing if we shrink, the block keeps its original size class.
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err) {
+    Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void RecyclePool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  BlockHeader *header = HeaderOf(p);
+  size_t n = header->size;
+  BlockHeader *victim = nullptr;
+  {
+    std::lock_guard<std::mutex> lck(mux_);
+    in_use_bytes_ -= n;
+    if (num_cached_blocks_ >= max_cached_blocks_) {
+      // Make room by dropping a block of another size, so sizes that are no longer requested
+      // (e.g. the last partial batch of an epoch) do not keep the cache to themselves.
+      auto it = std::find_if(free_blocks_.begin(), free_blocks_.end(),
+                             [n](const auto &entry) { return entry.first != n && !entry.second.empty(); });
+      if (it == free_blocks_.end()) {
+        free(header);
+        return;
+      }
+      victim = it->second.back();
+      it->second.pop_back();
+      num_cached_blocks_--;
+      cached_bytes_ -= it->first;
+    }
+    free_blocks_[n].push_back(header);
+    num_cached_blocks_++;
+    cached_bytes_ += n;
+  }
+  free(victim);
+}
+
+uint64_t RecyclePool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+int RecyclePool::PercentFree() const {
+  std::lock_guard<std::mutex> lck(mux_);
+  uint64_t total = cached_bytes_ + in_use_bytes_;
+  return total == 0 ? 100 : static_cast<int>(cached_bytes_ * 100 / total);
+}
+
+int64_t RecyclePool::hit_count() const {
+  std::lock_guard<std::mutex> lck(mux_);
+  return hit_count_;
+}
+
+int64_t RecyclePool::miss_count() const {
+  std::lock_guard<std::mutex> lck(mux_);
+  return miss_count_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A MemoryPool that keeps freed blocks around and hands them out again to
+// requests of exactly the same size. It is meant for large buffers that are
+// allocated over and over with a handful of sizes, e.g. the batch tensors of
+// BatchOp, where going back to malloc costs an mmap/munmap and fresh page
+// faults for every buffer. At most max_cached_blocks free blocks are kept;
+// when the cache is full a block of another size is released to make room.
+class RecyclePool : public MemoryPool {
+ public:
+  explicit RecyclePool(size_t max_cached_blocks);
+
+  ~RecyclePool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override;
+
+  // Number of allocations served from a cached block
+  int64_t hit_count() const;
+
+  // Number of allocations that had to go to the system
+  int64_t miss_count() const;
+
+ private:
+  // Every block starts with a header recording its size, padded so the
+  // returned address keeps the alignment of malloc.
+  struct alignas(alignof(std::max_align_t)) BlockHeader {
+    size_t size;
+  };
+
+  static BlockHeader *HeaderOf(void *p) { return reinterpret_cast<BlockHeader *>(p) - 1; }
+
+  mutable std::mutex mux_;
+  std::unordered_map<size_t, std::vector<BlockHeader *>> free_blocks_;
+  size_t max_cached_blocks_;
+  size_t num_cached_blocks_;
+  uint64_t cached_bytes_;
+  uint64_t in_use_bytes_;
+  int64_t hit_count_;
+  int64_t miss_count_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
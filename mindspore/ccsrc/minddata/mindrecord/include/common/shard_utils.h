@@ -68,6 +68,10 @@ enum LabelCategory { kSchemaLabel, kStatisticsLabel, kIndexLabel };
 const char kVersion[] = "3.0";
 const std::vector<std::string> kSupportedVersion = {"2.0", kVersion};
 
+// Encoding of the raw data rows, recorded in the header, files without it use msgpack
+const uint64_t kRawFormatMsgpack = 0;
+const uint64_t kRawFormatTyped = 1;
+
 enum ShardType {
   kNLP = 0,
   kCV = 1,
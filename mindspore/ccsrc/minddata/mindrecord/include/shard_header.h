@@ -121,12 +121,16 @@ class ShardHeader {
 
   uint64_t GetCompressionSize() const { return compression_size_; }
 
+  uint64_t GetRawFormat() const { return raw_format_; }
+
   void SetHeaderSize(const uint64_t &header_size) { header_size_ = header_size; }
 
   void SetPageSize(const uint64_t &page_size) { page_size_ = page_size; }
 
   void SetCompressionSize(const uint64_t &compression_size) { compression_size_ = compression_size; }
 
+  void SetRawFormat(const uint64_t &raw_format) { raw_format_ = raw_format; }
+
   std::vector<std::string> SerializeHeader();
 
   MSRStatus PagesToFile(const std::string dump_file_name);
@@ -187,6 +191,7 @@ class ShardHeader {
   uint64_t header_size_;
   uint64_t page_size_;
   uint64_t compression_size_;
+  uint64_t raw_format_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+// Columns of every row in the index, same names as the columns of the INDEXES table in the sqlite index
+const std::vector<std::string> kIndexFileFixedColumns = {
+  "ROW_ID",       "PAGE_ID_RAW",  "PAGE_OFFSET_RAW",  "PAGE_OFFSET_RAW_END",
+  "ROW_GROUP_ID", "PAGE_ID_BLOB", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
+
+const char kIndexFileSuffix[] = ".idx";
+
+/// \brief Writer of the binary index of one shard, the columnar alternative of the sqlite index.
+///
+/// The index file is a sequence of 8 bytes aligned sections, all integers are uint64 in host byte order:
+///   header:  magic "MRINDEX1", byte order mark, number of rows, number of index fields, shard name
+///   fields:  for each index field, its column name and whether it is numeric
+///   fixed:   the fixed columns, one array per column, rows sorted by ROW_ID
+///   pages:   row positions sorted by (PAGE_ID_BLOB, ROW_ID), to binary search the rows of a blob page
+///   values:  for each index field, value offsets (number of rows + 1), row positions sorted by value and the
+///            concatenated values
+/// Values are stored as the text sqlite returns for them, so both indexes give the same query results.
+class ShardIndexFileWriter {
+ public:
+  /// \brief Constructor
+  /// \param[in] shard_name file name of the shard, without directory
+  /// \param[in] fields column name of each index field and whether its values are numeric
+  ShardIndexFileWriter(const std::string &shard_name, const std::vector<std::pair<std::string, bool>> &fields);
+
+  ~ShardIndexFileWriter() = default;
+
+  /// \brief add a row, in the format generated for the sqlite index: (":column", db type, value)
+  MSRStatus AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row);
+
+  /// \brief sort the rows and write the index file
+  MSRStatus Commit(const std::string &file_path);
+
+ private:
+  std::string shard_name_;
+  std::vector<std::pair<std::string, bool>> fields_;
+  std::map<std::string, int> column_ids_;  // ":column" to position in fixed columns and then index fields
+  std::vector<std::vector<uint64_t>> fixed_;
+  std::vector<std::vector<std::string>> values_;
+};
+
+/// \brief Read-only view of a binary index file, see ShardIndexFileWriter for the layout.
+///
+/// The file is memory mapped, opening it costs one system call whatever the number of rows. Rows of a blob page
+/// are found by binary search and values are compared in place. Open and all queries are thread safe.
+class ShardIndexFile {
+ public:
+  ~ShardIndexFile();
+
+  /// \brief map and validate an index file
+  static std::pair<MSRStatus, std::shared_ptr<ShardIndexFile>> Open(const std::string &file_path);
+
+  const std::string &GetShardName() const { return shard_name_; }
+
+  uint64_t GetNumRows() const { return num_rows_; }
+
+  /// \brief select columns of the rows in ROW_ID order, as "SELECT columns FROM INDEXES" would
+  /// \param[in] columns fixed column names or index field names "field_schemaid"
+  /// \param[in] page_id only rows with this PAGE_ID_BLOB, -1 for all rows
+  /// \param[in] criteria only rows where the index field criteria.first equals criteria.second, if not empty
+  /// \return column values of the selected rows
+  std::pair<MSRStatus, std::vector<std::vector<std::string>>> Select(
+    const std::vector<std::string> &columns, int64_t page_id = -1,
+    const std::pair<std::string, std::string> &criteria = {"", ""}) const;
+
+  /// \brief distinct values of an index field, as "SELECT DISTINCT field FROM INDEXES" would
+  std::pair<MSRStatus, std::vector<std::string>> Distinct(const std::string &field) const;
+
+ private:
+  struct FieldView {
+    std::string name;
+    bool numeric;
+    const uint64_t *offsets;
+    const uint64_t *value_order;
+    const char *values;
+    uint64_t values_size;
+  };
+
+  ShardIndexFile() = default;
+
+  MSRStatus Parse();
+
+  // Column number, fixed columns first and then index fields, -1 if not found
+  int GetColumnId(const std::string &column) const;
+
+  std::pair<MSRStatus, std::string> GetValue(int column_id, uint64_t row) const;
+
+  // Rows of a blob page, as positions in the ROW_ID order
+  std::pair<MSRStatus, std::vector<uint64_t>> GetPageRows(int64_t page_id) const;
+
+  // Whether the value of an index field equals the criteria, numerically for numeric fields
+  std::pair<MSRStatus, bool> Match(const FieldView &field, uint64_t row, const std::string &criteria) const;
+
+  std::string file_path_;
+  const char *data_ = nullptr;
+  uint64_t size_ = 0;
+  std::vector<char> buffer_;  // file content when it is not memory mapped
+  bool mapped_ = false;
+
+  std::string shard_name_;
+  uint64_t num_rows_ = 0;
+  const uint64_t *fixed_ = nullptr;
+  const uint64_t *page_order_ = nullptr;
+  std::vector<FieldView> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
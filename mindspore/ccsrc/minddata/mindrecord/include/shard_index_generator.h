@@ -26,6 +26,8 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
+#include "minddata/mindrecord/include/shard_row_codec.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -93,6 +95,9 @@ class ShardIndexGenerator {
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
+  /// \brief column name of each index field and whether its values are numeric, for the binary index
+  std::pair<MSRStatus, std::vector<std::pair<std::string, bool>>> GenerateIndexFileFields();
+
   MSRStatus ExecuteTransaction(const int &shard_no, std::pair<MSRStatus, sqlite3 *> &db,
                                const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id);
 
@@ -110,6 +115,7 @@ class ShardIndexGenerator {
   std::string file_path_;
   bool append_;
   ShardHeader shard_header_;
+  std::vector<std::shared_ptr<ShardRowCodec>> row_codecs_;  // decoder of the raw data of each schema
   uint64_t page_size_;
   uint64_t header_size_;
   int schema_count_;
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+// Number of tasks the reader schedules ahead of the consumers
+const int64_t kPrefetchTasks = 1024;
+// Number of tasks scheduled together, only blobs scheduled together are merged into one read
+const int64_t kPrefetchBatch = 128;
+// Bytes scheduled and not consumed yet, the reader stops scheduling above it
+const uint64_t kPrefetchBytes = 1 << 28;  // 256MB
+// Blobs separated by less than this gap are merged into one read
+const uint64_t kMaxReadGap = 1 << 16;  // 64KB
+// Merged reads stop growing at this size
+const uint64_t kMaxReadSize = 1 << 24;  // 16MB
+const int kNumPrefetchThreads = 4;
+
+/// \brief a blob to read from a shard file
+struct BlobRequest {
+  int64_t key;        // id of the blob, the task id for ShardReader
+  int shard_id;       // shard file
+  uint64_t offset;    // offset of the blob in the shard file
+  uint64_t length;    // length of the blob
+};
+
+/// \brief view of a blob in a read buffer, the buffer is kept alive by the view
+class BlobView {
+ public:
+  BlobView() : offset_(0), length_(0) {}
+
+  BlobView(std::shared_ptr<const std::vector<uint8_t>> buffer, uint64_t offset, uint64_t length)
+      : buffer_(std::move(buffer)), offset_(offset), length_(length) {}
+
+  const uint8_t *data() const { return buffer_ == nullptr ? nullptr : buffer_->data() + offset_; }
+
+  uint64_t size() const { return length_; }
+
+ private:
+  std::shared_ptr<const std::vector<uint8_t>> buffer_;
+  uint64_t offset_;
+  uint64_t length_;
+};
+
+/// \brief read blobs of shard files ahead of their consumption.
+///
+/// Blobs are scheduled in the order they will be consumed. Blobs of a schedule call which are close to each other
+/// in the same file are merged into one sequential read, and the reads are done by a bounded pool of I/O threads
+/// in the order of their first blob. Consumers get views into the read buffers instead of copies. A blob which is
+/// not scheduled, or whose read failed, is read by the consumer thread.
+class ShardPrefetcher {
+ public:
+  /// \brief Constructor
+  /// \param[in] file_paths shard files, indexed by shard id
+  /// \param[in] num_threads number of I/O threads
+  ShardPrefetcher(const std::vector<std::string> &file_paths, int num_threads);
+
+  ~ShardPrefetcher();
+
+  /// \brief open the shard files and launch the I/O threads
+  MSRStatus Open();
+
+  /// \brief stop the I/O threads and close the shard files
+  void Close();
+
+  /// \brief schedule the reads of blobs, in the order of consumption
+  void Schedule(const std::vector<BlobRequest> &requests);
+
+  /// \brief get a blob, waiting for its scheduled read or reading it now
+  std::pair<MSRStatus, BlobView> Get(const BlobRequest &request);
+
+  /// \brief drop all scheduled blobs, reads in flight are discarded when they complete
+  void Reset();
+
+  /// \brief bytes of the reads which are scheduled and not consumed yet
+  uint64_t GetPendingBytes();
+
+ private:
+  struct Extent {
+    int shard_id;
+    uint64_t offset;
+    uint64_t length;
+    std::shared_ptr<std::vector<uint8_t>> buffer;
+    bool done;
+    bool failed;
+    int pending;  // blobs not consumed yet
+  };
+
+  // Position of a scheduled blob
+  struct BlobLocation {
+    BlobRequest request;
+    std::shared_ptr<Extent> extent;
+  };
+
+  void IoWorker(int thread_id);
+
+  MSRStatus ReadAt(int shard_id, uint64_t offset, uint64_t length, uint8_t *dest);
+
+  void Release(const std::shared_ptr<Extent> &extent);
+
+  std::vector<std::string> file_paths_;
+  std::vector<int> fds_;
+  int num_threads_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_queue_;  // I/O threads wait for extents to read
+  std::condition_variable cv_done_;   // consumers wait for extents being read
+  std::deque<std::shared_ptr<Extent>> queue_;
+  std::unordered_map<int64_t, BlobLocation> blobs_;
+  uint64_t pending_bytes_;
+  bool stop_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
@@ -47,10 +47,13 @@
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
+#include "minddata/mindrecord/include/shard_prefetcher.h"
 #include "minddata/mindrecord/include/shard_reader.h"
+#include "minddata/mindrecord/include/shard_row_codec.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
 #include "utils/log_adapter.h"
@@ -199,6 +202,10 @@ class ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set flag of reading the binary index files instead of the sqlite databases when they exist
+  /// \return null
+  void SetUseIndexFile(bool use_index_file) { use_index_file_ = use_index_file; }
+
   /// \brief get all classes
   MSRStatus GetAllClasses(const std::string &category_field, std::set<std::string> &categories);
 
@@ -219,7 +226,8 @@ class ShardReader {
   ROW_GROUPS ReadAllRowGroup(std::vector<std::string> &columns);
 
   /// \brief read all rows in one shard
-  MSRStatus ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+  MSRStatus ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &index_columns,
+                               const std::vector<std::string> &columns,
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                std::vector<std::vector<json>> &column_values);
 
@@ -236,6 +244,11 @@ class ShardReader {
   std::vector<std::vector<uint64_t>> GetImageOffset(int group_id, int shard_id,
                                                     const std::pair<std::string, std::string> &criteria = {"", ""});
 
+  /// \brief select columns of the rows of a page from the binary index of a shard
+  std::pair<MSRStatus, std::vector<std::vector<std::string>>> SelectFromIndexFile(
+    int shard_id, const std::vector<std::string> &index_columns, int page_id,
+    const std::pair<std::string, std::string> &criteria);
+
   /// \brief execute sqlite query with prepare statement
   MSRStatus QueryWithCriteria(sqlite3 *db, string &sql, string criteria, std::vector<std::vector<std::string>> &labels);
 
@@ -270,6 +283,15 @@ class ShardReader {
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief location of the blob of a task in the shard files
+  std::pair<MSRStatus, BlobRequest> GetBlobRequest(int task_id);
+
+  /// \brief schedule the blob reads of the tasks ahead of a task
+  void SchedulePrefetch(int task_id);
+
+  /// \brief drop the scheduled blob reads when the task list changes
+  void ResetPrefetch();
+
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
     int shard_id, const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &label_offsets);
@@ -277,6 +299,9 @@ class ShardReader {
   /// \brief get classes in one shard
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string sql, std::set<std::string> &categories);
 
+  /// \brief get classes in one shard from its binary index
+  void GetClassesInIndexFile(int shard_id, const std::string &field, std::set<std::string> &categories);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
@@ -292,8 +317,10 @@ class ShardReader {
   int shard_count_;                            // number of shards
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
+  std::shared_ptr<ShardRowCodec> row_codec_;   // decoder of the raw data rows
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardIndexFile>> index_files_;                     // binary index list, or nullptr
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
@@ -305,10 +332,14 @@ class ShardReader {
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // data operators, including shuffle, sample and category
   ShardTask tasks_;                                        // shard task
   std::mutex shard_locker_;                                // locker of shard
+  std::shared_ptr<ShardPrefetcher> prefetcher_;            // reads blobs ahead of the consumers
+  std::mutex prefetch_locker_;                             // locker of prefetch schedule
+  int prefetch_task_id_ = 0;                               // tasks before it are scheduled
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;    // if all columns are stored in index-table
+  bool use_index_file_ = true;  // if binary index files are read instead of sqlite databases
+  bool interrupt_ = false;      // reader interrupted
 
   int num_padded_;  // number of padding samples
 
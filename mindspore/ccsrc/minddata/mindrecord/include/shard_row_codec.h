@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ROW_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ROW_CODEC_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+// First byte of a typed row, msgpack never uses it so typed and msgpack rows can be told apart
+const uint8_t kTypedRowMarker = 0xc1;
+
+/// \brief Fixed-layout binary encoding of the raw data of a row, generated from the schema.
+///
+/// A typed row is the marker byte, a bitmap of the fields present in the row, one slot per raw field at an offset
+/// fixed by the schema and the string values. Slots are 4 bytes for int32 and 8 bytes for int64, float32, float64
+/// (float32 is kept as double, as msgpack does) and string (offset and length of the value in the row). Fields
+/// are laid out in the order of the schema. Rows which do not fit the schema, e.g. with extra fields or values of
+/// another type when the data was not validated, are encoded with msgpack so they are read back unchanged.
+class ShardRowCodec {
+ public:
+  /// \brief Constructor
+  /// \param[in] schema the "schema" object of a Schema, blob fields are skipped
+  explicit ShardRowCodec(const json &schema);
+
+  ~ShardRowCodec() = default;
+
+  /// \brief encode the raw data of a row
+  std::vector<uint8_t> Encode(const json &row) const;
+
+  /// \brief position of the columns in the layout, -1 for the columns which are not raw fields
+  std::vector<int> GetFieldIds(const std::vector<std::string> &columns) const;
+
+  /// \brief decode a typed or msgpack row
+  /// \param[in] row the encoded row
+  /// \param[in] columns the columns to decode, all the fields if empty
+  /// \param[in] field_ids the positions of the columns, from GetFieldIds
+  /// \return the row as json
+  std::pair<MSRStatus, json> Decode(const std::vector<uint8_t> &row, const std::vector<std::string> &columns = {},
+                                    const std::vector<int> &field_ids = {}) const;
+
+ private:
+  enum FieldType { kInt32Field, kInt64Field, kFloat32Field, kFloat64Field, kStringField };
+
+  struct Field {
+    std::string name;
+    FieldType type;
+    uint64_t offset;  // offset of the slot in the row
+  };
+
+  // Whether the value can be stored in the slot of the field without changing its json type
+  bool Fits(const Field &field, const json &value) const;
+
+  MSRStatus DecodeField(const std::vector<uint8_t> &row, const Field &field, json *value) const;
+
+  std::vector<Field> fields_;
+  std::map<std::string, int> field_ids_;
+  uint64_t bitmap_size_ = 0;
+  uint64_t fixed_size_ = 0;  // size of a row without its string values
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ROW_CODEC_H_
@@ -40,6 +40,7 @@
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_row_codec.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "utils/log_adapter.h"
@@ -135,11 +136,17 @@ class ShardWriter {
 
   /// \brief fill data array in multiple thread run
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                 std::vector<std::vector<uint8_t>> &bin_data);
+                 std::vector<std::vector<uint8_t>> &bin_data,
+                 const std::map<uint64_t, std::shared_ptr<ShardRowCodec>> &row_codecs);
 
   /// \brief serialized raw data
+  /// \param[in] row_codecs typed encoding of each schema, msgpack for the schemas without one
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
+                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                             const std::map<uint64_t, std::shared_ptr<ShardRowCodec>> &row_codecs = {});
+
+  /// \brief typed encoding of the raw data of each schema, empty if the header records msgpack rows
+  std::map<uint64_t, std::shared_ptr<ShardRowCodec>> GetRowCodecs();
 
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
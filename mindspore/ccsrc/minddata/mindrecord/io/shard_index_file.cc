@@ -0,0 +1,571 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_index_file.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include "utils/log_adapter.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kIndexFileMagic[] = "MRINDEX1";
+const uint64_t kByteOrderMark = 0x0102030405060708;
+const uint64_t kAlignment = 8;
+const int kNumFixedColumns = 8;
+const int kRowIdColumn = 0;
+const int kPageIdBlobColumn = 5;
+// Largest double that converts to an int64 without overflow
+const double kMaxExactInt64 = 9223372036854774784.0;
+
+uint64_t AlignUp(uint64_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+// Text of an integer value as sqlite returns it
+std::string NormalizeInteger(const std::string &value) {
+  char *end = nullptr;
+  long long num = std::strtoll(value.c_str(), &end, 10);
+  if (end == value.c_str()) {
+    return value;
+  }
+  return std::to_string(num);
+}
+
+// Text of a value bound to a NUMERIC column as sqlite returns it. Reals without fractional part are stored as
+// integers, the others are printed with 15 significant digits and always have a decimal point.
+std::string NormalizeNumeric(const std::string &value) {
+  char *end = nullptr;
+  double num = std::strtod(value.c_str(), &end);
+  if (end == value.c_str()) {
+    return value;
+  }
+  if (std::isfinite(num) && std::floor(num) == num && std::fabs(num) <= kMaxExactInt64) {
+    return std::to_string(static_cast<int64_t>(num));
+  }
+  if (std::isnan(num)) {
+    return "";
+  }
+  if (std::isinf(num)) {
+    return num > 0 ? "Inf" : "-Inf";
+  }
+  char buf[32] = {0};
+  (void)snprintf(buf, sizeof(buf), "%.15g", num);
+  std::string text(buf);
+  if (text.find('.') == std::string::npos) {
+    auto exp = text.find('e');
+    text.insert(exp == std::string::npos ? text.size() : exp, ".0");
+  }
+  return text;
+}
+
+bool ParseNumber(const char *begin, const char *end, double *num) {
+  std::string text(begin, end);
+  char *parse_end = nullptr;
+  *num = std::strtod(text.c_str(), &parse_end);
+  if (parse_end == text.c_str()) {
+    return false;
+  }
+  while (*parse_end == ' ') {
+    parse_end++;
+  }
+  return *parse_end == '\0';
+}
+
+class IndexFileStream {
+ public:
+  explicit IndexFileStream(const std::string &file_path)
+      : out_(file_path, std::ios::out | std::ios::binary | std::ios::trunc) {}
+
+  bool good() const { return out_.good(); }
+
+  void WriteU64(uint64_t value) { (void)out_.write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+
+  void WriteU64Array(const std::vector<uint64_t> &values) {
+    (void)out_.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(uint64_t));
+  }
+
+  // Raw bytes, padded to the alignment of the next section
+  void WriteBytes(const char *data, uint64_t size) {
+    static const char kPadding[kAlignment] = {0};
+    (void)out_.write(data, size);
+    (void)out_.write(kPadding, AlignUp(size) - size);
+  }
+
+  void WriteString(const std::string &value) {
+    WriteU64(value.size());
+    WriteBytes(value.data(), value.size());
+  }
+
+  void Close() { out_.close(); }
+
+ private:
+  std::ofstream out_;
+};
+
+class IndexFileCursor {
+ public:
+  IndexFileCursor(const char *data, uint64_t size) : data_(data), size_(size), pos_(0) {}
+
+  const char *Take(uint64_t size) {
+    uint64_t aligned = AlignUp(size);
+    if (aligned < size || aligned > size_ - pos_) {
+      return nullptr;
+    }
+    const char *ptr = data_ + pos_;
+    pos_ += aligned;
+    return ptr;
+  }
+
+  const uint64_t *TakeU64Array(uint64_t count) {
+    if (count > (size_ - pos_) / sizeof(uint64_t)) {
+      return nullptr;
+    }
+    return reinterpret_cast<const uint64_t *>(Take(count * sizeof(uint64_t)));
+  }
+
+  bool ReadU64(uint64_t *value) {
+    auto ptr = TakeU64Array(1);
+    if (ptr == nullptr) {
+      return false;
+    }
+    *value = *ptr;
+    return true;
+  }
+
+  bool ReadString(std::string *value) {
+    uint64_t len = 0;
+    if (!ReadU64(&len)) {
+      return false;
+    }
+    const char *ptr = Take(len);
+    if (ptr == nullptr) {
+      return false;
+    }
+    value->assign(ptr, len);
+    return true;
+  }
+
+  uint64_t Remaining() const { return size_ - pos_; }
+
+ private:
+  const char *data_;
+  uint64_t size_;
+  uint64_t pos_;
+};
+}  // namespace
+
+ShardIndexFileWriter::ShardIndexFileWriter(const std::string &shard_name,
+                                           const std::vector<std::pair<std::string, bool>> &fields)
+    : shard_name_(shard_name), fields_(fields), fixed_(kNumFixedColumns), values_(fields.size()) {
+  for (int i = 0; i < kNumFixedColumns; ++i) {
+    column_ids_[":" + kIndexFileFixedColumns[i]] = i;
+  }
+  for (int i = 0; i < static_cast<int>(fields_.size()); ++i) {
+    column_ids_[":" + fields_[i].first] = kNumFixedColumns + i;
+  }
+}
+
+MSRStatus ShardIndexFileWriter::AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row) {
+  std::vector<bool> found(kNumFixedColumns + fields_.size(), false);
+  std::vector<uint64_t> fixed(kNumFixedColumns, 0);
+  // Fields missing in the row are NULL in sqlite, which is read back as an empty string
+  std::vector<std::string> values(fields_.size());
+  for (const auto &field : row) {
+    const auto &place_holder = std::get<0>(field);
+    const auto &field_type = std::get<1>(field);
+    const auto &field_value = std::get<2>(field);
+    auto iter = column_ids_.find(place_holder);
+    if (iter == column_ids_.end()) {
+      // INC_n columns only exist for the primary key of the sqlite table
+      if (place_holder.compare(0, 5, ":INC_") == 0) {
+        continue;
+      }
+      MS_LOG(ERROR) << "Index field " << place_holder << " is not found in index file of " << shard_name_;
+      return FAILED;
+    }
+    int id = iter->second;
+    found[id] = true;
+    if (id < kNumFixedColumns) {
+      fixed[id] = std::strtoull(field_value.c_str(), nullptr, 10);
+    } else if (field_type == "INTEGER") {
+      values[id - kNumFixedColumns] = NormalizeInteger(field_value);
+    } else if (field_type == "NUMERIC") {
+      values[id - kNumFixedColumns] = NormalizeNumeric(field_value);
+    } else if (field_type != "NULL") {
+      values[id - kNumFixedColumns] = field_value;
+    }
+  }
+  for (int i = 0; i < kNumFixedColumns; ++i) {
+    if (!found[i]) {
+      MS_LOG(ERROR) << "Column " << kIndexFileFixedColumns[i] << " is missing in the row of " << shard_name_;
+      return FAILED;
+    }
+    fixed_[i].push_back(fixed[i]);
+  }
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    values_[i].push_back(std::move(values[i]));
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexFileWriter::Commit(const std::string &file_path) {
+  uint64_t num_rows = fixed_[kRowIdColumn].size();
+  // Rows are written in ROW_ID order
+  std::vector<uint64_t> row_order(num_rows);
+  std::iota(row_order.begin(), row_order.end(), 0);
+  std::stable_sort(row_order.begin(), row_order.end(), [this](uint64_t a, uint64_t b) {
+    return fixed_[kRowIdColumn][a] < fixed_[kRowIdColumn][b];
+  });
+
+  IndexFileStream out(file_path);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Invalid file, failed to open index file: " << file_path;
+    return FAILED;
+  }
+  out.WriteBytes(kIndexFileMagic, kAlignment);
+  out.WriteU64(kByteOrderMark);
+  out.WriteU64(num_rows);
+  out.WriteU64(fields_.size());
+  out.WriteString(shard_name_);
+  for (const auto &field : fields_) {
+    out.WriteString(field.first);
+    out.WriteU64(field.second ? 1 : 0);
+  }
+
+  std::vector<uint64_t> column(num_rows);
+  for (int i = 0; i < kNumFixedColumns; ++i) {
+    for (uint64_t j = 0; j < num_rows; ++j) {
+      column[j] = fixed_[i][row_order[j]];
+    }
+    out.WriteU64Array(column);
+  }
+
+  // Stable sort keeps the rows of a page in ROW_ID order
+  std::vector<uint64_t> page_order(num_rows);
+  std::iota(page_order.begin(), page_order.end(), 0);
+  const auto &page_ids = fixed_[kPageIdBlobColumn];
+  std::stable_sort(page_order.begin(), page_order.end(), [&page_ids, &row_order](uint64_t a, uint64_t b) {
+    return page_ids[row_order[a]] < page_ids[row_order[b]];
+  });
+  out.WriteU64Array(page_order);
+
+  for (const auto &values : values_) {
+    std::vector<uint64_t> offsets(num_rows + 1, 0);
+    for (uint64_t j = 0; j < num_rows; ++j) {
+      offsets[j + 1] = offsets[j] + values[row_order[j]].size();
+    }
+    out.WriteU64Array(offsets);
+
+    std::vector<uint64_t> value_order(num_rows);
+    std::iota(value_order.begin(), value_order.end(), 0);
+    std::stable_sort(value_order.begin(), value_order.end(), [&values, &row_order](uint64_t a, uint64_t b) {
+      return values[row_order[a]] < values[row_order[b]];
+    });
+    out.WriteU64Array(value_order);
+
+    std::string bytes;
+    bytes.reserve(offsets[num_rows]);
+    for (uint64_t j = 0; j < num_rows; ++j) {
+      bytes += values[row_order[j]];
+    }
+    out.WriteBytes(bytes.data(), bytes.size());
+  }
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Failed to write index file: " << file_path;
+    out.Close();
+    (void)std::remove(file_path.c_str());
+    return FAILED;
+  }
+  out.Close();
+  MS_LOG(DEBUG) << "Write " << num_rows << " rows to index file " << file_path;
+  return SUCCESS;
+}
+
+ShardIndexFile::~ShardIndexFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_) {
+    (void)munmap(const_cast<char *>(data_), size_);
+  }
+#endif
+}
+
+std::pair<MSRStatus, std::shared_ptr<ShardIndexFile>> ShardIndexFile::Open(const std::string &file_path) {
+  std::shared_ptr<ShardIndexFile> index(new ShardIndexFile());
+  index->file_path_ = file_path;
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return {FAILED, nullptr};
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    (void)close(fd);
+    return {FAILED, nullptr};
+  }
+  void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map index file: " << file_path;
+    return {FAILED, nullptr};
+  }
+  index->data_ = static_cast<const char *>(data);
+  index->size_ = static_cast<uint64_t>(st.st_size);
+  index->mapped_ = true;
+#else
+  std::ifstream in(file_path, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in.good()) {
+    return {FAILED, nullptr};
+  }
+  index->buffer_.resize(static_cast<size_t>(in.tellg()));
+  (void)in.seekg(0, std::ios::beg);
+  if (!in.read(index->buffer_.data(), index->buffer_.size())) {
+    MS_LOG(ERROR) << "Failed to read index file: " << file_path;
+    return {FAILED, nullptr};
+  }
+  index->data_ = index->buffer_.data();
+  index->size_ = index->buffer_.size();
+#endif
+  if (index->Parse() != SUCCESS) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path;
+    return {FAILED, nullptr};
+  }
+  return {SUCCESS, index};
+}
+
+MSRStatus ShardIndexFile::Parse() {
+  IndexFileCursor cursor(data_, size_);
+  const char *magic = cursor.Take(kAlignment);
+  uint64_t byte_order = 0;
+  uint64_t num_fields = 0;
+  if (magic == nullptr || std::memcmp(magic, kIndexFileMagic, kAlignment) != 0 || !cursor.ReadU64(&byte_order) ||
+      byte_order != kByteOrderMark || !cursor.ReadU64(&num_rows_) || !cursor.ReadU64(&num_fields) ||
+      !cursor.ReadString(&shard_name_)) {
+    return FAILED;
+  }
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    FieldView field{};
+    uint64_t numeric = 0;
+    if (!cursor.ReadString(&field.name) || !cursor.ReadU64(&numeric)) {
+      return FAILED;
+    }
+    field.numeric = numeric != 0;
+    fields_.push_back(field);
+  }
+  if (num_rows_ > cursor.Remaining() / sizeof(uint64_t) / (kNumFixedColumns + 1)) {
+    return FAILED;
+  }
+  fixed_ = cursor.TakeU64Array(kNumFixedColumns * num_rows_);
+  page_order_ = cursor.TakeU64Array(num_rows_);
+  if (fixed_ == nullptr || page_order_ == nullptr) {
+    return FAILED;
+  }
+  for (auto &field : fields_) {
+    field.offsets = cursor.TakeU64Array(num_rows_ + 1);
+    field.value_order = cursor.TakeU64Array(num_rows_);
+    if (field.offsets == nullptr || field.value_order == nullptr) {
+      return FAILED;
+    }
+    field.values_size = field.offsets[num_rows_];
+    field.values = cursor.Take(field.values_size);
+    if (field.values == nullptr) {
+      return FAILED;
+    }
+  }
+  return cursor.Remaining() == 0 ? SUCCESS : FAILED;
+}
+
+int ShardIndexFile::GetColumnId(const std::string &column) const {
+  for (int i = 0; i < kNumFixedColumns; ++i) {
+    if (kIndexFileFixedColumns[i] == column) {
+      return i;
+    }
+  }
+  for (int i = 0; i < static_cast<int>(fields_.size()); ++i) {
+    if (fields_[i].name == column) {
+      return kNumFixedColumns + i;
+    }
+  }
+  return -1;
+}
+
+std::pair<MSRStatus, std::string> ShardIndexFile::GetValue(int column_id, uint64_t row) const {
+  if (column_id < kNumFixedColumns) {
+    return {SUCCESS, std::to_string(fixed_[column_id * num_rows_ + row])};
+  }
+  const FieldView &field = fields_[column_id - kNumFixedColumns];
+  uint64_t start = field.offsets[row];
+  uint64_t end = field.offsets[row + 1];
+  if (start > end || end > field.values_size) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path_;
+    return {FAILED, ""};
+  }
+  return {SUCCESS, std::string(field.values + start, end - start)};
+}
+
+std::pair<MSRStatus, std::vector<uint64_t>> ShardIndexFile::GetPageRows(int64_t page_id) const {
+  std::vector<uint64_t> rows;
+  if (page_id < 0) {
+    rows.resize(num_rows_);
+    std::iota(rows.begin(), rows.end(), 0);
+    return {SUCCESS, std::move(rows)};
+  }
+  const uint64_t *page_ids = fixed_ + kPageIdBlobColumn * num_rows_;
+  bool valid = true;
+  auto page_of = [this, page_ids, &valid](uint64_t i) {
+    uint64_t row = page_order_[i];
+    if (row >= num_rows_) {
+      valid = false;
+      return uint64_t(0);
+    }
+    return page_ids[row];
+  };
+  // Lower bound of the page in page_order_
+  uint64_t low = 0;
+  uint64_t high = num_rows_;
+  while (low < high) {
+    uint64_t mid = low + (high - low) / 2;
+    if (page_of(mid) < static_cast<uint64_t>(page_id)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  for (uint64_t i = low; i < num_rows_ && page_of(i) == static_cast<uint64_t>(page_id); ++i) {
+    rows.push_back(page_order_[i]);
+  }
+  if (!valid) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path_;
+    return {FAILED, {}};
+  }
+  return {SUCCESS, std::move(rows)};
+}
+
+std::pair<MSRStatus, bool> ShardIndexFile::Match(const FieldView &field, uint64_t row,
+                                                 const std::string &criteria) const {
+  uint64_t start = field.offsets[row];
+  uint64_t end = field.offsets[row + 1];
+  if (start > end || end > field.values_size) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path_;
+    return {FAILED, false};
+  }
+  if (!field.numeric) {
+    return {SUCCESS, criteria.size() == end - start && std::memcmp(criteria.data(), field.values + start,
+                                                                   end - start) == 0};
+  }
+  // Numeric columns compare as numbers, a criteria which is not a number matches nothing
+  double expected = 0;
+  double value = 0;
+  if (!ParseNumber(criteria.data(), criteria.data() + criteria.size(), &expected) ||
+      !ParseNumber(field.values + start, field.values + end, &value)) {
+    return {SUCCESS, false};
+  }
+  return {SUCCESS, value == expected};
+}
+
+std::pair<MSRStatus, std::vector<std::vector<std::string>>> ShardIndexFile::Select(
+  const std::vector<std::string> &columns, int64_t page_id, const std::pair<std::string, std::string> &criteria) const {
+  std::vector<int> column_ids;
+  for (const auto &column : columns) {
+    int id = GetColumnId(column);
+    if (id < 0) {
+      MS_LOG(ERROR) << "Column " << column << " is not found in index file: " << file_path_;
+      return {FAILED, {}};
+    }
+    column_ids.push_back(id);
+  }
+  const FieldView *criteria_field = nullptr;
+  if (!criteria.first.empty()) {
+    int id = GetColumnId(criteria.first);
+    if (id < kNumFixedColumns) {
+      MS_LOG(ERROR) << "Index field " << criteria.first << " is not found in index file: " << file_path_;
+      return {FAILED, {}};
+    }
+    criteria_field = &fields_[id - kNumFixedColumns];
+  }
+
+  auto rows = GetPageRows(page_id);
+  if (rows.first != SUCCESS) {
+    return {FAILED, {}};
+  }
+  std::vector<std::vector<std::string>> result;
+  result.reserve(rows.second.size());
+  for (uint64_t row : rows.second) {
+    if (criteria_field != nullptr) {
+      auto match = Match(*criteria_field, row, criteria.second);
+      if (match.first != SUCCESS) {
+        return {FAILED, {}};
+      }
+      if (!match.second) {
+        continue;
+      }
+    }
+    std::vector<std::string> values;
+    values.reserve(column_ids.size());
+    for (int id : column_ids) {
+      auto value = GetValue(id, row);
+      if (value.first != SUCCESS) {
+        return {FAILED, {}};
+      }
+      values.push_back(std::move(value.second));
+    }
+    result.push_back(std::move(values));
+  }
+  return {SUCCESS, std::move(result)};
+}
+
+std::pair<MSRStatus, std::vector<std::string>> ShardIndexFile::Distinct(const std::string &field) const {
+  int id = GetColumnId(field);
+  if (id < kNumFixedColumns) {
+    MS_LOG(ERROR) << "Index field " << field << " is not found in index file: " << file_path_;
+    return {FAILED, {}};
+  }
+  const FieldView &view = fields_[id - kNumFixedColumns];
+  // Equal values are adjacent in value order
+  std::vector<std::string> result;
+  for (uint64_t i = 0; i < num_rows_; ++i) {
+    uint64_t row = view.value_order[i];
+    if (row >= num_rows_) {
+      MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path_;
+      return {FAILED, {}};
+    }
+    auto value = GetValue(id, row);
+    if (value.first != SUCCESS) {
+      return {FAILED, {}};
+    }
+    if (result.empty() || result.back() != value.second) {
+      result.push_back(std::move(value.second));
+    }
+  }
+  return {SUCCESS, std::move(result)};
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -56,6 +56,9 @@ MSRStatus ShardIndexGenerator::Build() {
     return FAILED;
   }
   shard_header_ = header;
+  for (const auto &schema : shard_header_.GetSchemas()) {
+    row_codecs_.push_back(std::make_shared<ShardRowCodec>(schema->GetSchema()["schema"]));
+  }
   MS_LOG(INFO) << "Init header from mindrecord file for index successfully.";
   return SUCCESS;
 }
@@ -276,16 +279,24 @@ std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(co
   std::vector<json> schema_details;
   if (schema_count_ <= kMaxSchemaCount) {
     for (int sc = 0; sc < schema_count_; ++sc) {
-      std::vector<char> schema_detail(schema_lens[sc]);
+      std::vector<uint8_t> schema_detail(schema_lens[sc]);
 
-      auto &io_read = in.read(&schema_detail[0], schema_lens[sc]);
+      auto &io_read = in.read(reinterpret_cast<char *>(&schema_detail[0]), schema_lens[sc]);
       if (!io_read.good() || io_read.fail() || io_read.bad()) {
         MS_LOG(ERROR) << "File read failed";
         in.close();
         return {FAILED, {}};
       }
 
-      schema_details.emplace_back(json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end())));
+      if (sc >= static_cast<int>(row_codecs_.size())) {
+        MS_LOG(ERROR) << "Schema " << sc << " is not found in the header.";
+        return {FAILED, {}};
+      }
+      auto ret = row_codecs_[sc]->Decode(schema_detail);
+      if (ret.first != SUCCESS) {
+        return {FAILED, {}};
+      }
+      schema_details.emplace_back(std::move(ret.second));
     }
   }
 
@@ -516,6 +527,23 @@ INDEX_FIELDS ShardIndexGenerator::GenerateIndexFields(const std::vector<json> &s
   return {SUCCESS, std::move(fields)};
 }
 
+std::pair<MSRStatus, std::vector<std::pair<std::string, bool>>> ShardIndexGenerator::GenerateIndexFileFields() {
+  std::vector<std::pair<std::string, bool>> index_fields;
+  for (const auto &field : fields_) {
+    auto result = shard_header_.GetSchemaByID(field.first);
+    if (result.second != SUCCESS) {
+      return {FAILED, {}};
+    }
+    std::string field_type = ConvertJsonToSQL(TakeFieldType(field.second, result.first->GetSchema()["schema"]));
+    auto ret = GenerateFieldName(field);
+    if (ret.first != SUCCESS) {
+      return {FAILED, {}};
+    }
+    index_fields.emplace_back(ret.second, field_type == "INTEGER" || field_type == "NUMERIC");
+  }
+  return {SUCCESS, std::move(index_fields)};
+}
+
 MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair<MSRStatus, sqlite3 *> &db,
                                                   const std::vector<int> &raw_page_ids,
                                                   const std::map<int, int> &blob_id_to_page_id) {
@@ -532,6 +560,13 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     MS_LOG(ERROR) << "Invalid file, failed to open file: " << shard_address;
     return FAILED;
   }
+  // The binary index holds the same rows as the database, sqlite stays the fallback of readers
+  auto index_fields = GenerateIndexFileFields();
+  if (index_fields.first != SUCCESS) {
+    MS_LOG(ERROR) << "Generate index file fields failed";
+    return FAILED;
+  }
+  ShardIndexFileWriter index_file(GetFileName(shard_address).second, index_fields.second);
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     auto sql = GenerateRawSQL(fields_);
@@ -549,10 +584,21 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
       return FAILED;
     }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
+    for (const auto &row : data.second) {
+      if (index_file.AddRow(row) != SUCCESS) {
+        MS_LOG(ERROR) << "Add row to index file failed";
+        return FAILED;
+      }
+    }
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
 
+  if (index_file.Commit(shard_address + kIndexFileSuffix) != SUCCESS) {
+    MS_LOG(ERROR) << "Write index file failed";
+    return FAILED;
+  }
+
   // Close database
   if (sqlite3_close(db.second) != SQLITE_OK) {
     MS_LOG(ERROR) << "Close database failed";
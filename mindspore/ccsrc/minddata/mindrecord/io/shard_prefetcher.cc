@@ -0,0 +1,262 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_prefetcher.h"
+
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/prctl.h>
+#endif
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <numeric>
+#include "utils/log_adapter.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+const char kPrefetchThreadName[] = "THRD_PREFETCH_";
+
+ShardPrefetcher::ShardPrefetcher(const std::vector<std::string> &file_paths, int num_threads)
+    : file_paths_(file_paths), num_threads_(std::max(num_threads, 1)), pending_bytes_(0), stop_(false) {}
+
+ShardPrefetcher::~ShardPrefetcher() { Close(); }
+
+MSRStatus ShardPrefetcher::Open() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (const auto &file : file_paths_) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
+      Close();
+      return FAILED;
+    }
+    fds_.push_back(fd);
+  }
+#endif
+  for (int i = 0; i < num_threads_; ++i) {
+    threads_.emplace_back(&ShardPrefetcher::IoWorker, this, i);
+  }
+  MS_LOG(INFO) << "Launch " << num_threads_ << " prefetch threads for " << file_paths_.size() << " shard files.";
+  return SUCCESS;
+}
+
+void ShardPrefetcher::Close() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_queue_.notify_all();
+  cv_done_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (int fd : fds_) {
+    (void)close(fd);
+  }
+#endif
+  fds_.clear();
+}
+
+void ShardPrefetcher::Schedule(const std::vector<BlobRequest> &requests) {
+  if (requests.empty()) {
+    return;
+  }
+  // Merge the blobs close to each other in a file, by walking them in file order
+  std::vector<size_t> file_order(requests.size());
+  std::iota(file_order.begin(), file_order.end(), 0);
+  std::sort(file_order.begin(), file_order.end(), [&requests](size_t a, size_t b) {
+    return requests[a].shard_id < requests[b].shard_id ||
+           (requests[a].shard_id == requests[b].shard_id && requests[a].offset < requests[b].offset);
+  });
+  std::vector<std::shared_ptr<Extent>> blob_extents(requests.size());
+  std::vector<std::pair<size_t, std::shared_ptr<Extent>>> extents;  // first blob in consumption order, extent
+  for (size_t i : file_order) {
+    const auto &request = requests[i];
+    uint64_t end = request.offset + request.length;
+    if (!extents.empty()) {
+      auto &last = extents.back();
+      auto &extent = last.second;
+      uint64_t extent_end = std::max(end, extent->offset + extent->length);
+      if (extent->shard_id == request.shard_id && request.offset <= extent->offset + extent->length + kMaxReadGap &&
+          extent_end - extent->offset <= kMaxReadSize) {
+        extent->length = extent_end - extent->offset;
+        extent->pending++;
+        last.first = std::min(last.first, i);
+        blob_extents[i] = extent;
+        continue;
+      }
+    }
+    auto extent = std::make_shared<Extent>(Extent{request.shard_id, request.offset, request.length, nullptr, false,
+                                                  false, 1});
+    extents.emplace_back(i, extent);
+    blob_extents[i] = extent;
+  }
+  // Read the extents in the order they are consumed
+  std::sort(extents.begin(), extents.end(),
+            [](const std::pair<size_t, std::shared_ptr<Extent>> &a, const std::pair<size_t, std::shared_ptr<Extent>> &b) {
+              return a.first < b.first;
+            });
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (stop_) {
+      return;
+    }
+    for (size_t i = 0; i < requests.size(); ++i) {
+      auto iter = blobs_.find(requests[i].key);
+      if (iter != blobs_.end()) {
+        Release(iter->second.extent);
+      }
+      blobs_[requests[i].key] = BlobLocation{requests[i], blob_extents[i]};
+    }
+    for (auto &extent : extents) {
+      pending_bytes_ += extent.second->length;
+      queue_.push_back(std::move(extent.second));
+    }
+  }
+  cv_queue_.notify_all();
+}
+
+std::pair<MSRStatus, BlobView> ShardPrefetcher::Get(const BlobRequest &request) {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (stop_) {
+      return {FAILED, BlobView()};
+    }
+    auto iter = blobs_.find(request.key);
+    if (iter != blobs_.end()) {
+      BlobLocation location = iter->second;
+      blobs_.erase(iter);
+      Release(location.extent);
+      const auto &scheduled = location.request;
+      // A blob scheduled with other content is read again
+      if (scheduled.shard_id == request.shard_id && scheduled.offset == request.offset &&
+          scheduled.length == request.length) {
+        auto extent = location.extent;
+        cv_done_.wait(lck, [this, &extent] { return stop_ || extent->done; });
+        if (extent->done && !extent->failed) {
+          return {SUCCESS, BlobView(extent->buffer, request.offset - extent->offset, request.length)};
+        }
+        if (stop_) {
+          return {FAILED, BlobView()};
+        }
+      }
+    }
+  }
+  auto buffer = std::make_shared<std::vector<uint8_t>>(request.length);
+  if (ReadAt(request.shard_id, request.offset, request.length, buffer->data()) != SUCCESS) {
+    return {FAILED, BlobView()};
+  }
+  return {SUCCESS, BlobView(buffer, 0, request.length)};
+}
+
+void ShardPrefetcher::Reset() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    // Consumers waiting for a dropped extent read their blob themselves
+    for (auto &extent : queue_) {
+      extent->done = true;
+      extent->failed = true;
+    }
+    queue_.clear();
+    blobs_.clear();
+    pending_bytes_ = 0;
+  }
+  cv_done_.notify_all();
+}
+
+uint64_t ShardPrefetcher::GetPendingBytes() {
+  std::lock_guard<std::mutex> lck(mtx_);
+  return pending_bytes_;
+}
+
+void ShardPrefetcher::Release(const std::shared_ptr<Extent> &extent) {
+  if (--extent->pending == 0) {
+    pending_bytes_ -= std::min(pending_bytes_, extent->length);
+  }
+}
+
+void ShardPrefetcher::IoWorker(int thread_id) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto thread_name = kPrefetchThreadName + std::to_string(thread_id);
+  prctl(PR_SET_NAME, thread_name.c_str(), 0, 0, 0);
+#endif
+  for (;;) {
+    std::shared_ptr<Extent> extent;
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_queue_.wait(lck, [this] { return stop_ || !queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+      extent = queue_.front();
+      queue_.pop_front();
+    }
+    auto buffer = std::make_shared<std::vector<uint8_t>>(extent->length);
+    MSRStatus rc = ReadAt(extent->shard_id, extent->offset, extent->length, buffer->data());
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      extent->buffer = std::move(buffer);
+      extent->failed = rc != SUCCESS;
+      extent->done = true;
+    }
+    cv_done_.notify_all();
+  }
+}
+
+MSRStatus ShardPrefetcher::ReadAt(int shard_id, uint64_t offset, uint64_t length, uint8_t *dest) {
+  if (shard_id < 0 || shard_id >= static_cast<int>(file_paths_.size())) {
+    MS_LOG(ERROR) << "Invalid shard id: " << shard_id;
+    return FAILED;
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (shard_id >= static_cast<int>(fds_.size())) {
+    MS_LOG(ERROR) << "File is not opened: " << file_paths_[shard_id];
+    return FAILED;
+  }
+  uint64_t done = 0;
+  while (done < length) {
+    ssize_t n = pread(fds_[shard_id], dest + done, length - done, offset + done);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      MS_LOG(ERROR) << "File read failed: " << file_paths_[shard_id] << ", offset: " << offset + done;
+      return FAILED;
+    }
+    done += static_cast<uint64_t>(n);
+  }
+#else
+  std::ifstream in(file_paths_[shard_id], std::ios::in | std::ios::binary);
+  if (!in.good() || !in.seekg(offset, std::ios::beg) || !in.read(reinterpret_cast<char *>(dest), length)) {
+    MS_LOG(ERROR) << "File read failed: " << file_paths_[shard_id] << ", offset: " << offset;
+    return FAILED;
+  }
+#endif
+  return SUCCESS;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
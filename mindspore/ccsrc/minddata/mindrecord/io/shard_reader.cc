@@ -97,6 +97,16 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
       MS_LOG(ERROR) << "Mindrecord files meta information is different.";
       return FAILED;
     }
+    if (use_index_file_) {
+      auto index_file = ShardIndexFile::Open(file + kIndexFileSuffix);
+      if (index_file.first == SUCCESS && index_file.second->GetShardName() == GetFileName(file).second) {
+        MS_LOG(DEBUG) << "Opened index file successfully";
+        index_files_.push_back(index_file.second);
+        database_paths_.push_back(nullptr);
+        continue;
+      }
+      MS_LOG(DEBUG) << "Index file of " << file << " is not available, use database instead.";
+    }
     sqlite3 *db = nullptr;
     // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
     int rc = sqlite3_open_v2(common::SafeCStr(file + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
@@ -128,6 +138,7 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
       }
     }
     database_paths_.push_back(db);
+    index_files_.push_back(nullptr);
   }
   ShardHeader sh = ShardHeader();
   if (sh.BuildDataset(file_paths_, load_dataset) == FAILED) {
@@ -142,6 +153,7 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
   } else {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
   }
+  row_codec_ = std::make_shared<ShardRowCodec>(shard_header_->GetSchemas()[0]->GetSchema()["schema"]);
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
   for (const auto &rg : row_group_summary) {
@@ -208,6 +220,12 @@ MSRStatus ShardReader::Open(int n_consumer) {
     MS_LOG(INFO) << "Open shard file successfully.";
   }
 
+  prefetcher_ = std::make_shared<ShardPrefetcher>(file_paths_, std::min(n_consumer, kNumPrefetchThreads));
+  if (prefetcher_->Open() != SUCCESS) {
+    MS_LOG(WARNING) << "Failed to open prefetcher, read blobs without prefetch.";
+    prefetcher_ = nullptr;
+  }
+  prefetch_task_id_ = 0;
   return SUCCESS;
 }
 
@@ -250,6 +268,9 @@ void ShardReader::Close() {
       i_thread.join();
     }
   }
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Close();
+  }
 
   FileStreamsOperator();
 }
@@ -301,6 +322,7 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
                                           const std::vector<std::string> &columns,
                                           std::vector<std::vector<json>> &column_values) {
+  auto field_ids = row_codec_->GetFieldIds(columns);
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     uint64_t group_id = std::stoull(labels[i][0]);
     uint64_t offset_start = std::stoull(labels[i][1]) + kInt64Len;
@@ -326,18 +348,12 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
         fs->close();
         return FAILED;
       }
-      json label_json = json::from_msgpack(label_raw);
-      json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
+      auto label_json = row_codec_->Decode(label_raw, columns, field_ids);
+      if (label_json.first != SUCCESS) {
+        fs->close();
+        return FAILED;
       }
-      column_values[shard_id].emplace_back(tmp);
+      column_values[shard_id].emplace_back(std::move(label_json.second));
     } else {
       json construct_json;
       for (unsigned int j = 0; j < columns.size(); ++j) {
@@ -364,19 +380,30 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
   return SUCCESS;
 }
 
-MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
+MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
+                                          const std::vector<std::string> &index_columns,
+                                          const std::vector<std::string> &columns,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                           std::vector<std::vector<json>> &column_values) {
-  auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
-  char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
-  if (rc != SQLITE_OK) {
-    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+  if (index_files_[shard_id] != nullptr) {
+    auto ret = SelectFromIndexFile(shard_id, index_columns, -1, {"", ""});
+    if (ret.first != SUCCESS) {
+      return FAILED;
+    }
+    labels = std::move(ret.second);
+  } else {
+    auto db = database_paths_[shard_id];
+    char *errmsg = nullptr;
+    int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+    if (rc != SQLITE_OK) {
+      MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+      sqlite3_free(errmsg);
+      sqlite3_close(db);
+      db = nullptr;
+      return FAILED;
+    }
     sqlite3_free(errmsg);
-    sqlite3_close(db);
-    db = nullptr;
-    return FAILED;
   }
   MS_LOG(INFO) << "Get " << static_cast<int>(labels.size()) << " records from shard " << shard_id << " index.";
 
@@ -389,7 +416,6 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
       return FAILED;
     }
   }
-  sqlite3_free(errmsg);
   return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
 }
 
@@ -409,7 +435,12 @@ MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set
   std::string sql = "SELECT DISTINCT " + ret.second + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
+    if (index_files_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInIndexFile, this, x, ret.second, std::ref(categories));
+    } else {
+      threads[x] =
+        std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -440,8 +471,20 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
   }
 }
 
+void ShardReader::GetClassesInIndexFile(int shard_id, const std::string &field, std::set<std::string> &categories) {
+  auto ret = index_files_[shard_id]->Distinct(field);
+  if (ret.first != SUCCESS) {
+    MS_LOG(ERROR) << "Failed to get classes of field " << field << " from shard " << shard_id << " index file.";
+    return;
+  }
+  MS_LOG(INFO) << "Get " << static_cast<int>(ret.second.size()) << " records from shard " << shard_id << " index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  categories.insert(ret.second.begin(), ret.second.end());
+}
+
 ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
+  std::vector<std::string> index_columns = {"ROW_GROUP_ID", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
   std::vector<std::vector<std::vector<uint64_t>>> offsets(shard_count_, std::vector<std::vector<uint64_t>>{});
   std::vector<std::vector<json>> column_values(shard_count_, std::vector<json>{});
   if (all_in_index_) {
@@ -452,17 +495,19 @@ ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
         return std::make_tuple(FAILED, std::move(offsets), std::move(column_values));
       }
       fields += ret.second;
+      index_columns.push_back(ret.second);
     }
   } else {  // fetch raw data from Raw page while some field is not index.
     fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
+    index_columns.insert(index_columns.end(), {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"});
   }
 
   std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] =
-      std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, std::ref(offsets), std::ref(column_values));
+    thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, index_columns, columns,
+                                    std::ref(offsets), std::ref(column_values));
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -528,36 +573,44 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
-  auto db = database_paths_[shard_id];
-
-  std::string sql =
-    "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
+  std::vector<std::vector<std::string>> image_offsets;
+  if (index_files_[shard_id] != nullptr) {
+    auto ret = SelectFromIndexFile(shard_id, {"PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"}, page_id, criteria);
+    if (ret.first != SUCCESS) {
+      return std::vector<std::vector<uint64_t>>();
+    }
+    image_offsets = std::move(ret.second);
+  } else {
+    auto db = database_paths_[shard_id];
+    std::string sql =
+      "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
 
-  // whether use index search
-  if (!criteria.first.empty()) {
-    auto schema = shard_header_->GetSchemas()[0]->GetSchema();
+    // whether use index search
+    if (!criteria.first.empty()) {
+      auto schema = shard_header_->GetSchemas()[0]->GetSchema();
 
-    // not number field should add '' in sql
-    if (kNumberFieldTypeSet.find(schema["schema"][criteria.first]["type"]) != kNumberFieldTypeSet.end()) {
-      sql +=
-        " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + criteria.second;
+      // not number field should add '' in sql
+      if (kNumberFieldTypeSet.find(schema["schema"][criteria.first]["type"]) != kNumberFieldTypeSet.end()) {
+        sql +=
+          " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + criteria.second;
+      } else {
+        sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = '" +
+               criteria.second + "'";
+      }
+    }
+    sql += ";";
+    char *errmsg = nullptr;
+    int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &image_offsets, &errmsg);
+    if (rc != SQLITE_OK) {
+      MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+      sqlite3_free(errmsg);
+      sqlite3_close(db);
+      db = nullptr;
+      return std::vector<std::vector<uint64_t>>();
     } else {
-      sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = '" +
-             criteria.second + "'";
+      MS_LOG(DEBUG) << "Get " << static_cast<int>(image_offsets.size()) << "records from index.";
     }
-  }
-  sql += ";";
-  std::vector<std::vector<std::string>> image_offsets;
-  char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &image_offsets, &errmsg);
-  if (rc != SQLITE_OK) {
-    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
     sqlite3_free(errmsg);
-    sqlite3_close(db);
-    db = nullptr;
-    return std::vector<std::vector<uint64_t>>();
-  } else {
-    MS_LOG(DEBUG) << "Get " << static_cast<int>(image_offsets.size()) << "records from index.";
   }
   std::vector<std::vector<uint64_t>> res;
   for (int i = static_cast<int>(image_offsets.size()) - 1; i >= 0; i--) res.emplace_back(std::vector<uint64_t>{0, 0});
@@ -566,7 +619,6 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
     res[i][0] = std::stoull(image_offset[0]) + kInt64Len;
     res[i][1] = std::stoull(image_offset[1]);
   }
-  sqlite3_free(errmsg);
   return res;
 }
 
@@ -598,6 +650,31 @@ void ShardReader::CheckIfColumnInIndex(const std::vector<std::string> &columns)
   }
 }
 
+std::pair<MSRStatus, std::vector<std::vector<std::string>>> ShardReader::SelectFromIndexFile(
+  int shard_id, const std::vector<std::string> &index_columns, int page_id,
+  const std::pair<std::string, std::string> &criteria) {
+  std::pair<std::string, std::string> index_criteria = {"", criteria.second};
+  if (!criteria.first.empty()) {
+    for (auto &field : shard_header_->GetFields()) {
+      if (field.second == criteria.first) {
+        index_criteria.first = criteria.first + "_" + std::to_string(field.first);
+        break;
+      }
+    }
+    if (index_criteria.first.empty()) {
+      MS_LOG(ERROR) << "Index field " << criteria.first << " does not exist.";
+      return {FAILED, {}};
+    }
+  }
+  auto ret = index_files_[shard_id]->Select(index_columns, page_id, index_criteria);
+  if (ret.first != SUCCESS) {
+    MS_LOG(ERROR) << "Failed to select from shard " << shard_id << " index file.";
+    return {FAILED, {}};
+  }
+  MS_LOG(DEBUG) << "Get " << static_cast<int>(ret.second.size()) << " records from shard " << shard_id << " index.";
+  return ret;
+}
+
 MSRStatus ShardReader::QueryWithCriteria(sqlite3 *db, string &sql, string criteria,
                                          std::vector<std::vector<std::string>> &labels) {
   sqlite3_stmt *stmt = nullptr;
@@ -661,14 +738,12 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
       return {FAILED, {}};
     }
 
-    json label_json = json::from_msgpack(label_raw);
-    json tmp = label_json;
-    for (auto &col : columns) {
-      if (label_json.find(col) != label_json.end()) {
-        tmp[col] = label_json[col];
-      }
+    auto label_json = row_codec_->Decode(label_raw);
+    if (label_json.first != SUCCESS) {
+      fs->close();
+      return {FAILED, {}};
     }
-    res[i] = tmp;
+    res[i] = std::move(label_json.second);
   }
   return {SUCCESS, res};
 }
@@ -676,11 +751,19 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
 std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
   int page_id, int shard_id, const std::vector<std::string> &columns,
   const std::pair<std::string, std::string> &criteria) {
+  std::vector<std::vector<std::string>> label_offsets;
+  if (index_files_[shard_id] != nullptr) {
+    auto ret =
+      SelectFromIndexFile(shard_id, {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"}, page_id, criteria);
+    if (ret.first != SUCCESS) {
+      return {FAILED, {}};
+    }
+    return GetLabelsFromBinaryFile(shard_id, columns, ret.second);
+  }
   // get page info from sqlite
   auto db = database_paths_[shard_id];
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
-  std::vector<std::vector<std::string>> label_offsets;
   if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
     if (QueryWithCriteria(db, sql, criteria.second, label_offsets) == FAILED) {
@@ -710,15 +793,23 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
   if (all_in_index_) {
     auto db = database_paths_[shard_id];
     std::string fields;
+    std::vector<std::string> index_columns;
     for (unsigned int i = 0; i < columns.size(); ++i) {
       if (i > 0) fields += ',';
       uint64_t schema_id = column_schema_id_[columns[i]];
       fields += columns[i] + "_" + std::to_string(schema_id);
+      index_columns.push_back(columns[i] + "_" + std::to_string(schema_id));
     }
     if (fields.empty()) fields = "*";
     std::vector<std::vector<std::string>> labels;
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
-    if (!criteria.first.empty()) {
+    if (index_files_[shard_id] != nullptr) {
+      auto ret = SelectFromIndexFile(shard_id, index_columns, page_id, criteria);
+      if (ret.first != SUCCESS) {
+        return {FAILED, {}};
+      }
+      labels = std::move(ret.second);
+    } else if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
       if (QueryWithCriteria(db, sql, criteria.second, labels) == FAILED) {
         return {FAILED, {}};
@@ -792,6 +883,10 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
   std::set<std::string> categories;
   for (int x = 0; x < shard_count; x++) {
+    if (x < index_files_.size() && index_files_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInIndexFile, this, x, ret.second, std::ref(categories));
+      continue;
+    }
     sqlite3 *db = nullptr;
     int rc = sqlite3_open_v2(common::SafeCStr(file_paths_[x] + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
     if (SQLITE_OK != rc) {
@@ -1110,35 +1205,43 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
                           std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
 
-  auto shard_id = std::get<0>(std::get<1>(task));
-  auto group_id = std::get<1>(std::get<1>(task));
-  auto addr = std::get<2>(task);
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
-  if (SUCCESS != ret.first) {
+  auto request = GetBlobRequest(task_id);
+  if (SUCCESS != request.first) {
     return std::make_pair(FAILED,
                           std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
-  const std::shared_ptr<Page> &page = ret.second;
+  auto shard_id = request.second.shard_id;
+  auto file_offset = request.second.offset;
+  auto length = request.second.length;
 
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
+  std::vector<uint8_t> images;
+  if (prefetcher_ != nullptr) {
+    SchedulePrefetch(task_id);
+    auto blob = prefetcher_->Get(request.second);
+    if (SUCCESS != blob.first) {
+      MS_LOG(ERROR) << "Failed to read blob of task " << task_id << " from shard " << shard_id;
+      return std::make_pair(FAILED,
+                            std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
+    images.assign(blob.second.data(), blob.second.data() + blob.second.size());
+  } else {
+    images.resize(length);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED,
+                            std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), length);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED,
+                            std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
   }
 
   // Deliver batch data to output map
@@ -1148,6 +1251,51 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
 }
 
+std::pair<MSRStatus, BlobRequest> ShardReader::GetBlobRequest(int task_id) {
+  const auto &task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return {FAILED, BlobRequest{}};
+  }
+  auto shard_id = std::get<0>(std::get<1>(task));
+  auto group_id = std::get<1>(std::get<1>(task));
+  const auto &addr = std::get<2>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return {FAILED, BlobRequest{}};
+  }
+  uint64_t file_offset = header_size_ + page_size_ * (ret.second->GetPageID()) + addr[0];
+  return {SUCCESS, BlobRequest{task_id, shard_id, file_offset, addr[1] - addr[0]}};
+}
+
+void ShardReader::SchedulePrefetch(int task_id) {
+  std::lock_guard<std::mutex> lck(prefetch_locker_);
+  int num_tasks = static_cast<int>(tasks_.Size());
+  // Consumers jumped ahead, for example with a random access, restart the schedule from there
+  if (task_id >= prefetch_task_id_ + kPrefetchTasks) {
+    prefetch_task_id_ = task_id;
+  }
+  while (prefetch_task_id_ < num_tasks && prefetch_task_id_ <= task_id + kPrefetchTasks - kPrefetchBatch &&
+         prefetcher_->GetPendingBytes() < kPrefetchBytes) {
+    std::vector<BlobRequest> requests;
+    int end = std::min<int>(prefetch_task_id_ + kPrefetchBatch, num_tasks);
+    for (; prefetch_task_id_ < end; ++prefetch_task_id_) {
+      auto request = GetBlobRequest(prefetch_task_id_);
+      if (SUCCESS == request.first) {
+        requests.push_back(request.second);
+      }
+    }
+    prefetcher_->Schedule(requests);
+  }
+}
+
+void ShardReader::ResetPrefetch() {
+  std::lock_guard<std::mutex> lck(prefetch_locker_);
+  prefetch_task_id_ = 0;
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Reset();
+  }
+}
+
 MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
   // Set thread name
 #if !defined(_WIN32) && !defined(_WIN64)
@@ -1265,6 +1413,7 @@ void ShardReader::Reset() {
     deliver_id_ = 0;
   }
   cv_delivery_.notify_all();
+  ResetPrefetch();
 }
 
 void ShardReader::ShuffleTask() {
@@ -1287,6 +1436,7 @@ void ShardReader::ShuffleTask() {
     }
   }
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
+  ResetPrefetch();
 }
 
 }  // namespace mindrecord
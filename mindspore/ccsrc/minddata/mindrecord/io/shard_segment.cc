@@ -28,7 +28,11 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { SetAllInIndex(false); }
+ShardSegment::ShardSegment() {
+  SetAllInIndex(false);
+  // Segment queries run on the sqlite databases
+  SetUseIndexFile(false);
+}
 
 std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   // Skip if already populated
@@ -519,7 +519,8 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
 }
 
 void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                            std::vector<std::vector<uint8_t>> &bin_data) {
+                            std::vector<std::vector<uint8_t>> &bin_data,
+                            const std::map<uint64_t, std::shared_ptr<ShardRowCodec>> &row_codecs) {
   // Prevent excessive thread opening and cause cross-border
   if (start >= end) {
     flag_ = true;
@@ -530,8 +531,10 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
   for (int x = start; x < end; ++x) {
     int cnt = 0;
     for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
-      const json &line = raw_data.at(rawdata_iter->first)[x];
-      std::vector<std::uint8_t> bline = json::to_msgpack(line);
+      const json &line = rawdata_iter->second[x];
+      auto codec = row_codecs.find(rawdata_iter->first);
+      std::vector<std::uint8_t> bline =
+        codec == row_codecs.end() ? json::to_msgpack(line) : codec->second->Encode(line);
 
       // Storage form is [Sample1-Schema1, Sample1-Schema2, Sample2-Schema1, Sample2-Schema2]
       bin_data[x * schema_count + cnt] = bline;
@@ -702,7 +705,7 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
   std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
 
   // Serialize raw data
-  if (SerializeRawData(raw_data, bin_raw_data, row_count) == FAILED) {
+  if (SerializeRawData(raw_data, bin_raw_data, row_count, GetRowCodecs()) == FAILED) {
     MS_LOG(ERROR) << "Serialize raw data failed";
     return FAILED;
   }
@@ -1224,7 +1227,8 @@ MSRStatus ShardWriter::WriteShardHeader() {
 }
 
 MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count) {
+                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                                        const std::map<uint64_t, std::shared_ptr<ShardRowCodec>> &row_codecs) {
   // define the number of thread
   uint32_t thread_num = std::thread::hardware_concurrency();
   if (thread_num == 0) thread_num = kThreadNumber;
@@ -1240,7 +1244,8 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
     }
     // Define the run boundary and start the child thread
     thread_set[x] =
-      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data));
+      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data),
+                  std::cref(row_codecs));
     work_thread_num++;
   }
   for (uint32_t x = 0; x < work_thread_num; ++x) {
@@ -1250,6 +1255,18 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
+std::map<uint64_t, std::shared_ptr<ShardRowCodec>> ShardWriter::GetRowCodecs() {
+  std::map<uint64_t, std::shared_ptr<ShardRowCodec>> row_codecs;
+  // Data appended to files of msgpack rows stays msgpack
+  if (shard_header_->GetRawFormat() < kRawFormatTyped) {
+    return row_codecs;
+  }
+  for (const auto &schema : shard_header_->GetSchemas()) {
+    row_codecs[schema->GetSchemaID()] = std::make_shared<ShardRowCodec>(schema->GetSchema()["schema"]);
+  }
+  return row_codecs;
+}
+
 MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
   raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
   for (uint32_t i = 0; i < row_count_; ++i) {
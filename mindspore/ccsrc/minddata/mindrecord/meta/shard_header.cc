@@ -33,7 +33,8 @@ using mindspore::MsLogLevel::ERROR;
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0) {
+ShardHeader::ShardHeader()
+    : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0), raw_format_(kRawFormatTyped) {
   index_ = std::make_shared<Index>();
 }
 
@@ -57,6 +58,11 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers, bool l
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
       compression_size_ = header.contains("compression_size") ? header["compression_size"].get<uint64_t>() : 0;
+      raw_format_ = header.contains("raw_format") ? header["raw_format"].get<uint64_t>() : kRawFormatMsgpack;
+      if (raw_format_ > kRawFormatTyped) {
+        MS_LOG(ERROR) << "Raw data format " << raw_format_ << " is not supported, lib supports up to " << kRawFormatTyped;
+        return FAILED;
+      }
     }
     if (SUCCESS != ParsePage(header["page"], shard_index, load_dataset)) {
       return FAILED;
@@ -349,6 +355,7 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
       s += "\"index_fields\":" + index + ",";
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
+      s += "\"raw_format\":" + std::to_string(raw_format_) + ",";
       s += "\"compression_size\":" + std::to_string(compression_size_) + ",";
       s += "\"schema\":" + schema + ",";
       s += "\"shard_addresses\":" + address + ",";
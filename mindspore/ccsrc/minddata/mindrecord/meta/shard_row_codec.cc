@@ -0,0 +1,238 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_row_codec.h"
+
+#include <cstring>
+#include <limits>
+#include "utils/log_adapter.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+template <typename T>
+void Store(std::vector<uint8_t> *row, uint64_t offset, T value) {
+  (void)memcpy(row->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T Load(const std::vector<uint8_t> &row, uint64_t offset) {
+  T value;
+  (void)memcpy(&value, row.data() + offset, sizeof(T));
+  return value;
+}
+}  // namespace
+
+ShardRowCodec::ShardRowCodec(const json &schema) {
+  const std::map<std::string, FieldType> kFieldTypes = {{"int32", kInt32Field},
+                                                        {"int64", kInt64Field},
+                                                        {"float32", kFloat32Field},
+                                                        {"float64", kFloat64Field},
+                                                        {"string", kStringField}};
+  std::vector<std::pair<std::string, FieldType>> raw_fields;
+  for (auto it = schema.begin(); it != schema.end(); ++it) {
+    const json &value = it.value();
+    if (!value.is_object() || value.find("shape") != value.end() || value.find("type") == value.end()) {
+      continue;
+    }
+    auto type = kFieldTypes.find(value["type"].get<std::string>());
+    if (type != kFieldTypes.end()) {
+      raw_fields.emplace_back(it.key(), type->second);
+    }
+  }
+  bitmap_size_ = (raw_fields.size() + 7) / 8;
+  uint64_t offset = 1 + bitmap_size_;
+  for (const auto &field : raw_fields) {
+    field_ids_[field.first] = static_cast<int>(fields_.size());
+    fields_.push_back(Field{field.first, field.second, offset});
+    offset += field.second == kInt32Field ? sizeof(int32_t) : sizeof(uint64_t);
+  }
+  fixed_size_ = offset;
+}
+
+bool ShardRowCodec::Fits(const Field &field, const json &value) const {
+  switch (field.type) {
+    case kInt32Field:
+      if (value.is_number_unsigned()) {
+        return value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+      }
+      return value.is_number_integer() && value.get<int64_t>() >= std::numeric_limits<int32_t>::min() &&
+             value.get<int64_t>() <= std::numeric_limits<int32_t>::max();
+    case kInt64Field:
+      if (value.is_number_unsigned()) {
+        return value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+      }
+      return value.is_number_integer();
+    case kFloat32Field:
+    case kFloat64Field:
+      return value.is_number_float();
+    case kStringField:
+      return value.is_string() && value.get_ref<const std::string &>().size() <= std::numeric_limits<uint32_t>::max();
+  }
+  return false;
+}
+
+std::vector<uint8_t> ShardRowCodec::Encode(const json &row) const {
+  if (!row.is_object() || fields_.empty()) {
+    return json::to_msgpack(row);
+  }
+  uint64_t row_size = fixed_size_;
+  size_t num_present = 0;
+  for (const auto &field : fields_) {
+    auto it = row.find(field.name);
+    if (it == row.end()) {
+      continue;
+    }
+    if (!Fits(field, *it)) {
+      return json::to_msgpack(row);
+    }
+    if (field.type == kStringField) {
+      row_size += it->get_ref<const std::string &>().size();
+    }
+    num_present++;
+  }
+  // Fields out of the schema only have a place in msgpack
+  if (num_present != row.size() || row_size > std::numeric_limits<uint32_t>::max()) {
+    return json::to_msgpack(row);
+  }
+
+  std::vector<uint8_t> bin(row_size, 0);
+  bin[0] = kTypedRowMarker;
+  uint64_t string_offset = fixed_size_;
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const auto &field = fields_[i];
+    auto it = row.find(field.name);
+    if (it == row.end()) {
+      continue;
+    }
+    bin[1 + i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+    switch (field.type) {
+      case kInt32Field:
+        Store<int32_t>(&bin, field.offset, static_cast<int32_t>(it->get<int64_t>()));
+        break;
+      case kInt64Field:
+        Store<int64_t>(&bin, field.offset, it->get<int64_t>());
+        break;
+      case kFloat32Field:
+      case kFloat64Field:
+        Store<double>(&bin, field.offset, it->get<double>());
+        break;
+      case kStringField: {
+        const auto &value = it->get_ref<const std::string &>();
+        Store<uint32_t>(&bin, field.offset, static_cast<uint32_t>(string_offset));
+        Store<uint32_t>(&bin, field.offset + sizeof(uint32_t), static_cast<uint32_t>(value.size()));
+        (void)memcpy(bin.data() + string_offset, value.data(), value.size());
+        string_offset += value.size();
+        break;
+      }
+    }
+  }
+  return bin;
+}
+
+std::vector<int> ShardRowCodec::GetFieldIds(const std::vector<std::string> &columns) const {
+  std::vector<int> ids;
+  for (const auto &column : columns) {
+    auto it = field_ids_.find(column);
+    ids.push_back(it == field_ids_.end() ? -1 : it->second);
+  }
+  return ids;
+}
+
+MSRStatus ShardRowCodec::DecodeField(const std::vector<uint8_t> &row, const Field &field, json *value) const {
+  switch (field.type) {
+    case kInt32Field:
+      *value = Load<int32_t>(row, field.offset);
+      break;
+    case kInt64Field:
+      *value = Load<int64_t>(row, field.offset);
+      break;
+    case kFloat32Field:
+    case kFloat64Field:
+      *value = Load<double>(row, field.offset);
+      break;
+    case kStringField: {
+      uint64_t offset = Load<uint32_t>(row, field.offset);
+      uint64_t length = Load<uint32_t>(row, field.offset + sizeof(uint32_t));
+      if (offset < fixed_size_ || offset + length > row.size()) {
+        MS_LOG(ERROR) << "Invalid typed row, string field " << field.name << " is out of the row.";
+        return FAILED;
+      }
+      *value = std::string(reinterpret_cast<const char *>(row.data()) + offset, length);
+      break;
+    }
+  }
+  return SUCCESS;
+}
+
+std::pair<MSRStatus, json> ShardRowCodec::Decode(const std::vector<uint8_t> &row,
+                                                 const std::vector<std::string> &columns,
+                                                 const std::vector<int> &field_ids) const {
+  if (row.empty() || row[0] != kTypedRowMarker) {
+    json label_json;
+    try {
+      label_json = json::from_msgpack(row);
+    } catch (json::exception &e) {
+      MS_LOG(ERROR) << "Invalid raw data, msgpack decode error: " << e.what();
+      return {FAILED, json()};
+    }
+    if (columns.empty()) {
+      return {SUCCESS, std::move(label_json)};
+    }
+    json selected;
+    for (const auto &column : columns) {
+      auto it = label_json.find(column);
+      if (it != label_json.end()) {
+        selected[column] = *it;
+      }
+    }
+    return {SUCCESS, std::move(selected)};
+  }
+
+  if (row.size() < fixed_size_) {
+    MS_LOG(ERROR) << "Invalid typed row, size " << row.size() << " is less than " << fixed_size_;
+    return {FAILED, json()};
+  }
+  auto present = [&row](int id) { return (row[1 + id / 8] >> (id % 8)) & 1; };
+  if (columns.empty()) {
+    json label_json = json::object();
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      if (present(i) && DecodeField(row, fields_[i], &label_json[fields_[i].name]) != SUCCESS) {
+        return {FAILED, json()};
+      }
+    }
+    return {SUCCESS, std::move(label_json)};
+  }
+  if (field_ids.size() != columns.size()) {
+    MS_LOG(ERROR) << "Invalid field ids, size " << field_ids.size() << " does not match the columns.";
+    return {FAILED, json()};
+  }
+  json label_json;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    int id = field_ids[i];
+    if (id >= 0 && id < static_cast<int>(fields_.size()) && present(id) &&
+        DecodeField(row, fields_[id], &label_json[columns[i]]) != SUCCESS) {
+      return {FAILED, json()};
+    }
+  }
+  return {SUCCESS, std::move(label_json)};
+}
+}  // namespace mindrecord
+}  // namespace mindspore
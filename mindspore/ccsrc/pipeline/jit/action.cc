@@ -29,6 +29,7 @@
 #include "frontend/parallel/costmodel_context.h"
 #include "frontend/parallel/context.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/parse_base.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "abstract/abstract_value.h"
@@ -436,6 +437,45 @@ bool StartPSSchedulerAction(const ResourcePtr &res) {
 }
 #endif
 
+bool CompileCacheLoadAction(const ResourcePtr &res) {
+  if (res->func_graph() == nullptr || res->manager() == nullptr) {
+    MS_LOG(EXCEPTION) << "CompileCacheLoad error, graph or manager is null";
+  }
+  double start_time = GetTime();
+  CompileCache cache(MsContext::GetInstance()->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH));
+  std::string key = cache.GenerateKey(res->func_graph(), res->args_spec());
+  res->results()[kCompileCacheKey] = key;
+  res->results()[kCompileCacheStartTime] = start_time;
+  FuncGraphPtr func_graph = cache.Load(key, res->func_graph());
+  if (func_graph == nullptr) {
+    MS_LOG(INFO) << "Compile cache miss, key " << key << ", the graph will be compiled.";
+    return true;
+  }
+  // The loaded graph replaces the graphs of the analysis and optimization actions
+  res->manager()->AddFuncGraph(func_graph, true);
+  res->manager()->KeepRoots({func_graph});
+  res->set_func_graph(func_graph);
+  parse::Parser::UpdateTopFuncGraph(func_graph);
+  res->results()[kCompileCacheHit] = true;
+  MS_LOG(INFO) << "Compile cache hit, key " << key << ", loading the graph costs " << GetTime() - start_time << "s.";
+  return true;
+}
+
+bool CompileCacheStoreAction(const ResourcePtr &res) {
+  if (res->func_graph() == nullptr || res->results().count(kCompileCacheKey) == 0) {
+    MS_LOG(EXCEPTION) << "CompileCacheStore error, graph or key is null";
+  }
+  auto key = res->results()[kCompileCacheKey].cast<std::string>();
+  auto start_time = res->results()[kCompileCacheStartTime].cast<double>();
+  double compiled_time = GetTime();
+  CompileCache cache(MsContext::GetInstance()->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH));
+  bool stored = cache.Store(key, res->func_graph());
+  MS_LOG(INFO) << "Compile cache miss, key " << key << ", analyzing and optimizing the graph costs "
+               << compiled_time - start_time << "s, " << (stored ? "storing" : "the graph can not be cached, checking")
+               << " it costs " << GetTime() - compiled_time << "s.";
+  return true;
+}
+
 // The parallel primitive related valuenode might be partitioned so that its value changes by device,
 // that will result in a syncronization error due to different executing order.
 // Here we temporarily avoid the problem by skipping valuenode merging used by parallel related primitive,
@@ -42,6 +42,8 @@ bool ExecuteAction(const ResourcePtr &res);
 bool StartPSWorkerAction(const ResourcePtr &res);
 bool StartPSServerAction(const ResourcePtr &res);
 bool StartPSSchedulerAction(const ResourcePtr &res);
+bool CompileCacheLoadAction(const ResourcePtr &res);
+bool CompileCacheStoreAction(const ResourcePtr &res);
 
 std::vector<ActionItem> GePipeline();
 std::vector<ActionItem> VmPipeline();
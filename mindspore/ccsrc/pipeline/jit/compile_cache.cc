@@ -0,0 +1,590 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "proto/onnx.pb.h"
+#include "ir/tensor.h"
+#include "ir/graph_utils.h"
+#include "base/core_ops.h"
+#include "debug/dump_proto.h"
+#include "utils/load_onnx/anf_model_parser.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+#include "frontend/operator/composite/composite.h"
+#include "frontend/operator/composite/do_signature.h"
+#include "frontend/optimizer/py_pass_manager.h"
+#include "frontend/parallel/context.h"
+#include "pipeline/jit/parse/python_adapter.h"
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+#include "ps/util.h"
+#endif
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+// Version of the content of the cache files, bump it when the fingerprint or the file layout change
+constexpr char kCompileCacheFormat[] = "1";
+constexpr char kCompileCacheFileSuffix[] = ".mindir";
+// Metadata of the cache files: the key, the names of the weights by parameter index and the flags of the graph
+constexpr char kMetaKey[] = "compile_cache_key";
+constexpr char kMetaParamPrefix[] = "param:";
+constexpr char kMetaFlagPrefix[] = "flag:";
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t Fnv1aHash(const void *data, size_t size, uint64_t hash = kFnvOffsetBasis) {
+  auto bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+// Text which identifies a graph and the graphs it uses. The nodes are listed in topological order, a node refers to
+// its inputs by their index. Values are described by their content, so the text of a graph does not depend on the
+// addresses of its nodes and values.
+class GraphFingerprint {
+ public:
+  explicit GraphFingerprint(std::ostringstream *oss) : oss_(oss) {}
+
+  ~GraphFingerprint() = default;
+
+  void Build(const FuncGraphPtr &root) {
+    (void)GraphIndex(root);
+    while (!todo_.empty()) {
+      FuncGraphPtr fg = todo_.front();
+      todo_.pop_front();
+      AddGraph(fg);
+    }
+  }
+
+ private:
+  size_t GraphIndex(const FuncGraphPtr &fg) {
+    auto iter = graph_index_.find(fg);
+    if (iter != graph_index_.end()) {
+      return iter->second;
+    }
+    size_t index = graph_index_.size();
+    graph_index_[fg] = index;
+    todo_.push_back(fg);
+    return index;
+  }
+
+  void AddGraph(const FuncGraphPtr &fg) {
+    MS_EXCEPTION_IF_NULL(fg);
+    *oss_ << "graph " << graph_index_[fg] << " hyper_param_count " << fg->hyper_param_count() << "\n";
+    for (auto &param : fg->parameters()) {
+      AddNode(param);
+    }
+    for (auto &node : TopoSort(fg->get_return())) {
+      AddNode(node);
+    }
+    *oss_ << "return %" << node_index_[fg->get_return()] << "\n";
+  }
+
+  void AddNode(const AnfNodePtr &node) {
+    MS_EXCEPTION_IF_NULL(node);
+    if (node_index_.count(node) != 0) {
+      return;
+    }
+    std::ostringstream line;
+    if (node->isa<Parameter>()) {
+      auto param = node->cast<ParameterPtr>();
+      line << "parameter " << param->name() << " of " << GraphIndex(param->func_graph());
+      // The data of the weights is not part of the graph
+      auto meta_tensor = param->has_default() ? param->default_param()->cast<tensor::MetaTensorPtr>() : nullptr;
+      if (meta_tensor != nullptr) {
+        line << " default " << TypeIdLabel(meta_tensor->data_type()) << " " << ShapeText(meta_tensor->shape());
+      } else if (param->has_default()) {
+        line << " default " << ValueText(param->default_param());
+      }
+    } else if (node->isa<ValueNode>()) {
+      line << "value " << ValueText(GetValueNode(node));
+    } else if (node->isa<CNode>()) {
+      auto cnode = node->cast<CNodePtr>();
+      line << "apply";
+      for (auto &input : cnode->inputs()) {
+        AddNode(input);
+        line << " %" << node_index_[input];
+      }
+      line << " of " << GraphIndex(cnode->func_graph());
+      if (cnode->scope() != nullptr) {
+        line << " scope " << cnode->scope()->name();
+      }
+    } else {
+      line << node->type_name();
+    }
+    size_t index = node_index_.size();
+    node_index_[node] = index;
+    *oss_ << "%" << index << " = " << line.str() << "\n";
+  }
+
+  std::string ValueText(const ValuePtr &value) {
+    if (value == nullptr) {
+      return "null";
+    }
+    std::ostringstream text;
+    text << value->type_name() << " ";
+    if (value->isa<FuncGraph>()) {
+      text << GraphIndex(value->cast<FuncGraphPtr>());
+    } else if (value->isa<tensor::Tensor>()) {
+      // The text of a tensor only shows part of its data
+      auto tensor = value->cast<tensor::TensorPtr>();
+      text << TypeIdLabel(tensor->data_type()) << " " << ShapeText(tensor->shape()) << " "
+           << Fnv1aHash(tensor->data_c(), tensor->data().nbytes());
+    } else if (value->isa<prim::DoSignaturePrimitive>()) {
+      text << value->cast<prim::DoSignaturePrimitivePtr>()->name() << " "
+           << ValueText(value->cast<prim::DoSignaturePrimitivePtr>()->function());
+    } else if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      // Sorted, the order of the attrs in the map is not part of the primitive
+      std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+      text << prim->name() << " [";
+      for (auto &attr : attrs) {
+        text << attr.first << "=" << ValueText(attr.second) << ", ";
+      }
+      text << "]";
+    } else if (value->isa<prim::DoSignatureMetaFuncGraph>()) {
+      auto do_signature = value->cast<std::shared_ptr<prim::DoSignatureMetaFuncGraph>>();
+      text << do_signature->name() << " " << ValueText(do_signature->function());
+    } else if (value->isa<prim::GradOperation>()) {
+      // The options of a grad operation are not part of its name
+      auto grad = value->cast<prim::GradOperationPtr>();
+      text << grad->name() << " " << grad->get_all_ << grad->get_by_list_ << grad->sens_param_;
+    } else if (value->isa<ValueSequeue>()) {
+      text << "(";
+      for (auto &elem : value->cast<ValueSequeuePtr>()->value()) {
+        text << ValueText(elem) << ", ";
+      }
+      text << ")";
+    } else {
+      text << value->ToString();
+    }
+    return text.str();
+  }
+
+  static std::string ShapeText(const ShapeVector &shape) {
+    std::ostringstream text;
+    text << "[";
+    for (auto dim : shape) {
+      text << dim << ",";
+    }
+    text << "]";
+    return text.str();
+  }
+
+  std::ostringstream *oss_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_index_;
+  std::deque<FuncGraphPtr> todo_;
+  std::unordered_map<AnfNodePtr, size_t> node_index_;
+};
+
+std::string MindSporeVersion() {
+  try {
+    return py::cast<std::string>(py::str(parse::python_adapter::GetPyFn("mindspore.version", "__version__")));
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Get the version of MindSpore failed: " << e.what();
+    return "";
+  }
+}
+
+// The options of the context which change the graph optimized by the front end
+void AddContextText(std::ostringstream *oss) {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  *oss << "device_target " << ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << "\n";
+  *oss << "backend_policy " << ms_context->backend_policy() << "\n";
+  *oss << "execution_mode " << ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) << "\n";
+  *oss << "max_call_depth " << ms_context->get_param<uint32_t>(MS_CTX_MAX_CALL_DEPTH) << "\n";
+  const std::vector<std::pair<std::string, MsCtxParam>> bool_params = {
+    {"enable_auto_mixed_precision", MS_CTX_ENABLE_AUTO_MIXED_PRECISION},
+    {"check_bprop", MS_CTX_CHECK_BPROP_FLAG},
+    {"enable_graph_kernel", MS_CTX_ENABLE_GRAPH_KERNEL},
+    {"enable_reduce_precision", MS_CTX_ENABLE_REDUCE_PRECISION},
+    {"enable_sparse", MS_CTX_ENABLE_SPARSE}};
+  for (auto &param : bool_params) {
+    *oss << param.first << " " << ms_context->get_param<bool>(param.second) << "\n";
+  }
+
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  *oss << "parallel_mode " << parallel_context->parallel_mode() << "\n";
+  *oss << "device_num " << parallel_context->device_num() << "\n";
+  *oss << "gradients_mean " << parallel_context->gradients_mean() << "\n";
+  *oss << "gradient_fp32_sync " << parallel_context->gradient_fp32_sync() << "\n";
+  *oss << "loss_repeated_mean " << parallel_context->loss_repeated_mean() << "\n";
+  *oss << "full_batch " << parallel_context->full_batch() << "\n";
+  *oss << "enable_parallel_optimizer " << parallel_context->enable_parallel_optimizer() << "\n";
+}
+
+bool SameValue(const ValuePtr &lhs, const ValuePtr &rhs) {
+  if (lhs == nullptr || rhs == nullptr) {
+    return lhs == rhs;
+  }
+  if (lhs->isa<tensor::Tensor>() && rhs->isa<tensor::Tensor>()) {
+    return lhs->cast<tensor::TensorPtr>()->ValueEqual(*rhs->cast<tensor::TensorPtr>());
+  }
+  if (lhs->isa<ValueSequeue>() && rhs->isa<ValueSequeue>()) {
+    auto &lhs_elems = lhs->cast<ValueSequeuePtr>()->value();
+    auto &rhs_elems = rhs->cast<ValueSequeuePtr>()->value();
+    if (lhs->type_name() != rhs->type_name() || lhs_elems.size() != rhs_elems.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhs_elems.size(); ++i) {
+      if (!SameValue(lhs_elems[i], rhs_elems[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return *lhs == *rhs;
+}
+
+bool SameAbstract(const AbstractBasePtr &lhs, const AbstractBasePtr &rhs) {
+  if (lhs == nullptr || rhs == nullptr) {
+    return lhs == rhs;
+  }
+  auto lhs_type = lhs->BuildType();
+  auto rhs_type = rhs->BuildType();
+  auto lhs_shape = lhs->BuildShape();
+  auto rhs_shape = rhs->BuildShape();
+  if (lhs_type == nullptr || rhs_type == nullptr || lhs_shape == nullptr || rhs_shape == nullptr) {
+    return false;
+  }
+  return lhs_type->ToString() == rhs_type->ToString() && lhs_shape->ToString() == rhs_shape->ToString();
+}
+
+bool SamePrimitive(const PrimitivePtr &lhs, const PrimitivePtr &rhs) {
+  if (lhs->name() != rhs->name() || lhs->attrs().size() != rhs->attrs().size()) {
+    return false;
+  }
+  for (auto &attr : lhs->attrs()) {
+    auto iter = rhs->attrs().find(attr.first);
+    if (iter == rhs->attrs().end() || !SameValue(attr.second, iter->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether a graph loaded from MindIR is the same graph as the one it was exported from, for the backend: the same
+// nodes in the same order, with the same primitives, values, types and shapes.
+bool SameGraph(const FuncGraphPtr &origin, const FuncGraphPtr &loaded) {
+  if (origin->parameters().size() != loaded->parameters().size() ||
+      origin->hyper_param_count() != loaded->hyper_param_count()) {
+    return false;
+  }
+  auto origin_nodes = TopoSort(origin->get_return());
+  auto loaded_nodes = TopoSort(loaded->get_return());
+  if (origin_nodes.size() != loaded_nodes.size()) {
+    return false;
+  }
+  std::unordered_map<AnfNodePtr, AnfNodePtr> node_map;
+  for (size_t i = 0; i < origin->parameters().size(); ++i) {
+    auto origin_param = origin->parameters()[i]->cast<ParameterPtr>();
+    auto loaded_param = loaded->parameters()[i]->cast<ParameterPtr>();
+    if (origin_param->has_default() != loaded_param->has_default() ||
+        !SameAbstract(origin_param->abstract(), loaded_param->abstract())) {
+      return false;
+    }
+    node_map[origin_param] = loaded_param;
+  }
+  for (size_t i = 0; i < origin_nodes.size(); ++i) {
+    auto &origin_node = origin_nodes[i];
+    auto &loaded_node = loaded_nodes[i];
+    if (origin_node->isa<Parameter>()) {
+      if (node_map[origin_node] != loaded_node) {
+        return false;
+      }
+    } else if (origin_node->isa<ValueNode>()) {
+      if (!loaded_node->isa<ValueNode>()) {
+        return false;
+      }
+      auto origin_value = GetValueNode(origin_node);
+      auto loaded_value = GetValueNode(loaded_node);
+      bool same = (origin_value != nullptr && origin_value->isa<Primitive>())
+                    ? (loaded_value != nullptr && loaded_value->isa<Primitive>() &&
+                       SamePrimitive(origin_value->cast<PrimitivePtr>(), loaded_value->cast<PrimitivePtr>()))
+                    : SameValue(origin_value, loaded_value);
+      if (!same) {
+        return false;
+      }
+    } else if (origin_node->isa<CNode>()) {
+      if (!loaded_node->isa<CNode>()) {
+        return false;
+      }
+      auto origin_cnode = origin_node->cast<CNodePtr>();
+      auto loaded_cnode = loaded_node->cast<CNodePtr>();
+      if (origin_cnode->size() != loaded_cnode->size() ||
+          !SameAbstract(origin_cnode->abstract(), loaded_cnode->abstract())) {
+        return false;
+      }
+      if (origin_cnode != origin->get_return() &&
+          origin_cnode->fullname_with_scope() != loaded_cnode->fullname_with_scope()) {
+        return false;
+      }
+      for (size_t j = 0; j < origin_cnode->size(); ++j) {
+        auto iter = node_map.find(origin_cnode->input(j));
+        if (iter == node_map.end() || iter->second != loaded_cnode->input(j)) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+    node_map[origin_node] = loaded_node;
+  }
+  return true;
+}
+
+// MindIR holds a single graph whose nodes apply primitives
+bool CanExportToMindIR(const FuncGraphPtr &func_graph) {
+  if (!func_graph->func_graphs_used_total().empty()) {
+    return false;
+  }
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode != nullptr && !IsValueNode<Primitive>(cnode->input(0))) {
+      return false;
+    }
+  }
+  return func_graph->output() != nullptr && func_graph->output()->isa<CNode>();
+}
+
+bool ParseModel(const std::string &data, onnx::ModelProto *model) {
+  google::protobuf::io::ArrayInputStream array_input(data.data(), static_cast<int>(data.size()));
+  google::protobuf::io::CodedInputStream coded_input(&array_input);
+  coded_input.SetTotalBytesLimit(INT_MAX, INT_MAX);
+  return model->ParseFromCodedStream(&coded_input);
+}
+
+// Build the graph of a cache file, the weights are bound to the tensors in weights
+FuncGraphPtr BuildGraph(const onnx::ModelProto &model, const std::unordered_map<std::string, ParameterPtr> &weights) {
+  lite::MSANFModelParser parser;
+  FuncGraphPtr func_graph = parser.Parse(model);
+  if (func_graph == nullptr) {
+    return nullptr;
+  }
+  std::unordered_map<std::string, std::string> metadata;
+  for (auto &prop : model.metadata_props()) {
+    metadata[prop.key()] = prop.value();
+  }
+  size_t hyper_param_count = 0;
+  auto &params = func_graph->parameters();
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto param = params[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    if (!param->has_default()) {
+      continue;
+    }
+    auto iter = metadata.find(kMetaParamPrefix + std::to_string(i));
+    if (iter == metadata.end()) {
+      return nullptr;
+    }
+    auto weight = weights.find(iter->second);
+    if (weight == weights.end()) {
+      MS_LOG(INFO) << "Weight " << iter->second << " of the cached graph is not a weight of the network.";
+      return nullptr;
+    }
+    // The same abstract as in the specialization of the graph
+    auto value = weight->second->default_param();
+    auto abs_value = value->ToAbstract()->cast<abstract::AbstractTensorPtr>();
+    auto abs_ref_key = std::make_shared<RefKey>(iter->second)->ToAbstract();
+    param->set_name(iter->second);
+    param->set_default_param(value);
+    param->set_abstract(std::make_shared<abstract::AbstractRef>(abs_ref_key, abs_value));
+    ++hyper_param_count;
+  }
+  func_graph->set_hyper_param_count(hyper_param_count);
+  func_graph->get_return()->set_abstract(func_graph->output()->abstract());
+  for (auto &item : metadata) {
+    if (item.first.compare(0, strlen(kMetaFlagPrefix), kMetaFlagPrefix) == 0) {
+      func_graph->set_flag(item.first.substr(strlen(kMetaFlagPrefix)), item.second == "1");
+    }
+  }
+  return func_graph;
+}
+}  // namespace
+
+bool CompileCache::IsEnabled(const std::string &phase) {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH).empty()) {
+    return false;
+  }
+  if (ms_context->backend_policy() != "ms" || phase.rfind("export", 0) != std::string::npos) {
+    return false;
+  }
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (ps::Util::IsParamServerMode()) {
+    return false;
+  }
+#endif
+  // The passes registered from python rewrite the graphs with python patterns, which are not part of the key
+  auto ppm = opt::python_pass::PyPassManager::GetInstance();
+  MS_EXCEPTION_IF_NULL(ppm);
+  if (ppm->GetPassGroup(opt::python_pass::Phase::PREAD)->size() != 0 ||
+      ppm->GetPassGroup(opt::python_pass::Phase::OPT)->size() != 0) {
+    return false;
+  }
+  // The graphs of auto parallel hold the parallel strategies, which are not stored
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  return parallel_mode == parallel::STAND_ALONE || parallel_mode == parallel::DATA_PARALLEL;
+}
+
+std::string CompileCache::GenerateKey(const FuncGraphPtr &resolved_graph,
+                                      const abstract::AbstractBasePtrList &args_spec) const {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  std::ostringstream oss;
+  oss << "format " << kCompileCacheFormat << "\n";
+  oss << "version " << MindSporeVersion() << "\n";
+  AddContextText(&oss);
+  for (auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    oss << "arg " << arg->BuildType()->ToString() << " " << arg->BuildShape()->ToString() << "\n";
+  }
+  GraphFingerprint fingerprint(&oss);
+  fingerprint.Build(resolved_graph);
+
+  // Two independent hashes, a key is 128 bits
+  std::string text = oss.str();
+  std::ostringstream key;
+  key << std::hex << std::setfill('0') << std::setw(16) << Fnv1aHash(text.data(), text.size()) << std::setw(16)
+      << std::hash<std::string>()(text);
+  return key.str();
+}
+
+FuncGraphPtr CompileCache::Load(const std::string &key, const FuncGraphPtr &resolved_graph) const {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  std::ifstream ifs(GetFilePath(key), std::ios::binary);
+  if (!ifs.is_open()) {
+    return nullptr;
+  }
+  std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  onnx::ModelProto model;
+  if (!ParseModel(data, &model)) {
+    MS_LOG(WARNING) << "Compile cache file " << GetFilePath(key) << " is broken, ignore it.";
+    return nullptr;
+  }
+  bool key_matched = false;
+  for (auto &prop : model.metadata_props()) {
+    key_matched = key_matched || (prop.key() == kMetaKey && prop.value() == key);
+  }
+  if (!key_matched) {
+    MS_LOG(WARNING) << "Compile cache file " << GetFilePath(key) << " does not hold key " << key << ", ignore it.";
+    return nullptr;
+  }
+  std::unordered_map<std::string, ParameterPtr> weights;
+  for (auto &node : resolved_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      weights[param->name()] = param;
+    }
+  }
+  return BuildGraph(model, weights);
+}
+
+bool CompileCache::Store(const std::string &key, const FuncGraphPtr &optimized_graph) const {
+  MS_EXCEPTION_IF_NULL(optimized_graph);
+  if (!CanExportToMindIR(optimized_graph)) {
+    return false;
+  }
+  onnx::ModelProto model;
+  try {
+    if (!ParseModel(GetBinaryProtoString(optimized_graph, false), &model)) {
+      return false;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Export the graph to MindIR failed: " << e.what();
+    return false;
+  }
+
+  std::unordered_map<std::string, ParameterPtr> weights;
+  auto add_metadata = [&model](const std::string &key, const std::string &value) {
+    auto prop = model.add_metadata_props();
+    prop->set_key(key);
+    prop->set_value(value);
+  };
+  add_metadata(kMetaKey, key);
+  auto &params = optimized_graph->parameters();
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto param = params[i]->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      add_metadata(kMetaParamPrefix + std::to_string(i), param->name());
+      weights[param->name()] = param;
+    }
+  }
+  for (auto &attr : optimized_graph->attrs()) {
+    if (!attr.second->isa<BoolImm>()) {
+      return false;
+    }
+    add_metadata(kMetaFlagPrefix + attr.first, GetValue<bool>(attr.second) ? "1" : "0");
+  }
+
+  // Only store the graph if it is what a cache hit will load
+  FuncGraphPtr loaded_graph = nullptr;
+  try {
+    loaded_graph = BuildGraph(model, weights);
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Load the graph from MindIR failed: " << e.what();
+  }
+  if (loaded_graph == nullptr || !SameGraph(optimized_graph, loaded_graph)) {
+    return false;
+  }
+
+  // Write to a temporary file and rename it, so that processes sharing the directory never read a partial file
+  std::string file_path = GetFilePath(key);
+  std::string tmp_path = file_path + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open() || !model.SerializeToOstream(&ofs)) {
+      MS_LOG(WARNING) << "Write compile cache file " << tmp_path << " failed.";
+      (void)remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  ChangeFileMode(tmp_path, S_IRUSR | S_IWUSR);
+  if (rename(tmp_path.c_str(), file_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename compile cache file " << tmp_path << " to " << file_path << " failed.";
+    (void)remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::string CompileCache::GetFilePath(const std::string &key) const {
+  return dir_ + "/" + key + kCompileCacheFileSuffix;
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <string>
+
+#include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore {
+namespace pipeline {
+// names of the pipeline actions which load and store the compiled graph
+const char kCompileCacheLoad[] = "compile_cache_load";
+const char kCompileCacheStore[] = "compile_cache_store";
+
+// keys of the resource results used by the compile cache actions
+const char kCompileCacheKey[] = "compile_cache_key";
+const char kCompileCacheStartTime[] = "compile_cache_start_time";
+const char kCompileCacheHit[] = "compile_cache_hit";
+
+// On-disk cache of the graphs optimized by the front end, in the directory set by the context option
+// compile_cache_path. An entry is keyed on a fingerprint of the resolved graph, the abstracts of the arguments,
+// the context options which change the optimized graph and the MindSpore version. It holds the optimized graph in
+// MindIR format, without the data of the weights: a loaded graph uses the weights of the resolved graph.
+class CompileCache {
+ public:
+  explicit CompileCache(const std::string &dir) : dir_(dir) {}
+
+  ~CompileCache() = default;
+
+  // Whether the graphs compiled for a phase go through the cache. The cache is used in the vm pipeline of the ms
+  // backend, in stand alone and data parallel mode, when no python pass is registered.
+  static bool IsEnabled(const std::string &phase);
+
+  // Generate the key of the entry of a graph.
+  std::string GenerateKey(const FuncGraphPtr &resolved_graph, const abstract::AbstractBasePtrList &args_spec) const;
+
+  // Load the optimized graph of an entry, return nullptr if there is no usable entry.
+  FuncGraphPtr Load(const std::string &key, const FuncGraphPtr &resolved_graph) const;
+
+  // Store the optimized graph of an entry. A graph is only stored if the graph loaded back from its MindIR is the
+  // same graph, otherwise false is returned.
+  bool Store(const std::string &key, const FuncGraphPtr &optimized_graph) const;
+
+ private:
+  std::string GetFilePath(const std::string &key) const;
+
+  std::string dir_;
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
@@ -26,6 +26,7 @@
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -407,6 +408,20 @@ bool IsPhaseExportAir(const std::string &phase_s) {
   return phase_s.rfind(phase_to_export) != std::string::npos;
 }
 
+// Load the graph from the compile cache once the symbols are resolved, store it once it is validated
+std::vector<ActionItem> AddCompileCacheActions(const std::vector<ActionItem> &actions) {
+  std::vector<ActionItem> cache_actions;
+  for (const auto &item : actions) {
+    cache_actions.emplace_back(item);
+    if (item.first == "symbol_resolve") {
+      cache_actions.emplace_back(std::make_pair(kCompileCacheLoad, CompileCacheLoadAction));
+    } else if (item.first == "validate") {
+      cache_actions.emplace_back(std::make_pair(kCompileCacheStore, CompileCacheStoreAction));
+    }
+  }
+  return cache_actions;
+}
+
 std::vector<ActionItem> GetPipline(const ResourcePtr &resource, const std::string &phase_s, bool use_vm) {
   bool is_air = IsPhaseExportAir(phase_s);
 
@@ -431,6 +446,9 @@ std::vector<ActionItem> GetPipline(const ResourcePtr &resource, const std::strin
     // Connect session to debugger
     backend_ptr->SetDebugger();
     resource->results()[kBackend] = backend_ptr;
+    if (CompileCache::IsEnabled(phase_s)) {
+      return AddCompileCacheActions(VmPipeline());
+    }
     return VmPipeline();
   }
   return GePipeline();
@@ -628,7 +646,14 @@ void Pipeline::Run() {
 
   WITH(MsProfile::GetProfile())[&user_graph, this]() {
     int i = 0;
+    bool skip_to_cache_store = false;
     for (auto &action : actions_) {
+      // On a compile cache hit, the loaded graph is the result of the actions up to the cache store
+      if (skip_to_cache_store) {
+        skip_to_cache_store = action.first != kCompileCacheStore;
+        i++;
+        continue;
+      }
 #ifdef ENABLE_TIMELINE
       DumpTime &dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
@@ -646,6 +671,9 @@ void Pipeline::Run() {
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
       }
+      if (action.first == kCompileCacheLoad && resource_->results().count(kCompileCacheHit) != 0) {
+        skip_to_cache_store = true;
+      }
       if (MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG) && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
@@ -17,6 +17,7 @@
 #include "pipeline/jit/static_analysis/evaluator.h"
 
 #include <algorithm>
+#include <memory>
 #include <unordered_set>
 
 #include "ir/func_graph_cloner.h"
@@ -92,6 +93,74 @@ static std::vector<AnfNodePtr> FastShadowSort(const AnfNodePtr &ret_node) {
   return sorted_nodes;
 }
 
+namespace {
+// Follows the evaluation of the nodes of a graph, and gives the primitive cnodes whose inputs in the graph are all
+// evaluated, so that they can be inferred together.
+class ParallelInferScheduler {
+ public:
+  explicit ParallelInferScheduler(const std::vector<AnfNodePtr> &nodes)
+      : nodes_(nodes), ready_at_(nodes.size() + 1), is_ready_(nodes.size(), false) {
+    std::unordered_map<AnfNodePtr, size_t> positions;
+    for (size_t i = 0; i < nodes_.size(); i++) {
+      positions[nodes_[i]] = i;
+    }
+    for (size_t i = 0; i < nodes_.size(); i++) {
+      auto cnode = nodes_[i]->cast<CNodePtr>();
+      if (cnode == nullptr || cnode->inputs().empty() || !IsValueNode<Primitive>(cnode->input(0))) {
+        continue;
+      }
+      // the inputs of a node may be evaluated after it, the node is then never ready before its own evaluation
+      size_t ready_at = 0;
+      bool ready = true;
+      for (size_t j = 1; j < cnode->inputs().size() && ready; j++) {
+        auto iter = positions.find(cnode->input(j));
+        if (iter != positions.end()) {
+          ready = iter->second < i;
+          ready_at = std::max(ready_at, iter->second + 1);
+        }
+      }
+      if (ready) {
+        ready_at_[ready_at].push_back(i);
+      }
+    }
+  }
+  ~ParallelInferScheduler() = default;
+
+  // Called before the evaluation of the node at position i, return the ready cnodes which are not evaluated yet if
+  // the node is one of them, and nothing otherwise.
+  std::vector<AnfNodePtr> ReadyNodes(size_t i) {
+    for (; next_ready_at_ <= i; next_ready_at_++) {
+      for (auto j : ready_at_[next_ready_at_]) {
+        if (j >= i) {
+          ready_.push_back(j);
+          is_ready_[j] = true;
+        }
+      }
+    }
+    std::vector<AnfNodePtr> ready_nodes;
+    if (!is_ready_[i]) {
+      return ready_nodes;
+    }
+    for (auto j : ready_) {
+      is_ready_[j] = false;
+      if (j >= i) {
+        ready_nodes.push_back(nodes_[j]);
+      }
+    }
+    ready_.clear();
+    return ready_nodes;
+  }
+
+ private:
+  const std::vector<AnfNodePtr> &nodes_;
+  // ready_at_[i] holds the positions of the cnodes whose inputs in the graph are all before position i
+  std::vector<std::vector<size_t>> ready_at_;
+  std::vector<size_t> ready_;
+  std::vector<bool> is_ready_;
+  size_t next_ready_at_{0};
+};
+}  // namespace
+
 EvalResultPtr BaseFuncGraphEvaluator::Eval(AnalysisEnginePtr engine, const AbstractBasePtrList &args_spec_list) {
   FuncGraphPtr fg = GetFuncGraph(engine, args_spec_list);
   MS_EXCEPTION_IF_NULL(fg);
@@ -124,8 +193,19 @@ EvalResultPtr BaseFuncGraphEvaluator::Eval(AnalysisEnginePtr engine, const Abstr
                       << ", please call 'context.set_context(max_call_depth=value)' to adjust this value.";
   }
   std::vector<AnfNodePtr> nodes = FastShadowSort(func_node);
-  for (auto it = nodes.crbegin(); it != nodes.crend(); it++) {
-    const auto &node = *it;
+  std::reverse(nodes.begin(), nodes.end());
+  std::unique_ptr<ParallelInferScheduler> parallel_infer_scheduler = nullptr;
+  if (MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER)) {
+    parallel_infer_scheduler = std::make_unique<ParallelInferScheduler>(nodes);
+  }
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const auto &node = nodes[i];
+    if (parallel_infer_scheduler != nullptr) {
+      auto ready_nodes = parallel_infer_scheduler->ReadyNodes(i);
+      if (ready_nodes.size() > 1) {
+        engine->InferPrimsInParallel(ready_nodes, graph_context_);
+      }
+    }
     AnfNodeConfigPtr node_conf = engine->MakeConfig(node, graph_context_);
     MS_LOG(DEBUG) << "Analysis node begin, func graph: " << fg.get() << fg->ToString()
                   << ", node_conf: " << node_conf->ToString();
@@ -309,7 +389,14 @@ EvalResultPtr Evaluator::Run(AnalysisEnginePtr engine, const ConfigPtrList &args
 }
 
 EvalResultPtr TrivialPrimEvaluator::Run(AnalysisEnginePtr engine, const ConfigPtrList &args_conf_list,
-                                        AnfNodeConfigPtr) {
+                                        AnfNodeConfigPtr out_conf) {
+  // The cnode may have been inferred with other cnodes of its graph on the worker threads.
+  if (engine != nullptr && out_conf != nullptr) {
+    auto parallel_infer_result = engine->TakeParallelInferResult(out_conf);
+    if (parallel_infer_result != nullptr) {
+      return parallel_infer_result;
+    }
+  }
   AbstractBasePtrList args_spec_list;
   auto is_py_eval = (identifier_ == "PythonPrimEvaluator");
   (void)std::transform(args_conf_list.begin(), args_conf_list.end(), std::back_inserter(args_spec_list),
@@ -174,6 +174,7 @@ class TrackedEvaluator : public Evaluator {
   }
   EvalResultPtr Run(AnalysisEnginePtr engine, const ConfigPtrList &args_conf_list, AnfNodeConfigPtr out_conf) override;
   std::string ToString() const override { return identifier_ + "_" + sub_evaluator_->ToString(); }
+  const EvaluatorPtr &sub_evaluator() const { return sub_evaluator_; }
 
  private:
   EvaluatorPtr sub_evaluator_;
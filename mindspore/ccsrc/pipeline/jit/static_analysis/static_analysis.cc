@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <set>
+#include <unordered_set>
 
 #include "abstract/utils.h"
 #include "pipeline/jit/static_analysis/prim.h"
@@ -30,6 +31,7 @@
 #include "pipeline/jit/parse/data_converter.h"
 #include "pipeline/jit/static_analysis/evaluator.h"
 #include "debug/trace.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace abstract {
@@ -303,6 +305,7 @@ void AnalysisEngine::Clear() {
   constructors_.clear();
   constructors_app_.clear();
   continued_evals_.clear();
+  parallel_infer_results_.clear();
 }
 
 namespace {
@@ -644,6 +647,140 @@ EvalResultPtr AnalysisEngine::ExecuteMultipleEvaluators(const std::vector<Evalua
   return ProcessEvalResults(out_specs);
 }
 
+namespace {
+// The infer of these primitives calls the engine or python, so they are always inferred on the calling thread.
+const std::unordered_set<std::string> prims_to_infer_sequentially{"list_map", "list_reduce", "tuple_to_array"};
+
+// Return the evaluator of a cnode if the cnode can be inferred on a worker thread, nullptr otherwise.
+StandardPrimEvaluatorPtr GetParallelInferEvaluator(const AnalysisEnginePtr &engine, const CNodePtr &cnode,
+                                                   const AnalysisContextPtr &context) {
+  auto &func_node = cnode->input(0);
+  if (!IsValueNode<Primitive>(func_node)) {
+    return nullptr;
+  }
+  auto func_abstract = engine->MakeConfig(func_node, context)->GetEvaluatedValue()->abstract();
+  auto func = dyn_cast<PrimitiveAbstractClosure>(func_abstract);
+  if (func == nullptr) {
+    return nullptr;
+  }
+  auto evaluator = engine->GetEvaluatorFor(func);
+  auto tracked_evaluator = dyn_cast<TrackedEvaluator>(evaluator);
+  if (tracked_evaluator != nullptr) {
+    evaluator = tracked_evaluator->sub_evaluator();
+  }
+  auto prim_evaluator = dyn_cast<StandardPrimEvaluator>(evaluator);
+  if (prim_evaluator == nullptr || prim_evaluator->prim()->prim_type() == PrimType::kPrimTypePyInferCheck ||
+      prims_to_infer_sequentially.find(prim_evaluator->prim()->name()) != prims_to_infer_sequentially.end()) {
+    return nullptr;
+  }
+  return prim_evaluator;
+}
+}  // namespace
+
+void AnalysisEngine::InferPrimsInParallel(const std::vector<AnfNodePtr> &nodes, const AnalysisContextPtr &context) {
+  struct InferJob {
+    AnfNodeConfigPtr conf;
+    StandardPrimEvaluatorPtr evaluator;
+    AbstractBasePtrList args_spec_list;
+    EvalResultPtr result;
+  };
+  std::vector<InferJob> jobs;
+  for (auto &node : nodes) {
+    auto cnode = dyn_cast<CNode>(node);
+    if (cnode == nullptr || cnode->abstract() != nullptr || cnode->inputs().empty()) {
+      continue;
+    }
+    auto conf = MakeConfig(cnode, context);
+    if (conf->context()->IsDummyContext() || cache_.GetValue(conf) != nullptr ||
+        parallel_infer_results_.find(conf) != parallel_infer_results_.end()) {
+      continue;
+    }
+    auto evaluator = GetParallelInferEvaluator(shared_from_this(), cnode, conf->context());
+    if (evaluator == nullptr) {
+      continue;
+    }
+    // Only the inputs which do not need an evaluation of a cnode are used, and no function is passed to the infer,
+    // so the infer does not call back into the engine.
+    AbstractBasePtrList args_spec_list;
+    bool ready = true;
+    for (size_t i = 1; i < cnode->inputs().size() && ready; i++) {
+      auto &input = cnode->input(i);
+      auto input_conf = MakeConfig(input, conf->context());
+      auto input_result = cache_.GetValue(input_conf);
+      if (input_result == nullptr && input->isa<ValueNode>()) {
+        input_result = input_conf->GetEvaluatedValue();
+      }
+      ready = input_result != nullptr && input_result->abstract() != nullptr &&
+              !input_result->abstract()->isa<AbstractFunction>();
+      if (ready) {
+        args_spec_list.push_back(input_result->abstract());
+      }
+    }
+    if (ready) {
+      jobs.push_back({conf, evaluator, args_spec_list, nullptr});
+    }
+  }
+  if (jobs.size() < 2) {
+    return;
+  }
+
+  // The infer records the attributes it adds to the primitive, so the jobs of a primitive run on one thread, in order.
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<Primitive *, size_t> group_of_prim;
+  for (size_t i = 0; i < jobs.size(); i++) {
+    auto prim = jobs[i].evaluator->prim().get();
+    auto iter = group_of_prim.find(prim);
+    if (iter == group_of_prim.end()) {
+      iter = group_of_prim.emplace(prim, groups.size()).first;
+      groups.emplace_back();
+    }
+    groups[iter->second].push_back(i);
+  }
+  auto engine = shared_from_this();
+  std::vector<common::Task> tasks;
+  for (auto &group : groups) {
+    tasks.emplace_back([&jobs, &group, &engine]() {
+      // The error of a failed infer is raised again by the sequential evaluation, which dumps the trace.
+      trace::TraceProviderDisabler trace_provider_disabler;
+      for (auto i : group) {
+        auto &job = jobs[i];
+        // A failed infer is left to the evaluation of the cnode, which raises the error with the trace of the node.
+        try {
+          job.result = job.evaluator->EvalPrim(engine, job.args_spec_list);
+        } catch (...) {
+          job.result = nullptr;
+        }
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+
+  size_t inferred = 0;
+  for (auto &job : jobs) {
+    if (job.result != nullptr && job.result->abstract() != nullptr) {
+      parallel_infer_results_[job.conf] = job.result;
+      inferred++;
+    }
+  }
+  parallel_inferred_count_ += inferred;
+  MS_LOG(DEBUG) << "Inferred " << inferred << " of " << jobs.size() << " cnodes in parallel, on " << groups.size()
+                << " primitives.";
+}
+
+EvalResultPtr AnalysisEngine::TakeParallelInferResult(const AnfNodeConfigPtr &conf) {
+  if (parallel_infer_results_.empty()) {
+    return nullptr;
+  }
+  auto iter = parallel_infer_results_.find(conf);
+  if (iter == parallel_infer_results_.end()) {
+    return nullptr;
+  }
+  auto result = iter->second;
+  (void)parallel_infer_results_.erase(iter);
+  return result;
+}
+
 EvalResultPtr AnfNodeConfig::GetEvaluatedValue() {
   AnfNodeConfigPtr self = shared_from_base<AnfNodeConfig>();
   return engine_.lock()->GetEvaluatedValue(self);
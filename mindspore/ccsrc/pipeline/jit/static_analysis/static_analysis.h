@@ -230,6 +230,15 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
   }
   const PrimEvaluatorMap &PrimConstructors() const { return prim_constructors_; }
 
+  // Infer the cnodes of a graph which call a primitive with a C++ infer and have all their inputs evaluated, on the
+  // worker threads. The results are kept in the order of the nodes and taken when each cnode is evaluated, so the
+  // evaluation order and the results are the same as when the cnodes are inferred one by one.
+  void InferPrimsInParallel(const std::vector<AnfNodePtr> &nodes, const AnalysisContextPtr &context);
+  // Take the result of a cnode inferred by InferPrimsInParallel, return nullptr if there is none.
+  EvalResultPtr TakeParallelInferResult(const AnfNodeConfigPtr &conf);
+  // Number of cnodes InferPrimsInParallel inferred since the engine was created.
+  size_t parallel_inferred_count() const { return parallel_inferred_count_; }
+
   AnalysisCache cache_;
   std::unordered_map<PrimitivePyPtr, EvaluatorPtr> prim_py_evaluators_;
 
@@ -259,6 +268,8 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
   std::unordered_map<std::pair<AbstractFunctionPtr, AbstractBasePtrList>, EvaluatorPtr, PartialAppHasher>
     constructors_app_;
   AnfNodeConfigMap anfnode_config_map_;
+  std::unordered_map<AnfNodeConfigPtr, EvalResultPtr, AnfNodeConfigHasher, AnfNodeConfigEqual> parallel_infer_results_;
+  size_t parallel_inferred_count_{0};
   // Use a list to trace multiple evaluators.
   std::list<std::pair<EvaluatorPtr, AbstractBasePtrList>> eval_trace_;
   std::map<EvaluatorPtr, EvaluatorPtr> multi_poss_;
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler/device/cpu/cpu_data_saver.h"
+#include <fstream>
+#include <unordered_set>
+#include "nlohmann/json.hpp"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+namespace {
+// Format the input shapes of a launch like '[1,3,224,224];[64]'
+std::string InputShapesToString(const std::vector<std::vector<size_t>> &input_shapes) {
+  std::string res;
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    if (i != 0) {
+      res += ";";
+    }
+    res += "[";
+    for (size_t j = 0; j < input_shapes[i].size(); ++j) {
+      if (j != 0) {
+        res += ",";
+      }
+      res += std::to_string(input_shapes[i][j]);
+    }
+    res += "]";
+  }
+  return res;
+}
+}  // namespace
+
+void CpuDataSaver::ParseEvent(const std::vector<Event> &events) { events_ = &events; }
+
+void CpuDataSaver::WriteFile(std::string out_path_dir) {
+  if (out_path_dir.empty()) {
+    MS_LOG(WARNING) << "Output directory. Ignore the writing data.";
+    return;
+  }
+  if (op_detail_infos_.empty() || op_type_infos_.empty()) {
+    MS_LOG(WARNING) << "No operation detail infos to write.";
+    return;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  device_id_ = std::to_string(context_ptr->get_param<uint32_t>(MS_CTX_DEVICE_ID));
+  WriteOpDetail(out_path_dir + "/cpu_op_detail_info_" + device_id_ + ".csv");
+  WriteOpType(out_path_dir + "/cpu_op_type_info_" + device_id_ + ".csv");
+  WriteOpTimestamp(out_path_dir + "/cpu_op_execute_timestamp_" + device_id_ + ".txt");
+  WriteTimeline(out_path_dir);
+}
+
+void CpuDataSaver::WriteTimeline(const std::string &saver_base_dir) {
+  if (events_ == nullptr) {
+    return;
+  }
+  // the display file is an array of chrome trace complete events, with one row per thread launching kernels
+  std::string file_path = saver_base_dir + "/cpu_timeline_display_" + device_id_ + ".json";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  nlohmann::json timeline = nlohmann::json::array();
+  std::unordered_set<uint32_t> thread_ids;
+  float total_time = 0;
+  for (const auto &event : *events_) {
+    float duration = (event.end_time_stamp - event.start_time_stamp) / kTimeUnit;
+    nlohmann::json item;
+    item["name"] = event.op_name;
+    item["ph"] = "X";
+    item["pid"] = std::stoi(device_id_);
+    item["tid"] = event.thread_id;
+    // the time stamps are in us in the chrome trace format
+    item["ts"] = static_cast<double>(event.start_time_stamp) / kTimeUnit;
+    item["dur"] = duration;
+    item["args"] = {{"input_shapes", InputShapesToString(event.input_shapes)}, {"memory(bytes)", event.memory_size}};
+    timeline.push_back(item);
+    (void)thread_ids.insert(event.thread_id);
+    total_time += duration;
+  }
+  ofs << timeline.dump();
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << events_->size() << " timeline events into file: " << file_path;
+
+  // the summary has the keys of the gpu timeline summary, the threads take the place of the streams
+  std::string summary_file_path = saver_base_dir + "/cpu_timeline_summary_" + device_id_ + ".json";
+  std::ofstream summary_ofs(summary_file_path);
+  if (!summary_ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << summary_file_path << "' failed!";
+    return;
+  }
+  nlohmann::json summary;
+  summary["total_time"] = total_time / kTimeUnit;
+  summary["num_of_streams"] = thread_ids.size();
+  summary["num_of_ops"] = op_detail_infos_.size();
+  summary["op_exe_times"] = events_->size();
+  summary_ofs << summary.dump();
+  summary_ofs.close();
+  ChangeFileMode(summary_file_path);
+}
+
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CPU_DATA_SAVER_H
+#define MINDSPORE_CPU_DATA_SAVER_H
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <memory>
+#include "profiler/device/data_saver.h"
+#include "profiler/device/cpu/cpu_profiling.h"
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+// Write the op statistics in the files of the gpu profiler, with the cpu prefix, and the launches of the kernels
+// as a timeline in the chrome trace format.
+class CpuDataSaver : public DataSaver {
+ public:
+  CpuDataSaver() = default;
+
+  ~CpuDataSaver() override = default;
+
+  CpuDataSaver(const CpuDataSaver &) = delete;
+
+  CpuDataSaver &operator=(const CpuDataSaver &) = delete;
+
+  void ParseEvent(const std::vector<Event> &events);
+
+  void WriteFile(std::string out_path);
+
+ protected:
+  // the memory of the kernels takes the place of the cuda activities
+  std::string GetOpDetailDeviceHeader() const override { return "op_total_memory(bytes),op_avg_memory(bytes)"; }
+
+  void WriteOpDetailDeviceColumns(std::ostream &os, const OpInfo &op_info) const override {
+    os << op_info.op_memory_size << ',' << op_info.op_memory_size / op_info.op_count;
+  }
+
+ private:
+  void WriteTimeline(const std::string &saver_base_dir);
+
+  const std::vector<Event> *events_{nullptr};
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CPU_DATA_SAVER_H
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler/device/cpu/cpu_profiling.h"
+#include <pthread.h>
+#include <chrono>
+#include <utility>
+#include "profiler/device/cpu/cpu_data_saver.h"
+#include "utils/log_adapter.h"
+#include "pybind_api/api_register.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+std::shared_ptr<CPUProfiler> CPUProfiler::profiler_inst_ = nullptr;
+
+namespace {
+uint32_t GetThreadID() {
+  uint32_t thread_id = static_cast<uint32_t>(pthread_self());
+  return thread_id;
+}
+
+uint64_t GetHostTimeStamp() {
+  auto cur_sys_clock = std::chrono::system_clock::now();
+  uint64_t cur_time_stamp =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(cur_sys_clock.time_since_epoch()).count();
+  return cur_time_stamp;
+}
+
+// the launch in progress on this thread
+thread_local Event op_event;
+}  // namespace
+
+std::shared_ptr<CPUProfiler> CPUProfiler::GetInstance() {
+  if (profiler_inst_ == nullptr) {
+    profiler_inst_ = std::shared_ptr<CPUProfiler>(new (std::nothrow) CPUProfiler());
+  }
+  return profiler_inst_;
+}
+
+void CPUProfiler::Init(const std::string &profileDataPath = "") {
+  MS_LOG(INFO) << "Initialize CPU Profiling";
+  ClearInst();
+  profile_data_path_ = profileDataPath;
+  MS_LOG(INFO) << "Host start time(ns):" << GetHostTimeStamp() << " profile data path: " << profile_data_path_;
+}
+
+void CPUProfiler::StepProfilingEnable(const bool enable_flag) {
+  MS_LOG(INFO) << "CPU Profiler enable flag:" << enable_flag;
+  enable_flag_ = enable_flag;
+}
+
+void CPUProfiler::OpDataProducerBegin(const std::string &op_name, std::vector<std::vector<size_t>> &&input_shapes,
+                                      size_t memory_size) {
+  op_event.op_name = op_name;
+  op_event.thread_id = GetThreadID();
+  op_event.input_shapes = std::move(input_shapes);
+  op_event.memory_size = memory_size;
+  op_event.start_time_stamp = GetHostTimeStamp();
+}
+
+void CPUProfiler::OpDataProducerEnd() {
+  op_event.end_time_stamp = GetHostTimeStamp();
+  MS_LOG(DEBUG) << "Host Time Elapsed(us)," << op_event.op_name << ","
+                << (op_event.end_time_stamp - op_event.start_time_stamp) / kTimeUnit;
+  AddEvent(std::move(op_event));
+}
+
+void CPUProfiler::SetRunTimeData(const Event &event) {
+  float op_time_elapsed = (event.end_time_stamp - event.start_time_stamp) / kTimeUnit;
+  auto iter = op_info_map_.find(event.op_name);
+  if (iter == op_info_map_.end()) {
+    OpInfo op_info;
+    op_info.op_name = event.op_name;
+    iter = op_info_map_.emplace(event.op_name, std::move(op_info)).first;
+  }
+  iter->second.op_count += 1;
+  iter->second.op_host_cost_time += op_time_elapsed;
+  iter->second.op_memory_size += event.memory_size;
+  iter->second.start_duration.emplace_back(StartDuration({event.start_time_stamp, op_time_elapsed}));
+}
+
+void CPUProfiler::AddEvent(Event &&event) {
+  // the kernels of different graphs may be launched by different threads
+  std::unique_lock<std::mutex> lock(event_mutex_);
+  SetRunTimeData(event);
+  if (events_.size() < max_events_) {
+    events_.emplace_back(std::move(event));
+  } else {
+    events_drop_count_++;
+  }
+}
+
+void CPUProfiler::Stop() {
+  MS_LOG(INFO) << "Stop CPU Profiling";
+  enable_flag_ = false;
+  MS_LOG(INFO) << "Count the number of events size:" << events_.size();
+  if (events_drop_count_ > 0) {
+    MS_LOG(WARNING) << "The total number of events exceeded the profiler's processing capacity, " << events_drop_count_
+                    << " events were left out of the timeline.";
+  }
+  SaveProfileData();
+  ClearInst();
+}
+
+void CPUProfiler::SaveProfileData() {
+  if (profile_data_path_.empty()) {
+    MS_LOG(WARNING) << "Profile data path is empty, skip save profile data.";
+  } else {
+    CpuDataSaver dataSaver;
+    dataSaver.ParseOpInfo(op_info_map_);
+    dataSaver.ParseEvent(events_);
+    dataSaver.WriteFile(profile_data_path_);
+  }
+}
+
+void CPUProfiler::ClearInst() {
+  std::unique_lock<std::mutex> lock(event_mutex_);
+  op_info_map_.clear();
+  events_.clear();
+  enable_flag_ = false;
+  events_drop_count_ = 0l;
+}
+
+REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
+                         (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
+                           .def_static("get_instance", &CPUProfiler::GetInstance, "CPUProfiler get_instance.")
+                           .def("init", &CPUProfiler::Init, py::arg("profile_data_path"), "init")
+                           .def("stop", &CPUProfiler::Stop, "stop")
+                           .def("step_profiling_enable", &CPUProfiler::StepProfilingEnable, py::arg("enable_flag"),
+                                "enable or disable step profiling");
+                       }));
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CPU_PROFILING_H
+#define MINDSPORE_CPU_PROFILING_H
+#include <cstdint>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include "profiler/device/profiling.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+// One launch of a cpu kernel, the time stamps are in ns
+struct Event {
+  std::string op_name;
+  uint64_t start_time_stamp;
+  uint64_t end_time_stamp;
+  uint32_t thread_id;
+  std::vector<std::vector<size_t>> input_shapes;
+  size_t memory_size;
+};
+
+const float kTimeUnit = 1000;
+
+class CPUProfiler {
+ public:
+  static std::shared_ptr<CPUProfiler> GetInstance();
+  ~CPUProfiler() = default;
+  CPUProfiler(const CPUProfiler &) = delete;
+  CPUProfiler &operator=(const CPUProfiler &) = delete;
+
+  void Init(const std::string &profileDataPath);
+  void Stop();
+  void StepProfilingEnable(const bool enable_flag);
+  bool GetEnableFlag() const { return enable_flag_; }
+  // Called around the launch of a kernel. memory_size is the size of the outputs and the workspaces of the kernel.
+  void OpDataProducerBegin(const std::string &op_name, std::vector<std::vector<size_t>> &&input_shapes,
+                           size_t memory_size);
+  void OpDataProducerEnd();
+
+ private:
+  CPUProfiler() = default;
+  void SetRunTimeData(const Event &event);
+  void AddEvent(Event &&event);
+  void SaveProfileData();
+  void ClearInst();
+
+  static std::shared_ptr<CPUProfiler> profiler_inst_;
+  bool enable_flag_ = false;
+  std::unordered_map<std::string, OpInfo> op_info_map_;
+  std::vector<Event> events_;
+  std::mutex event_mutex_;
+
+  uint64_t events_drop_count_ = 0l;
+  uint64_t max_events_ = 2 * 1024 * 10000;
+
+  std::string profile_data_path_;
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CPU_PROFILING_H
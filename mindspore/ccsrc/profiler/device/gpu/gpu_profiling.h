@@ -26,6 +26,7 @@
 #include <memory>
 #include <algorithm>
 #include <utility>
+#include "profiler/device/profiling.h"
 
 namespace mindspore {
 namespace profiler {
@@ -84,23 +85,6 @@ struct Event {
   };
 };
 
-struct StartDuration {
-  uint64_t start_timestamp = 0l;
-  float duration = 0l;
-};
-
-struct OpInfo {
-  std::string op_name;
-  float cupti_api_call_time = 0l;
-  float cupti_activity_time = 0l;
-  float op_host_cost_time = 0;
-  int op_kernel_api_count = 0;
-  int op_kernel_count = 0;
-  int op_count = 0;
-  std::vector<StartDuration> start_duration;
-  void *stream;
-};
-
 struct BaseTime {
   // nanosecond
   uint64_t host_start_time = 0l;
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_PROFILING_H
+#define MINDSPORE_PROFILING_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace profiler {
+struct StartDuration {
+  uint64_t start_timestamp = 0l;
+  float duration = 0l;
+};
+
+// Statistics of the launches of an op, the times are in us. The cupti and kernel counts are only set on gpu and the
+// memory size only on cpu.
+struct OpInfo {
+  std::string op_name;
+  float cupti_api_call_time = 0l;
+  float cupti_activity_time = 0l;
+  float op_host_cost_time = 0;
+  int op_kernel_api_count = 0;
+  int op_kernel_count = 0;
+  int op_count = 0;
+  uint64_t op_memory_size = 0;
+  std::vector<StartDuration> start_duration;
+  void *stream{nullptr};
+};
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_PROFILING_H
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_LOCK_STRIPES_H_
+#define MINDSPORE_CCSRC_PS_LOCK_STRIPES_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace mindspore {
+namespace ps {
+constexpr size_t kDefaultLockStripeNum = 64;
+
+// A fixed array of mutexes selected by key. Requests on different keys rarely wait on each other, and the number of
+// mutexes stays bounded however many keys the server holds. A caller must hold at most one stripe at a time.
+class LockStripes {
+ public:
+  explicit LockStripes(size_t stripe_num = kDefaultLockStripeNum)
+      : stripe_num_(stripe_num == 0 ? 1 : stripe_num), stripes_(new Stripe[stripe_num_]) {}
+  ~LockStripes() = default;
+  LockStripes(const LockStripes &) = delete;
+  LockStripes &operator=(const LockStripes &) = delete;
+
+  size_t stripe_num() const { return stripe_num_; }
+  size_t StripeIndex(uint64_t key) const {
+    // mix the bits, keys are usually small consecutive integers
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key % stripe_num_);
+  }
+  std::mutex &GetLock(uint64_t key) { return stripes_[StripeIndex(key)].mutex; }
+
+  // Runs a request on key the way ParameterServer serves pushes and pulls: lookup runs under meta_mutex, which guards
+  // the maps and the counters of the keys, and returns whether the request goes on. Then access runs under the stripe
+  // of key only, and commit under meta_mutex again. Requests on different keys only wait on each other while they
+  // look up or commit, requests on the same key wait for each other's access.
+  template <typename Lookup, typename Access, typename Commit>
+  void RunOnKey(std::mutex *meta_mutex, uint64_t key, const Lookup &lookup, const Access &access,
+                const Commit &commit) {
+    {
+      std::lock_guard<std::mutex> lock(*meta_mutex);
+      if (!lookup()) {
+        return;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(GetLock(key));
+      access();
+    }
+    std::lock_guard<std::mutex> lock(*meta_mutex);
+    commit();
+  }
+
+ private:
+  // keep each mutex on its own cache line so that stripes do not false share
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+  };
+  size_t stripe_num_;
+  std::unique_ptr<Stripe[]> stripes_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_LOCK_STRIPES_H_
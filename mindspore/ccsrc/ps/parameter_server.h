@@ -41,6 +41,8 @@
 #include "ps/optimizer_info_builder.h"
 #include "ps/util.h"
 #include "ps/ps_context.h"
+#include "ps/lock_stripes.h"
+#include "common/thread_pool.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "utils/ms_context.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -122,9 +124,13 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
+  void ApplyOptimizer(const std::shared_ptr<PServerKernel> &optimizer, const std::shared_ptr<OptimizerInfo> &optim_info,
+                      const InputsShapePtr &original_inputs_shape);
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
+  void LookupEmbeddingTable(const WeightPtr &table_ptr, const std::shared_ptr<PServerKernel> &table_lookup_op,
+                            const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
   bool ReadyForUpdateWeights();
   bool ReadyForPush(const Key &key);
   bool ReadyForPull(const Key &key);
@@ -158,7 +164,11 @@ class ParameterServer {
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
 
+  // mutex_ guards the maps above, the counters and the tokens. The content of each key, i.e. its weight, optimizer
+  // info and kernels, is guarded by the stripe of the key in key_locks_, so requests on different keys only meet on
+  // the short metadata sections.
   std::mutex mutex_;
+  LockStripes key_locks_;
   std::condition_variable apply_grads_cv_;
 
   std::unique_ptr<std::thread> thread_;
@@ -518,116 +528,178 @@ void ParameterServer<T>::Finalize() {
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
   while (true) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
-    }
-
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
+    std::vector<common::Task> tasks;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
+      if (!running_) {
+        break;
       }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
 
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
+      for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+        Key key = iter->first;
+        std::shared_ptr<PServerKernel> optimizer = nullptr;
+        if (weight_key_to_optims_.count(key) > 0) {
+          optimizer = optimizers_[key];
+        }
+        MS_EXCEPTION_IF_NULL(optimizer);
 
+        std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+        if (optim_info == nullptr) {
+          continue;
+        }
+        InputsShapePtr original_inputs_shape = nullptr;
         if (original_optim_inputs_shape_.count(key) != 0) {
-          for (auto input_shapes : *(original_optim_inputs_shape_[key])) {
-            shapes.push_back(*input_shapes);
-          }
+          original_inputs_shape = original_optim_inputs_shape_[key];
         }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
+        tasks.emplace_back([this, key, optimizer, optim_info, original_inputs_shape]() {
+          std::lock_guard<std::mutex> key_lock(key_locks_.GetLock(key));
+          ApplyOptimizer(optimizer, optim_info, original_inputs_shape);
+          return common::SUCCESS;
+        });
       }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
+    }
+
+    // Pushes wait in ReadyForPush until the counters are reset below, so the optimizers of different keys run in
+    // parallel and only lookups of the same key wait for them.
+    if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
+      MS_LOG(EXCEPTION) << "Update weights failed";
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+      if (!is_embedding_[iter->first]) {
+        tokens_[iter->first] = worker_num_;
       }
     }
     ResetGradAccumCount();
   }
 }
 
+template <typename T>
+void ParameterServer<T>::ApplyOptimizer(const std::shared_ptr<PServerKernel> &optimizer,
+                                        const std::shared_ptr<OptimizerInfo> &optim_info,
+                                        const InputsShapePtr &original_inputs_shape) {
+  const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+  const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+  const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+  std::vector<std::vector<size_t>> shapes = {};
+  std::vector<size_t> indices_shape = {};
+  indices_shape.emplace_back(optim_info->indice_size());
+  shapes.push_back(indices_shape);
+
+  if (original_inputs_shape != nullptr) {
+    for (auto input_shapes : *original_inputs_shape) {
+      shapes.push_back(*input_shapes);
+    }
+  }
+  optimizer->ReInit(shapes);
+  optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
+  optimizer->Execute(inputs, workspaces, outputs);
+  optim_info->Reset();
+}
+
 template <typename T>
 void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+  bool built = false;
+  key_locks_.RunOnKey(
+    &mutex_, key,
+    [&]() {
+      if (no_sparse_grad) {
+        return true;
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim =
-        builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
-    }
-  }
-
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
-  }
-  if (ReadyForUpdateWeights()) {
-    apply_grads_cv_.notify_one();
-  }
+      optim_info = optim_infos_[key];
+      // Create the optimizer info from the first push
+      if (optim_info == nullptr) {
+        const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
+        std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
+        if (pserver_kernel == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+        }
+        MS_EXCEPTION_IF_NULL(pserver_kernel);
+        OptimizerInfo *optim =
+          builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
+        optim_info.reset(optim);
+        optim_infos_[key] = optim_info;
+        built = true;
+      }
+      return true;
+    },
+    [&]() {
+      // Accumulate under the stripe of the key only, pushes and lookups of other keys go on meanwhile
+      if (optim_info != nullptr && !built) {
+        optim_info->Update(values, lengths);
+        optim_info->Accumulate(values, lengths);
+      }
+    },
+    [&]() {
+      grads_accum_counter_[key] += 1;
+      if (grads_accum_counter_[key] == worker_num_) {
+        grad_accum_count_++;
+      }
+      if (ReadyForUpdateWeights()) {
+        apply_grads_cv_.notify_one();
+      }
+    });
 }
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
-    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
-  }
-  WeightPtr weight_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(weight_ptr);
-  WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
-  MS_EXCEPTION_IF_NULL(copy_weight_ptr);
-  copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
-  tokens_[key] -= 1;
+  WeightPtr weight_ptr = nullptr;
+  WeightPtr copy_weight_ptr = nullptr;
+  key_locks_.RunOnKey(
+    &mutex_, key,
+    [&]() {
+      if (weights_.count(key) == 0) {
+        MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+      }
+      weight_ptr = weights_[key];
+      MS_EXCEPTION_IF_NULL(weight_ptr);
+      return true;
+    },
+    [&]() {
+      copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
+      MS_EXCEPTION_IF_NULL(copy_weight_ptr);
+      copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
+    },
+    [&]() { tokens_[key] -= 1; });
   return copy_weight_ptr;
 }
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding table key " << key;
-    return;
-  }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
-  }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = nullptr;
+  std::shared_ptr<PServerKernel> table_lookup_op = nullptr;
+  // The lookup op and the table are only touched under the stripe of the key, so lookups of other tables are not
+  // blocked by this one or by their optimizers.
+  key_locks_.RunOnKey(
+    &mutex_, key,
+    [&]() {
+      if (weights_.count(key) == 0) {
+        MS_LOG(ERROR) << "Invalid embedding table key " << key;
+        return false;
+      }
+      if (embedding_lookup_ops_.count(key) == 0) {
+        MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
+        return false;
+      }
+      table_ptr = weights_[key];
+      table_lookup_op = embedding_lookup_ops_[key];
+      return true;
+    },
+    [&]() { LookupEmbeddingTable(table_ptr, table_lookup_op, lookup_ids, res); }, []() {});
+}
+
+template <typename T>
+void ParameterServer<T>::LookupEmbeddingTable(const WeightPtr &table_ptr,
+                                              const std::shared_ptr<PServerKernel> &table_lookup_op,
+                                              const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
   MS_EXCEPTION_IF_NULL(table_lookup_op);
 
   // Update shapes of lookup operator
@@ -749,7 +821,9 @@ void ParameterServer<T>::SyncEmbeddingTables() {
     }
     MS_EXCEPTION_IF_NULL(new_tensor_data_ptr);
     MS_EXCEPTION_IF_NULL(weights_[key]->data());
+    std::unique_lock<std::mutex> key_lock(key_locks_.GetLock(key));
     int ret = memcpy_s(new_tensor_data_ptr, new_tensor_size, weights_[key]->data(), embedding_table_size);
+    key_lock.unlock();
     if (ret != 0) {
       MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
       return;
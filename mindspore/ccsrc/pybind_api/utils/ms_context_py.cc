@@ -80,12 +80,14 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("enable_graph_kernel", MsCtxParam::MS_CTX_ENABLE_GRAPH_KERNEL)
                            .value("enable_reduce_precision", MsCtxParam::MS_CTX_ENABLE_REDUCE_PRECISION)
                            .value("enable_sparse", MsCtxParam::MS_CTX_ENABLE_SPARSE)
+                           .value("enable_parallel_infer", MsCtxParam::MS_CTX_ENABLE_PARALLEL_INFER)
                            .value("precompile_only", MsCtxParam::MS_CTX_PRECOMPILE_ONLY)
                            .value("enable_profiling", MsCtxParam::MS_CTX_ENABLE_PROFILING)
                            .value("save_graphs", MsCtxParam::MS_CTX_SAVE_GRAPHS_FLAG)
                            .value("max_device_memory", MsCtxParam::MS_CTX_MAX_DEVICE_MEMORY)
                            .value("mode", MsCtxParam::MS_CTX_EXECUTION_MODE)
                            .value("device_target", MsCtxParam::MS_CTX_DEVICE_TARGET)
+                           .value("compile_cache_path", MsCtxParam::MS_CTX_COMPILE_CACHE_PATH)
                            .value("_graph_memory_max_size", MsCtxParam::MS_CTX_GRAPH_MEMORY_MAX_SIZE)
                            .value("print_file_path", MsCtxParam::MS_CTX_PRINT_FILE_PATH)
                            .value("profiling_options", MsCtxParam::MS_CTX_PROFILING_OPTIONS)
@@ -28,6 +28,7 @@
 #include "frontend/operator/ops.h"
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
+#include "profiler/device/cpu/cpu_profiling.h"
 
 namespace mindspore {
 namespace device {
@@ -291,6 +292,9 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
 
+  auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  MS_EXCEPTION_IF_NULL(profiler_inst);
+
   auto kernels = kernel_graph->execution_order();
   for (const auto &kernel : kernels) {
 #ifdef ENABLE_PROFILE
@@ -318,7 +322,25 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
+    bool profiling = profiler_inst->GetEnableFlag();
+    if (profiling) {
+      std::vector<std::vector<size_t>> input_shapes;
+      for (size_t i = 0; i < input_num; ++i) {
+        input_shapes.emplace_back(AnfAlgo::GetPrevNodeOutputInferShape(kernel, i));
+      }
+      size_t memory_size = 0;
+      for (const auto &address : kernel_outputs) {
+        memory_size += address->size;
+      }
+      for (const auto &address : kernel_workspaces) {
+        memory_size += address->size;
+      }
+      profiler_inst->OpDataProducerBegin(kernel->fullname_with_scope(), std::move(input_shapes), memory_size);
+    }
     auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+    if (profiling) {
+      profiler_inst->OpDataProducerEnd();
+    }
     resource_manager_.DecreaseAddressRefCount(kernel);
     if (!ret) {
       MS_LOG(EXCEPTION) << "Launch kernel failed.";
@@ -14,60 +14,68 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <unordered_map>
 #include "backend/session/anf_runtime_algorithm.h"
+#include "utils/mem_plan.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
-    }
+namespace {
+constexpr size_t kMemAlignSize = 64;
+constexpr size_t kMemPadSize = 32;
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
-    }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+void CollectOutputAddress(const session::KernelWithIndex &kernel_with_index, std::vector<DeviceAddress *> *addresses) {
+  MS_EXCEPTION_IF_NULL(addresses);
+  auto &node = kernel_with_index.first;
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  if (AnfAlgo::CheckPrimitiveType(node, prim::kPrimMakeTuple)) {
+    auto make_tuple = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(make_tuple);
+    for (size_t i = 1; i < make_tuple->inputs().size(); ++i) {
+      CollectOutputAddress(AnfAlgo::VisitKernelWithReturnType(make_tuple->input(i), 0, true), addresses);
     }
+    return;
+  }
+  if (AnfAlgo::OutputAddrExist(node, kernel_with_index.second)) {
+    addresses->push_back(AnfAlgo::GetMutableOutputAddr(node, kernel_with_index.second, true).get());
   }
-
-  return total_mem_size;
 }
+}  // namespace
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+std::vector<CPUMemBlock> CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph) const {
   MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
+  std::vector<CPUMemBlock> mem_blocks;
+  std::unordered_map<DeviceAddress *, size_t> block_index_map;
+  auto update_block = [&mem_blocks, &block_index_map](DeviceAddress *address, size_t step) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ != nullptr) {
+      return;
+    }
+    auto iter = block_index_map.find(address);
+    if (iter == block_index_map.end()) {
+      block_index_map[address] = mem_blocks.size();
+      CPUMemBlock mem_block;
+      mem_block.address_ = address;
+      mem_block.size_ = address->size_;
+      mem_block.first_use_ = step;
+      mem_block.last_use_ = step;
+      mem_blocks.push_back(mem_block);
+      return;
+    }
+    auto &mem_block = mem_blocks[iter->second];
+    mem_block.first_use_ = std::min(mem_block.first_use_, step);
+    mem_block.last_use_ = std::max(mem_block.last_use_, step);
+  };
+
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -77,34 +85,69 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
         continue;
       }
       auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      update_block(address.get(), step);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
       auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      update_block(address.get(), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      update_block(address, step);
     }
   }
+
+  // Graph outputs and summary outputs are read after the whole graph is launched, keep them alive to the end.
+  std::vector<DeviceAddress *> persistent_addresses;
+  for (const auto &output : graph->outputs()) {
+    CollectOutputAddress(AnfAlgo::VisitKernelWithReturnType(output, 0, true), &persistent_addresses);
+  }
+  for (const auto &summary_item : graph->summary_nodes()) {
+    CollectOutputAddress(summary_item.second, &persistent_addresses);
+  }
+  for (auto address : persistent_addresses) {
+    auto iter = block_index_map.find(address);
+    if (iter != block_index_map.end()) {
+      mem_blocks[iter->second].last_use_ = kernels.size();
+    }
+  }
+  return mem_blocks;
+}
+
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool enable_mem_reuse = context_ptr->get_param<bool>(MS_CTX_ENABLE_MEM_REUSE);
+  auto mem_blocks = CollectMemBlocks(graph);
+  naive_mem_size_ = kMemPadSize;
+  for (const auto &mem_block : mem_blocks) {
+    naive_mem_size_ += mem_block.size_;
+  }
+  planned_mem_size_ = AssignMemBlockOffsets(&mem_blocks, kMemAlignSize, enable_mem_reuse) + kMemPadSize;
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " memory plan: " << mem_blocks.size()
+               << " blocks, planned peak size " << planned_mem_size_ << ", naive total size " << naive_mem_size_
+               << ", mem reuse " << (enable_mem_reuse ? "enabled" : "disabled");
+  return planned_mem_size_;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool enable_mem_reuse = context_ptr->get_param<bool>(MS_CTX_ENABLE_MEM_REUSE);
+  auto mem_blocks = CollectMemBlocks(graph);
+  (void)AssignMemBlockOffsets(&mem_blocks, kMemAlignSize, enable_mem_reuse);
+  for (auto &mem_block : mem_blocks) {
+    MS_EXCEPTION_IF_NULL(mem_block.address_);
+    mem_block.address_->ptr_ = base_ptr + mem_block.offset_;
+  }
 }
 }  // namespace cpu
 }  // namespace device
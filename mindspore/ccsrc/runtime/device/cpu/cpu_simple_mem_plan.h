@@ -23,6 +23,15 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A memory block whose lifetime is [first_use_, last_use_] in kernel execution order.
+struct CPUMemBlock {
+  DeviceAddress *address_{nullptr};
+  size_t size_{0};
+  size_t first_use_{0};
+  size_t last_use_{0};
+  size_t offset_{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -30,6 +39,13 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  size_t naive_mem_size() const { return naive_mem_size_; }
+  size_t planned_mem_size() const { return planned_mem_size_; }
+
+ private:
+  std::vector<CPUMemBlock> CollectMemBlocks(const session::KernelGraph *graph) const;
+  size_t naive_mem_size_{0};
+  size_t planned_mem_size_{0};
 };
 }  // namespace cpu
 }  // namespace device
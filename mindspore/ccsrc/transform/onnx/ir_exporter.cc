@@ -70,8 +70,8 @@ class IrExporter {
 
 class IrExportBuilder {
  public:
-  IrExportBuilder() = default;
-  ~IrExportBuilder() { google::protobuf::ShutdownProtobufLibrary(); }
+  explicit IrExportBuilder(bool with_param_data = true) : with_param_data_(with_param_data) {}
+  ~IrExportBuilder() = default;
   std::string GetProtoString(const FuncGraphPtr &func_graph);
   void BuildModelInfo();
   void BuildModel(const FuncGraphPtr &func_graph);
@@ -120,6 +120,7 @@ class IrExportBuilder {
   std::map<AnfNodePtr, size_t> node_index_map_;
   size_t node_index_{0};
   size_t shape_index_{0};
+  bool with_param_data_;
 };
 
 using IrExporterPtr = std::shared_ptr<IrExporter>;
@@ -192,7 +193,7 @@ void IrExportBuilder::BuildParameters(const FuncGraphPtr &func_graph, onnx::Grap
     initializer_proto->set_name(param_name);
     SetParamToTensorProto(param, initializer_proto);
     auto tensor = std::dynamic_pointer_cast<tensor::Tensor>(param->default_param());
-    if (tensor) {
+    if (tensor && with_param_data_) {
       initializer_proto->set_raw_data(tensor->data_c(), tensor->data().nbytes());
     }
   }
@@ -654,8 +655,8 @@ void IrExportBuilder::SetSequenceToAttributeProto(const ValueSequeuePtr &value,
   }
 }
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph) {
-  auto builder = std::make_shared<IrExportBuilder>();
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool with_param_data) {
+  auto builder = std::make_shared<IrExportBuilder>(with_param_data);
   if (builder == nullptr) {
     MS_LOG(ERROR) << "Create ir exporter failed!";
     return "";
@@ -0,0 +1,411 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint_engine.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+
+#include "common/thread_pool.h"
+#include "pybind_api/api_register.h"
+#include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+// The data types of the tensors are stored as their position in this list, which does not depend on the TypeId enum.
+const std::vector<TypeId> kDataTypes = {kNumberTypeBool,   kNumberTypeInt8,    kNumberTypeUInt8,   kNumberTypeInt16,
+                                        kNumberTypeUInt16, kNumberTypeInt32,   kNumberTypeUInt32,  kNumberTypeInt64,
+                                        kNumberTypeUInt64, kNumberTypeFloat16, kNumberTypeFloat32, kNumberTypeFloat64};
+
+uint64_t AlignBlob(uint64_t offset) { return (offset + kBlobAlignment - 1) / kBlobAlignment * kBlobAlignment; }
+
+size_t ChunkCount(uint64_t size) { return static_cast<size_t>((size + kChunkSize - 1) / kChunkSize); }
+
+uint32_t Crc(const char *data, uint64_t size) {
+  return system::Crc32c::MakeCrc32c(0, data, static_cast<size_t>(size));
+}
+
+template <typename T>
+void Append(std::string *buf, const T &value) {
+  buf->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// Reads the integers and strings of the header and of the index, with bound checks.
+class Reader {
+ public:
+  Reader(const std::string &file_name, const char *data, uint64_t size)
+      : file_name_(file_name), data_(data), size_(size) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    Check(sizeof(T));
+    (void)memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString(uint64_t size) {
+    Check(size);
+    std::string value(data_ + pos_, size);
+    pos_ += size;
+    return value;
+  }
+
+  bool End() const { return pos_ == size_; }
+
+ private:
+  void Check(uint64_t size) const {
+    if (size > size_ - pos_) {
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is truncated or corrupted.";
+    }
+  }
+
+  std::string file_name_;
+  const char *data_;
+  uint64_t size_;
+  uint64_t pos_{0};
+};
+
+// A checkpoint file mapped copy on write, unmapped when the last tensor using it is released.
+class MappedFile {
+ public:
+  MappedFile(const std::string &file_name, char *addr, uint64_t size)
+      : file_name_(file_name), addr_(addr), size_(size) {}
+
+  ~MappedFile() {
+    if (munmap(addr_, size_) != 0) {
+      MS_LOG(WARNING) << "Unmap the checkpoint file " << file_name_ << " failed.";
+    }
+  }
+
+  static std::shared_ptr<MappedFile> Open(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(EXCEPTION) << "Open the checkpoint file " << file_name << " failed.";
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(kHeaderSize)) {
+      (void)close(fd);
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name << " is truncated or corrupted.";
+    }
+    auto size = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(EXCEPTION) << "Map the checkpoint file " << file_name << " failed.";
+    }
+    return std::make_shared<MappedFile>(file_name, static_cast<char *>(addr), size);
+  }
+
+  const std::string &file_name() const { return file_name_; }
+  char *addr() const { return addr_; }
+  uint64_t size() const { return size_; }
+
+ private:
+  std::string file_name_;
+  char *addr_;
+  uint64_t size_;
+};
+using MappedFilePtr = std::shared_ptr<MappedFile>;
+
+// Tensor data in a mapped checkpoint file. The mapping is private, so the writes to the data are not seen in the file.
+class MappedTensorData : public tensor::TensorData {
+ public:
+  MappedTensorData(const MappedFilePtr &file, char *data, const ShapeVector &shape, size_t itemsize)
+      : file_(file), data_(data), ndim_(shape.size()), itemsize_(itemsize) {
+    size_ = std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1),
+                            [](size_t n, int64_t dim) { return n * static_cast<size_t>(dim); });
+  }
+
+  ~MappedTensorData() override = default;
+
+  ssize_t size() const override { return static_cast<ssize_t>(size_); }
+
+  ssize_t itemsize() const override { return static_cast<ssize_t>(itemsize_); }
+
+  ssize_t nbytes() const override { return size() * itemsize(); }
+
+  ssize_t ndim() const override { return static_cast<ssize_t>(ndim_); }
+
+  void *data() override { return data_; }
+
+  const void *const_data() const override { return data_; }
+
+  std::string ToString(const TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    // printing is not on a hot path, print a copy with the default tensor data
+    tensor::Tensor copy(type, shape, data_, static_cast<size_t>(nbytes()));
+    return copy.data().ToString(type, shape, use_comma);
+  }
+
+ private:
+  MappedFilePtr file_;
+  char *data_;
+  size_t ndim_;
+  size_t itemsize_;
+  size_t size_;
+};
+
+struct Entry {
+  std::string name;
+  TypeId type;
+  ShapeVector shape;
+  uint64_t offset;
+  uint64_t size;
+  std::vector<uint32_t> crcs;
+};
+
+std::vector<Entry> ReadIndex(const MappedFilePtr &file) {
+  const auto &file_name = file->file_name();
+  Reader header(file_name, file->addr(), kHeaderSize);
+  if (header.ReadString(kMagicSize) != std::string(kMagic, kMagicSize)) {
+    MS_LOG(EXCEPTION) << "The file " << file_name << " is not a native checkpoint.";
+  }
+  auto index_offset = header.Read<uint64_t>();
+  auto index_size = header.Read<uint64_t>();
+  auto index_crc = header.Read<uint32_t>();
+  if (index_offset > file->size() || index_size > file->size() - index_offset ||
+      Crc(file->addr() + index_offset, index_size) != index_crc) {
+    MS_LOG(EXCEPTION) << "The index of the checkpoint file " << file_name << " is corrupted.";
+  }
+
+  std::vector<Entry> entries;
+  Reader index(file_name, file->addr() + index_offset, index_size);
+  while (!index.End()) {
+    Entry entry;
+    entry.name = index.ReadString(index.Read<uint32_t>());
+    auto type_code = index.Read<uint32_t>();
+    if (type_code >= kDataTypes.size()) {
+      MS_LOG(EXCEPTION) << "The parameter " << entry.name << " of the checkpoint file " << file_name
+                        << " has an unknown data type " << type_code << ".";
+    }
+    entry.type = kDataTypes[type_code];
+    auto ndim = index.Read<uint32_t>();
+    uint64_t count = 1;
+    for (uint32_t i = 0; i < ndim; ++i) {
+      entry.shape.push_back(index.Read<int64_t>());
+      count *= static_cast<uint64_t>(entry.shape.back());
+    }
+    entry.offset = index.Read<uint64_t>();
+    entry.size = index.Read<uint64_t>();
+    auto chunk_count = index.Read<uint32_t>();
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+      entry.crcs.push_back(index.Read<uint32_t>());
+    }
+    if (entry.offset > index_offset || entry.size > index_offset - entry.offset ||
+        entry.size != count * GetTypeByte(TypeIdToType(entry.type)) || chunk_count != ChunkCount(entry.size)) {
+      MS_LOG(EXCEPTION) << "The index entry of the parameter " << entry.name << " of the checkpoint file "
+                        << file_name << " is corrupted.";
+    }
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+void VerifyBlobs(const MappedFilePtr &file, const std::vector<const Entry *> &entries) {
+  std::vector<common::Task> tasks;
+  for (auto entry : entries) {
+    for (size_t c = 0; c < entry->crcs.size(); ++c) {
+      tasks.emplace_back([&file, entry, c]() {
+        uint64_t begin = c * kChunkSize;
+        uint64_t size = std::min<uint64_t>(kChunkSize, entry->size - begin);
+        if (Crc(file->addr() + entry->offset + begin, size) != entry->crcs[c]) {
+          MS_LOG(ERROR) << "The data of the parameter " << entry->name << " of the checkpoint file "
+                        << file->file_name() << " does not match its crc.";
+          return common::FAIL;
+        }
+        return common::SUCCESS;
+      });
+    }
+  }
+  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
+    MS_LOG(EXCEPTION) << "The checkpoint file " << file->file_name() << " is corrupted.";
+  }
+}
+
+bool WriteAll(int fd, const char *data, uint64_t size, uint64_t offset) {
+  while (size > 0) {
+    auto written = pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= static_cast<uint64_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+  return true;
+}
+}  // namespace
+
+bool CheckpointEngine::IsNativeCheckpoint(const std::string &file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  char magic[kMagicSize];
+  bool is_native = read(fd, magic, kMagicSize) == static_cast<ssize_t>(kMagicSize) &&
+                   memcmp(magic, kMagic, kMagicSize) == 0;
+  (void)close(fd);
+  return is_native;
+}
+
+void CheckpointEngine::Save(const std::string &file_name, const NamedTensors &tensors) {
+  struct Blob {
+    const char *data;
+    uint64_t offset;
+    uint64_t size;
+    std::vector<uint32_t> crcs;
+  };
+  std::vector<Blob> blobs;
+  std::string index;
+  uint64_t offset = AlignBlob(kHeaderSize);
+  for (const auto &item : tensors) {
+    const auto &tensor = item.second;
+    MS_EXCEPTION_IF_NULL(tensor);
+    auto type_iter = std::find(kDataTypes.begin(), kDataTypes.end(), tensor->data_type());
+    if (type_iter == kDataTypes.end()) {
+      MS_LOG(EXCEPTION) << "The parameter " << item.first << " has the data type "
+                        << TypeIdLabel(tensor->data_type()) << ", which can not be saved in a checkpoint.";
+    }
+    auto size = static_cast<uint64_t>(tensor->data().nbytes());
+    blobs.push_back({static_cast<const char *>(tensor->data_c()), offset, size, {}});
+    blobs.back().crcs.resize(ChunkCount(size));
+    offset = AlignBlob(offset + size);
+  }
+  uint64_t index_offset = offset;
+
+  std::string temp_file_name = file_name + ".tmp";
+  int fd = open(temp_file_name.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(EXCEPTION) << "Create the checkpoint file " << temp_file_name << " failed.";
+  }
+  // each chunk of the blobs is written and checksummed by a task
+  std::vector<common::Task> tasks;
+  for (auto &blob : blobs) {
+    for (size_t c = 0; c < blob.crcs.size(); ++c) {
+      tasks.emplace_back([fd, &blob, c]() {
+        uint64_t begin = c * kChunkSize;
+        uint64_t size = std::min<uint64_t>(kChunkSize, blob.size - begin);
+        if (!WriteAll(fd, blob.data + begin, size, blob.offset + begin)) {
+          return common::FAIL;
+        }
+        blob.crcs[c] = Crc(blob.data + begin, size);
+        return common::SUCCESS;
+      });
+    }
+  }
+  bool succeed = common::ThreadPool::GetInstance().SyncRun(tasks);
+
+  if (succeed) {
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      const auto &name = tensors[i].first;
+      const auto &tensor = tensors[i].second;
+      const auto &blob = blobs[i];
+      Append(&index, static_cast<uint32_t>(name.size()));
+      index.append(name);
+      Append(&index, static_cast<uint32_t>(std::find(kDataTypes.begin(), kDataTypes.end(), tensor->data_type()) -
+                                           kDataTypes.begin()));
+      Append(&index, static_cast<uint32_t>(tensor->shape().size()));
+      for (auto dim : tensor->shape()) {
+        Append(&index, static_cast<int64_t>(dim));
+      }
+      Append(&index, blob.offset);
+      Append(&index, blob.size);
+      Append(&index, static_cast<uint32_t>(blob.crcs.size()));
+      for (auto crc : blob.crcs) {
+        Append(&index, crc);
+      }
+    }
+    // the header is written last, a file left incomplete by a failure has no magic
+    std::string header(kMagic, kMagicSize);
+    Append(&header, index_offset);
+    Append(&header, static_cast<uint64_t>(index.size()));
+    Append(&header, Crc(index.data(), index.size()));
+    Append(&header, static_cast<uint32_t>(0));
+    succeed = WriteAll(fd, index.data(), index.size(), index_offset) && WriteAll(fd, header.data(), header.size(), 0);
+  }
+  if (close(fd) != 0 || !succeed || rename(temp_file_name.c_str(), file_name.c_str()) != 0) {
+    (void)unlink(temp_file_name.c_str());
+    MS_LOG(EXCEPTION) << "Write the checkpoint file " << file_name << " failed.";
+  }
+}
+
+NamedTensors CheckpointEngine::Load(const std::string &file_name, const std::vector<std::string> &names, bool verify) {
+  auto file = MappedFile::Open(file_name);
+  auto entries = ReadIndex(file);
+
+  std::vector<const Entry *> selected;
+  if (names.empty()) {
+    for (const auto &entry : entries) {
+      selected.push_back(&entry);
+    }
+  } else {
+    std::unordered_map<std::string, const Entry *> entry_map;
+    for (const auto &entry : entries) {
+      entry_map[entry.name] = &entry;
+    }
+    for (const auto &name : names) {
+      auto iter = entry_map.find(name);
+      if (iter == entry_map.end()) {
+        MS_LOG(EXCEPTION) << "The parameter " << name << " is not in the checkpoint file " << file_name << ".";
+      }
+      selected.push_back(iter->second);
+    }
+  }
+  if (verify) {
+    VerifyBlobs(file, selected);
+  }
+
+  NamedTensors tensors;
+  for (auto entry : selected) {
+    auto itemsize = GetTypeByte(TypeIdToType(entry->type));
+    auto data = std::make_shared<MappedTensorData>(file, file->addr() + entry->offset, entry->shape, itemsize);
+    tensors.emplace_back(entry->name, std::make_shared<tensor::Tensor>(entry->type, entry->shape, data));
+  }
+  return tensors;
+}
+
+REGISTER_PYBIND_DEFINE(CheckpointEngine, ([](py::module *const m) {
+                         (void)m->def("_is_native_checkpoint", &CheckpointEngine::IsNativeCheckpoint,
+                                      py::arg("file_name"), "Whether a file is a native checkpoint.");
+                         (void)m->def(
+                           "_save_native_checkpoint",
+                           [](const std::string &file_name, const NamedTensors &tensors) {
+                             py::gil_scoped_release release;
+                             CheckpointEngine::Save(file_name, tensors);
+                           },
+                           py::arg("file_name"), py::arg("tensors"), "Save tensors in a native checkpoint.");
+                         (void)m->def(
+                           "_load_native_checkpoint",
+                           [](const std::string &file_name, const std::vector<std::string> &names, bool verify) {
+                             py::gil_scoped_release release;
+                             return CheckpointEngine::Load(file_name, names, verify);
+                           },
+                           py::arg("file_name"), py::arg("names"), py::arg("verify"),
+                           "Load tensors from a native checkpoint.");
+                       }));
+}  // namespace checkpoint
+}  // namespace mindspore
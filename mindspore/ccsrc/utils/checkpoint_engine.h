@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+// Native checkpoint file, all the integers are little endian:
+//   header: magic "MSCKPT01", uint64 offset of the index, uint64 size of the index, uint32 crc of the index,
+//           uint32 padding
+//   blobs:  the data of the tensors, each one starting at a multiple of kBlobAlignment
+//   index:  for each tensor: uint32 size of the name, the name, uint32 data type, uint32 ndim, int64 dims[ndim],
+//           uint64 offset of the blob, uint64 size of the blob, uint32 chunk count, uint32 crc[chunk count]
+// The crc of a blob is computed on each kChunkSize bytes, so that big blobs are checked on several threads.
+constexpr char kMagic[] = "MSCKPT01";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kHeaderSize = kMagicSize + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+constexpr size_t kBlobAlignment = 64;
+constexpr size_t kChunkSize = 64 * 1024 * 1024;
+
+using NamedTensors = std::vector<std::pair<std::string, tensor::TensorPtr>>;
+
+class CheckpointEngine {
+ public:
+  // Whether a file starts with the magic of the native checkpoints.
+  static bool IsNativeCheckpoint(const std::string &file_name);
+
+  // Save tensors in a native checkpoint. The blobs are written and checksummed by the threads of the common thread
+  // pool, into a temporary file which replaces file_name once it is complete. The host data of the tensors is
+  // written as it is, the caller syncs it from the devices beforehand.
+  static void Save(const std::string &file_name, const NamedTensors &tensors);
+
+  // Load tensors from a native checkpoint, all of them if names is empty. The data of the tensors is mapped copy on
+  // write from the file, so it is only read when it is used. With verify, the crcs of the loaded blobs are checked,
+  // which reads them.
+  static NamedTensors Load(const std::string &file_name, const std::vector<std::string> &names, bool verify);
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_ENGINE_H_
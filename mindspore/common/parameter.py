@@ -16,6 +16,7 @@
 """Parameter for cell."""
 from copy import copy
 from .._c_expression import ParamInfo
+from .._c_expression import Tensor as Tensor_
 from . import dtype as mstype
 from .initializer import initializer, Initializer
 from .tensor import Tensor, MetaTensor
@@ -147,6 +148,10 @@ class Parameter(MetaTensor):
                 # do not init data while in auto parallel.
                 return (MetaTensor, data.dtype, data.shape)
             data = data.to_tensor()
+        if isinstance(data, Tensor_) and not isinstance(data, Tensor):
+            # a tensor returned by the backend, like the ones mapped from a native checkpoint, is not shared with
+            # the user, so the parameter takes over its data
+            return (Tensor, data)
         if isinstance(data, Tensor):
             # make a copy of Tensor to init the parameter
             return (Tensor, data.asnumpy(),)
@@ -193,6 +193,12 @@ class _Context:
     def set_save_graphs_path(self, save_graphs_path):
         self.set_param(ms_ctx_param.save_graphs_path, _make_directory(save_graphs_path))
 
+    def set_compile_cache_path(self, compile_cache_path):
+        if compile_cache_path == "":
+            self.set_param(ms_ctx_param.compile_cache_path, "")
+            return
+        self.set_param(ms_ctx_param.compile_cache_path, _make_directory(compile_cache_path))
+
     def set_device_target(self, target):
         valid_targets = ["CPU", "GPU", "Ascend", "Davinci"]
         if not target in valid_targets:
@@ -261,6 +267,7 @@ class _Context:
         'mode': set_mode,
         'backend_policy': set_backend_policy,
         'save_graphs_path': set_save_graphs_path,
+        'compile_cache_path': set_compile_cache_path,
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
@@ -481,7 +488,7 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, compile_cache_path=str, enable_parallel_infer=bool)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -507,10 +514,12 @@ def set_context(**kwargs):
     Common(CPU/GPU/Ascend)       Ascend                       GPU
     ===========================  ===========================  =================
     check_bprop                  enable_auto_mixed_precision  max_device_memory
-    device_id                    enable_dump
-    device_target                enable_profiling
-    enable_graph_kernel          variable_memory_max_size
-    enable_reduce_precision      print_file_path
+    compile_cache_path           enable_dump
+    device_id                    enable_profiling
+    device_target                variable_memory_max_size
+    enable_graph_kernel          print_file_path
+    enable_parallel_infer
+    enable_reduce_precision
     enable_sparse
     max_call_depth
     mode
@@ -562,6 +571,13 @@ def set_context(**kwargs):
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        compile_cache_path (str): Directory of the compile cache. In graph mode, the graphs optimized by the front end
+            are saved in this directory, and a later compilation of the same network with the same inputs and
+            context loads the graph instead of analyzing and optimizing it again. Graphs with control flow are not
+            cached. The cache is keyed on the network, so clear the directory after changing a user-defined bprop
+            function. An empty string disables the cache. Default: ''.
+        enable_parallel_infer (bool): Whether to infer the types and shapes of independent operators on several
+            threads when compiling a graph. The inferred graph is the same as with a single thread. Default: False.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -583,6 +599,8 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(compile_cache_path="./compile_cache")
+        >>> context.set_context(enable_parallel_infer=True)
     """
     ctx = _context()
     # set device target first
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_MEM_PLAN_H_
+#define MINDSPORE_CORE_UTILS_MEM_PLAN_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+inline size_t AlignMemBlockSize(size_t size, size_t align_size) {
+  return (size + align_size - 1) / align_size * align_size;
+}
+
+// Assign the offset_ of each block in one buffer and return the size of the buffer. A block has the members size_,
+// first_use_, last_use_ and offset_, it is alive from first_use_ to last_use_ included, in execution order. With
+// reuse, blocks whose lifetimes do not overlap may share memory, otherwise they are laid out one after the other.
+// The offsets and the sizes of the blocks are aligned to align_size.
+template <typename MemBlock>
+size_t AssignMemBlockOffsets(std::vector<MemBlock> *mem_blocks, size_t align_size, bool reuse) {
+  if (mem_blocks == nullptr) {
+    return 0;
+  }
+  size_t total_size = 0;
+  if (!reuse) {
+    for (auto &mem_block : *mem_blocks) {
+      mem_block.offset_ = total_size;
+      total_size += AlignMemBlockSize(mem_block.size_, align_size);
+    }
+    return total_size;
+  }
+
+  // Greedy by size: place the larger blocks first, each one into the smallest gap left between the already placed
+  // blocks whose lifetimes overlap with it.
+  std::vector<MemBlock *> order;
+  for (auto &mem_block : *mem_blocks) {
+    order.push_back(&mem_block);
+  }
+  std::stable_sort(order.begin(), order.end(), [](const MemBlock *a, const MemBlock *b) {
+    if (a->size_ != b->size_) {
+      return a->size_ > b->size_;
+    }
+    return a->first_use_ < b->first_use_;
+  });
+
+  std::vector<MemBlock *> placed;
+  for (auto mem_block : order) {
+    size_t block_size = AlignMemBlockSize(mem_block->size_, align_size);
+    std::vector<MemBlock *> overlapped;
+    for (auto placed_block : placed) {
+      if (placed_block->first_use_ <= mem_block->last_use_ && mem_block->first_use_ <= placed_block->last_use_) {
+        overlapped.push_back(placed_block);
+      }
+    }
+    std::sort(overlapped.begin(), overlapped.end(),
+              [](const MemBlock *a, const MemBlock *b) { return a->offset_ < b->offset_; });
+
+    size_t prev_end = 0;
+    size_t best_offset = SIZE_MAX;
+    size_t best_gap = SIZE_MAX;
+    for (auto overlapped_block : overlapped) {
+      if (overlapped_block->offset_ > prev_end) {
+        size_t gap = overlapped_block->offset_ - prev_end;
+        if (gap >= block_size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = prev_end;
+        }
+      }
+      prev_end = std::max(prev_end, overlapped_block->offset_ + AlignMemBlockSize(overlapped_block->size_, align_size));
+    }
+    mem_block->offset_ = best_offset == SIZE_MAX ? prev_end : best_offset;
+    total_size = std::max(total_size, mem_block->offset_ + block_size);
+    placed.push_back(mem_block);
+  }
+  return total_size;
+}
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_UTILS_MEM_PLAN_H_
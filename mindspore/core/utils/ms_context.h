@@ -62,6 +62,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_ENABLE_HCCL,
   MS_CTX_ENABLE_LOOP_SINK,
   MS_CTX_ENABLE_MEM_REUSE,
+  MS_CTX_ENABLE_PARALLEL_INFER,
   MS_CTX_ENABLE_PYNATIVE_HOOK,
   MS_CTX_ENABLE_PYNATIVE_INFER,
   MS_CTX_ENABLE_REDUCE_PRECISION,
@@ -96,6 +97,7 @@ enum MsCtxParam : unsigned {
   // paramater of type string
   MS_CTX_TYPE_STRING_BEGIN = MS_CTX_TYPE_FLOAT_END,
   MS_CTX_DEVICE_TARGET = MS_CTX_TYPE_STRING_BEGIN,
+  MS_CTX_COMPILE_CACHE_PATH,
   MS_CTX_GRAPH_MEMORY_MAX_SIZE,
   MS_CTX_PRINT_FILE_PATH,
   MS_CTX_PROFILING_OPTIONS,
@@ -197,6 +197,84 @@ def get_callback_timeout():
     return _config.get_callback_timeout()
 
 
+def set_enable_autotune(enable):
+    """
+    Set whether the pipeline autotuner runs while a dataset pipeline is executing.
+    The autotuner resizes the operator queues, whose default size is the prefetch size,
+    and the number of active workers of the map operators at run time. It logs the tuned
+    num_parallel_workers and queue sizes of each operator when the pipeline finishes.
+
+    Note:
+        With the autotuner enabled, a map operator launches spare worker threads, up to
+        the number of CPU cores, and runs num_parallel_workers of them at first. The
+        autotuner can only grow it within these threads. The worker threads of the other
+        operators cannot be added or removed, so their tuned num_parallel_workers are
+        advisory and only take effect when they are set on the operators of the next run.
+
+    Args:
+        enable (bool): Whether to enable the autotuner.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Enable the pipeline autotuner for the pipelines created afterwards.
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether the pipeline autotuner is enabled.
+
+    Returns:
+        Bool, true if the autotuner is enabled.
+    """
+    return _config.get_enable_autotune()
+
+
+def set_enable_image_fusion(enable):
+    """
+    Set whether a map of Decode, RandomResizedCrop, RandomHorizontalFlip, Normalize and HWC2CHW
+    is run as a single fused op when the dataset pipeline is optimized.
+
+    Note:
+        The fused op interpolates in float instead of the fixed-point arithmetic of OpenCV and
+        draws the flips from its own random generator, so its output is not bit identical to
+        the one of the separate ops.
+
+    Args:
+        enable (bool): Whether to fuse the image augmentation chains.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Fuse the image augmentation chains of the pipelines created afterwards.
+        >>> ds.config.set_enable_image_fusion(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean.")
+    _config.set_enable_image_fusion(enable)
+
+
+def get_enable_image_fusion():
+    """
+    Get whether the image augmentation chains are fused.
+
+    Returns:
+        Bool, true if the image augmentation chains are fused.
+    """
+    return _config.get_enable_image_fusion()
+
+
 def __str__():
     """
     String representation of the configurations.
@@ -47,6 +47,19 @@ class MS_API LiteSession {
   /// \return Pointer of MindSpore Lite LiteSession.
   static LiteSession *CreateSession(lite::Context *context);
 
+  /// \brief Static method to create a LiteSession pointer sharing the weights of a compiled session.
+  ///
+  /// \note The new session compiles the model of source and reuses its const tensors, and the sessions created from
+  /// one source share the packed weights of their kernels. It only owns activations and a thread pool of its own, so
+  /// sessions created this way can run concurrently. The model must not be freed and source must outlive the new
+  /// session. Give every session its own allocator or none.
+  ///
+  /// \param[in] context Define the context of session to be created.
+  /// \param[in] source Define a session whose model has been compiled.
+  ///
+  /// \return Pointer of MindSpore Lite LiteSession, the graph of which is already compiled.
+  static LiteSession *CreateSharedSession(lite::Context *context, const LiteSession *source);
+
   /// \brief Destructor of MindSpore Lite LiteSession.
   virtual ~LiteSession() = default;
 
@@ -35,7 +35,9 @@ struct Model {
   Uint32Vector input_indices_;
   Uint32Vector output_indices_;
   NodePtrVector nodes_;
-  char *buf;
+  char *buf = nullptr;
+  bool buf_mapped_ = false;
+  size_t mapped_size_ = 0;
 
   /// \brief Static method to create a Model pointer.
   ///
@@ -45,6 +47,16 @@ struct Model {
   /// \return Pointer of MindSpore Lite Model.
   static Model *Import(const char *model_buf, size_t size);
 
+  /// \brief Static method to create a Model pointer by mapping a model file into memory instead of copying it.
+  ///
+  /// \note Const tensors of sessions compiled from this model reference the mapped pages directly, so the model must
+  /// outlive those sessions. Free() keeps the mapping, it is released when the model is destroyed.
+  ///
+  /// \param[in] model_path Define the path of the model file.
+  ///
+  /// \return Pointer of MindSpore Lite Model.
+  static Model *ImportFromFile(const char *model_path);
+
   /// \brief Free meta graph temporary buffer
   virtual void Free();
 
@@ -16,10 +16,13 @@
 
 #include "nnacl/fp32/activation.h"
 #include "nnacl/errorcode.h"
+#ifdef ENABLE_SSE
+#include "nnacl/x86_64/sse_compat.h"
+#endif
 
 int Fp32Relu(const float *src, int length, float *dst) {
   int i = 0;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t zero_4 = vdupq_n_f32(0.0f);
   for (; i < length - 4; i += 4) {
     vst1q_f32(dst + i, vmaxq_f32(vld1q_f32(src + i), zero_4));
@@ -33,7 +36,7 @@ int Fp32Relu(const float *src, int length, float *dst) {
 
 int Fp32Relu6(const float *src, int length, float *dst) {
   int i = 0;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t zero_4 = vdupq_n_f32(0.0f);
   float32x4_t six_4 = vdupq_n_f32(6.0f);
   for (; i < length - 4; i += 4) {
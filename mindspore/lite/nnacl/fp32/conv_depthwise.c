@@ -20,10 +20,23 @@
 #ifdef ENABLE_ARM64
 #include <arm_neon.h>
 #endif
+#ifdef ENABLE_SSE
+#include "nnacl/x86_64/sse_compat.h"
+#endif
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/conv_depthwise_avx.h"
+#endif
 
 #ifndef ENABLE_ARM
 void ConvDwFp32Row(float *output_ptr, const float *input_ptr, const float *weight_ptr, int num_pixels,
                    int output_channel, int input_step) {
+#ifdef ENABLE_AVX
+  if (X86SupportAvx2Fma()) {
+    ConvDwFp32RowAvx2(output_ptr, input_ptr, weight_ptr, num_pixels, output_channel, input_step);
+    return;
+  }
+#endif
   for (int i = 0; i < num_pixels; i++) {
     for (int c = 0; c < output_channel; c++) {
       *output_ptr++ += weight_ptr[c] * input_ptr[c];
@@ -164,9 +177,13 @@ void DepthwiseBorderPixel(float *dst, const float *src, const float *weight, con
     const float *src_kw = src_kh;
     const float *weight_kw = weight_kh;
     for (int kw = 0; kw < width; kw++) {
+#ifdef ENABLE_SSE
+      vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(src_kw), vld1q_f32(weight_kw)));
+#else
       for (int c = 0; c < C4NUM; c++) {
         dst[c] += src_kw[c] * weight_kw[c];
       }
+#endif
       src_kw += in_kw_step;
       weight_kw += C4NUM;
     }  // kernel_w loop
@@ -235,9 +252,13 @@ void DepthwiseCenter(float *dst, const float *src, const float *weight, const fl
         const float *src_kw = src_kh;
         const float *weight_kw = weight_kh;
         for (int kw = 0; kw < kernel_w; kw++) {
+#ifdef ENABLE_SSE
+          vst1q_f32(dst_w, vmlaq_f32(vld1q_f32(dst_w), vld1q_f32(src_kw), vld1q_f32(weight_kw)));
+#else
           for (int c = 0; c < C4NUM; c++) {
             dst_w[c] += src_kw[c] * weight_kw[c];
           }
+#endif
           src_kw += in_kw_step;
           weight_kw += C4NUM;
         }  // kernel_w loop
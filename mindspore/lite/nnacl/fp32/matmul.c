@@ -15,6 +15,27 @@
  */
 
 #include "nnacl/fp32/matmul.h"
+#ifdef ENABLE_SSE
+#include <xmmintrin.h>
+#endif
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/matmul_avx.h"
+#endif
+
+#ifdef ENABLE_SSE
+static inline void Transpose4x4Sse(const float *src, size_t src_stride, float *dst, size_t dst_stride) {
+  __m128 r0 = _mm_loadu_ps(src);
+  __m128 r1 = _mm_loadu_ps(src + src_stride);
+  __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+  __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst, r0);
+  _mm_storeu_ps(dst + dst_stride, r1);
+  _mm_storeu_ps(dst + 2 * dst_stride, r2);
+  _mm_storeu_ps(dst + 3 * dst_stride, r3);
+}
+#endif
 
 void RowMajor2Row4Major(float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
@@ -182,6 +203,10 @@ void RowMajor2Col12Major(float *src_ptr, float *dst_ptr, size_t row, size_t col)
         :
         : [ dst_c ] "r"(dst_c), [ src_c ] "r"(src_c), [ stride ] "r"(stride)
         : "r10", "r12", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12", "q13", "q14", "q15");
+#elif ENABLE_SSE
+      for (int tr = 0; tr < C12NUM; tr += C4NUM) {
+        Transpose4x4Sse(src_c + tr * col, col, dst_c + tr, C12NUM);
+      }
 #else
       for (int tr = 0; tr < C12NUM; tr++) {
         for (int tc = 0; tc < C4NUM; tc++) {
@@ -281,6 +306,10 @@ void RowMajor2Col8Major(float *src_ptr, float *dst_ptr, size_t row, size_t col)
         : [ dst_c ] "r"(dst_c), [ src_c ] "r"(src_c), [ stride ] "r"(stride)
         : "x10", "x11", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9", "v10", "v11", "v12", "v13", "v14",
           "v15");
+#elif ENABLE_SSE
+      for (int tr = 0; tr < C8NUM; tr += C4NUM) {
+        Transpose4x4Sse(src_c + tr * col, col, dst_c + tr, C8NUM);
+      }
 #else
       for (int tr = 0; tr < 8; tr++) {
         for (int tc = 0; tc < 4; tc++) {
@@ -480,6 +509,18 @@ void MatMulOpt(const float *a, const float *b, float *c, const float *bias, ActT
   MatmulFloatNeon32Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, (int)(out_type == OutType_Nhwc),
                        (int)(out_type == OutType_TileC8));
 #else
+#ifdef ENABLE_AVX
+  if (out_type != OutType_TileC8) {
+    if (X86SupportAvx512()) {
+      MatMul12x8Avx512(a, b, c, bias, act_type, deep, row, col, stride, out_type);
+      return;
+    }
+    if (X86SupportAvx2Fma()) {
+      MatMul12x8Avx2(a, b, c, bias, act_type, deep, row, col, stride, out_type);
+      return;
+    }
+  }
+#endif
   MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
 #endif
 }
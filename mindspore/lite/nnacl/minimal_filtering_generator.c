@@ -156,7 +156,8 @@ int CookToomFilter(float *matrix_a, float *matrix_at, float *matrix_b, float *ma
                    float *matrix_gt, float coefficient, int out_unit, int filter_size) {
   int in_unit = out_unit + filter_size - 1;
   int degree = in_unit - 1;
-  if (degree > MAX_LEN || (in_unit * in_unit) > MAX_LEN || (in_unit * filter_size) > MAX_LEN) {
+  if (out_unit <= 0 || filter_size <= 0 || degree > MAX_LEN || (in_unit * in_unit) > MAX_LEN ||
+      (in_unit * filter_size) > MAX_LEN) {
     return NNACL_ERR;
   }
   float polynomial_m[MAX_LEN];             // degree
@@ -202,7 +203,7 @@ int CookToomFilter(float *matrix_a, float *matrix_at, float *matrix_b, float *ma
   return NNACL_OK;
 }
 
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
 void MatrixMultiplyVec(const float32x4_t *matrix_a, const float32x4_t *matrix_b, float32x4_t *matrix_c,
                        const float *bias, int m, int k, int n) {
   if (bias == NULL) {
@@ -19,6 +19,8 @@
 
 #ifdef ENABLE_ARM
 #include <arm_neon.h>
+#elif defined(ENABLE_SSE)
+#include "nnacl/x86_64/sse_compat.h"
 #endif
 
 #ifdef __cplusplus
@@ -45,7 +47,7 @@ void MatrixMultiply(const float *matrix_a, const float *matrix_b, float *matrix_
 int CookToomFilter(float *matrix_a, float *matrix_at, float *matrix_b, float *matrix_bt, float *matrix_g,
                    float *matrix_gt, float coefficient, int out_unit, int filter_size);
 
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
 void MatrixMultiplyVec(const float32x4_t *matrix_a, const float32x4_t *matrix_b, float32x4_t *matrix_c,
                        const float *bias, int m, int k, int n);
 #endif
@@ -73,8 +73,8 @@ static OutputTransFunc OutputTransFuncRelu6List8[] = {NULL,
 void GeneralInputTransformUnit(const float *src_data, float *dst_data, float *matrix_b, float *matrix_bt, int src_step,
                                int dst_step, int in_unit) {
   int len = in_unit * in_unit;
-  if (len > MAX_LEN) return;
-#ifdef ENABLE_ARM
+  if (len <= 0 || len > MAX_LEN) return;
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[MAX_LEN];
   float32x4_t t[MAX_LEN];
   float32x4_t m[MAX_LEN];
@@ -113,7 +113,7 @@ void GeneralOutputTransformUnit(const float *src_data, float *dst_data, const fl
   if (src_len > MAX_LEN) {
     return;
   }
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[MAX_LEN];
   float32x4_t t[MAX_LEN];
   float32x4_t m[MAX_LEN];
@@ -167,7 +167,7 @@ void GeneralOutputTransformUnit(const float *src_data, float *dst_data, const fl
 InputTransFunc GetInputTransFunc(int input_unit) { return InputTransFuncList[input_unit]; }
 
 void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[16];
   float32x4_t m[16];
@@ -219,7 +219,7 @@ void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step,
 }
 
 void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[36];
   float32x4_t m[36];
@@ -291,7 +291,7 @@ void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step,
 }
 
 void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[64];
   float32x4_t m[64];
@@ -423,7 +423,7 @@ OutputTransFunc GetOutputTransFunc(int input_unit, int output_unit, ActType act_
 
 void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -485,7 +485,7 @@ void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -552,7 +552,7 @@ void OutputTransform4x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform4x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -623,7 +623,7 @@ void OutputTransform4x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -691,7 +691,7 @@ void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -765,7 +765,7 @@ void OutputTransform4x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform4x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -844,7 +844,7 @@ void OutputTransform4x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -914,7 +914,7 @@ void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -989,7 +989,7 @@ void OutputTransform6x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -1068,7 +1068,7 @@ void OutputTransform6x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1141,7 +1141,7 @@ void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1220,7 +1220,7 @@ void OutputTransform6x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1304,7 +1304,7 @@ void OutputTransform6x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1382,7 +1382,7 @@ void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x4ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1467,7 +1467,7 @@ void OutputTransform6x4ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x4Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1558,7 +1558,7 @@ void OutputTransform6x4Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1640,7 +1640,7 @@ void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x5ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1730,7 +1730,7 @@ void OutputTransform6x5ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x5Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1827,7 +1827,7 @@ void OutputTransform6x5Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -1905,7 +1905,7 @@ void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -1988,7 +1988,7 @@ void OutputTransform8x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -2066,7 +2066,7 @@ void OutputTransform8x2Relu6Unit(const float *src_data, float *dst_data, const f
         float out_value = m[j + m_k_offset] + bias_data[i];
         out_value = out_value > 0 ? out_value : 0;
         out_value = out_value < 6 ? out_value : 6;
-        dst_data[i + dst_k_offset + j * out_c] = m[j + m_k_offset] + bias_data[i];
+        dst_data[i + dst_k_offset + j * out_c] = out_value;
       }
     }
   }
@@ -2075,7 +2075,7 @@ void OutputTransform8x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2160,7 +2160,7 @@ void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2251,7 +2251,7 @@ void OutputTransform8x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2347,7 +2347,7 @@ void OutputTransform8x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2439,7 +2439,7 @@ void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x4ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2538,7 +2538,7 @@ void OutputTransform8x4ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x4Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2643,7 +2643,7 @@ void OutputTransform8x4Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2741,7 +2741,7 @@ void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x5ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2847,7 +2847,7 @@ void OutputTransform8x5ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x5Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2960,7 +2960,7 @@ void OutputTransform8x5Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3073,7 +3073,7 @@ void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x6ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3195,7 +3195,7 @@ void OutputTransform8x6ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x6Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3325,7 +3325,7 @@ void OutputTransform8x6Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
@@ -3445,7 +3445,7 @@ void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x7ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
@@ -3575,7 +3575,7 @@ void OutputTransform8x7ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x7Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
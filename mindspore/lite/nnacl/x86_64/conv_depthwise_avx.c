@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/conv_depthwise_avx.h"
+#include <immintrin.h>
+
+__attribute__((target("avx2,fma"))) void ConvDwFp32RowAvx2(float *output_ptr, const float *input_ptr,
+                                                           const float *weight_ptr, int num_pixels,
+                                                           int output_channel, int input_step) {
+  for (int i = 0; i < num_pixels; i++) {
+    int c = 0;
+    for (; c <= output_channel - C8NUM; c += C8NUM) {
+      __m256 out = _mm256_loadu_ps(output_ptr + c);
+      out = _mm256_fmadd_ps(_mm256_loadu_ps(weight_ptr + c), _mm256_loadu_ps(input_ptr + c), out);
+      _mm256_storeu_ps(output_ptr + c, out);
+    }
+    for (; c < output_channel; c++) {
+      output_ptr[c] += weight_ptr[c] * input_ptr[c];
+    }
+    output_ptr += output_channel;
+    input_ptr += input_step;
+  }
+}
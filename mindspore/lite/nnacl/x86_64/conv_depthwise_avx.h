@@ -0,0 +1,32 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_CONV_DEPTHWISE_AVX_H_
+#define MINDSPORE_LITE_NNACL_X86_64_CONV_DEPTHWISE_AVX_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* Same contract as the c ConvDwFp32Row, callers must check X86SupportAvx2Fma first. */
+void ConvDwFp32RowAvx2(float *output_ptr, const float *input_ptr, const float *weight_ptr, int num_pixels,
+                       int output_channel, int input_step);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_CONV_DEPTHWISE_AVX_H_
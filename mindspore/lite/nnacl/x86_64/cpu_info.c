@@ -0,0 +1,38 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/cpu_info.h"
+
+#define CPU_FEATURE_UNKNOWN (-1)
+
+static int g_support_avx2_fma = CPU_FEATURE_UNKNOWN;
+static int g_support_avx512 = CPU_FEATURE_UNKNOWN;
+
+bool X86SupportAvx2Fma(void) {
+  if (g_support_avx2_fma == CPU_FEATURE_UNKNOWN) {
+    __builtin_cpu_init();
+    g_support_avx2_fma = (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? 1 : 0;
+  }
+  return g_support_avx2_fma == 1;
+}
+
+bool X86SupportAvx512(void) {
+  if (g_support_avx512 == CPU_FEATURE_UNKNOWN) {
+    __builtin_cpu_init();
+    g_support_avx512 = (X86SupportAvx2Fma() && __builtin_cpu_supports("avx512f")) ? 1 : 0;
+  }
+  return g_support_avx512 == 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/matmul_avx.h"
+#include <string.h>
+#include <immintrin.h>
+#include "nnacl/matmul_parameter.h"
+
+/* One 12x8 tile keeps twelve ymm accumulators live, b is loaded once per depth step and each a value is broadcast. */
+#define TILE_ROW_NUM C12NUM
+
+__attribute__((target("avx2,fma"))) static void StoreTileAvx2(__m256 *acc, float *dst, const float *bias,
+                                                              ActType act_type, int row_valid, int col_valid,
+                                                              int dst_row_step) {
+  float bias_buf[C8NUM] = {0};
+  if (bias != NULL) {
+    memcpy(bias_buf, bias, col_valid * sizeof(float));
+  }
+  __m256 bias_v = _mm256_loadu_ps(bias_buf);
+  __m256 zero_v = _mm256_setzero_ps();
+  __m256 six_v = _mm256_set1_ps(6.0f);
+  for (int i = 0; i < row_valid; i++) {
+    __m256 v = _mm256_add_ps(acc[i], bias_v);
+    if (act_type == ActType_Relu6) v = _mm256_min_ps(v, six_v);
+    if (act_type != ActType_No) v = _mm256_max_ps(v, zero_v);
+    float *dst_r = dst + i * dst_row_step;
+    if (col_valid == C8NUM) {
+      _mm256_storeu_ps(dst_r, v);
+    } else {
+      float tmp[C8NUM];
+      _mm256_storeu_ps(tmp, v);
+      memcpy(dst_r, tmp, col_valid * sizeof(float));
+    }
+  }
+}
+
+__attribute__((target("avx2,fma"))) static void Tile12x8Avx2(const float *a, const float *b, int deep, __m256 *acc) {
+  __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps(), c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+  __m256 c4 = _mm256_setzero_ps(), c5 = _mm256_setzero_ps(), c6 = _mm256_setzero_ps(), c7 = _mm256_setzero_ps();
+  __m256 c8 = _mm256_setzero_ps(), c9 = _mm256_setzero_ps(), c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  for (int d = 0; d < deep; d++) {
+    __m256 bv = _mm256_loadu_ps(b);
+    c0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 0), bv, c0);
+    c1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 1), bv, c1);
+    c2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 2), bv, c2);
+    c3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 3), bv, c3);
+    c4 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 4), bv, c4);
+    c5 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 5), bv, c5);
+    c6 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 6), bv, c6);
+    c7 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 7), bv, c7);
+    c8 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 8), bv, c8);
+    c9 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 9), bv, c9);
+    c10 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 10), bv, c10);
+    c11 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 11), bv, c11);
+    a += C12NUM;
+    b += C8NUM;
+  }
+  acc[0] = c0, acc[1] = c1, acc[2] = c2, acc[3] = c3, acc[4] = c4, acc[5] = c5;
+  acc[6] = c6, acc[7] = c7, acc[8] = c8, acc[9] = c9, acc[10] = c10, acc[11] = c11;
+}
+
+/* Runs the 8-wide tile for columns [col_start, col) of one 12-row block. */
+__attribute__((target("avx2,fma"))) static void MatMulRowBlockAvx2(const float *a, const float *b, float *dst,
+                                                                   const float *bias, ActType act_type, int deep,
+                                                                   int r, int row, int col_start, int col,
+                                                                   int stride, int out_type) {
+  int row_12 = UP_ROUND(row, C12NUM);
+  __m256 acc[TILE_ROW_NUM];
+  for (int c = col_start; c < col; c += C8NUM) {
+    Tile12x8Avx2(a + r * deep, b + c * deep, deep, acc);
+    const float *bias_c = bias == NULL ? NULL : bias + c;
+    if (out_type == OutType_Nhwc) {
+      StoreTileAvx2(acc, dst + r * stride + c, bias_c, act_type, MSMIN(C12NUM, row - r), MSMIN(C8NUM, col - c),
+                    stride);
+    } else {
+      /* C8 output keeps the padded rows and columns, like the reference kernel */
+      StoreTileAvx2(acc, dst + c * row_12 + r * C8NUM, bias_c, act_type, C12NUM, C8NUM, C8NUM);
+    }
+  }
+}
+
+void MatMul12x8Avx2(const float *a, const float *b, float *dst, const float *bias, ActType act_type, int deep, int row,
+                    int col, int stride, int out_type) {
+  for (int r = 0; r < row; r += C12NUM) {
+    MatMulRowBlockAvx2(a, b, dst, bias, act_type, deep, r, row, 0, col, stride, out_type);
+  }
+}
+
+/* Two adjacent col8 blocks of b form one zmm, so a 12x16 tile halves the number of a broadcasts per flop. */
+__attribute__((target("avx512f,avx2,fma"))) static inline __m512 LoadB16(const float *b0, const float *b1) {
+  __m512d lo = _mm512_castpd256_pd512(_mm256_castps_pd(_mm256_loadu_ps(b0)));
+  return _mm512_castpd_ps(_mm512_insertf64x4(lo, _mm256_castps_pd(_mm256_loadu_ps(b1)), 1));
+}
+
+__attribute__((target("avx512f,avx2,fma"))) static void Tile12x16Avx512(const float *a, const float *b, int deep,
+                                                                         __m512 *acc) {
+  const float *b0 = b;
+  const float *b1 = b + deep * C8NUM;
+  __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps(), c3 = _mm512_setzero_ps();
+  __m512 c4 = _mm512_setzero_ps(), c5 = _mm512_setzero_ps(), c6 = _mm512_setzero_ps(), c7 = _mm512_setzero_ps();
+  __m512 c8 = _mm512_setzero_ps(), c9 = _mm512_setzero_ps(), c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+  for (int d = 0; d < deep; d++) {
+    __m512 bv = LoadB16(b0, b1);
+    c0 = _mm512_fmadd_ps(_mm512_set1_ps(a[0]), bv, c0);
+    c1 = _mm512_fmadd_ps(_mm512_set1_ps(a[1]), bv, c1);
+    c2 = _mm512_fmadd_ps(_mm512_set1_ps(a[2]), bv, c2);
+    c3 = _mm512_fmadd_ps(_mm512_set1_ps(a[3]), bv, c3);
+    c4 = _mm512_fmadd_ps(_mm512_set1_ps(a[4]), bv, c4);
+    c5 = _mm512_fmadd_ps(_mm512_set1_ps(a[5]), bv, c5);
+    c6 = _mm512_fmadd_ps(_mm512_set1_ps(a[6]), bv, c6);
+    c7 = _mm512_fmadd_ps(_mm512_set1_ps(a[7]), bv, c7);
+    c8 = _mm512_fmadd_ps(_mm512_set1_ps(a[8]), bv, c8);
+    c9 = _mm512_fmadd_ps(_mm512_set1_ps(a[9]), bv, c9);
+    c10 = _mm512_fmadd_ps(_mm512_set1_ps(a[10]), bv, c10);
+    c11 = _mm512_fmadd_ps(_mm512_set1_ps(a[11]), bv, c11);
+    a += C12NUM;
+    b0 += C8NUM;
+    b1 += C8NUM;
+  }
+  acc[0] = c0, acc[1] = c1, acc[2] = c2, acc[3] = c3, acc[4] = c4, acc[5] = c5;
+  acc[6] = c6, acc[7] = c7, acc[8] = c8, acc[9] = c9, acc[10] = c10, acc[11] = c11;
+}
+
+__attribute__((target("avx512f,avx2,fma"))) static void StoreTileAvx512(__m512 *acc, float *dst, const float *bias,
+                                                                         ActType act_type, int row_valid,
+                                                                         int col_valid, int stride, int row_12,
+                                                                         int out_type) {
+  float bias_buf[C16NUM] = {0};
+  if (bias != NULL) {
+    memcpy(bias_buf, bias, col_valid * sizeof(float));
+  }
+  __m512 bias_v = _mm512_loadu_ps(bias_buf);
+  __m512 zero_v = _mm512_setzero_ps();
+  __m512 six_v = _mm512_set1_ps(6.0f);
+  for (int i = 0; i < row_valid; i++) {
+    __m512 v = _mm512_add_ps(acc[i], bias_v);
+    if (act_type == ActType_Relu6) v = _mm512_min_ps(v, six_v);
+    if (act_type != ActType_No) v = _mm512_max_ps(v, zero_v);
+    if (out_type == OutType_Nhwc) {
+      float *dst_r = dst + i * stride;
+      if (col_valid == C16NUM) {
+        _mm512_storeu_ps(dst_r, v);
+      } else {
+        float tmp[C16NUM];
+        _mm512_storeu_ps(tmp, v);
+        memcpy(dst_r, tmp, col_valid * sizeof(float));
+      }
+    } else {
+      __m512d vd = _mm512_castps_pd(v);
+      _mm256_storeu_ps(dst + i * C8NUM, _mm256_castpd_ps(_mm512_castpd512_pd256(vd)));
+      _mm256_storeu_ps(dst + row_12 * C8NUM + i * C8NUM, _mm256_castpd_ps(_mm512_extractf64x4_pd(vd, 1)));
+    }
+  }
+}
+
+void MatMul12x8Avx512(const float *a, const float *b, float *dst, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride, int out_type) {
+  int row_12 = UP_ROUND(row, C12NUM);
+  __m512 acc[TILE_ROW_NUM];
+  for (int r = 0; r < row; r += C12NUM) {
+    int c = 0;
+    for (; c + C8NUM < col; c += C16NUM) {
+      Tile12x16Avx512(a + r * deep, b + c * deep, deep, acc);
+      const float *bias_c = bias == NULL ? NULL : bias + c;
+      if (out_type == OutType_Nhwc) {
+        StoreTileAvx512(acc, dst + r * stride + c, bias_c, act_type, MSMIN(C12NUM, row - r), MSMIN(C16NUM, col - c),
+                        stride, row_12, out_type);
+      } else {
+        StoreTileAvx512(acc, dst + c * row_12 + r * C8NUM, bias_c, act_type, C12NUM, C16NUM, stride, row_12,
+                        out_type);
+      }
+    }
+    if (c < col) {
+      MatMulRowBlockAvx2(a, b, dst, bias, act_type, deep, r, row, c, col, stride, out_type);
+    }
+  }
+}
@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
+#define MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* Same packed layouts as MatMul12x8: a is col12-major, b is col8-major, out_type is OutType_Nhwc or OutType_C8.
+ * Callers must check X86SupportAvx2Fma / X86SupportAvx512 first. */
+void MatMul12x8Avx2(const float *a, const float *b, float *dst, const float *bias, ActType act_type, int deep, int row,
+                    int col, int stride, int out_type);
+void MatMul12x8Avx512(const float *a, const float *b, float *dst, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride, int out_type);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
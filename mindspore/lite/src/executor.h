@@ -30,6 +30,9 @@ class Executor {
 
   virtual int Prepare(std::vector<kernel::LiteKernel *> &kernels) { return 0; }
 
+  // whether kernels run one by one in the scheduled order, the arena planner only reuses memory if they do
+  virtual bool RunInKernelOrder() const { return true; }
+
   virtual int Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
                   std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
                   const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr);
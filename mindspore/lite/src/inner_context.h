@@ -17,14 +17,18 @@
 #ifndef MINDSPORE_LITE_SRC_INNER_CONTEXT_H
 #define MINDSPORE_LITE_SRC_INNER_CONTEXT_H
 
+#include <memory>
 #include "include/context.h"
 #include "src/runtime/runtime_api.h"
 #include "src/runtime/allocator.h"
+#include "src/runtime/packed_weight_cache.h"
 
 namespace mindspore::lite {
 struct InnerContext : public Context {
  public:
   struct ThreadPool *thread_pool_ = nullptr;
+  // packed weights, shared by the sessions created from one compiled session, null for the other sessions
+  std::shared_ptr<PackedWeightCache> weight_cache_ = nullptr;
 
  public:
   int Init();
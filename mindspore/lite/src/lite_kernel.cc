@@ -24,6 +24,35 @@ void LiteKernel::InitOutTensorRefCount() {
   }
 }
 
+void *LiteKernel::MallocPackedWeight(const void *origin, const std::string &kind, size_t size,
+                                     const std::function<int(void *)> &pack) {
+  // only the weights of a shared model go to the cache, transient origins like dequantized weights are packed here
+  if (context_ != nullptr && context_->weight_cache_ != nullptr && context_->weight_cache_->IsWeight(origin)) {
+    return context_->weight_cache_->GetOrPack(origin, kind, size, pack);
+  }
+  auto packed = malloc(size);
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed, name: " << name_;
+    return nullptr;
+  }
+  if (pack(packed) != RET_OK) {
+    MS_LOG(ERROR) << "pack weight failed, name: " << name_;
+    free(packed);
+    return nullptr;
+  }
+  return packed;
+}
+
+void LiteKernel::FreePackedWeight(void *packed) {
+  if (packed == nullptr) {
+    return;
+  }
+  if (context_ != nullptr && context_->weight_cache_ != nullptr && context_->weight_cache_->Release(packed)) {
+    return;
+  }
+  free(packed);
+}
+
 int LiteKernel::DecOutTensorRefCount() {
   for (auto *tensor : this->out_tensors_) {
     tensor->decRefCount();
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_LITE_SRC_LITE_KERNEL_H_
 #define MINDSPORE_LITE_SRC_LITE_KERNEL_H_
+#include <functional>
 #include <vector>
 #include <string>
 #include "src/common/utils.h"
@@ -146,9 +147,18 @@ class LiteKernel {
 
   const mindspore::lite::PrimitiveC *GetPrimitive() const { return primitive_; }
 
- protected:
+  const lite::InnerContext *context() const { return context_; }
+
+  // Packs a const weight through the weight cache of the context, sessions sharing the cache share the buffer.
+  // The buffer must be treated as read only and released with FreePackedWeight.
+  void *MallocPackedWeight(const void *origin, const std::string &kind, size_t size,
+                           const std::function<int(void *)> &pack);
+
+  void FreePackedWeight(void *packed);
+
   bool InferShapeDone() { return !(primitive_ != nullptr && !primitive_->GetInferFlag()) && true; }
 
+ protected:
   KernelKey desc_;
   std::string name_;
   OpParameter *op_parameter_ = nullptr;
@@ -87,7 +87,12 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
         dstTensor->set_shape(shape);
       }
       MS_ASSERT(dstTensor->Size() == srcTensor->data()->size());
-      if (WeightTensorNeedCopy(model, i)) {
+      if (weight_source_ != nullptr && !IsContain(model->input_indices_, i)) {
+        // the same address is registered in the packed weight cache of the source session
+        MS_ASSERT(i < weight_source_->tensors_.size());
+        dstTensor->SetData(weight_source_->tensors_.at(i)->data_c());
+      } else if (!model->buf_mapped_ && WeightTensorNeedCopy(model, i)) {
+        // a mapped model stays alive with the session, so every weight can reference the mapped pages directly
         auto dst_data = dstTensor->MutableData();
         if (dst_data == nullptr) {
           MS_LOG(ERROR) << "MutableData from " << i << "th tensor is nullptr";
@@ -264,6 +269,13 @@ int LiteSession::CompileGraph(Model *model) {
     return RET_PARAM_INVALID;
   }
 
+  if (weight_source_ != nullptr && model != weight_source_->model_) {
+    MS_LOG(ERROR) << "A session sharing weights can only compile the model of its source session.";
+    is_running_.store(false);
+    return RET_PARAM_INVALID;
+  }
+  model_ = model;
+
   auto ret = ConvertTensors(model);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "ConvertTensors failed: " << ret;
@@ -287,10 +299,33 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
+  ret = PlanArena();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Plan arena failed: " << ret;
+    is_running_.store(false);
+    return ret;
+  }
   is_running_.store(false);
   return RET_OK;
 }
 
+int LiteSession::PlanArena() {
+  if (arena_planner_ == nullptr) {
+    arena_planner_ = new (std::nothrow) ArenaPlanner(context_->allocator.get());
+    if (arena_planner_ == nullptr) {
+      MS_LOG(ERROR) << "New ArenaPlanner failed";
+      return RET_MEMORY_FAILED;
+    }
+  }
+#ifdef SUPPORT_TRAIN
+  // train sessions switch their outputs and run kernel subsets, so every tensor keeps its own block
+  bool reuse_memory = false;
+#else
+  bool reuse_memory = executor->RunInKernelOrder();
+#endif
+  return arena_planner_->Plan(kernels_, outputs_, reuse_memory);
+}
+
 std::vector<mindspore::tensor::MSTensor *> LiteSession::GetInputs() const { return this->input_vec_; }
 
 int LiteSession::RunGraph(const session::KernelCallBack &before, const session::KernelCallBack &after) {
@@ -301,6 +336,9 @@ int LiteSession::RunGraph(const session::KernelCallBack &before, const session::
   }
   STATUS ret = RET_ERROR;
   MS_ASSERT(this->context_);
+  if (arena_planner_ != nullptr) {
+    arena_planner_->Bind();
+  }
   if (before == nullptr && after == nullptr) {
     ret = executor->Run(this->inputs_, this->outputs_, this->kernels_, this->context_->allocator.get());
   } else {
@@ -363,6 +401,47 @@ int LiteSession::Init(Context *context) {
   return RET_OK;
 }
 
+int LiteSession::ShareWeightsFrom(const LiteSession *source) {
+  if (source == nullptr || source->model_ == nullptr) {
+    MS_LOG(ERROR) << "The source session has not compiled a model.";
+    return RET_PARAM_INVALID;
+  }
+  if (model_ != nullptr) {
+    MS_LOG(ERROR) << "Weights can only be shared before CompileGraph.";
+    return RET_ERROR;
+  }
+  MS_ASSERT(this->context_ != nullptr);
+  weight_source_ = source;
+#ifndef SUPPORT_TRAIN
+  // training updates weights in place, so packed weights are only cached for inference
+  this->context_->weight_cache_ = source->GetSharedWeightCache();
+#endif
+  return RET_OK;
+}
+
+std::shared_ptr<PackedWeightCache> LiteSession::GetSharedWeightCache() const {
+  if (weight_source_ != nullptr) {
+    // this session already shares the weights of another one, every session of the model uses the same cache
+    return weight_source_->GetSharedWeightCache();
+  }
+  std::lock_guard<std::mutex> lock(weight_cache_mutex_);
+  if (shared_weight_cache_ != nullptr) {
+    return shared_weight_cache_;
+  }
+  auto cache = std::make_shared<PackedWeightCache>();
+  MS_ASSERT(model_ != nullptr);
+  // the sessions sharing this one point their const tensors at the same data, see ConvertTensors
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    auto tensor = tensors_[i];
+    if (tensor->category() == Tensor::Category::CONST && tensor->data_c() != nullptr &&
+        !IsContain(model_->input_indices_, static_cast<uint32_t>(i))) {
+      cache->AddWeight(tensor->data_c(), i);
+    }
+  }
+  shared_weight_cache_ = cache;
+  return shared_weight_cache_;
+}
+
 void LiteSession::BindThread(bool if_bind) {
   if (this->context_->cpu_bind_mode_ != NO_BIND) {
     MS_ASSERT(this->context_->thread_pool_ != NULL);
@@ -394,6 +473,9 @@ LiteSession::~LiteSession() {
   for (auto *kernel : kernels_) {
     delete kernel;
   }
+  // planned tensors hold the arena allocator, so the planner goes after them
+  delete this->arena_planner_;
+  this->arena_planner_ = nullptr;
 #if SUPPORT_GPU
   if (context_->device_type_ == DT_GPU) {
     lite::opencl::OpenCLRuntime::DeleteInstance();
@@ -499,6 +581,12 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     is_running_.store(false);
     return ret;
   }
+  ret = PlanArena();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Replan arena after resize failed: " << ret;
+    is_running_.store(false);
+    return ret;
+  }
   is_running_.store(false);
   return RET_OK;
 }
@@ -514,4 +602,36 @@ session::LiteSession *session::LiteSession::CreateSession(lite::Context *context
   }
   return session;
 }
+
+session::LiteSession *session::LiteSession::CreateSharedSession(lite::Context *context, const LiteSession *source) {
+  auto source_session = static_cast<const lite::LiteSession *>(source);
+  if (source_session == nullptr || source_session->model() == nullptr) {
+    MS_LOG(ERROR) << "The source session has not compiled a model.";
+    return nullptr;
+  }
+  auto session = new (std::nothrow) lite::LiteSession();
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "new session failed";
+    return nullptr;
+  }
+  auto ret = session->Init(context);
+  if (ret != mindspore::lite::RET_OK) {
+    MS_LOG(ERROR) << "init sesssion failed";
+    delete session;
+    return nullptr;
+  }
+  ret = session->ShareWeightsFrom(source_session);
+  if (ret != mindspore::lite::RET_OK) {
+    MS_LOG(ERROR) << "share weights failed";
+    delete session;
+    return nullptr;
+  }
+  ret = session->CompileGraph(const_cast<lite::Model *>(source_session->model()));
+  if (ret != mindspore::lite::RET_OK) {
+    MS_LOG(ERROR) << "compile graph failed";
+    delete session;
+    return nullptr;
+  }
+  return session;
+}
 }  // namespace mindspore
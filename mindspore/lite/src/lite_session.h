@@ -22,6 +22,7 @@
 #include <string>
 #include <unordered_map>
 #include <atomic>
+#include <mutex>
 #include "src/lite_kernel.h"
 #include "include/ms_tensor.h"
 #include "include/lite_session.h"
@@ -30,6 +31,7 @@
 #include "schema/model_generated.h"
 #include "src/executor.h"
 #include "src/tensor.h"
+#include "src/runtime/arena_planner.h"
 
 namespace mindspore {
 namespace lite {
@@ -63,6 +65,15 @@ class LiteSession : public session::LiteSession {
   int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
              const std::vector<std::vector<int>> &dims) override;
 
+  // must be called after Init and before CompileGraph, source must have compiled its model
+  int ShareWeightsFrom(const LiteSession *source);
+
+  const Model *model() const { return this->model_; }
+
+  // The cache of the packed weights shared by the sessions sharing the weights of this one, created with the first of
+  // them. The kernels of this session keep their own packed weights.
+  std::shared_ptr<PackedWeightCache> GetSharedWeightCache() const;
+
  protected:
   int ConvertTensors(const lite::Model *model);
 
@@ -84,6 +95,8 @@ class LiteSession : public session::LiteSession {
 
   int ResizeInputs(const std::vector<mindspore::tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims);
 
+  int PlanArena();
+
  private:
   void ResetInputsShape(const std::vector<std::vector<int>> &dims);
 
@@ -107,6 +120,12 @@ class LiteSession : public session::LiteSession {
   // graph output tensor name -- output tensor
   std::unordered_map<std::string, mindspore::tensor::MSTensor *> output_tensor_map_;
   Executor *executor = nullptr;
+  ArenaPlanner *arena_planner_ = nullptr;
+  const Model *model_ = nullptr;
+  // const tensors reference the data of this session instead of holding their own copy
+  const LiteSession *weight_source_ = nullptr;
+  mutable std::mutex weight_cache_mutex_;
+  mutable std::shared_ptr<PackedWeightCache> shared_weight_cache_ = nullptr;
   std::atomic<bool> is_running_ = false;
 };
 }  // namespace lite
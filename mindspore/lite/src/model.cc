@@ -13,6 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+#include <vector>
 #include "src/ops/primitive_c.h"
 #include "include/model.h"
 #include "utils/log_adapter.h"
@@ -68,6 +78,66 @@ bool ConvertTensors(const schema::MetaGraph *meta_graph, Model *model) {
   return true;
 }
 
+namespace {
+bool InitModelFromBuf(Model *model) {
+  auto meta_graph = schema::GetMetaGraph(model->buf);
+  if (meta_graph == nullptr) {
+    MS_LOG(ERROR) << "meta_graph is nullptr!";
+    return false;
+  }
+
+  if (meta_graph->name() != nullptr) {
+    model->name_ = meta_graph->name()->c_str();
+  }
+  if (meta_graph->version() != nullptr) {
+    model->version_ = meta_graph->version()->c_str();
+  }
+
+  if (model->version_ != Version()) {
+    MS_LOG(WARNING) << "model version is " << model->version_ << ", inference version is " << Version() << " not equal";
+  }
+
+  auto in_count = meta_graph->inputIndex()->size();
+  for (uint32_t i = 0; i < in_count; ++i) {
+    model->input_indices_.push_back(size_t(meta_graph->inputIndex()->GetAs<uint32_t>(i)));
+  }
+
+  auto out_count = meta_graph->outputIndex()->size();
+  for (uint32_t i = 0; i < out_count; ++i) {
+    model->output_indices_.push_back(size_t(meta_graph->outputIndex()->GetAs<uint32_t>(i)));
+  }
+  if (!ConvertNodes(meta_graph, model)) {
+    return false;
+  }
+  return ConvertTensors(meta_graph, model);
+}
+
+#ifndef _WIN32
+char *MapModelFile(const char *model_path, size_t *size) {
+  int fd = open(model_path, O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "open model file " << model_path << " failed";
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "model file " << model_path << " is empty or can not be stat";
+    close(fd);
+    return nullptr;
+  }
+  *size = static_cast<size_t>(file_stat.st_size);
+  // a private writable mapping: the file is never modified, a kernel writing to a weight only copies the touched page
+  auto addr = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap model file " << model_path << " failed";
+    return nullptr;
+  }
+  return reinterpret_cast<char *>(addr);
+}
+#endif
+}  // namespace
+
 Model *Model::Import(const char *model_buf, size_t size) {
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "The model buf is nullptr";
@@ -90,46 +160,60 @@ Model *Model::Import(const char *model_buf, size_t size) {
     return nullptr;
   }
   memcpy(model->buf, model_buf, size);
-  auto meta_graph = schema::GetMetaGraph(model->buf);
-  if (meta_graph == nullptr) {
-    MS_LOG(ERROR) << "meta_graph is nullptr!";
-    delete(model);
+  if (!InitModelFromBuf(model)) {
+    delete model;
     return nullptr;
   }
+  return model;
+}
 
-  if (meta_graph->name() != nullptr) {
-    model->name_ = meta_graph->name()->c_str();
-  }
-  if (meta_graph->version() != nullptr) {
-    model->version_ = meta_graph->version()->c_str();
+Model *Model::ImportFromFile(const char *model_path) {
+  if (model_path == nullptr) {
+    MS_LOG(ERROR) << "The model path is nullptr";
+    return nullptr;
   }
-
-  if (model->version_ != Version()) {
-    MS_LOG(WARNING) << "model version is " << model->version_ << ", inference version is " << Version() << " not equal";
+#ifdef _WIN32
+  std::ifstream ifs(model_path, std::ios::binary);
+  if (!ifs.good()) {
+    MS_LOG(ERROR) << "open model file " << model_path << " failed";
+    return nullptr;
   }
-
-  auto in_count = meta_graph->inputIndex()->size();
-  for (uint32_t i = 0; i < in_count; ++i) {
-    model->input_indices_.push_back(size_t(meta_graph->inputIndex()->GetAs<uint32_t>(i)));
+  std::vector<char> content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  return Import(content.data(), content.size());
+#else
+  size_t size = 0;
+  char *mapped_buf = MapModelFile(model_path, &size);
+  if (mapped_buf == nullptr) {
+    return nullptr;
   }
-
-  auto out_count = meta_graph->outputIndex()->size();
-  for (uint32_t i = 0; i < out_count; ++i) {
-    model->output_indices_.push_back(size_t(meta_graph->outputIndex()->GetAs<uint32_t>(i)));
+  flatbuffers::Verifier verify((const uint8_t *)mapped_buf, size);
+  if (!schema::VerifyMetaGraphBuffer(verify)) {
+    MS_LOG(ERROR) << "The model file is invalid and fail to create graph.";
+    munmap(mapped_buf, size);
+    return nullptr;
   }
-  if (!ConvertNodes(meta_graph, model)) {
-    delete model;
+  Model *model = new (std::nothrow) Model();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model fail!";
+    munmap(mapped_buf, size);
     return nullptr;
   }
-
-  if (!ConvertTensors(meta_graph, model)) {
+  model->buf = mapped_buf;
+  model->buf_mapped_ = true;
+  model->mapped_size_ = size;
+  if (!InitModelFromBuf(model)) {
     delete model;
     return nullptr;
   }
   return model;
+#endif
 }
 
 void Model::Free() {
+  if (this->buf_mapped_) {
+    // const tensors of compiled sessions still reference the mapped file, it is unmapped in Destroy
+    return;
+  }
   if (this->buf != nullptr) {
     free(this->buf);
     this->buf = nullptr;
@@ -137,6 +221,14 @@ void Model::Free() {
 }
 
 void Model::Destroy() {
+#ifndef _WIN32
+  if (this->buf_mapped_) {
+    munmap(this->buf, this->mapped_size_);
+    this->buf = nullptr;
+    this->buf_mapped_ = false;
+    this->mapped_size_ = 0;
+  }
+#endif
   Free();
   auto nodes_size = this->nodes_.size();
   for (size_t i = 0; i < nodes_size; ++i) {
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/arena_planner.h"
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include "include/errorcode.h"
+#include "utils/mem_plan.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr size_t kArenaAlignSize = 64;
+}  // namespace
+
+void *ArenaAllocator::Malloc(size_t size) {
+  if (fallback_ == nullptr) {
+    return malloc(size);
+  }
+  return fallback_->Malloc(size);
+}
+
+void ArenaAllocator::Free(void *ptr) {
+  if (ptr == nullptr || InArena(ptr)) {
+    return;
+  }
+  if (fallback_ == nullptr) {
+    free(ptr);
+    return;
+  }
+  fallback_->Free(ptr);
+}
+
+void ArenaAllocator::SetArena(void *arena, size_t arena_size) {
+  arena_ = reinterpret_cast<char *>(arena);
+  arena_size_ = arena_size;
+}
+
+bool ArenaAllocator::InArena(const void *ptr) const {
+  auto addr = reinterpret_cast<const char *>(ptr);
+  return arena_ != nullptr && addr >= arena_ && addr < arena_ + arena_size_;
+}
+
+ArenaPlanner::~ArenaPlanner() { ReleaseArena(); }
+
+void ArenaPlanner::ReleaseArena() {
+  allocator_.SetArena(nullptr, 0);
+  if (arena_buf_ != nullptr) {
+    free(arena_buf_);
+    arena_buf_ = nullptr;
+  }
+  arena_ = nullptr;
+  arena_size_ = 0;
+}
+
+void ArenaPlanner::CollectBlocks(const std::vector<kernel::LiteKernel *> &kernels,
+                                 const std::vector<Tensor *> &graph_outputs) {
+  blocks_.clear();
+  // graph outputs are read by the user after the run, keep them out of the arena
+  std::unordered_set<Tensor *> excluded(graph_outputs.begin(), graph_outputs.end());
+  std::unordered_map<Tensor *, size_t> block_index;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto kernel = kernels[i];
+    MS_ASSERT(kernel != nullptr);
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = block_index.find(tensor);
+      if (iter != block_index.end()) {
+        blocks_[iter->second].last_use_ = i;
+      }
+    }
+    // outputs of kernels whose shape is only known at run time, and of output nodes, keep the allocator path
+    if (kernel->desc().arch != kernel::KERNEL_ARCH::kCPU || !kernel->InferShapeDone() || kernel->is_model_output()) {
+      continue;
+    }
+    for (auto tensor : kernel->out_tensors()) {
+      MS_ASSERT(tensor != nullptr);
+      if (tensor->category() == Tensor::Category::CONST || excluded.count(tensor) > 0 ||
+          block_index.count(tensor) > 0 || tensor->Size() == 0) {
+        continue;
+      }
+      block_index[tensor] = blocks_.size();
+      blocks_.push_back({tensor, tensor->Size(), i, i, 0});
+    }
+  }
+}
+
+int ArenaPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs,
+                       bool reuse_memory) {
+  // tensors planned before go back to the fallback allocator first, shapes may have changed since the last plan
+  for (auto &block : blocks_) {
+    if (allocator_.InArena(block.tensor_->data_c())) {
+      block.tensor_->SetData(nullptr);
+    }
+  }
+  ReleaseArena();
+  CollectBlocks(kernels, graph_outputs);
+  naive_size_ = 0;
+  for (auto &block : blocks_) {
+    naive_size_ += AlignMemBlockSize(block.size_, kArenaAlignSize);
+  }
+  size_t arena_size = AssignMemBlockOffsets(&blocks_, kArenaAlignSize, reuse_memory);
+  if (arena_size > 0) {
+    arena_buf_ = malloc(arena_size + kArenaAlignSize);
+    if (arena_buf_ == nullptr) {
+      MS_LOG(ERROR) << "malloc arena of size " << arena_size << " failed";
+      blocks_.clear();
+      return RET_MEMORY_FAILED;
+    }
+    auto addr = reinterpret_cast<uintptr_t>(arena_buf_);
+    arena_ = reinterpret_cast<void *>((addr + kArenaAlignSize - 1) / kArenaAlignSize * kArenaAlignSize);
+    arena_size_ = arena_size;
+    allocator_.SetArena(arena_, arena_size_);
+  }
+  for (auto &block : blocks_) {
+    // data kernels allocated during Init/ReSize is released before the tensor moves into the arena
+    block.tensor_->FreeData();
+    block.tensor_->set_allocator(&allocator_);
+  }
+  Bind();
+  MS_LOG(INFO) << "arena plan: " << blocks_.size() << " tensors, arena size " << arena_size_ << ", naive size "
+               << naive_size_ << ", memory reuse " << (reuse_memory ? "enabled" : "disabled");
+  return RET_OK;
+}
+
+void ArenaPlanner::Bind() {
+  auto arena = reinterpret_cast<char *>(arena_);
+  for (auto &block : blocks_) {
+    block.tensor_->SetData(arena + block.offset_);
+  }
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_ARENA_PLANNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_ARENA_PLANNER_H_
+
+#include <memory>
+#include <vector>
+#include "src/runtime/allocator.h"
+#include "src/lite_kernel.h"
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// Tensors planned into the arena get this allocator. The memory belongs to the arena, so freeing it is a no-op,
+// anything allocated outside of the plan still goes to the fallback allocator.
+class ArenaAllocator : public Allocator {
+ public:
+  explicit ArenaAllocator(Allocator *fallback) : fallback_(fallback) { name = "arena"; }
+  ~ArenaAllocator() override = default;
+  void *Malloc(size_t size) override;
+  void Free(void *ptr) override;
+  size_t GetTotalSize() override { return arena_size_; }
+  void SetArena(void *arena, size_t arena_size);
+  bool InArena(const void *ptr) const;
+
+ private:
+  Allocator *fallback_ = nullptr;
+  char *arena_ = nullptr;
+  size_t arena_size_ = 0;
+};
+
+struct ArenaBlock {
+  Tensor *tensor_;
+  size_t size_;
+  size_t first_use_;
+  size_t last_use_;
+  size_t offset_;
+};
+
+// Plans every intermediate tensor of a cpu graph into one preallocated arena. Offsets come from the kernel order and
+// the tensor lifetimes, so running the graph needs no allocator traffic and the peak memory is known after compiling.
+class ArenaPlanner {
+ public:
+  explicit ArenaPlanner(Allocator *fallback) : allocator_(fallback) {}
+  ~ArenaPlanner();
+
+  // reuse_memory must be false when kernels may run out of order, every tensor then keeps its own block
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs,
+           bool reuse_memory);
+  // Points planned tensors back into the arena, their data is reset whenever the executor frees them.
+  void Bind();
+  size_t arena_size() const { return arena_size_; }
+  size_t naive_size() const { return naive_size_; }
+
+ private:
+  void CollectBlocks(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs);
+  void ReleaseArena();
+
+  ArenaAllocator allocator_;
+  std::vector<ArenaBlock> blocks_;
+  void *arena_buf_ = nullptr;
+  void *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  size_t naive_size_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_ARENA_PLANNER_H_
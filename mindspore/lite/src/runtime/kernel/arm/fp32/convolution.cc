@@ -55,13 +55,16 @@ int ConvolutionCPUKernel::InitWeightBias() {
   int pack_weight_size = oc_block_num * oc_block * ic4 * C4NUM * kernel_plane;
 
   auto origin_weight = reinterpret_cast<float *>(filter_tensor->MutableData());
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  packed_weight_ = reinterpret_cast<float *>(
+    MallocPackedWeight(origin_weight, "conv_fp32", pack_weight_size * sizeof(float), [&](void *packed) {
+      memset(packed, 0, pack_weight_size * sizeof(float));
+      PackWeightFp32(origin_weight, conv_param_, reinterpret_cast<float *>(packed), oc_block, oc_block_num);
+      return RET_OK;
+    }));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed weight failed.";
     return RET_ERROR;
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
-  PackWeightFp32(origin_weight, conv_param_, packed_weight_, oc_block, oc_block_num);
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * oc_block * sizeof(float)));
   if (bias_data_ == nullptr) {
@@ -31,10 +31,8 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
                        const mindspore::lite::PrimitiveC *primitive)
       : ConvolutionBaseCPUKernel(parameter, inputs, outputs, ctx, primitive) {}
   ~ConvolutionCPUKernel() override {
-    if (packed_weight_ != nullptr) {
-      free(packed_weight_);
-      packed_weight_ = nullptr;
-    }
+    FreePackedWeight(packed_weight_);
+    packed_weight_ = nullptr;
   }
 
   int Init() override;
@@ -24,10 +24,8 @@ using mindspore::lite::RET_OK;
 namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   FreeTmpBuffer();
-  if (weight_ptr_ != nullptr) {
-    free(weight_ptr_);
-    weight_ptr_ = nullptr;
-  }
+  FreePackedWeight(weight_ptr_);
+  weight_ptr_ = nullptr;
   if (matmul_param_ != nullptr) {
     delete matmul_param_;
     matmul_param_ = nullptr;
@@ -83,14 +81,16 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
   }
 
   size = input_channel * UP_ROUND(output_channel, C8NUM) * sizeof(float);
-  weight_ptr_ = reinterpret_cast<float *>(malloc(size));
+  auto origin_weight = reinterpret_cast<float *>(filter_tensor->MutableData());
+  weight_ptr_ = reinterpret_cast<float *>(MallocPackedWeight(origin_weight, "conv1x1_fp32", size, [&](void *packed) {
+    memset(packed, 0, size);
+    RowMajor2Col8Major(origin_weight, reinterpret_cast<float *>(packed), output_channel, input_channel);
+    return RET_OK;
+  }));
   if (weight_ptr_ == nullptr) {
     MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
     return RET_ERROR;
   }
-  memset(weight_ptr_, 0, size);
-  RowMajor2Col8Major(reinterpret_cast<float *>(filter_tensor->MutableData()), weight_ptr_, output_channel,
-                     input_channel);
   return RET_OK;
 }
 
@@ -30,10 +30,8 @@ using mindspore::schema::PrimitiveType_DepthwiseConv2D;
 
 namespace mindspore::kernel {
 ConvolutionDepthwiseCPUKernel::~ConvolutionDepthwiseCPUKernel() {
-  if (packed_weight_ != nullptr) {
-    free(packed_weight_);
-    packed_weight_ = nullptr;
-  }
+  FreePackedWeight(packed_weight_);
+  packed_weight_ = nullptr;
 }
 
 int ConvolutionDepthwiseCPUKernel::InitWeightBias() {
@@ -43,12 +41,16 @@ int ConvolutionDepthwiseCPUKernel::InitWeightBias() {
   int channel = weight_tensor->Batch();
   int pack_weight_size = weight_tensor->Batch() * weight_tensor->Height() * weight_tensor->Width();
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  int plane = weight_tensor->Height() * weight_tensor->Width();
+  packed_weight_ = reinterpret_cast<float *>(
+    MallocPackedWeight(origin_weight, "conv_dw_fp32", pack_weight_size * sizeof(float), [&](void *packed) {
+      PackWeightKHWToHWKFp32(origin_weight, packed, plane, channel);
+      return RET_OK;
+    }));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "Malloc buffer failed.";
     return RET_ERROR;
   }
-  PackWeightKHWToHWKFp32(origin_weight, packed_weight_, weight_tensor->Height() * weight_tensor->Width(), channel);
 
   bias_data_ = reinterpret_cast<float *>(malloc(channel * sizeof(float)));
   if (bias_data_ == nullptr) {
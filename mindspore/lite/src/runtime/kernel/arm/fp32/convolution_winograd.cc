@@ -108,28 +108,7 @@ int ConvolutionWinogradCPUKernel::WinogradFilterTransform(const float *weight_da
   return RET_OK;
 }
 
-int ConvolutionWinogradCPUKernel::InitWeightBias() {
-  auto filter_tensor = in_tensors_.at(kWeightIndex);
-  int in_channel = filter_tensor->Channel();
-  int out_channel = filter_tensor->Batch();
-  int ic4 = UP_DIV(in_channel, C4NUM);
-  conv_param_->input_channel_ = in_channel;
-  conv_param_->output_channel_ = out_channel;
-
-  int oc4 = UP_DIV(out_channel, C4NUM);
-  int oc_block, oc_block_num;
-  oc_block = C8NUM;
-  oc_block_num = UP_DIV(out_channel, C8NUM);
-
-  // set data
-  auto trans_matrix_data_size = input_unit_ * input_unit_ * ic4 * C4NUM * oc_block_num * oc_block * sizeof(float);
-  trans_weight_ = reinterpret_cast<float *>(malloc(trans_matrix_data_size));
-  if (trans_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc matrix_buffer failed.";
-    return RET_MEMORY_FAILED;
-  }
-  memset(trans_weight_, 0, trans_matrix_data_size);
-
+int ConvolutionWinogradCPUKernel::TransformWeight(float *weight_data, int oc_block) {
   float matrix_g[64];
   float matrix_gt[64];
   float matrix_a[64];
@@ -146,12 +125,40 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
     MS_LOG(ERROR) << "get matrix g from CookToomFilter failed.";
     return ret;
   }
-  auto weight_data = reinterpret_cast<float *>(filter_tensor->MutableData());
   ret = WinogradFilterTransform(weight_data, matrix_g, matrix_gt, oc_block);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "winograd filter transfrom failed.";
     return ret;
   }
+  return RET_OK;
+}
+
+int ConvolutionWinogradCPUKernel::InitWeightBias() {
+  auto filter_tensor = in_tensors_.at(kWeightIndex);
+  int in_channel = filter_tensor->Channel();
+  int out_channel = filter_tensor->Batch();
+  int ic4 = UP_DIV(in_channel, C4NUM);
+  conv_param_->input_channel_ = in_channel;
+  conv_param_->output_channel_ = out_channel;
+
+  int oc4 = UP_DIV(out_channel, C4NUM);
+  int oc_block, oc_block_num;
+  oc_block = C8NUM;
+  oc_block_num = UP_DIV(out_channel, C8NUM);
+
+  // set data
+  auto trans_matrix_data_size = input_unit_ * input_unit_ * ic4 * C4NUM * oc_block_num * oc_block * sizeof(float);
+  auto weight_data = reinterpret_cast<float *>(filter_tensor->MutableData());
+  trans_weight_ = reinterpret_cast<float *>(
+    MallocPackedWeight(weight_data, "conv_winograd_fp32", trans_matrix_data_size, [&](void *packed) {
+      trans_weight_ = reinterpret_cast<float *>(packed);
+      memset(trans_weight_, 0, trans_matrix_data_size);
+      return TransformWeight(weight_data, oc_block);
+    }));
+  if (trans_weight_ == nullptr) {
+    MS_LOG(ERROR) << "malloc matrix_buffer failed.";
+    return RET_MEMORY_FAILED;
+  }
 
   // init bias
   size_t new_bias_size = oc4 * C4NUM * sizeof(float);
@@ -33,15 +33,14 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
         output_unit_(output_unit),
         trans_weight_(nullptr) {}
   ~ConvolutionWinogradCPUKernel() override {
-    if (trans_weight_ != nullptr) {
-      free(trans_weight_);
-      trans_weight_ = nullptr;
-    }
+    FreePackedWeight(trans_weight_);
+    trans_weight_ = nullptr;
   };
   int Init() override;
   int ReSize() override;
   int Run() override;
   int RunImpl(int task_id);
+  int TransformWeight(float *weight_data, int oc_block);
   int InitWeightBias();
   int InitTmpBuffer();
   int ConfigInputOutput();
@@ -32,7 +32,11 @@ void FullconnectionCPUKernel::FreeBuf() {
     a_c12_ptr_ = nullptr;
   }
   if (b_r8_ptr_ != nullptr) {
-    free(b_r8_ptr_);
+    if (b_shared_) {
+      FreePackedWeight(b_r8_ptr_);
+    } else {
+      free(b_r8_ptr_);
+    }
     b_r8_ptr_ = nullptr;
   }
   if (bias_ptr_ != nullptr) {
@@ -76,17 +80,31 @@ int FullconnectionCPUKernel::ReSize() {
   memset(a_c12_ptr_, 0, fc_param_->row_12_ * fc_param_->deep_ * sizeof(float));
 #endif
 
-  b_r8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->col_8_ * fc_param_->deep_ * sizeof(float)));
+  fc_param_->a_const_ = (in_tensors_[0]->data_c() != nullptr);
+  fc_param_->b_const_ = (in_tensors_[1]->data_c() != nullptr);
+  size_t b_size = fc_param_->col_8_ * fc_param_->deep_ * sizeof(float);
+  b_shared_ = fc_param_->b_const_ && in_tensors_[1]->category() == lite::Tensor::Category::CONST;
+  if (b_shared_) {
+    auto b_data = reinterpret_cast<float *>(in_tensors_[1]->MutableData());
+    b_r8_ptr_ = reinterpret_cast<float *>(MallocPackedWeight(b_data, "fc_fp32", b_size, [&](void *packed) {
+      memset(packed, 0, b_size);
+      InitMatrixB(b_data, reinterpret_cast<float *>(packed));
+      return RET_OK;
+    }));
+  } else {
+    b_r8_ptr_ = reinterpret_cast<float *>(malloc(b_size));
+    if (b_r8_ptr_ != nullptr) {
+      memset(b_r8_ptr_, 0, b_size);
+    }
+  }
   if (b_r8_ptr_ == nullptr) {
     FreeBuf();
     return RET_MEMORY_FAILED;
   }
-  memset(b_r8_ptr_, 0, fc_param_->col_8_ * fc_param_->deep_ * sizeof(float));
-
-  fc_param_->a_const_ = (in_tensors_[0]->data_c() != nullptr);
-  fc_param_->b_const_ = (in_tensors_[1]->data_c() != nullptr);
   if (fc_param_->a_const_) InitMatrixA(reinterpret_cast<float *>(in_tensors_[0]->MutableData()), a_c12_ptr_);
-  if (fc_param_->b_const_) InitMatrixB(reinterpret_cast<float *>(in_tensors_[1]->MutableData()), b_r8_ptr_);
+  if (fc_param_->b_const_ && !b_shared_) {
+    InitMatrixB(reinterpret_cast<float *>(in_tensors_[1]->MutableData()), b_r8_ptr_);
+  }
   return RET_OK;
 }
 
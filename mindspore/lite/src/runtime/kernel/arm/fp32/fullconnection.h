@@ -49,6 +49,8 @@ class FullconnectionCPUKernel : public FullconnectionBaseCPUKernel {
  private:
   float *a_c12_ptr_ = nullptr;
   float *b_r8_ptr_ = nullptr;
+  // a packed const weight may be shared with other sessions
+  bool b_shared_ = false;
   float *c_r_ptr = nullptr;
   float *bias_ptr_ = nullptr;
 };
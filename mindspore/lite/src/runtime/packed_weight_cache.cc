@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/packed_weight_cache.h"
+#include <cstdlib>
+#include <utility>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+PackedWeightCache::~PackedWeightCache() {
+  for (auto &entry : entries_) {
+    free(entry.first);
+  }
+  entries_.clear();
+  packed_.clear();
+  weights_.clear();
+}
+
+void PackedWeightCache::AddWeight(const void *data, size_t tensor_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  weights_[data] = tensor_index;
+}
+
+bool PackedWeightCache::IsWeight(const void *origin) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return weights_.find(origin) != weights_.end();
+}
+
+void *PackedWeightCache::GetOrPack(const void *origin, const std::string &kind, size_t size,
+                                   const std::function<int(void *)> &pack) {
+  // packing runs under the lock, so sessions compiling at the same time never pack one weight twice
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto weight = weights_.find(origin);
+  if (weight == weights_.end()) {
+    MS_LOG(ERROR) << "origin of packed weight " << kind << " is not a weight of the shared model";
+    return nullptr;
+  }
+  Key key(weight->second, kind, size);
+  auto iter = packed_.find(key);
+  if (iter != packed_.end()) {
+    entries_[iter->second].ref_count_++;
+    return iter->second;
+  }
+  auto buf = malloc(size);
+  if (buf == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight of size " << size << " failed";
+    return nullptr;
+  }
+  if (pack(buf) != RET_OK) {
+    MS_LOG(ERROR) << "pack weight " << kind << " failed";
+    free(buf);
+    return nullptr;
+  }
+  packed_[key] = buf;
+  entries_[buf] = {std::move(key), 1};
+  total_size_ += size;
+  return buf;
+}
+
+bool PackedWeightCache::Release(void *packed) {
+  if (packed == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(packed);
+  if (iter == entries_.end()) {
+    return false;
+  }
+  if (--iter->second.ref_count_ > 0) {
+    return true;
+  }
+  total_size_ -= std::get<2>(iter->second.key_);
+  packed_.erase(iter->second.key_);
+  entries_.erase(iter);
+  free(packed);
+  return true;
+}
+
+size_t PackedWeightCache::GetTotalSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_size_;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace mindspore::lite {
+// Weights packed by kernels at init, shared by the sessions created from one compiled session. Only the const tensors
+// of the shared model are cached: their data is registered with AddWeight, and a buffer is keyed by the index of its
+// origin tensor in the model, the kind of packing and its size. Any other origin, like the dequantized copy of a
+// quantized weight, is transient and its address may be reused, so kernels pack it into a buffer of their own.
+// Packed buffers are read only once they are in the cache.
+class PackedWeightCache {
+ public:
+  PackedWeightCache() = default;
+  ~PackedWeightCache();
+
+  // Registers data as the weight of the const tensor tensor_index of the model.
+  void AddWeight(const void *data, size_t tensor_index);
+  // Whether origin is the data of a registered weight.
+  bool IsWeight(const void *origin);
+  // Returns a buffer of size bytes filled by pack, or the one packed earlier for the same weight, kind and size.
+  // origin must be the data of a registered weight.
+  void *GetOrPack(const void *origin, const std::string &kind, size_t size, const std::function<int(void *)> &pack);
+  // Drops the reference taken by GetOrPack, the buffer is freed with the last reference. Returns false when packed is
+  // not a buffer of the cache.
+  bool Release(void *packed);
+  size_t GetTotalSize();
+
+ private:
+  using Key = std::tuple<size_t, std::string, size_t>;
+  struct Entry {
+    Key key_;
+    size_t ref_count_;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<const void *, size_t> weights_;
+  std::map<Key, void *> packed_;
+  std::unordered_map<void *, Entry> entries_;
+  size_t total_size_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_CACHE_H_
@@ -14,43 +14,214 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
 #include "src/runtime/parallel_executor.h"
-#include "src/runtime/runtime_api.h"
+#include "include/errorcode.h"
 
-#define MAX_THREAD_NUM 8
 namespace mindspore::lite {
-ParallelExecutor::~ParallelExecutor() { DestroyThreadPool(thread_pool_); }
+namespace {
+// same as the DefaultAllocator default, kernels running side by side need the allocator to lock
+constexpr int kAllocatorShiftFactor = 6;
+}  // namespace
+
+ParallelExecutor::~ParallelExecutor() { StopWorkers(); }
+
+void ParallelExecutor::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    stop_ = true;
+  }
+  run_cond_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  stop_ = false;
+}
+
 int ParallelExecutor::Prepare(std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  thread_pool_ = CreateLiteThreadPool(MAX_THREAD_NUM, NO_BIND);
-  if (thread_pool_ == nullptr) {
-    MS_LOG(ERROR) << "Memory error: fail to new ThreadPool";
+  StopWorkers();
+  kernels_ = kernels;
+  std::unordered_map<kernel::LiteKernel *, size_t> kernel_index;
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    kernel_index[kernels_[i]] = i;
+  }
+  successors_.assign(kernels_.size(), {});
+  in_degree_.assign(kernels_.size(), 0);
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    for (auto in_kernel : kernels_[i]->in_kernels()) {
+      auto iter = kernel_index.find(in_kernel);
+      if (iter == kernel_index.end()) {
+        continue;
+      }
+      successors_[iter->second].push_back(i);
+      in_degree_[i]++;
+    }
+  }
+  pending_.reset(new (std::nothrow) std::atomic_int[kernels_.size()]);
+  if (pending_ == nullptr) {
+    MS_LOG(ERROR) << "Memory error: fail to new kernel counters";
     return RET_ERROR;
   }
+
+  int thread_num = thread_num_;
+  if (thread_num <= 0) {
+    auto iter = std::find_if(kernels_.begin(), kernels_.end(),
+                             [](kernel::LiteKernel *kernel) { return kernel->context() != nullptr; });
+    thread_num = iter == kernels_.end() ? 1 : (*iter)->context()->thread_num_;
+  }
+  size_t worker_num = std::max<size_t>(1, std::min<size_t>(thread_num, kernels_.size()));
+  queues_.clear();
+  for (size_t i = 0; i < worker_num; ++i) {
+    queues_.emplace_back(std::make_unique<WorkQueue>());
+  }
+  // the thread calling Run is worker 0
+  for (size_t i = 1; i < worker_num; ++i) {
+    workers_.emplace_back(&ParallelExecutor::WorkerLoop, this, i);
+  }
   return RET_OK;
 }
 
-static int RunKernel(void *data, int index) {
-  ParallelExecutor *executor = reinterpret_cast<ParallelExecutor *>(data);
-  auto kernel = executor->GetReadyKernel(index);
+void ParallelExecutor::WorkerLoop(size_t worker_id) {
+  size_t run_id = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(run_mutex_);
+      run_cond_.wait(lock, [this, run_id] { return stop_ || run_id_ != run_id; });
+      if (stop_) {
+        return;
+      }
+      run_id = run_id_;
+      active_workers_++;
+    }
+    Work(worker_id);
+    {
+      std::lock_guard<std::mutex> lock(run_mutex_);
+      active_workers_--;
+    }
+    done_cond_.notify_one();
+  }
+}
+
+void ParallelExecutor::Work(size_t worker_id) {
+  size_t index = 0;
+  while (true) {
+    {
+      // sleep until a kernel is queued, each queued kernel is claimed by one worker before it is popped
+      std::unique_lock<std::mutex> lock(work_mutex_);
+      work_cond_.wait(lock, [this] { return remaining_ == 0 || result_ != RET_OK || queued_ > 0; });
+      if (remaining_ == 0 || result_ != RET_OK) {
+        return;
+      }
+      queued_--;
+    }
+    if (!PopKernel(worker_id, &index)) {
+      MS_LOG(ERROR) << "A queued kernel is missing";
+      SetResult(RET_ERROR);
+      return;
+    }
+    RunKernel(worker_id, index);
+  }
+}
+
+void ParallelExecutor::PushKernel(size_t worker_id, size_t index) {
+  {
+    auto &queue = queues_[worker_id];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->kernels.push_back(index);
+  }
+  {
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    queued_++;
+  }
+  work_cond_.notify_one();
+}
+
+void ParallelExecutor::SetResult(int ret) {
+  {
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    if (result_ == RET_OK) {
+      result_ = ret;
+    }
+  }
+  work_cond_.notify_all();
+}
+
+bool ParallelExecutor::PopKernel(size_t worker_id, size_t *index) {
+  {
+    // the newest kernel of the own queue most likely consumes data that is still in cache
+    auto &queue = queues_[worker_id];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->kernels.empty()) {
+      *index = queue->kernels.back();
+      queue->kernels.pop_back();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto &victim = queues_[(worker_id + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->kernels.empty()) {
+      *index = victim->kernels.front();
+      victim->kernels.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelExecutor::RunKernel(size_t worker_id, size_t index) {
+  auto kernel = kernels_[index];
+  MS_ASSERT(nullptr != kernel);
+  if (*before_ != nullptr) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (!(*before_)(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                    {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel before_callback failed, name: " << kernel->name();
+    }
+  }
   auto ret = kernel->Run();
-  executor->SetResult(index, ret);
   if (0 != ret) {
     MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-    return 0;
+    SetResult(ret);
+    return;
   }
-
-  for (auto input_kernel : kernel->in_kernels()) {
-    MS_ASSERT(input_kernel != nullptr);
-    if (input_kernel->is_model_output()) {
-      continue;
+  if (*after_ != nullptr) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (!(*after_)(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                   {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->name();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(ref_count_mutex_);
+    for (auto input_kernel : kernel->in_kernels()) {
+      MS_ASSERT(input_kernel != nullptr);
+      if (input_kernel->is_model_output()) {
+        continue;
+      }
+      ret = input_kernel->DecOutTensorRefCount();
+      if (0 != ret) {
+        MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << kernel->name() << " failed";
+      }
     }
-    ret = input_kernel->DecOutTensorRefCount();
-    if (0 != ret) {
-      MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << kernel->name() << " failed";
+  }
+  for (auto successor : successors_[index]) {
+    if (pending_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      PushKernel(worker_id, successor);
     }
   }
-  return 0;
+  // decrease after the successors are queued, so no worker sees the graph done too early
+  bool done = false;
+  {
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    done = --remaining_ == 0;
+  }
+  if (done) {
+    work_cond_.notify_all();
+  }
 }
 
 int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
@@ -67,54 +238,66 @@ int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor
       return RET_ERROR;
     }
   }
+  if (kernels != kernels_ || queues_.empty()) {
+    MS_LOG(ERROR) << "ParallelExecutor should be prepared with the kernels it runs";
+    return RET_ERROR;
+  }
+  if (allocator != nullptr) {
+    allocator->SetContext({kAllocatorShiftFactor, true});
+  }
   kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
+    out_tensor->SetRefCount(out_tensor->RefCount() + 1);
+  }
+  if (kernels_.empty()) {
+    return RET_OK;
+  }
 
-  for (auto kernel : kernels) {
-    if (kernel->in_kernels().size() == 0) {
-      readyKernels.emplace_back(kernel);
-      continue;
+  before_ = &before;
+  after_ = &after;
+  {
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    result_ = RET_OK;
+    queued_ = 0;
+  }
+  size_t next_queue = 0;
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    pending_[i].store(in_degree_[i], std::memory_order_relaxed);
+    if (in_degree_[i] == 0) {
+      PushKernel(next_queue, i);
+      next_queue = (next_queue + 1) % queues_.size();
     }
-    refCount[kernel] = kernel->in_kernels().size();
   }
-  std::vector<kernel::LiteKernel *> newReadyKernels;
-  while (readyKernels.size() > 0) {
-    results.resize(readyKernels.size(), RET_OK);
-    ParallelLaunch(thread_pool_, RunKernel, this, readyKernels.size());
-
-    if (std::find_if(results.begin(), results.end(), [](const int &ret) { return (ret != 0); }) != results.end()) {
-      return RET_ERROR;
+  // publish the run last, a worker still leaving the previous run may already be looking at it
+  {
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    remaining_ = kernels_.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    run_id_++;
+  }
+  run_cond_.notify_all();
+  Work(0);
+  {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    done_cond_.wait(lock, [this] { return active_workers_ == 0; });
+  }
+  if (result_ != RET_OK) {
+    // drop the kernels a failed run left behind
+    {
+      std::lock_guard<std::mutex> lock(work_mutex_);
+      remaining_ = 0;
+      queued_ = 0;
     }
-    newReadyKernels.clear();
-    for (auto completed : readyKernels) {
-      for (auto out : completed->out_kernels()) {
-        auto iter = refCount.find(out);
-        if (iter == refCount.end()) {
-          continue;
-        }
-        (iter->second)--;
-        if (iter->second <= 0) {
-          newReadyKernels.emplace_back(iter->first);
-          refCount.erase(iter);
-        }
-      }
-
-      for (auto input_kernel : completed->in_kernels()) {
-        MS_ASSERT(input_kernel != nullptr);
-        if (input_kernel->is_model_output()) {
-          continue;
-        }
-        auto ret = input_kernel->DecOutTensorRefCount();
-        if (0 != ret) {
-          MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << completed->name() << " failed";
-          return -1;
-        }
-      }
+    for (auto &queue : queues_) {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->kernels.clear();
     }
-    readyKernels.clear();
-    readyKernels = std::move(newReadyKernels);
   }
-
-  return RET_OK;
+  before_ = nullptr;
+  after_ = nullptr;
+  return result_;
 }
 
 }  // namespace mindspore::lite
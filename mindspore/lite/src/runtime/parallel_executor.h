@@ -17,32 +17,80 @@
 #ifndef MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 #define MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
-#include <unordered_map>
 #include "src/runtime/allocator.h"
 #include "src/lite_kernel.h"
 #include "include/lite_session.h"
 #include "src/executor.h"
 
 namespace mindspore::lite {
+// Runs the graph as a dataflow: a kernel is queued as soon as all of its input kernels are done. Every worker owns a
+// deque, it takes the newest kernel of its own deque and steals the oldest one of the others when it runs dry.
+// Idle workers sleep until a kernel is queued. Kernels still launch their intra-op tasks on the session thread pool,
+// where concurrent launches share the pool threads and each launching thread runs the tasks nobody claimed, so the
+// two levels of parallelism share the same cores.
 class ParallelExecutor : public Executor {
  public:
   ParallelExecutor() = default;
-  virtual ~ParallelExecutor();
+  // thread_num 0 takes the thread number of the session context
+  explicit ParallelExecutor(int thread_num) : thread_num_(thread_num) {}
+  ~ParallelExecutor() override;
 
   int Prepare(std::vector<kernel::LiteKernel *> &kernels) override;
 
+  bool RunInKernelOrder() const override { return false; }
+
   int Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr) override;
-  inline kernel::LiteKernel *GetReadyKernel(const int index) { return readyKernels.at(index); }
-  inline void SetResult(const int index, const int result) { results.at(index) = result; }
 
  private:
-  std::unordered_map<kernel::LiteKernel *, size_t> refCount;
-  std::vector<kernel::LiteKernel *> readyKernels;
-  std::vector<int> results;
-  struct ThreadPool *thread_pool_ = NULL;
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<size_t> kernels;
+  };
+
+  void StopWorkers();
+  void WorkerLoop(size_t worker_id);
+  void Work(size_t worker_id);
+  void PushKernel(size_t worker_id, size_t index);
+  bool PopKernel(size_t worker_id, size_t *index);
+  void RunKernel(size_t worker_id, size_t index);
+  void SetResult(int ret);
+
+  int thread_num_ = 0;
+  std::vector<kernel::LiteKernel *> kernels_;
+  // successors and number of input kernels per kernel, both indexed by the position in kernels_
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<int> in_degree_;
+  std::unique_ptr<std::atomic_int[]> pending_;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex run_mutex_;
+  std::condition_variable run_cond_;
+  std::condition_variable done_cond_;
+  size_t run_id_ = 0;
+  size_t active_workers_ = 0;
+  bool stop_ = false;
+  // idle workers sleep on work_cond_, the counters change under work_mutex_ and are read without it once a run is over
+  std::mutex work_mutex_;
+  std::condition_variable work_cond_;
+  size_t queued_ = 0;
+  std::atomic_size_t remaining_{0};
+  std::atomic_int result_{0};
+
+  // tensor ref counts and user callbacks are not thread safe
+  std::mutex ref_count_mutex_;
+  std::mutex callback_mutex_;
+  const session::KernelCallBack *before_ = nullptr;
+  const session::KernelCallBack *after_ = nullptr;
 };
 
 }  // namespace mindspore::lite
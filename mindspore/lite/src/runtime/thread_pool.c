@@ -47,9 +47,15 @@
 #define MAX_THREAD_POOL_NUM (4)
 #define DEFAULT_SPIN_COUNT (30000)
 
+// A launch of task_num tasks. Its tasks are claimed one by one by the launching thread and the threads it was queued
+// to, so a launch never waits for a thread which is busy elsewhere. The task is freed by the last of its holders.
 typedef struct {
   int (*func)(void *arg, int);
   void *content;
+  int task_num;
+  atomic_int next_index;
+  atomic_int finished;
+  atomic_int ref_count;
 } Task;
 
 typedef struct Thread {
@@ -65,6 +71,7 @@ typedef struct Thread {
   atomic_bool is_running;
   sem_t sem;
   sem_t sem_inited;
+  pthread_mutex_t push_lock;
 } Thread;
 
 typedef struct {
@@ -108,6 +115,24 @@ Thread *GetThread(struct ThreadPool *thread_pool, int thread_id) {
   return thread;
 }
 
+bool PopTaskFromQueue(Thread *thread, Task **task);
+
+void ReleaseTask(Task *task) {
+  if (atomic_fetch_sub_explicit(&task->ref_count, 1, memory_order_acq_rel) == 1) {
+    free(task);
+  }
+}
+
+// run the tasks of a launch which nobody claimed yet
+void RunClaimedTasks(Task *task) {
+  int index = atomic_fetch_add_explicit(&task->next_index, 1, memory_order_relaxed);
+  while (index < task->task_num) {
+    task->func(task->content, index);
+    atomic_fetch_add_explicit(&task->finished, 1, memory_order_release);
+    index = atomic_fetch_add_explicit(&task->next_index, 1, memory_order_relaxed);
+  }
+}
+
 void FreeThread(ThreadList *thread_list, Thread *thread) {
   if (thread_list == NULL) {
     LOG_ERROR("thead list is null");
@@ -122,6 +147,13 @@ void FreeThread(ThreadList *thread_list, Thread *thread) {
   sem_post(&thread->sem);
   while (true) {
     if (thread != NULL && !thread->is_running) {
+      // the launches still queued were run by their launching threads, only release them
+      Task *task = NULL;
+      while (PopTaskFromQueue(thread, &task)) {
+        atomic_fetch_sub_explicit(&thread->task_size, 1, memory_order_relaxed);
+        ReleaseTask(task);
+      }
+      pthread_mutex_destroy(&thread->push_lock);
       sem_destroy(&thread->sem);
       free(thread);
       thread = NULL;
@@ -411,14 +443,18 @@ bool PushTaskToQueue(struct ThreadPool *thread_pool, int thread_id, Task *task)
     LOG_ERROR("get thread failed, thread_id: %d", thread_id);
     return false;
   }
+  // several threads may launch on the pool, they take turns to push, the thread itself pops without locking
+  pthread_mutex_lock(&thread->push_lock);
   const int tail_index = atomic_load_explicit(&thread->tail, memory_order_relaxed);
   int next = (tail_index + 1) % MAX_TASK_NUM;
   if (next == atomic_load_explicit(&thread->head, memory_order_acquire)) {
+    pthread_mutex_unlock(&thread->push_lock);
     return false;
   }
   thread->task_list[tail_index] = task;
   atomic_store_explicit(&thread->tail, next, memory_order_release);
   atomic_fetch_add_explicit(&thread->task_size, 1, memory_order_relaxed);
+  pthread_mutex_unlock(&thread->push_lock);
   sem_post(&thread->sem);
   return true;
 }
@@ -440,55 +476,32 @@ bool PopTaskFromQueue(Thread *thread, Task **task) {
   return true;
 }
 
-void WaitAllThread(struct ThreadPool *thread_pool) {
-  if (thread_pool == NULL) {
-    LOG_ERROR("get thread pool instane failed");
-    return;
-  }
-  bool k_success_flag = false;
-  while (!k_success_flag) {
-    k_success_flag = true;
-    for (int i = 0; i < thread_pool->thread_num - 1; ++i) {
-      Thread *thread = GetThread(thread_pool, i);
-      if (thread == NULL) {
-        LOG_ERROR("get thread failed, thread_id: %d", i);
-        return;
-      }
-      if (thread->task_size != 0) {
-        k_success_flag = false;
-        break;
-      }
-    }
-  }
-}
-
-int DistributeTask(struct ThreadPool *thread_pool, Task *task, int task_num) {
+int DistributeTask(struct ThreadPool *thread_pool, Task *task) {
   if (thread_pool == NULL) {
     LOG_ERROR("get thread pool instane failed");
     return RET_TP_ERROR;
   }
-  if (task_num > thread_pool->thread_num || task_num <= 1) {
-    LOG_ERROR("invalid task num: %d, thread num: %d", task_num, thread_pool->thread_num);
+  if (task->task_num > thread_pool->thread_num || task->task_num <= 1) {
+    LOG_ERROR("invalid task num: %d, thread num: %d", task->task_num, thread_pool->thread_num);
     return RET_TP_ERROR;
   }
-  bool k_success_flag = false;
-  int size = thread_pool->thread_num < task_num ? thread_pool->thread_num : task_num;
-  for (int i = 0; i < size - 1; ++i) {
-    do {
-      k_success_flag = true;
-      if (!PushTaskToQueue(thread_pool, i, task)) {
-        k_success_flag = false;
-      }
-    } while (!k_success_flag);
-  }
-  // master thread
   if (task->func == NULL) {
     LOG_ERROR("task->func is nullptr");
     return RET_TP_ERROR;
   }
-  task->func(task->content, size - 1);
-  // wait
-  WaitAllThread(thread_pool);
+  // a thread whose queue is full is busy with other launches, its share is claimed by the others
+  for (int i = 0; i < task->task_num - 1; ++i) {
+    atomic_fetch_add_explicit(&task->ref_count, 1, memory_order_relaxed);
+    if (!PushTaskToQueue(thread_pool, i, task)) {
+      atomic_fetch_sub_explicit(&task->ref_count, 1, memory_order_relaxed);
+    }
+  }
+  // master thread, it runs whatever the pool threads did not claim, so nested and concurrent launches make progress
+  RunClaimedTasks(task);
+  // wait for the tasks claimed by the pool threads
+  while (atomic_load_explicit(&task->finished, memory_order_acquire) < task->task_num) {
+    sched_yield();
+  }
   return RET_TP_OK;
 }
 
@@ -504,10 +517,21 @@ int AddTask(struct ThreadPool *thread_pool, int func(void *, int), void *content
     }
     return RET_TP_OK;
   }
-  Task task;
-  task.func = func;
-  task.content = content;
-  return DistributeTask(thread_pool, &task, task_num);
+  // the task outlives the launch when a pool thread pops it late, it is freed by its last holder
+  Task *task = (Task *)malloc(sizeof(Task));
+  if (task == NULL) {
+    LOG_ERROR("malloc task failed");
+    return RET_TP_ERROR;
+  }
+  task->func = func;
+  task->content = content;
+  task->task_num = task_num;
+  atomic_init(&task->next_index, 0);
+  atomic_init(&task->finished, 0);
+  atomic_init(&task->ref_count, 1);
+  int ret = DistributeTask(thread_pool, task);
+  ReleaseTask(task);
+  return ret;
 }
 
 int ParallelLaunch(struct ThreadPool *thread_pool, int (*func)(void *, int), void *content, int task_num) {
@@ -523,18 +547,14 @@ void ThreadRun(Thread *thread) {
     return;
   }
   Task *task = NULL;
-  int thread_id = thread->thread_id;
   int spin_count = 0;
   sem_post(&thread->sem_inited);
   while (thread_pool->is_alive) {
     while (thread->activate) {
       if (PopTaskFromQueue(thread, &task)) {
-        if (task->func == NULL) {
-          LOG_ERROR("task->func is nullptr");
-          return;
-        }
-        task->func(task->content, thread_id);
+        RunClaimedTasks(task);
         atomic_fetch_sub_explicit(&thread->task_size, 1, memory_order_relaxed);
+        ReleaseTask(task);
         spin_count = 0;
         sem_trywait(&thread->sem);
       } else {
@@ -589,6 +609,7 @@ int CreateNewThread(struct ThreadPool *thread_pool, int thread_id) {
   thread->activate = ATOMIC_VAR_INIT(true);
   thread->is_running = ATOMIC_VAR_INIT(true);
   thread->next = NULL;
+  pthread_mutex_init(&thread->push_lock, NULL);
   sem_init(&thread->sem, 0, 0);
   sem_init(&thread->sem_inited, 0, 0);
   PushThreadToList(thread_pool, thread);
@@ -14,8 +14,14 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include "mindspore/lite/schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -25,6 +31,7 @@
 #include "mindspore/core/utils/log_adapter.h"
 #include "src/lite_session.h"
 #include "src/runtime/parallel_executor.h"
+#include "src/runtime/runtime_api.h"
 
 namespace mindspore {
 class InferTest : public mindspore::CommonTest {
@@ -325,6 +332,121 @@ TEST_F(InferTest, TestParallelExecutor) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestParallelExecutorBranches) {
+  // in0 + in1 feeds two branches that join again: out = ((in0 + in1) + in1) + ((in0 + in1) + in0)
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  std::vector<std::vector<uint32_t>> node_inputs = {{0, 1}, {2, 1}, {2, 0}, {3, 4}};
+  for (size_t i = 0; i < node_inputs.size(); ++i) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->inputIndex = node_inputs[i];
+    node->outputIndex = {static_cast<uint32_t>(i + 2)};
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = schema::PrimitiveType_Add;
+    node->primitive->value.value = new schema::AddT;
+    node->name = "Add" + std::to_string(i);
+    meta_graph->nodes.emplace_back(std::move(node));
+  }
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {5};
+  for (size_t i = 0; i < 6; ++i) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 8, 8, 3};
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::InnerContext;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_type_ = lite::DT_CPU;
+  context->thread_num_ = 4;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = new SessionWithParallelExecutor();
+  session->Init(context);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 2);
+  auto in_data0 = reinterpret_cast<float *>(inputs.front()->MutableData());
+  auto in_data1 = reinterpret_cast<float *>(inputs.back()->MutableData());
+  ASSERT_NE(nullptr, in_data0);
+  ASSERT_NE(nullptr, in_data1);
+  for (int i = 0; i < inputs.front()->ElementsNum(); ++i) {
+    in_data0[i] = 1.0f;
+    in_data1[i] = 2.0f;
+  }
+  // the executor keeps its workers between runs
+  for (int run = 0; run < 3; ++run) {
+    ret = session->RunGraph();
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    auto out_tensor = outputs.begin()->second;
+    ASSERT_NE(nullptr, out_tensor);
+    ASSERT_EQ(8 * 8 * 3, out_tensor->ElementsNum());
+    auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+    ASSERT_NE(nullptr, out_data);
+    std::vector<float> expect(out_tensor->ElementsNum(), 9.0f);
+    CompareOutputData(out_data, expect.data(), out_tensor->ElementsNum(), 0.0001);
+  }
+  delete session;
+  delete model;
+}
+
+namespace {
+struct NestedLaunch {
+  ThreadPool *thread_pool;
+  std::atomic_int count{0};
+};
+
+int InnerTask(void *cdata, int task_id) {
+  reinterpret_cast<NestedLaunch *>(cdata)->count++;
+  return lite::RET_OK;
+}
+
+int OuterTask(void *cdata, int task_id) {
+  auto launch = reinterpret_cast<NestedLaunch *>(cdata);
+  return ParallelLaunch(launch->thread_pool, InnerTask, cdata, 4);
+}
+}  // namespace
+
+TEST_F(InferTest, TestThreadPoolConcurrentLaunch) {
+  // kernels running side by side launch on the same pool, and a task may launch again, no launch waits for the other
+  NestedLaunch launch;
+  launch.thread_pool = CreateLiteThreadPool(4, NO_BIND_MODE);
+  ASSERT_NE(nullptr, launch.thread_pool);
+  constexpr int kThreadNum = 3;
+  constexpr int kLaunchNum = 200;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&launch] {
+      for (int j = 0; j < kLaunchNum; ++j) {
+        EXPECT_EQ(lite::RET_OK, ParallelLaunch(launch.thread_pool, OuterTask, &launch, 4));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(kThreadNum * kLaunchNum * 4 * 4, launch.count);
+  DestroyThreadPool(launch.thread_pool);
+}
+
 TEST_F(InferTest, TestModel) {
   auto buf = new char *[1];
   size_t model_size;
@@ -354,4 +476,216 @@ TEST_F(InferTest, TestModel) {
   auto outputs = session->GetOutputs();
   MS_LOG(INFO) << "Passed";
 }
+
+TEST_F(InferTest, TestMmapModel) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = schema::NodeType::NodeType_Parameter;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {1, 2, 2, 3};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {1, 2, 2, 3};
+  std::vector<float> weight_data(12);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = 0.5f * i;
+  }
+  weight->data.resize(sizeof(float) * weight_data.size());
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  std::string model_path = "./test_mmap_model.ms";
+  std::ofstream ofs(model_path, std::ios::binary);
+  ofs.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ofs.close();
+
+  auto model = lite::Model::ImportFromFile(model_path.c_str());
+  ASSERT_NE(nullptr, model);
+  ASSERT_TRUE(model->buf_mapped_);
+  auto context = new lite::InnerContext;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_type_ = lite::DT_CPU;
+  context->thread_num_ = 1;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+  // the mapping must stay valid for the session after the meta graph is released
+  model->Free();
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  ASSERT_NE(nullptr, in_data);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    in_data[i] = 1.0f;
+  }
+  ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  auto outputs = session->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1);
+  auto *out_data = reinterpret_cast<float *>(outputs.begin()->second->MutableData());
+  ASSERT_NE(nullptr, out_data);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    ASSERT_LE(std::fabs(out_data[i] - (1.0f + weight_data[i])), 0.0001);
+  }
+  delete session;
+  delete model;
+  remove(model_path.c_str());
+  MS_LOG(INFO) << "Passed";
+}
+
+TEST_F(InferTest, TestSharedSession) {
+  // y = x * w^T with a const w, the packed w is shared by every session
+  const int row = 2;
+  const int deep = 4;
+  const int col = 3;
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_FullConnection;
+  auto primitive = new schema::FullConnectionT;
+  primitive->hasBias = false;
+  primitive->useAxis = true;
+  primitive->axis = 1;
+  node->primitive->value.value = primitive;
+  node->name = "FullConnection";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = schema::NodeType::NodeType_Parameter;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {row, deep};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {col, deep};
+  std::vector<float> weight_data(col * deep);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = 0.25f * i - 1.0f;
+  }
+  weight->data.resize(sizeof(float) * weight_data.size());
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  auto model = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ASSERT_NE(nullptr, model);
+
+  lite::Context context;
+  context.cpu_bind_mode_ = lite::NO_BIND;
+  context.device_type_ = lite::DT_CPU;
+  context.thread_num_ = 1;
+  auto source = session::LiteSession::CreateSession(&context);
+  ASSERT_NE(nullptr, source);
+  ASSERT_EQ(lite::RET_OK, source->CompileGraph(model));
+  const int session_num = 4;
+  std::vector<session::LiteSession *> sessions = {source};
+  for (int i = 1; i < session_num; i++) {
+    auto session = session::LiteSession::CreateSharedSession(&context, source);
+    ASSERT_NE(nullptr, session);
+    sessions.push_back(session);
+  }
+  // the shared sessions packed the weight once, into the cache of the source
+  auto weight_cache = static_cast<lite::LiteSession *>(source)->GetSharedWeightCache();
+  ASSERT_NE(nullptr, weight_cache);
+  auto cached_size = weight_cache->GetTotalSize();
+  ASSERT_GT(cached_size, 0u);
+
+  // every session runs its own input at the same time
+  std::vector<int> results(session_num, lite::RET_ERROR);
+  std::vector<std::vector<float>> outs(session_num);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < session_num; i++) {
+    threads.emplace_back([&, i]() {
+      auto session = sessions[i];
+      auto in_data = reinterpret_cast<float *>(session->GetInputs().front()->MutableData());
+      for (int j = 0; j < row * deep; j++) {
+        in_data[j] = static_cast<float>(i + j);
+      }
+      for (int run = 0; run < 10; run++) {
+        results[i] = session->RunGraph();
+        if (results[i] != lite::RET_OK) {
+          return;
+        }
+      }
+      auto out_tensor = session->GetOutputs().begin()->second;
+      auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+      outs[i].assign(out_data, out_data + out_tensor->ElementsNum());
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < session_num; i++) {
+    ASSERT_EQ(lite::RET_OK, results[i]);
+    ASSERT_EQ(outs[i].size(), static_cast<size_t>(row * col));
+    std::vector<float> expect(row * col, 0.0f);
+    for (int r = 0; r < row; r++) {
+      for (int c = 0; c < col; c++) {
+        for (int d = 0; d < deep; d++) {
+          expect[r * col + c] += static_cast<float>(i + r * deep + d) * weight_data[c * deep + d];
+        }
+      }
+    }
+    CompareOutputData(outs[i].data(), expect.data(), row * col, 0.0001);
+  }
+  ASSERT_EQ(cached_size, weight_cache->GetTotalSize());
+  for (int i = session_num - 1; i >= 0; i--) {
+    delete sessions[i];
+  }
+  ASSERT_EQ(0u, weight_cache->GetTotalSize());
+  delete model;
+  MS_LOG(INFO) << "Passed";
+}
 }  // namespace mindspore
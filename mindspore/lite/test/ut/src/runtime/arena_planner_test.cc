@@ -0,0 +1,40 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "src/runtime/arena_planner.h"
+
+namespace mindspore {
+class TestArenaPlanner : public mindspore::CommonTest {
+ public:
+  TestArenaPlanner() {}
+};
+
+TEST_F(TestArenaPlanner, ArenaAllocatorFree) {
+  auto fallback = lite::Allocator::Create();
+  lite::ArenaAllocator allocator(fallback.get());
+  std::vector<char> arena(256);
+  allocator.SetArena(arena.data(), arena.size());
+  ASSERT_TRUE(allocator.InArena(arena.data() + 100));
+  ASSERT_FALSE(allocator.InArena(arena.data() + arena.size()));
+  // freeing arena memory is a no-op, memory from outside the plan goes back to the fallback allocator
+  allocator.Free(arena.data() + 64);
+  auto ptr = allocator.Malloc(32);
+  ASSERT_NE(nullptr, ptr);
+  ASSERT_FALSE(allocator.InArena(ptr));
+  allocator.Free(ptr);
+}
+}  // namespace mindspore
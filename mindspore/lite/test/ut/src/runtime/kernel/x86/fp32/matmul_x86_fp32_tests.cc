@@ -0,0 +1,189 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+#include "src/common/utils.h"
+#include "nnacl/fp32/matmul.h"
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/conv_depthwise_avx.h"
+#include "nnacl/x86_64/matmul_avx.h"
+#endif
+
+namespace mindspore {
+class TestMatMulX86Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatMulX86Fp32() {}
+};
+
+#ifdef ENABLE_AVX
+namespace {
+using MatMulFunc = void (*)(const float *, const float *, float *, const float *, ActType, int, int, int, int, int);
+
+void RandomFill(std::vector<float> *data) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (auto &v : *data) {
+    v = dist(gen);
+  }
+}
+
+// Random packed inputs of a row x deep by deep x col matmul
+struct PackedMatMulInput {
+  PackedMatMulInput(int row, int deep, int col)
+      : a_pack(UP_ROUND(row, C12NUM) * deep), b_pack(UP_ROUND(col, C8NUM) * deep, 0), bias(UP_ROUND(col, C8NUM), 0) {
+    std::vector<float> a(row * deep), b(deep * col);
+    RandomFill(&a);
+    RandomFill(&b);
+    for (int i = 0; i < col; i++) {
+      bias[i] = 0.01f * i;
+    }
+    RowMajor2Col12Major(a.data(), a_pack.data(), row, deep);
+    // b is deep x col row-major, packed the way the fp32 matmul kernel packs a transposed weight
+    std::vector<float> b_t(col * deep);
+    for (int d = 0; d < deep; d++) {
+      for (int c = 0; c < col; c++) {
+        b_t[c * deep + d] = b[d * col + c];
+      }
+    }
+    RowMajor2Col8Major(b_t.data(), b_pack.data(), col, deep);
+  }
+
+  std::vector<float> a_pack;
+  std::vector<float> b_pack;
+  std::vector<float> bias;
+};
+
+size_t MatMulOutSize(int row, int col, int out_type) {
+  return out_type == OutType_Nhwc ? row * col : UP_ROUND(row, C12NUM) * UP_ROUND(col, C8NUM);
+}
+
+void CompareWithC(MatMulFunc func, int row, int deep, int col, int out_type) {
+  PackedMatMulInput input(row, deep, col);
+  size_t out_size = MatMulOutSize(row, col, out_type);
+  std::vector<float> expect(out_size, 0), output(out_size, 0);
+  MatMul12x8(input.a_pack.data(), input.b_pack.data(), expect.data(), input.bias.data(), ActType_Relu6, deep, row, col,
+             col, out_type);
+  func(input.a_pack.data(), input.b_pack.data(), output.data(), input.bias.data(), ActType_Relu6, deep, row, col, col,
+       out_type);
+  CommonTest::CompareOutputData(output.data(), expect.data(), out_size, 0.0001);
+}
+
+// Average time in us of one matmul call after a few warm up calls
+float TimeMatMul(MatMulFunc func, const PackedMatMulInput &input, int row, int deep, int col, int out_type) {
+  constexpr int kWarmUp = 3;
+  constexpr int kLoop = 10;
+  std::vector<float> output(MatMulOutSize(row, col, out_type), 0);
+  for (int i = 0; i < kWarmUp; i++) {
+    func(input.a_pack.data(), input.b_pack.data(), output.data(), input.bias.data(), ActType_Relu6, deep, row, col, col,
+         out_type);
+  }
+  auto time_start = mindspore::lite::GetTimeUs();
+  for (int i = 0; i < kLoop; i++) {
+    func(input.a_pack.data(), input.b_pack.data(), output.data(), input.bias.data(), ActType_Relu6, deep, row, col, col,
+         out_type);
+  }
+  auto time_end = mindspore::lite::GetTimeUs();
+  return static_cast<float>(time_end - time_start) / kLoop;
+}
+
+void BenchmarkWithC(MatMulFunc func, const std::string &name, int row, int deep, int col) {
+  PackedMatMulInput input(row, deep, col);
+  float c_time = TimeMatMul(MatMul12x8, input, row, deep, col, OutType_Nhwc);
+  float simd_time = TimeMatMul(func, input, row, deep, col, OutType_Nhwc);
+  float flops = 2.0f * row * deep * col;
+  MS_LOG(INFO) << "MatMul " << row << "x" << deep << "x" << col << ": c " << c_time << " us (" << flops / c_time / 1000
+               << " GFLOPS), " << name << " " << simd_time << " us (" << flops / simd_time / 1000
+               << " GFLOPS), speedup " << c_time / simd_time;
+}
+}  // namespace
+
+TEST_F(TestMatMulX86Fp32, Row2ColMajorSse) {
+  int row = 27, col = 13;
+  std::vector<float> in(row * col);
+  RandomFill(&in);
+  std::vector<float> col12(UP_ROUND(row, C12NUM) * col, 0), col8(UP_ROUND(row, C8NUM) * col, 0);
+  std::vector<float> expect12(col12.size(), 0), expect8(col8.size(), 0);
+  for (int r = 0; r < row; r++) {
+    for (int c = 0; c < col; c++) {
+      expect12[r / C12NUM * C12NUM * col + c * C12NUM + r % C12NUM] = in[r * col + c];
+      expect8[r / C8NUM * C8NUM * col + c * C8NUM + r % C8NUM] = in[r * col + c];
+    }
+  }
+  RowMajor2Col12Major(in.data(), col12.data(), row, col);
+  RowMajor2Col8Major(in.data(), col8.data(), row, col);
+  CompareOutputData(col12.data(), expect12.data(), col12.size(), 0);
+  CompareOutputData(col8.data(), expect8.data(), col8.size(), 0);
+}
+
+TEST_F(TestMatMulX86Fp32, MatMulAvx2) {
+  if (!X86SupportAvx2Fma()) {
+    return;
+  }
+  for (int out_type : {OutType_Nhwc, OutType_C8}) {
+    CompareWithC(MatMul12x8Avx2, 12, 16, 8, out_type);
+    CompareWithC(MatMul12x8Avx2, 35, 67, 29, out_type);
+    CompareWithC(MatMul12x8Avx2, 196, 256, 128, out_type);
+  }
+}
+
+TEST_F(TestMatMulX86Fp32, MatMulAvx512) {
+  if (!X86SupportAvx512()) {
+    return;
+  }
+  for (int out_type : {OutType_Nhwc, OutType_C8}) {
+    CompareWithC(MatMul12x8Avx512, 12, 16, 8, out_type);
+    CompareWithC(MatMul12x8Avx512, 35, 67, 29, out_type);
+    CompareWithC(MatMul12x8Avx512, 196, 256, 128, out_type);
+  }
+}
+
+// Times the SIMD matmuls against the C one on the shapes of a few conv1x1 and fully connected layers
+TEST_F(TestMatMulX86Fp32, MatMulSimdBenchmark) {
+  const std::vector<std::vector<int>> shapes = {{196, 256, 256}, {784, 128, 128}, {1, 1024, 1000}};
+  for (const auto &shape : shapes) {
+    if (X86SupportAvx2Fma()) {
+      BenchmarkWithC(MatMul12x8Avx2, "avx2", shape[0], shape[1], shape[2]);
+    }
+    if (X86SupportAvx512()) {
+      BenchmarkWithC(MatMul12x8Avx512, "avx512", shape[0], shape[1], shape[2]);
+    }
+  }
+}
+
+TEST_F(TestMatMulX86Fp32, ConvDwRowAvx2) {
+  if (!X86SupportAvx2Fma()) {
+    return;
+  }
+  int num_pixels = 7, channel = 29, input_step = 2 * channel;
+  std::vector<float> input(num_pixels * input_step), weight(channel), expect(num_pixels * channel);
+  RandomFill(&input);
+  RandomFill(&weight);
+  RandomFill(&expect);
+  std::vector<float> output(expect);
+  for (int i = 0; i < num_pixels; i++) {
+    for (int c = 0; c < channel; c++) {
+      expect[i * channel + c] += weight[c] * input[i * input_step + c];
+    }
+  }
+  ConvDwFp32RowAvx2(output.data(), input.data(), weight.data(), num_pixels, channel, input_step);
+  CompareOutputData(output.data(), expect.data(), output.size(), 0.0001);
+}
+#endif
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/packed_weight_cache.h"
+
+namespace mindspore {
+class TestPackedWeightCache : public mindspore::CommonTest {
+ public:
+  TestPackedWeightCache() {}
+};
+
+TEST_F(TestPackedWeightCache, PackOnce) {
+  lite::PackedWeightCache cache;
+  std::vector<float> origin = {1.0f, 2.0f, 3.0f, 4.0f};
+  int pack_count = 0;
+  auto pack = [&](void *packed) {
+    pack_count++;
+    auto dst = reinterpret_cast<float *>(packed);
+    for (size_t i = 0; i < origin.size(); i++) {
+      dst[i] = origin[origin.size() - 1 - i];
+    }
+    return lite::RET_OK;
+  };
+  auto size = origin.size() * sizeof(float);
+  cache.AddWeight(origin.data(), 1);
+  auto first = cache.GetOrPack(origin.data(), "reverse", size, pack);
+  auto second = cache.GetOrPack(origin.data(), "reverse", size, pack);
+  ASSERT_NE(nullptr, first);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(1, pack_count);
+  ASSERT_EQ(size, cache.GetTotalSize());
+  ASSERT_EQ(4.0f, reinterpret_cast<float *>(first)[0]);
+
+  // another kind of packing of the same weight gets its own buffer
+  auto other = cache.GetOrPack(origin.data(), "copy", size, pack);
+  ASSERT_NE(first, other);
+  ASSERT_EQ(2, pack_count);
+
+  ASSERT_TRUE(cache.Release(first));
+  ASSERT_EQ(2 * size, cache.GetTotalSize());
+  ASSERT_TRUE(cache.Release(second));
+  ASSERT_EQ(size, cache.GetTotalSize());
+  ASSERT_TRUE(cache.Release(other));
+  ASSERT_EQ(0u, cache.GetTotalSize());
+}
+
+TEST_F(TestPackedWeightCache, PackFailed) {
+  lite::PackedWeightCache cache;
+  float origin = 1.0f;
+  cache.AddWeight(&origin, 0);
+  auto packed = cache.GetOrPack(&origin, "fail", sizeof(float), [](void *) { return lite::RET_ERROR; });
+  ASSERT_EQ(nullptr, packed);
+  ASSERT_EQ(0u, cache.GetTotalSize());
+}
+
+TEST_F(TestPackedWeightCache, TransientOrigin) {
+  lite::PackedWeightCache cache;
+  std::vector<float> weight = {1.0f, 2.0f};
+  cache.AddWeight(weight.data(), 3);
+  auto size = weight.size() * sizeof(float);
+  auto pack = [&](void *packed) {
+    memcpy(packed, weight.data(), size);
+    return lite::RET_OK;
+  };
+  auto packed = cache.GetOrPack(weight.data(), "copy", size, pack);
+  ASSERT_NE(nullptr, packed);
+
+  // a dequantized weight lives in a temporary buffer, whose address can be reused by the one of another layer
+  std::vector<float> dequant = {3.0f, 4.0f};
+  ASSERT_TRUE(cache.IsWeight(weight.data()));
+  ASSERT_FALSE(cache.IsWeight(dequant.data()));
+  ASSERT_EQ(nullptr, cache.GetOrPack(dequant.data(), "copy", size, pack));
+  ASSERT_EQ(size, cache.GetTotalSize());
+
+  // buffers packed outside of the cache are left to their owner
+  std::vector<float> own(weight.size());
+  ASSERT_FALSE(cache.Release(own.data()));
+  ASSERT_TRUE(cache.Release(packed));
+  ASSERT_EQ(0u, cache.GetTotalSize());
+}
+}  // namespace mindspore
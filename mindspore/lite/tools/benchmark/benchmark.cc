@@ -18,6 +18,7 @@
 #define __STDC_FORMAT_MACROS
 #include <cinttypes>
 #undef __STDC_FORMAT_MACROS
+#include <unistd.h>
 #include <algorithm>
 #include <utility>
 #include "src/common/common.h"
@@ -32,6 +33,17 @@ static const char *DELIM_COLON = ":";
 static const char *DELIM_COMMA = ",";
 static const char *DELIM_SLASH = "/";
 
+// resident set size of the process, read from procfs, 0 where procfs is not available
+static size_t GetResidentMemoryKB() {
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (!(statm >> total_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
 int Benchmark::GenerateRandomData(size_t size, void *data) {
   MS_ASSERT(data != nullptr);
   char *castedData = static_cast<char *>(data);
@@ -347,21 +359,25 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
 
   MS_LOG(INFO) << "start reading model file";
   std::cout << "start reading model file" << std::endl;
-  size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOG(ERROR) << "Read model file failed while running " << modelName.c_str();
-    std::cerr << "Read model file failed while running " << modelName.c_str() << std::endl;
-    return RET_ERROR;
+  lite::Model *model = nullptr;
+  if (_flags->mmapModel) {
+    model = lite::Model::ImportFromFile(_flags->modelPath.c_str());
+  } else {
+    size_t size = 0;
+    char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
+    if (graphBuf == nullptr) {
+      MS_LOG(ERROR) << "Read model file failed while running " << modelName.c_str();
+      std::cerr << "Read model file failed while running " << modelName.c_str() << std::endl;
+      return RET_ERROR;
+    }
+    model = lite::Model::Import(graphBuf, size);
+    delete[](graphBuf);
   }
-  auto model = lite::Model::Import(graphBuf, size);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model file failed while running " << modelName.c_str();
     std::cerr << "Import model file failed while running " << modelName.c_str() << std::endl;
-    delete[](graphBuf);
     return RET_ERROR;
   }
-  delete[](graphBuf);
   auto context = new (std::nothrow) lite::Context;
   if (context == nullptr) {
     MS_LOG(ERROR) << "New context failed while running " << modelName.c_str();
@@ -410,6 +426,8 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
   MS_LOG(INFO) << "PrepareTime = " << (endPrepareTime - startPrepareTime) / 1000 << " ms ";
   printf("PrepareTime = %ld ms, ", (endPrepareTime - startPrepareTime) / 1000);
 #endif
+  MS_LOG(INFO) << "ResidentMemory = " << GetResidentMemoryKB() << " KB";
+  printf("ResidentMemory = %zu KB, ", GetResidentMemoryKB());
 
   // Load input
   MS_LOG(INFO) << "start generate input data";
@@ -59,6 +59,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::device, "device", "CPU | GPU", "CPU");
     AddFlag(&BenchmarkFlags::cpuBindMode, "cpuBindMode",
             "Input -1 for MID_CPU, 1 for HIGHER_CPU, 0 for NO_BIND, defalut value: 1", 1);
+    AddFlag(&BenchmarkFlags::mmapModel, "mmapModel", "Map the model file into memory instead of copying it", false);
     // MarkPerformance
     AddFlag(&BenchmarkFlags::loopCount, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
@@ -85,6 +86,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   InDataType inDataType;
   std::string inDataTypeIn = "bin";
   int cpuBindMode = 1;
+  bool mmapModel = false;
   // MarkPerformance
   int loopCount;
   int numThreads;
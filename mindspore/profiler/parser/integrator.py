@@ -776,6 +776,45 @@ class GpuTimelineGenerator(BaseTimelineGenerator):
         # Update timeline summary info
         self._timeline_summary['num_of_streams'] += len(stream_count_dict.keys())
 
+class CpuTimelineGenerator(BaseTimelineGenerator):
+    """Generate cpu Timeline data from the files written by the cpu profiler."""
+    _display_filename = 'cpu_timeline_display_{}.json'
+    _timeline_summary_filename = 'cpu_timeline_summary_{}.json'
+
+    def __init__(self, profiling_dir, device_id):
+        self._profiling_dir = profiling_dir
+        self._device_id = device_id
+        self._timeline_meta = []
+        self._timeline_summary = {
+            'total_time': 0,
+            'num_of_streams': 0,
+            'num_of_ops': 0,
+            'op_exe_times': 0
+            }
+
+    def _load_json_file(self, file_name):
+        """Load a json file written by the cpu profiler."""
+        file_path = os.path.join(
+            self._profiling_dir,
+            file_name.format(self._device_id)
+        )
+        file_path = validate_and_normalize_path(file_path)
+        if not os.path.exists(file_path):
+            logger.error("Failed to find parsed timeline file.")
+            raise ProfilerFileNotFoundException('parsed timeline file')
+        try:
+            with open(file_path, 'r') as json_file:
+                return json.load(json_file)
+        except (IOError, OSError, ValueError) as err:
+            logger.error('Error occurred when load cpu timeline file: %s', err)
+            raise ProfilerIOException
+
+    def init_timeline(self):
+        """Init timeline metadata, the events and the summary are already in the chrome trace format."""
+        self._timeline_meta = self._load_json_file(self._display_filename)
+        self._timeline_meta.sort(key=lambda item: float(item.get('ts')))
+        self._timeline_summary.update(self._load_json_file(self._timeline_summary_filename))
+
 class AscendTimelineGenerator(BaseTimelineGenerator):
     """Generate ascend Timeline data from file."""
     _display_filename = 'ascend_timeline_display_{}.json'
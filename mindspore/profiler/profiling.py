@@ -28,7 +28,8 @@ from mindspore.profiler.parser.aicpu_data_parser import DataPreProcessParser
 from mindspore.profiler.parser.framework_parser import FrameworkParser
 from mindspore.profiler.parser.hwts_log_parser import HWTSLogParser
 from mindspore.profiler.parser.integrator import Integrator
-from mindspore.profiler.parser.integrator import GpuTimelineGenerator, AscendTimelineGenerator
+from mindspore.profiler.parser.integrator import GpuTimelineGenerator, CpuTimelineGenerator, \
+    AscendTimelineGenerator
 from mindspore.profiler.parser.minddata_parser import MinddataParser
 from mindspore.profiler.parser.minddata_pipeline_parser import \
     MinddataPipelineParser
@@ -50,8 +51,10 @@ class Profiler:
     Performance profiling API.
 
     This API enables MindSpore users to profile the performance of neural network.
-    Profiler supports Ascend and GPU, both of them are used in the same way,
-    but only output_path in args works on GPU.
+    Profiler supports Ascend, GPU and CPU, all of them are used in the same way,
+    but only output_path in args works on GPU and CPU. On CPU, the per-operator statistics are written
+    to cpu_op_type_info_{device_id}.csv and cpu_op_detail_info_{device_id}.csv, and the launches of the
+    operators to cpu_timeline_display_{device_id}.json in the chrome trace format.
 
     Args:
         output_path (str): Output data path.
@@ -96,6 +99,14 @@ class Profiler:
 
             if kwargs:
                 logger.warning("Params not be supported yet on GPU.")
+        elif self._device_target and self._device_target == "CPU":
+            from mindspore._c_expression import CPUProfiler
+            self._cpu_profiler = CPUProfiler.get_instance()
+            self._cpu_profiler.init(self._output_path)
+            self._cpu_profiler.step_profiling_enable(True)
+
+            if kwargs:
+                logger.warning("Params not be supported yet on CPU.")
         elif self._device_target and self._device_target == "Ascend":
             optypes_not_deal = kwargs.pop("optypes_not_deal", "Variable")
             if not isinstance(optypes_not_deal, str):
@@ -142,6 +153,10 @@ class Profiler:
         if self._device_target and self._device_target == "GPU":
             self._gpu_profiler.stop()
             self._generate_timeline()
+        elif self._device_target and self._device_target == "CPU":
+            # the op statistics and the timeline are written by the cpu profiler
+            self._cpu_profiler.stop()
+            self._generate_timeline()
         elif self._device_target and self._device_target == "Ascend":
             release()
 
@@ -288,18 +303,24 @@ class Profiler:
         timeline_analyser.write_timeline_summary()
 
     def _generate_timeline(self):
-        """Used for gpu, generate timeline info, write to json format file."""
+        """Used for gpu and cpu, generate timeline info, write to json format file."""
         try:
             size_limit = 100 * 1024 * 1024  # 100MB
+            if self._device_target == "CPU":
+                file_prefix = 'cpu_op_detail'
+                generator_class = CpuTimelineGenerator
+            else:
+                file_prefix = 'gpu_op_detail'
+                generator_class = GpuTimelineGenerator
             #stastic the number of dev_id
             file_list = os.listdir(self._output_path)
             dev_id_list = []
             for file_name in file_list:
-                if file_name.startswith('gpu_op_detail'):
+                if file_name.startswith(file_prefix):
                     _dev_id = file_name.split('.')[0].split('_')[-1]
                     dev_id_list.append(_dev_id)
             for dev_id in dev_id_list:
-                timeline_generator = GpuTimelineGenerator(self._output_path, dev_id)
+                timeline_generator = generator_class(self._output_path, dev_id)
                 timeline_generator.init_timeline()
                 timeline_generator.write_timeline(size_limit)
                 timeline_generator.write_timeline_summary()
@@ -451,7 +472,7 @@ class Profiler:
             dev_id = "0"
             logger.error("Fail to get DEVICE_ID, use 0 instead.")
 
-        if device_target and device_target not in ["Ascend", "GPU"]:
+        if device_target and device_target not in ["Ascend", "GPU", "CPU"]:
             msg = "Profiling: unsupported backend: %s" % device_target
             raise RuntimeError(msg)
 
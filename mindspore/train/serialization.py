@@ -30,6 +30,7 @@ from mindspore.common.parameter import Parameter
 from mindspore.common.api import _executor
 from mindspore.common import dtype as mstype
 from mindspore._checkparam import check_input_data
+from mindspore._c_expression import _is_native_checkpoint, _load_native_checkpoint, _save_native_checkpoint
 
 __all__ = ["save_checkpoint", "load_checkpoint", "load_param_into_net", "export", "parse_print",
            "build_searched_strategy", "merge_sliced_parameter"]
@@ -141,7 +142,20 @@ def _exec_save(ckpt_file_name, data_list):
         raise e
 
 
-def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False):
+def _exec_save_native(ckpt_file_name, tensor_list):
+    """Execute save checkpoint into a native format file process."""
+
+    try:
+        with _ckpt_mutex:
+            _save_native_checkpoint(ckpt_file_name, tensor_list)
+        os.chmod(ckpt_file_name, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.error("Failed to save the checkpoint file %s.", ckpt_file_name)
+        raise e
+
+
+def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, file_format="PROTOBUF"):
     """
     Saves checkpoint info to a specified file.
 
@@ -152,10 +166,17 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
         ckpt_file_name (str): Checkpoint file name. If the file name already exists, it will be overwritten.
         integrated_save (bool): Whether to integrated save in automatic model parallel scene. Default: True
         async_save (bool): Whether asynchronous execution saves the checkpoint to a file. Default: False
+        file_format (str): The format of the checkpoint file. Support 'PROTOBUF' and 'NATIVE'. Default: 'PROTOBUF'.
+
+            - PROTOBUF: A serialized Checkpoint protobuf message.
+            - NATIVE: The data of the parameters in aligned blobs, followed by an index. The blobs are written and
+              checksummed by several threads, without serializing them in memory, and `load_checkpoint` maps them
+              into the loaded parameters without copying them.
 
     Raises:
         TypeError: If the parameter save_obj is not nn.Cell or list type.And if the parameter integrated_save and
                    async_save are not bool type.
+        ValueError: If the parameter file_format is not 'PROTOBUF' or 'NATIVE'.
     """
 
     if not isinstance(save_obj, nn.Cell) and not isinstance(save_obj, list):
@@ -164,6 +185,8 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
         raise TypeError("The parameter integrated_save should be bool, but got {}".format(type(integrated_save)))
     if not isinstance(async_save, bool):
         raise TypeError("The parameter async_save should be bool, but got {}".format(type(async_save)))
+    if file_format not in ("PROTOBUF", "NATIVE"):
+        raise ValueError("The parameter file_format should be 'PROTOBUF' or 'NATIVE', but got {}".format(file_format))
 
     logger.info("Execute save checkpoint process.")
 
@@ -186,6 +209,29 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
             param_list.append(each_param)
         save_obj = param_list
 
+    if file_format == "NATIVE":
+        tensor_list = []
+        with _ckpt_mutex:
+            for param in save_obj:
+                if isinstance(param["data"], Parameter):
+                    param["data"].init_data()
+                # asnumpy syncs the data from the device. An asynchronous save writes a snapshot of it, since the
+                # parameters keep being updated while the file is written.
+                param_data = param["data"].asnumpy()
+                if async_save:
+                    tensor_list.append((param["name"], Tensor(param_data)))
+                else:
+                    tensor_list.append((param["name"], Tensor(param["data"])))
+
+        if async_save:
+            thr = Thread(target=_exec_save_native, args=(ckpt_file_name, tensor_list), name="asyn_save_ckpt")
+            thr.start()
+        else:
+            _exec_save_native(ckpt_file_name, tensor_list)
+
+        logger.info("Save checkpoint process finish.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -214,19 +260,27 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
     logger.info("Save checkpoint process finish.")
 
 
-def load_checkpoint(ckpt_file_name, net=None):
+def load_checkpoint(ckpt_file_name, net=None, param_names=None, verify=False):
     """
     Loads checkpoint info from a specified file.
 
+    The format of the file is detected. The parameters of a 'NATIVE' checkpoint are mapped from the file, so their
+    data is only read when it is used.
+
     Args:
         ckpt_file_name (str): Checkpoint file name.
         net (Cell): Cell network. Default: None
+        param_names (list[str]): The names of the parameters to load, all the parameters are loaded if it is None.
+            Default: None
+        verify (bool): Whether to check the checksums of the loaded parameters of a 'NATIVE' checkpoint, which reads
+            their data when loading. Default: False
 
     Returns:
         Dict, key is parameter name, value is a Parameter.
 
     Raises:
         ValueError: Checkpoint file is incorrect.
+        RuntimeError: A parameter of param_names is not in the checkpoint.
     """
     if not isinstance(ckpt_file_name, str):
         raise ValueError("The ckpt_file_name must be string.")
@@ -240,8 +294,19 @@ def load_checkpoint(ckpt_file_name, net=None):
     if os.path.getsize(ckpt_file_name) == 0:
         raise ValueError("The checkpoint file may be empty, please make sure enter the correct file name.")
 
+    if param_names is not None and (not isinstance(param_names, (list, tuple)) or
+                                    not all(isinstance(name, str) for name in param_names)):
+        raise ValueError("The param_names must be a list of string.")
+
     logger.info("Execute load checkpoint process.")
+    if _is_native_checkpoint(ckpt_file_name):
+        parameter_dict = _load_native(ckpt_file_name, param_names, verify)
+        if net is not None:
+            load_param_into_net(net, parameter_dict)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
+    param_name_set = set(param_names) if param_names is not None else None
 
     try:
         with open(ckpt_file_name, "rb") as f:
@@ -256,6 +321,9 @@ def load_checkpoint(ckpt_file_name, net=None):
         element_id = 0
         param_data_list = []
         for element in checkpoint_list.value:
+            if param_name_set is not None and element.tag not in param_name_set:
+                element_id += 1
+                continue
             data = element.tensor.tensor_content
             data_type = element.tensor.tensor_type
             np_type = tensor_to_np_type[data_type]
@@ -291,12 +359,33 @@ def load_checkpoint(ckpt_file_name, net=None):
         logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
         raise RuntimeError(e.__str__())
 
+    if param_names is not None:
+        param_not_found = [name for name in param_names if name not in parameter_dict]
+        if param_not_found:
+            raise RuntimeError("The parameters {} are not in the checkpoint file {}."
+                               .format(param_not_found, ckpt_file_name))
+
     if net is not None:
         load_param_into_net(net, parameter_dict)
 
     return parameter_dict
 
 
+def _load_native(ckpt_file_name, param_names, verify):
+    """Load the parameters of a native checkpoint file, their data is mapped from the file."""
+    try:
+        tensor_list = _load_native_checkpoint(ckpt_file_name, list(param_names or []), verify)
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
+        raise RuntimeError(e.__str__())
+
+    parameter_dict = {}
+    for name, tensor in tensor_list:
+        parameter_dict[name] = Parameter(tensor, name=name)
+    logger.info("Load checkpoint process finish.")
+    return parameter_dict
+
+
 def load_param_into_net(net, parameter_dict):
     """
     Loads parameters into network.
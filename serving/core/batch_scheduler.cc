@@ -0,0 +1,318 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "core/batch_scheduler.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "include/infer_log.h"
+
+using mindspore::inference::FAILED;
+using mindspore::inference::InferTensor;
+using mindspore::inference::ReplyBase;
+using mindspore::inference::RequestBase;
+using mindspore::inference::Status;
+using mindspore::inference::SUCCESS;
+
+namespace mindspore {
+namespace serving {
+namespace {
+uint64_t ElapsedUs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+}  // namespace
+
+void LatencyHistogram::Record(uint64_t latency_us) {
+  size_t bucket = 0;
+  while (bucket + 1 < kBucketNum && (latency_us >> (bucket + 1)) != 0) {
+    bucket++;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  buckets_[bucket]++;
+  count_++;
+  sum_us_ += latency_us;
+  max_us_ = std::max(max_us_, latency_us);
+}
+
+uint64_t LatencyHistogram::Count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_;
+}
+
+uint64_t LatencyHistogram::Percentile(double percent) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return PercentileLocked(percent);
+}
+
+uint64_t LatencyHistogram::PercentileLocked(double percent) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(static_cast<double>(count_) * percent / 100.0);
+  target = std::min(std::max<uint64_t>(target, 1), count_);
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < kBucketNum; i++) {
+    accumulated += buckets_[i];
+    if (accumulated >= target) {
+      return std::min((static_cast<uint64_t>(1) << (i + 1)) - 1, max_us_);
+    }
+  }
+  return max_us_;
+}
+
+std::string LatencyHistogram::ToString() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::stringstream ss;
+  ss << "count " << count_ << ", mean " << (count_ == 0 ? 0 : sum_us_ / count_) << "us, p50 " << PercentileLocked(50)
+     << "us, p90 " << PercentileLocked(90) << "us, p99 " << PercentileLocked(99) << "us, max " << max_us_ << "us";
+  return ss.str();
+}
+
+BatchScheduler::BatchScheduler(ExecuteFunc execute_func, const BatchOptions &options)
+    : execute_func_(std::move(execute_func)), options_(options) {
+  worker_ = std::thread(&BatchScheduler::WorkerLoop, this);
+}
+
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+Status BatchScheduler::Predict(const RequestBase &request, ReplyBase &reply) {
+  Task task;
+  task.request = &request;
+  task.reply = &reply;
+  task.rows = BatchRows(request);
+  task.enqueue_time = Clock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_) {
+      MSI_LOG(ERROR) << "the batch scheduler has been stopped";
+      return FAILED;
+    }
+    queue_.push_back(&task);
+    queue_cond_.notify_one();
+    done_cond_.wait(lock, [&task] { return task.done; });
+  }
+  auto end_time = Clock::now();
+  queue_latency_.Record(ElapsedUs(task.enqueue_time, task.start_time));
+  request_latency_.Record(ElapsedUs(task.enqueue_time, end_time));
+  return task.status;
+}
+
+void BatchScheduler::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queue_cond_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    // queued requests are still executed when stopping
+    if (queue_.empty()) {
+      break;
+    }
+    std::vector<Task *> batch;
+    CollectBatch(&lock, &batch);
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+    for (auto task : batch) {
+      task->done = true;
+    }
+    done_cond_.notify_all();
+  }
+}
+
+void BatchScheduler::CollectBatch(std::unique_lock<std::mutex> *lock, std::vector<Task *> *batch) {
+  Task *first = queue_.front();
+  queue_.pop_front();
+  batch->push_back(first);
+  if (first->rows <= 0 || !merge_enabled_) {
+    return;
+  }
+  int64_t rows = first->rows;
+  auto deadline = first->enqueue_time + std::chrono::microseconds(options_.max_queue_delay_us);
+  while (rows < static_cast<int64_t>(options_.max_batch_size)) {
+    if (queue_.empty()) {
+      if (stop_ || queue_cond_.wait_until(*lock, deadline) == std::cv_status::timeout) {
+        if (queue_.empty()) {
+          break;
+        }
+      }
+      continue;
+    }
+    Task *next = queue_.front();
+    if (next->rows <= 0 || rows + next->rows > static_cast<int64_t>(options_.max_batch_size) ||
+        !Compatible(*first->request, *next->request)) {
+      break;
+    }
+    queue_.pop_front();
+    batch->push_back(next);
+    rows += next->rows;
+  }
+}
+
+void BatchScheduler::RunBatch(const std::vector<Task *> &batch) {
+  auto start_time = Clock::now();
+  for (auto task : batch) {
+    task->start_time = start_time;
+  }
+  batch_count_++;
+  request_count_ += batch.size();
+  if (batch.size() == 1) {
+    batch[0]->status = execute_func_(*batch[0]->request, *batch[0]->reply);
+    return;
+  }
+  if (RunMerged(batch) == SUCCESS) {
+    return;
+  }
+  bool all_success = true;
+  for (auto task : batch) {
+    task->reply->clear();
+    task->status = execute_func_(*task->request, *task->reply);
+    all_success = all_success && task->status == SUCCESS;
+  }
+  // the requests are fine on their own, so it is the model that rejects merged batches
+  if (all_success) {
+    merge_enabled_ = false;
+    MSI_LOG(WARNING) << "execute merged batch failed while each request succeeded, request batching is disabled";
+  }
+}
+
+Status BatchScheduler::RunMerged(const std::vector<Task *> &batch) {
+  const RequestBase &first = *batch[0]->request;
+  int64_t total_rows = 0;
+  for (auto task : batch) {
+    total_rows += task->rows;
+  }
+  std::vector<InferTensor> inputs(first.size());
+  for (size_t i = 0; i < first.size(); i++) {
+    size_t total_size = 0;
+    for (auto task : batch) {
+      total_size += (*task->request)[i]->data_size();
+    }
+    auto shape = first[i]->shape();
+    shape[0] = total_rows;
+    inputs[i].set_data_type(first[i]->data_type());
+    inputs[i].set_shape(shape);
+    inputs[i].resize_data(total_size);
+    auto dst = reinterpret_cast<uint8_t *>(inputs[i].mutable_data());
+    size_t offset = 0;
+    for (auto task : batch) {
+      auto src = (*task->request)[i];
+      if (src->data_size() == 0) {
+        continue;
+      }
+      if (memcpy_s(dst + offset, total_size - offset, src->data(), src->data_size()) != EOK) {
+        MSI_LOG(ERROR) << "merge input " << i << " of batch failed";
+        return FAILED;
+      }
+      offset += src->data_size();
+    }
+  }
+
+  std::vector<InferTensor> outputs;
+  inference::VectorInferTensorWrapRequest merged_request(inputs);
+  inference::VectorInferTensorWrapReply merged_reply(outputs);
+  Status ret = execute_func_(merged_request, merged_reply);
+  if (ret != SUCCESS) {
+    MSI_LOG(WARNING) << "execute merged batch of " << batch.size() << " requests failed";
+    return ret;
+  }
+  for (auto &output : outputs) {
+    if (output.shape().empty() || output.shape()[0] != total_rows ||
+        output.data_size() % static_cast<size_t>(total_rows) != 0) {
+      MSI_LOG(WARNING) << "output of merged batch can not be split by " << total_rows << " rows";
+      return FAILED;
+    }
+  }
+
+  int64_t row_offset = 0;
+  for (auto task : batch) {
+    task->reply->clear();
+    for (auto &output : outputs) {
+      size_t row_size = output.data_size() / static_cast<size_t>(total_rows);
+      auto shape = output.shape();
+      shape[0] = task->rows;
+      auto item = task->reply->add();
+      if (item == nullptr) {
+        MSI_LOG(ERROR) << "add output tensor to reply failed";
+        return FAILED;
+      }
+      item->set_data_type(output.data_type());
+      item->set_shape(shape);
+      auto src = reinterpret_cast<const uint8_t *>(output.data()) + row_offset * row_size;
+      if (!item->set_data(src, task->rows * row_size)) {
+        MSI_LOG(ERROR) << "scatter output of merged batch failed";
+        return FAILED;
+      }
+    }
+    task->status = SUCCESS;
+    row_offset += task->rows;
+  }
+  return SUCCESS;
+}
+
+int64_t BatchScheduler::BatchRows(const RequestBase &request) {
+  if (request.size() == 0) {
+    return 0;
+  }
+  int64_t rows = 0;
+  for (size_t i = 0; i < request.size(); i++) {
+    auto tensor = request[i];
+    if (tensor == nullptr) {
+      return 0;
+    }
+    auto shape = tensor->shape();
+    if (shape.empty() || shape[0] <= 0) {
+      return 0;
+    }
+    if (i == 0) {
+      rows = shape[0];
+    } else if (shape[0] != rows) {
+      return 0;
+    }
+    auto type_size = tensor->GetTypeSize(tensor->data_type());
+    if (type_size == 0 || tensor->data_size() != static_cast<size_t>(tensor->ElementNum()) * type_size) {
+      return 0;
+    }
+  }
+  return rows;
+}
+
+bool BatchScheduler::Compatible(const RequestBase &first, const RequestBase &other) {
+  if (first.size() != other.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < first.size(); i++) {
+    if (first[i]->data_type() != other[i]->data_type()) {
+      return false;
+    }
+    auto first_shape = first[i]->shape();
+    auto other_shape = other[i]->shape();
+    if (first_shape.size() != other_shape.size() ||
+        !std::equal(first_shape.begin() + 1, first_shape.end(), other_shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace serving
+}  // namespace mindspore
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_SERVING_BATCH_SCHEDULER_H
+#define MINDSPORE_SERVING_BATCH_SCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/inference.h"
+
+namespace mindspore {
+namespace serving {
+// Latency histogram with power-of-two microsecond buckets, bucket i counts latencies in [2^i, 2^(i+1)) us.
+class LatencyHistogram {
+ public:
+  LatencyHistogram() = default;
+  ~LatencyHistogram() = default;
+
+  void Record(uint64_t latency_us);
+  uint64_t Count() const;
+  // upper bound of the bucket holding the given percentile, in us
+  uint64_t Percentile(double percent) const;
+  std::string ToString() const;
+
+ private:
+  static constexpr size_t kBucketNum = 40;
+  mutable std::mutex mutex_;
+  std::array<uint64_t, kBucketNum> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t sum_us_ = 0;
+  uint64_t max_us_ = 0;
+
+  uint64_t PercentileLocked(double percent) const;
+};
+
+struct BatchOptions {
+  // max rows along dim 0 merged into one execution, 1 disables batching
+  uint32_t max_batch_size = 1;
+  // max time the first queued request waits for others before the batch is executed
+  uint32_t max_queue_delay_us = 0;
+};
+
+// Queues data requests from concurrent callers and merges compatible ones along the batch dimension (dim 0),
+// runs them as one execution and scatters the outputs back. Two requests are compatible when they have the same
+// input count and every input has the same data type and the same shape except dim 0. The model must accept a
+// variable batch size, when a merged execution fails or its outputs can not be split by rows, the requests are
+// executed one by one and merging is disabled from then on.
+class BatchScheduler {
+ public:
+  using ExecuteFunc = std::function<inference::Status(const inference::RequestBase &, inference::ReplyBase &)>;
+
+  BatchScheduler(ExecuteFunc execute_func, const BatchOptions &options);
+  ~BatchScheduler();
+
+  // blocks until the request is executed
+  inference::Status Predict(const inference::RequestBase &request, inference::ReplyBase &reply);
+
+  const LatencyHistogram &queue_latency() const { return queue_latency_; }
+  const LatencyHistogram &request_latency() const { return request_latency_; }
+  uint64_t batch_count() const { return batch_count_; }
+  uint64_t request_count() const { return request_count_; }
+  bool merge_enabled() const { return merge_enabled_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  struct Task {
+    const inference::RequestBase *request = nullptr;
+    inference::ReplyBase *reply = nullptr;
+    int64_t rows = 0;  // dim 0 shared by all inputs, 0 when the request can not be merged
+    Clock::time_point enqueue_time;
+    Clock::time_point start_time;
+    inference::Status status = inference::FAILED;
+    bool done = false;
+  };
+
+  ExecuteFunc execute_func_;
+  BatchOptions options_;
+  std::mutex mutex_;
+  std::condition_variable queue_cond_;
+  std::condition_variable done_cond_;
+  std::deque<Task *> queue_;
+  bool stop_ = false;
+  std::thread worker_;
+  std::atomic_bool merge_enabled_{true};
+  std::atomic<uint64_t> batch_count_{0};
+  std::atomic<uint64_t> request_count_{0};
+  LatencyHistogram queue_latency_;
+  LatencyHistogram request_latency_;
+
+  void WorkerLoop();
+  void CollectBatch(std::unique_lock<std::mutex> *lock, std::vector<Task *> *batch);
+  void RunBatch(const std::vector<Task *> &batch);
+  inference::Status RunMerged(const std::vector<Task *> &batch);
+  static int64_t BatchRows(const inference::RequestBase &request);
+  static bool Compatible(const inference::RequestBase &first, const inference::RequestBase &other);
+};
+}  // namespace serving
+}  // namespace mindspore
+#endif  // MINDSPORE_SERVING_BATCH_SCHEDULER_H
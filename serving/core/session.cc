@@ -35,6 +35,10 @@ using ms_serving::PredictRequest;
 
 namespace mindspore {
 namespace serving {
+namespace {
+constexpr uint64_t kLatencyLogInterval = 1000;
+}  // namespace
+
 Status Session::CreatDeviceSession(const std::string &device, uint32_t device_id) {
   session_ = inference::InferSession::CreateSession(device, device_id);
   if (session_ == nullptr) {
@@ -79,6 +83,16 @@ Status Session::PredictInner(const PredictRequest &request, PredictReply &reply)
     MSI_LOG(ERROR) << "the inference session has not be initialized";
     return FAILED;
   }
+  if (request.images_size() == 0 && request.data_size() > 0) {
+    std::shared_ptr<BatchScheduler> batch_scheduler;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch_scheduler = batch_scheduler_;
+    }
+    if (batch_scheduler != nullptr) {
+      return PredictBatched(batch_scheduler.get(), request, reply);
+    }
+  }
   std::lock_guard<std::mutex> lock(mutex_);
   MSI_LOG(INFO) << "run Predict";
 
@@ -105,6 +119,46 @@ Status Session::PredictInner(const PredictRequest &request, PredictReply &reply)
   return SUCCESS;
 }
 
+Status Session::PredictBatched(BatchScheduler *batch_scheduler, const PredictRequest &request, PredictReply &reply) {
+  MSI_LOG(INFO) << "run Predict with request batching";
+  ServingRequest serving_request(request);
+  ServingReply serving_reply(reply);
+  Status ret = batch_scheduler->Predict(serving_request, serving_reply);
+  if (ret != SUCCESS) {
+    MSI_LOG(ERROR) << "execute model with datas return failed";
+    return ret;
+  }
+  if (batch_scheduler->request_latency().Count() % kLatencyLogInterval == 0) {
+    MSI_LOG(INFO) << "request latency: " << batch_scheduler->request_latency().ToString()
+                  << "; queue latency: " << batch_scheduler->queue_latency().ToString() << "; "
+                  << batch_scheduler->request_count() << " requests in " << batch_scheduler->batch_count()
+                  << " executions";
+  }
+  MSI_LOG(INFO) << "run Predict finished";
+  return SUCCESS;
+}
+
+void Session::CreateBatchScheduler() {
+  auto option_args = Options::Instance().GetArgs();
+  if (option_args == nullptr || option_args->max_batch_size <= 1) {
+    return;
+  }
+  BatchOptions options;
+  options.max_batch_size = static_cast<uint32_t>(option_args->max_batch_size);
+  options.max_queue_delay_us = static_cast<uint32_t>(option_args->max_queue_delay_us);
+  auto execute_func = [this](const inference::RequestBase &request, inference::ReplyBase &reply) -> Status {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (session_ == nullptr || !model_loaded_) {
+      MSI_LOG(ERROR) << "the model has not loaded";
+      return FAILED;
+    }
+    return session_->ExecuteModel(graph_id_, request, reply);
+  };
+  batch_scheduler_ = std::make_shared<BatchScheduler>(execute_func, options);
+  MSI_LOG(INFO) << "request batching enabled, max batch size " << options.max_batch_size << ", max queue delay "
+                << options.max_queue_delay_us << "us";
+}
+
 Status Session::Warmup(const MindSporeModelPtr model) {
   if (session_ == nullptr) {
     MSI_LOG(ERROR) << "The CreatDeviceSession should be called, before warmup";
@@ -121,11 +175,24 @@ Status Session::Warmup(const MindSporeModelPtr model) {
     return ret;
   }
   model_loaded_ = true;
+  if (batch_scheduler_ == nullptr) {
+    CreateBatchScheduler();
+  }
   MSI_LOG(INFO) << "Session Warmup finished";
   return SUCCESS;
 }
 
 Status Session::Clear() {
+  std::shared_ptr<BatchScheduler> batch_scheduler;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_scheduler.swap(batch_scheduler_);
+  }
+  if (batch_scheduler != nullptr) {
+    MSI_LOG(INFO) << "request latency: " << batch_scheduler->request_latency().ToString();
+    // queued requests are executed before the scheduler is destroyed
+    batch_scheduler = nullptr;
+  }
   if (session_ != nullptr) {
     session_->UnloadModel(graph_id_);
     session_->FinalizeEnv();
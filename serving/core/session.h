@@ -23,6 +23,7 @@
 #include "util/status.h"
 #include "version_control/model.h"
 #include "include/inference.h"
+#include "core/batch_scheduler.h"
 #include "serving/ms_service.pb.h"
 #include "serving/ms_service.grpc.pb.h"
 
@@ -53,8 +54,11 @@ class Session {
   uint32_t graph_id_{0};
   std::mutex mutex_;
   std::string device_type_;
+  std::shared_ptr<BatchScheduler> batch_scheduler_{nullptr};
 
   Status PredictInner(const PredictRequest &request, PredictReply &reply);
+  Status PredictBatched(BatchScheduler *batch_scheduler, const PredictRequest &request, PredictReply &reply);
+  void CreateBatchScheduler();
 };
 }  // namespace serving
 }  // namespace mindspore
@@ -0,0 +1,99 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test index performance of mindrecord, binary index file versus sqlite database"""
+import argparse
+import os
+import time
+
+import mindspore.dataset as ds
+from mindspore.mindrecord import FileReader, FileWriter
+
+MINDRECORD_FILE = "perf_index.mindrecord"
+SHARD_NUM = 4
+
+
+def shard_files():
+    return [MINDRECORD_FILE + str(x) for x in range(SHARD_NUM)]
+
+
+def remove_files():
+    for name in shard_files():
+        for suffix in ("", ".db", ".idx", ".idx.bak"):
+            if os.path.exists(name + suffix):
+                os.remove(name + suffix)
+
+
+def write_dataset(num_rows, num_classes):
+    """write a synthetic dataset with a small blob and two index fields"""
+    start = time.time()
+    writer = FileWriter(MINDRECORD_FILE, SHARD_NUM)
+    schema = {"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
+    writer.add_schema(schema, "perf index schema")
+    writer.add_index(["file_name", "label"])
+    batch_size = 10000
+    for begin in range(0, num_rows, batch_size):
+        rows = [{"file_name": "{:08d}.jpg".format(i), "label": i % num_classes, "data": bytes(16)}
+                for i in range(begin, min(begin + batch_size, num_rows))]
+        writer.write_raw_data(rows)
+    writer.commit()
+    print("Write {} rows, cost time: {}s".format(num_rows, time.time() - start))
+
+
+def use_index_file(enable):
+    """rename the index files so that the reader falls back to sqlite"""
+    for name in shard_files():
+        src, dst = (name + ".idx.bak", name + ".idx") if enable else (name + ".idx", name + ".idx.bak")
+        if os.path.exists(src):
+            os.rename(src, dst)
+
+
+def open_time(tag):
+    start = time.time()
+    reader = FileReader(file_name=shard_files()[0], num_consumer=4, columns=["file_name", "label"])
+    reader.close()
+    print("[{}] Open FileReader with index columns, cost time: {}s".format(tag, time.time() - start))
+
+
+def lookup_time(tag, num_classes):
+    """PKSampler counts the classes and looks up the rows of each class page by page"""
+    start = time.time()
+    sampler = ds.PKSampler(10, class_column="label")
+    data_set = ds.MindDataset(dataset_file=shard_files()[0], columns_list=["label"], sampler=sampler)
+    num_iter = 0
+    for _ in data_set.create_dict_iterator():
+        num_iter += 1
+    assert num_iter == 10 * num_classes
+    print("[{}] Read {} rows by PKSampler, cost time: {}s".format(tag, num_iter, time.time() - start))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="mindrecord index benchmark")
+    parser.add_argument("--num_rows", type=int, default=1000000)
+    parser.add_argument("--num_classes", type=int, default=10)
+    args = parser.parse_args()
+
+    remove_files()
+    write_dataset(args.num_rows, args.num_classes)
+    try:
+        for enable, tag in ((True, "index file"), (False, "sqlite")):
+            use_index_file(enable)
+            open_time(tag)
+            lookup_time(tag, args.num_classes)
+    finally:
+        remove_files()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,102 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test read throughput of mindrecord with cold and warm page cache"""
+import argparse
+import os
+import time
+
+import numpy as np
+import mindspore.dataset as ds
+from mindspore.mindrecord import FileWriter
+
+MINDRECORD_FILE = "perf_prefetch.mindrecord"
+SHARD_NUM = 4
+
+
+def shard_files():
+    return [MINDRECORD_FILE + str(x) for x in range(SHARD_NUM)]
+
+
+def remove_files():
+    for name in shard_files():
+        for suffix in ("", ".db", ".idx"):
+            if os.path.exists(name + suffix):
+                os.remove(name + suffix)
+
+
+def write_dataset(num_rows, blob_size):
+    """write a synthetic dataset with a random blob per row"""
+    start = time.time()
+    writer = FileWriter(MINDRECORD_FILE, SHARD_NUM)
+    schema = {"label": {"type": "int32"}, "data": {"type": "bytes"}}
+    writer.add_schema(schema, "perf prefetch schema")
+    writer.add_index(["label"])
+    batch_size = 1000
+    for begin in range(0, num_rows, batch_size):
+        rows = [{"label": i, "data": np.random.bytes(blob_size)}
+                for i in range(begin, min(begin + batch_size, num_rows))]
+        writer.write_raw_data(rows)
+    writer.commit()
+    print("Write {} rows, cost time: {}s".format(num_rows, time.time() - start))
+
+
+def drop_page_cache():
+    """evict the shard files from the page cache so that the next read hits the disk"""
+    for name in shard_files():
+        fd = os.open(name, os.O_RDONLY)
+        try:
+            os.fsync(fd)
+            os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_DONTNEED)
+        finally:
+            os.close(fd)
+
+
+def read_time(tag, num_rows, num_workers, shuffle):
+    """iterate the whole dataset once and report rows/s and MB/s"""
+    start = time.time()
+    data_set = ds.MindDataset(dataset_file=shard_files()[0], columns_list=["data", "label"],
+                              num_parallel_workers=num_workers, shuffle=shuffle)
+    num_iter = 0
+    num_bytes = 0
+    for item in data_set.create_dict_iterator():
+        num_iter += 1
+        num_bytes += item["data"].nbytes
+    cost = time.time() - start
+    assert num_iter == num_rows
+    print("[{}] Read {} rows, cost time: {:.3f}s, {:.1f} rows/s, {:.1f} MB/s".format(
+        tag, num_iter, cost, num_iter / cost, num_bytes / cost / 1024 / 1024))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="mindrecord prefetch benchmark")
+    parser.add_argument("--num_rows", type=int, default=100000)
+    parser.add_argument("--blob_size", type=int, default=100 * 1024)
+    parser.add_argument("--num_workers", type=int, default=4)
+    args = parser.parse_args()
+
+    remove_files()
+    write_dataset(args.num_rows, args.blob_size)
+    try:
+        for shuffle in (False, True):
+            order = "shuffle" if shuffle else "sequential"
+            drop_page_cache()
+            read_time("cold cache, " + order, args.num_rows, args.num_workers, shuffle)
+            read_time("warm cache, " + order, args.num_rows, args.num_workers, shuffle)
+    finally:
+        remove_files()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <random>
+#include <vector>
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/cache_pool.h"
+#include "minddata/dataset/util/lz_compressor.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/services.h"
+#include "common/common.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCachePool : public UT::Common {
+ public:
+  MindDataTestCachePool() {}
+};
+
+namespace {
+// Every third row is random bytes which does not compress, the others are runs of bytes like a smooth image.
+std::vector<uint8_t> MakeRow(int i, size_t sz, std::mt19937 *gen) {
+  std::vector<uint8_t> row(sz);
+  for (size_t j = 0; j < sz; ++j) {
+    row[j] = (i % 3 == 0) ? static_cast<uint8_t>((*gen)()) : static_cast<uint8_t>(j / 64 + i);
+  }
+  return row;
+}
+}  // namespace
+
+TEST_F(MindDataTestCachePool, TestCompressRoundTrip) {
+  std::mt19937 gen(1234);
+  for (int i = 0; i < 30; ++i) {
+    size_t sz = (i < 3) ? i : gen() % 100000;
+    auto src = MakeRow(i, sz, &gen);
+    std::vector<uint8_t> packed(LZCompressor::MaxCompressedSize(sz));
+    size_t csz = LZCompressor::Compress(src.data(), sz, packed.data());
+    ASSERT_LE(csz, sz + 1);
+    if (i % 3 != 0 && sz > 1000) {
+      ASSERT_LT(csz, sz / 4);
+    }
+    std::vector<uint8_t> out(sz);
+    Status rc = LZCompressor::Decompress(packed.data(), csz, out.data(), sz);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(src, out);
+  }
+}
+
+TEST_F(MindDataTestCachePool, TestCompressCorrupted) {
+  std::mt19937 gen(4321);
+  auto src = MakeRow(1, 10000, &gen);
+  std::vector<uint8_t> packed(LZCompressor::MaxCompressedSize(src.size()));
+  size_t csz = LZCompressor::Compress(src.data(), src.size(), packed.data());
+  std::vector<uint8_t> out(src.size());
+  // Wrong uncompressed size
+  ASSERT_TRUE(LZCompressor::Decompress(packed.data(), csz, out.data(), src.size() - 1).IsError());
+  // Truncated input
+  ASSERT_TRUE(LZCompressor::Decompress(packed.data(), csz / 2, out.data(), src.size()).IsError());
+}
+
+TEST_F(MindDataTestCachePool, TestTiers) {
+  Services::CreateInstance();
+  std::shared_ptr<Arena> mp;
+  // 4MB of memory for 2000 rows of 16KB, about 32MB
+  Status rc = Arena::CreateArena(&mp, 4);
+  ASSERT_TRUE(rc.IsOk());
+  Path spill("/tmp/cache_pool_test");
+  rc = spill.CreateDirectories();
+  ASSERT_TRUE(rc.IsOk());
+  auto cp = std::make_shared<CachePool>(CachePool::value_allocator(mp), spill.toString());
+  rc = cp->ServiceStart();
+  ASSERT_TRUE(rc.IsOk());
+  const int num_rows = 2000;
+  const size_t row_sz = 16384;
+  std::mt19937 gen(5678);
+  std::vector<std::vector<uint8_t>> rows;
+  std::vector<CachePool::key_type> keys(num_rows);
+  for (int i = 0; i < num_rows; ++i) {
+    rows.push_back(MakeRow(i, row_sz, &gen));
+    rc = cp->Insert({ReadableSlice(rows[i].data(), row_sz)}, &keys[i]);
+    ASSERT_TRUE(rc.IsOk());
+  }
+  for (int i = 0; i < num_rows; ++i) {
+    std::vector<uint8_t> out(row_sz);
+    WritableSlice dest(out.data(), row_sz);
+    size_t bytes_read = 0;
+    rc = cp->Read(keys[i], &dest, &bytes_read);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(bytes_read, row_sz);
+    ASSERT_EQ(out, rows[i]);
+  }
+  auto stat = cp->GetStat();
+  MS_LOG(INFO) << "Rows in memory " << stat.num_mem_cached << ", compressed " << stat.num_compressed_cached
+               << ", on disk " << stat.num_disk_cached;
+  ASSERT_EQ(stat.num_mem_cached + stat.num_compressed_cached + stat.num_disk_cached, num_rows);
+  ASSERT_GT(stat.num_compressed_cached, 0);
+  ASSERT_GT(stat.num_disk_cached, 0);
+  ASSERT_EQ(stat.num_mem_hit + stat.num_compressed_hit + stat.num_disk_hit, num_rows);
+  ASSERT_EQ(stat.average_cache_sz, row_sz);
+  rc = cp->ServiceStop();
+  ASSERT_TRUE(rc.IsOk());
+}
@@ -19,6 +19,7 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
@@ -138,6 +139,43 @@ TEST_F(MindDataTestExecutionTree, TestExecutionTree2) {
   }
 }
 
+// Tune a prepared tree whose source op has not produced anything yet
+TEST_F(MindDataTestExecutionTree, TestAutoTune) {
+  MS_LOG(INFO) << "Doing MindDataTestExecutionTree-TestAutoTune.";
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder()
+      .SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(2)
+      .SetNumWorkers(2)
+      .Build(&my_tfreader_op);
+  my_tree->AssociateNode(my_tfreader_op);
+  my_tree->AssignRoot(my_tfreader_op);
+  ASSERT_TRUE(my_tree->Prepare(1).IsOk());
+
+  // A source op with an empty output connector is the bottleneck, it gets a worker within the budget of 3
+  AutoTune auto_tune(my_tree.get(), 3, 0);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(auto_tune.Sample().IsOk());
+  }
+  ASSERT_TRUE(auto_tune.Tune().IsOk());
+  EXPECT_EQ(auto_tune.bottleneck_op_id(), my_tfreader_op->id());
+  json config = auto_tune.GetConfig();
+  ASSERT_EQ(config.size(), 1);
+  EXPECT_EQ(config[0]["num_workers"], 3);
+  EXPECT_EQ(config[0]["op_connector_size"], my_tfreader_op->ConnectorCapacity() / my_tfreader_op->num_producers());
+
+  // The budget is used up, the recommendation stays
+  for (int step = 0; step < 10; step++) {
+    ASSERT_TRUE(auto_tune.Sample().IsOk());
+    ASSERT_TRUE(auto_tune.Tune().IsOk());
+  }
+  EXPECT_EQ(auto_tune.GetConfig()[0]["num_workers"], 3);
+}
+
 // Construct some tree nodes and play with them
 TEST_F(MindDataTestExecutionTree, TestExecutionTree3) {
   MS_LOG(INFO) << "Doing MindDataTestExecutionTree3.";
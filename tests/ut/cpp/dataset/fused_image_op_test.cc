@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/cv_tensor.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestFusedImageOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedImageOp() : CVOpCommon() {}
+};
+
+// The fused kernel rounds like a uint8 resize, OpenCV's fixed point resize may differ by one level
+constexpr float kMaxLevelDiff = 1.0;
+
+TEST_F(MindDataTestFusedImageOp, TestMatchesUnfusedChain) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestMatchesUnfusedChain.";
+  constexpr int target_height = 224;
+  constexpr int target_width = 192;
+  float mean_value[3] = {121.0, 115.0, 100.0};
+  float std_value[3] = {70.0, 68.0, 71.0};
+  std::shared_ptr<Tensor> mean_tensor;
+  std::shared_ptr<Tensor> std_tensor;
+  ASSERT_TRUE(Tensor::CreateFromVector<float>({mean_value[0], mean_value[1], mean_value[2]}, &mean_tensor).IsOk());
+  ASSERT_TRUE(Tensor::CreateFromVector<float>({std_value[0], std_value[1], std_value[2]}, &std_tensor).IsOk());
+
+  GlobalContext::config_manager()->set_seed(42);
+  RandomCropAndResizeOp crop(target_height, target_width);
+  RandomCropAndResizeOp unfused = crop;
+  FusedImageOp fused(crop, false);
+  fused.SetHorizontalFlip(1.0);
+  ASSERT_TRUE(fused.SetNormalize(mean_tensor, std_tensor).IsOk());
+  fused.SetHwcToChw();
+  EXPECT_TRUE(fused.OneToOne());
+
+  for (int k = 0; k < 5; k++) {
+    std::shared_ptr<Tensor> fused_output;
+    std::shared_ptr<Tensor> expected;
+    ASSERT_TRUE(fused.Compute(input_tensor_, &fused_output).IsOk());
+    ASSERT_TRUE(unfused.Compute(input_tensor_, &expected).IsOk());
+    ASSERT_TRUE(HorizontalFlip(expected, &expected).IsOk());
+    ASSERT_TRUE(Normalize(expected, &expected, mean_tensor, std_tensor).IsOk());
+    ASSERT_TRUE(HwcToChw(expected, &expected).IsOk());
+
+    ASSERT_EQ(fused_output->shape(), expected->shape());
+    ASSERT_EQ(fused_output->type(), DataType(DataType::DE_FLOAT32));
+    auto fused_it = fused_output->begin<float>();
+    auto expected_it = expected->begin<float>();
+    const int64_t plane = target_height * target_width;
+    for (int64_t i = 0; i < fused_output->Size(); i++, ++fused_it, ++expected_it) {
+      float level_diff = std::fabs(*fused_it - *expected_it) * std_value[i / plane];
+      ASSERT_LE(level_diff, kMaxLevelDiff + 1e-3) << "mismatch at " << i;
+    }
+  }
+}
+
+TEST_F(MindDataTestFusedImageOp, TestCropOnlyKeepsUint8) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestCropOnlyKeepsUint8.";
+  constexpr int target_height = 100;
+  constexpr int target_width = 300;
+  GlobalContext::config_manager()->set_seed(7);
+  RandomCropAndResizeOp crop(target_height, target_width);
+  RandomCropAndResizeOp unfused = crop;
+  FusedImageOp fused(crop, false);
+  fused.SetHorizontalFlip(0.0);
+
+  std::shared_ptr<Tensor> fused_output;
+  std::shared_ptr<Tensor> expected;
+  ASSERT_TRUE(fused.Compute(input_tensor_, &fused_output).IsOk());
+  ASSERT_TRUE(unfused.Compute(input_tensor_, &expected).IsOk());
+  ASSERT_EQ(fused_output->shape(), expected->shape());
+  ASSERT_EQ(fused_output->type(), DataType(DataType::DE_UINT8));
+  auto fused_it = fused_output->begin<uint8_t>();
+  auto expected_it = expected->begin<uint8_t>();
+  for (int64_t i = 0; i < fused_output->Size(); i++, ++fused_it, ++expected_it) {
+    ASSERT_LE(std::abs(static_cast<int>(*fused_it) - static_cast<int>(*expected_it)), kMaxLevelDiff);
+  }
+}
+
+TEST_F(MindDataTestFusedImageOp, TestDecode) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestDecode.";
+  constexpr int target_height = 64;
+  constexpr int target_width = 48;
+  RandomCropAndResizeOp crop(target_height, target_width);
+  FusedImageOp fused(crop, true);
+  fused.SetHwcToChw();
+
+  std::shared_ptr<Tensor> output;
+  ASSERT_TRUE(fused.Compute(raw_input_tensor_, &output).IsOk());
+  EXPECT_EQ(output->shape(), TensorShape({3, target_height, target_width}));
+  EXPECT_EQ(output->type(), DataType(DataType::DE_UINT8));
+
+  std::vector<TensorShape> shapes;
+  ASSERT_TRUE(fused.OutputShape({raw_input_tensor_->shape()}, shapes).IsOk());
+  EXPECT_EQ(shapes[0], output->shape());
+}
@@ -266,3 +266,62 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestSampleWithWorkers) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 4);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  // Enough nodes to be split among the workers
+  std::vector<NodeIdType> node_list;
+  for (int i = 0; i < 10; ++i) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+  std::shared_ptr<Tensor> all_neighbors;
+  s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], &all_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<std::unordered_set<NodeIdType>> neighbor_sets(node_list.size());
+  dsize_t width = all_neighbors->shape()[1];
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    for (dsize_t j = 1; j < width; ++j) {
+      NodeIdType id;
+      EXPECT_TRUE(all_neighbors->GetItemAt(&id, {static_cast<dsize_t>(i), j}).IsOk());
+      neighbor_sets[i].insert(id);
+    }
+  }
+
+  std::shared_ptr<Tensor> neighbors;
+  s = graph.GetSampledNeighbors(node_list, {3}, {meta_info.node_type[1]}, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(neighbors->shape()[0], static_cast<dsize_t>(node_list.size()));
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    NodeIdType id;
+    EXPECT_TRUE(neighbors->GetItemAt(&id, {static_cast<dsize_t>(i), 0}).IsOk());
+    EXPECT_EQ(id, node_list[i]);
+    for (dsize_t j = 1; j < 4; ++j) {
+      EXPECT_TRUE(neighbors->GetItemAt(&id, {static_cast<dsize_t>(i), j}).IsOk());
+      EXPECT_TRUE(neighbor_sets[i].count(id) > 0);
+    }
+  }
+
+  std::shared_ptr<Tensor> neg_neighbors;
+  s = graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &neg_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    for (dsize_t j = 1; j < 4; ++j) {
+      NodeIdType id;
+      EXPECT_TRUE(neg_neighbors->GetItemAt(&id, {static_cast<dsize_t>(i), j}).IsOk());
+      EXPECT_TRUE(id == kDefaultNodeId || neighbor_sets[i].count(id) == 0);
+    }
+  }
+}
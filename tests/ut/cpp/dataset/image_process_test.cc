@@ -21,6 +21,8 @@
 #include <opencv2/imgproc/types_c.h>
 #include "utils/log_adapter.h"
 
+#include <chrono>
+#include <cstring>
 #include <fstream>
 
 using namespace mindspore::dataset;
@@ -334,3 +336,109 @@ TEST_F(MindDataImageProcess, TestAffine) {
     }
   }
 }
+
+bool SameMat(const LiteMat &a, const LiteMat &b) {
+  if (a.width_ != b.width_ || a.height_ != b.height_ || a.channel_ != b.channel_ || a.data_type_ != b.data_type_) {
+    return false;
+  }
+  size_t size = static_cast<size_t>(a.width_) * a.height_ * a.channel_ * a.data_type_.SizeInBytes();
+  return memcmp(a.data_ptr_, b.data_ptr_, size) == 0;
+}
+
+// The per element loops of ConvertTo and SubStractMeanNormalize, without vector instructions
+void ScalarConvertNormalize(const LiteMat &src, LiteMat &dst, const std::vector<float> &mean,
+                            const std::vector<float> &std, double scale) {
+  dst.Init(src.width_, src.height_, src.channel_, LDataType::FLOAT32);
+  const unsigned char *src_p = src;
+  float *dst_p = dst;
+  for (int i = 0; i < src.width_ * src.height_ * src.channel_; i++) {
+    dst_p[i] = (static_cast<float>(src_p[i] * scale) - mean[i % src.channel_]) / std[i % src.channel_];
+  }
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+TEST_F(MindDataImageProcess, TestResizeBilinearNormalize) {
+  std::string filename = "data/dataset/apple.jpg";
+  cv::Mat image = cv::imread(filename, cv::ImreadModes::IMREAD_COLOR);
+  cv::Mat rgba_mat;
+  cv::cvtColor(image, rgba_mat, CV_BGR2RGBA);
+  LiteMat lite_mat_bgr;
+  ASSERT_TRUE(
+    InitFromPixel(rgba_mat.data, LPixelType::RGBA2BGR, LDataType::UINT8, rgba_mat.cols, rgba_mat.rows, lite_mat_bgr));
+
+  const double scale = 1.0 / 255;
+  std::vector<float> means = {0.485, 0.456, 0.406};
+  std::vector<float> stds = {0.229, 0.224, 0.225};
+  const int loops = 20;
+
+  LiteMat lite_mat_resize;
+  LiteMat lite_mat_float;
+  LiteMat lite_mat_norm;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    ASSERT_TRUE(ResizeBilinear(lite_mat_bgr, lite_mat_resize, 256, 256));
+    ASSERT_TRUE(ConvertTo(lite_mat_resize, lite_mat_float, scale));
+    ASSERT_TRUE(SubStractMeanNormalize(lite_mat_float, lite_mat_norm, means, stds));
+  }
+  double separate_ms = ElapsedMs(begin) / loops;
+
+  LiteMat lite_mat_scalar;
+  begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    ASSERT_TRUE(ResizeBilinear(lite_mat_bgr, lite_mat_resize, 256, 256));
+    ScalarConvertNormalize(lite_mat_resize, lite_mat_scalar, means, stds, scale);
+  }
+  double scalar_ms = ElapsedMs(begin) / loops;
+
+  LiteMat lite_mat_fused;
+  begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    ASSERT_TRUE(ResizeBilinearNormalize(lite_mat_bgr, lite_mat_fused, 256, 256, means, stds, scale));
+  }
+  double fused_ms = ElapsedMs(begin) / loops;
+
+  cv::Mat cv_mat;
+  begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    cv::Mat resize_256_image;
+    cv::resize(image, resize_256_image, cv::Size(256, 256), CV_INTER_LINEAR);
+    resize_256_image.convertTo(cv_mat, CV_32FC3, scale);
+    cv::subtract(cv_mat, cv::Scalar(means[0], means[1], means[2]), cv_mat);
+    cv::divide(cv_mat, cv::Scalar(stds[0], stds[1], stds[2]), cv_mat);
+  }
+  double cv_ms = ElapsedMs(begin) / loops;
+  MS_LOG(INFO) << "Resize and normalize, separate: " << separate_ms << "ms, scalar normalize: " << scalar_ms
+               << "ms, fused: " << fused_ms << "ms, opencv: " << cv_ms << "ms";
+
+  ASSERT_TRUE(SameMat(lite_mat_norm, lite_mat_scalar));
+  ASSERT_TRUE(SameMat(lite_mat_norm, lite_mat_fused));
+  CompareMat(cv_mat, lite_mat_fused);
+}
+
+TEST_F(MindDataImageProcess, TestCropResizeBilinear) {
+  std::string filename = "data/dataset/apple.jpg";
+  cv::Mat image = cv::imread(filename, cv::ImreadModes::IMREAD_COLOR);
+  cv::Mat rgba_mat;
+  cv::cvtColor(image, rgba_mat, CV_BGR2RGBA);
+  for (auto pixel_type : {LPixelType::RGBA2BGR, LPixelType::RGBA2GRAY}) {
+    LiteMat lite_mat;
+    ASSERT_TRUE(InitFromPixel(rgba_mat.data, pixel_type, LDataType::UINT8, rgba_mat.cols, rgba_mat.rows, lite_mat));
+    int x = lite_mat.width_ / 5;
+    int y = lite_mat.height_ / 7;
+    int w = lite_mat.width_ / 2;
+    int h = lite_mat.height_ / 3;
+
+    LiteMat lite_mat_crop;
+    LiteMat lite_mat_expect;
+    ASSERT_TRUE(Crop(lite_mat, lite_mat_crop, x, y, w, h));
+    ASSERT_TRUE(ResizeBilinear(lite_mat_crop, lite_mat_expect, 224, 224));
+
+    LiteMat lite_mat_fused;
+    ASSERT_TRUE(CropResizeBilinear(lite_mat, lite_mat_fused, x, y, w, h, 224, 224));
+    ASSERT_TRUE(SameMat(lite_mat_expect, lite_mat_fused));
+    ASSERT_FALSE(CropResizeBilinear(lite_mat, lite_mat_fused, x, y, lite_mat.width_, h, 224, 224));
+  }
+}
@@ -443,6 +443,65 @@ TEST_F(MindDataTestMapOp, TestTFReaderRepeatMap) {
   ASSERT_EQ(row_count, 10 * num_repeats);
 }
 
+// TestActiveWorkers scenario:
+//    With the autotuner enabled, a MapOp built with 1 worker launches spare workers and runs with 1 active worker.
+//    The number of active workers is changed while the tree is running, all the rows still come out.
+TEST_F(MindDataTestMapOp, TestActiveWorkers) {
+  Status rc;
+  MS_LOG(INFO) << "Doing TestActiveWorkers.";
+  bool original_enable_autotune = GlobalContext::config_manager()->enable_autotune();
+  GlobalContext::config_manager()->set_enable_autotune(true);
+
+  auto my_tfreader_op = this->CreateTFReaderOp();
+  rc = my_tree_->AssociateNode(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto my_no_op = std::make_shared<mindspore::dataset::test::NoOp>();
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(my_no_op);
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"}).SetOutColNames({}).SetTensorFuncs(std::move(my_func_list)).SetNumWorkers(1);
+  rc = builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  GlobalContext::config_manager()->set_enable_autotune(original_enable_autotune);
+  EXPECT_EQ(my_map_op->num_workers(), 1);
+  EXPECT_GE(my_map_op->max_num_workers(), 1);
+  EXPECT_FALSE(my_map_op->SetNumActiveWorkers(0).IsOk());
+  EXPECT_FALSE(my_map_op->SetNumActiveWorkers(my_map_op->max_num_workers() + 1).IsOk());
+
+  rc = my_tree_->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_map_op->AddChild(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssignRoot(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  uint32_t row_count = 0;
+  while (!tensor_list.empty()) {
+    row_count++;
+    // Grow the running op to all its workers, then shrink it back to one
+    if (row_count == 3) {
+      rc = my_map_op->SetNumActiveWorkers(my_map_op->max_num_workers());
+      EXPECT_TRUE(rc.IsOk());
+      EXPECT_EQ(my_map_op->num_workers(), my_map_op->max_num_workers());
+    } else if (row_count == 6) {
+      rc = my_map_op->SetNumActiveWorkers(1);
+      EXPECT_TRUE(rc.IsOk());
+    }
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  ASSERT_EQ(row_count, 10);
+}
+
 TEST_F(MindDataTestMapOp, TestTFReaderMapRepeat) {
   Status rc;
   MS_LOG(INFO) << "Doing TestTFReaderMapRepeat.";
@@ -17,6 +17,7 @@
 #include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/circular_pool.h"
 #include "minddata/dataset/util/system_pool.h"
+#include "minddata/dataset/util/recycle_pool.h"
 #include "minddata/dataset/util/allocator.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -74,3 +75,41 @@ TEST_F(MindDataTestMemoryPool, TestAllocator) {
   ASSERT_EQ(v, 3);
   MS_LOG(DEBUG) << *(std::dynamic_pointer_cast<CircularPool>(mp_)) << std::endl;
 }
+
+TEST_F(MindDataTestMemoryPool, TestRecyclePool) {
+  auto pool = std::make_shared<RecyclePool>(2);
+  void *p1 = nullptr;
+  void *p2 = nullptr;
+  void *p3 = nullptr;
+  ASSERT_TRUE(pool->Allocate(4096, &p1).IsOk());
+  ASSERT_TRUE(pool->Allocate(4096, &p2).IsOk());
+  ASSERT_TRUE(pool->Allocate(4096, &p3).IsOk());
+  ASSERT_EQ(pool->miss_count(), 3);
+  pool->Deallocate(p1);
+  pool->Deallocate(p2);
+  // Only two free blocks are cached, the third one goes back to the system
+  pool->Deallocate(p3);
+  ASSERT_EQ(pool->PercentFree(), 100);
+
+  // Same size is served from the cache, a different size is not
+  void *q1 = nullptr;
+  void *q2 = nullptr;
+  ASSERT_TRUE(pool->Allocate(4096, &q1).IsOk());
+  ASSERT_TRUE(q1 == p1 || q1 == p2);
+  ASSERT_EQ(pool->hit_count(), 1);
+  ASSERT_TRUE(pool->Allocate(1024, &q2).IsOk());
+  ASSERT_EQ(pool->miss_count(), 4);
+
+  // Growing keeps the content
+  auto *data = reinterpret_cast<int *>(q2);
+  for (int i = 0; i < 256; i++) {
+    data[i] = i;
+  }
+  ASSERT_TRUE(pool->Reallocate(&q2, 1024, 8192).IsOk());
+  data = reinterpret_cast<int *>(q2);
+  for (int i = 0; i < 256; i++) {
+    ASSERT_EQ(data[i], i);
+  }
+  pool->Deallocate(q1);
+  pool->Deallocate(q2);
+}
@@ -177,3 +177,30 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<int> que(2);
+  ASSERT_TRUE(que.Add(1).IsOk());
+  ASSERT_TRUE(que.Add(2).IsOk());
+  // Grow a full queue, the queued elements keep their order
+  ASSERT_TRUE(que.Resize(4).IsOk());
+  ASSERT_EQ(que.capacity(), 4);
+  ASSERT_TRUE(que.Add(3).IsOk());
+  ASSERT_TRUE(que.Add(4).IsOk());
+  ASSERT_EQ(que.size(), 4);
+  // Shrink below the number of queued elements, nothing is dropped
+  ASSERT_TRUE(que.Resize(1).IsOk());
+  ASSERT_EQ(que.capacity(), 1);
+  ASSERT_EQ(que.size(), 4);
+  for (int i = 1; i <= 4; i++) {
+    int v = 0;
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_TRUE(que.Add(5).IsOk());
+  ASSERT_EQ(que.size(), que.capacity());
+  int v = 0;
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_EQ(v, 5);
+  ASSERT_FALSE(que.Resize(0).IsOk());
+}
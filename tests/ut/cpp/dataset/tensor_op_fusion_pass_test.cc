@@ -17,10 +17,15 @@
 #include <memory>
 #include <string>
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 
@@ -102,4 +107,75 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_enabled) {
   auto func_it = tfuncs.begin();
   EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
   EXPECT_EQ(++func_it, tfuncs.end());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, FusedImageOp_fusion_disabled) {
+  MS_LOG(INFO) << "Doing FusedImageOp_fusion";
+  std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                             bool shuf = false, std::shared_ptr<Sampler> sampler = nullptr,
+                                             std::map<std::string, int32_t> map = {}, bool decode = false);
+  std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+  Status rc;
+  std::vector<std::shared_ptr<TensorOp>> func_list;
+  func_list.push_back(std::make_shared<DecodeOp>());
+  func_list.push_back(std::make_shared<RandomCropAndResizeOp>(224, 224));
+  func_list.push_back(std::make_shared<RandomHorizontalFlipOp>());
+  func_list.push_back(std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0));
+  func_list.push_back(std::make_shared<HwcToChwOp>());
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder map_decode_builder;
+  map_decode_builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  rc = map_decode_builder.Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = std::make_shared<ExecutionTree>();
+  tree = Build({ImageFolder(16, 2, 32, "./", false), map_op});
+  rc = tree->SetOptimize(true);
+  EXPECT_TRUE(rc);
+  rc = tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  auto it = tree->begin();
+  ++it;
+  auto *m_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(m_op)->TFuncs();
+  auto func_it = tfuncs.begin();
+  EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
+  EXPECT_EQ((*++func_it)->Name(), kRandomHorizontalFlipOp);
+  EXPECT_EQ((*++func_it)->Name(), kNormalizeOp);
+  EXPECT_EQ((*++func_it)->Name(), kHwcToChwOp);
+  EXPECT_EQ(++func_it, tfuncs.end());
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, FusedImageOp_fusion_enabled) {
+  MS_LOG(INFO) << "Doing FusedImageOp_fusion";
+  std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                             bool shuf = false, std::shared_ptr<Sampler> sampler = nullptr,
+                                             std::map<std::string, int32_t> map = {}, bool decode = false);
+  std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+  Status rc;
+  std::vector<std::shared_ptr<TensorOp>> func_list;
+  func_list.push_back(std::make_shared<DecodeOp>());
+  func_list.push_back(std::make_shared<RandomCropAndResizeOp>(224, 224));
+  func_list.push_back(std::make_shared<RandomHorizontalFlipOp>());
+  func_list.push_back(std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0));
+  func_list.push_back(std::make_shared<HwcToChwOp>());
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder map_decode_builder;
+  map_decode_builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  rc = map_decode_builder.Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = std::make_shared<ExecutionTree>();
+  tree = Build({ImageFolder(16, 2, 32, "./", false), map_op});
+  rc = tree->SetOptimize(true);
+  EXPECT_TRUE(rc);
+  GlobalContext::config_manager()->set_enable_image_fusion(true);
+  rc = tree->Prepare();
+  GlobalContext::config_manager()->set_enable_image_fusion(false);
+  EXPECT_TRUE(rc.IsOk());
+  auto it = tree->begin();
+  ++it;
+  auto *m_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(m_op)->TFuncs();
+  auto func_it = tfuncs.begin();
+  EXPECT_EQ((*func_it)->Name(), kFusedImageOp);
+  EXPECT_EQ(++func_it, tfuncs.end());
+}
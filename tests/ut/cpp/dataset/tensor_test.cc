@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/util/recycle_pool.h"
 
 using namespace mindspore::dataset;
 
@@ -537,3 +538,46 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+TEST_F(MindDataTestTensorDE, TensorFromPool) {
+  auto pool = std::make_shared<RecyclePool>(4);
+  const unsigned char *first_buffer = nullptr;
+  {
+    TensorPtr t;
+    ASSERT_TRUE(Tensor::CreateEmpty(TensorShape({4, 8}), DataType(DataType::DE_FLOAT32), pool, &t).IsOk());
+    ASSERT_EQ(t->SizeInBytes(), 4 * 8 * sizeof(float));
+    first_buffer = t->GetBuffer();
+    ASSERT_NE(first_buffer, nullptr);
+  }
+  // The buffer went back to the pool when the tensor was destroyed and is reused by the next tensor of that size
+  TensorPtr t;
+  ASSERT_TRUE(Tensor::CreateEmpty(TensorShape({8, 4}), DataType(DataType::DE_INT32), pool, &t).IsOk());
+  ASSERT_EQ(t->GetBuffer(), first_buffer);
+  ASSERT_EQ(pool->hit_count(), 1);
+
+  ASSERT_FALSE(Tensor::CreateEmpty(TensorShape({2}), DataType(DataType::DE_STRING), pool, &t).IsOk());
+}
+
+TEST_F(MindDataTestTensorDE, TensorFromStringTensors) {
+  std::vector<std::string> strings1 = {"abc", "", "defg"};
+  std::vector<std::string> strings2 = {"h", "ij", "klmnop"};
+  TensorPtr t1, t2, empty;
+  Tensor::CreateFromVector(strings1, &t1);
+  Tensor::CreateFromVector(strings2, &t2);
+  Tensor::CreateFromVector(std::vector<std::string>{}, &empty);
+
+  TensorPtr out;
+  ASSERT_TRUE(Tensor::CreateFromStringTensors({t1, empty, t2}, TensorShape({2, 3}), &out).IsOk());
+  std::vector<std::string> all = strings1;
+  all.insert(all.end(), strings2.begin(), strings2.end());
+  TensorPtr expected;
+  Tensor::CreateFromVector(all, TensorShape({2, 3}), &expected);
+  ASSERT_EQ(*out, *expected);
+  ASSERT_EQ(out->SizeInBytes(), expected->SizeInBytes());
+
+  std::string_view item;
+  ASSERT_TRUE(out->GetItemAt(&item, {1, 2}).IsOk());
+  ASSERT_EQ(item, "klmnop");
+
+  ASSERT_FALSE(Tensor::CreateFromStringTensors({t1, t2}, TensorShape({5}), &out).IsOk());
+}
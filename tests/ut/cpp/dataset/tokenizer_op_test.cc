@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <memory>
+#include <random>
+#include <set>
 #include <string>
 #include <string_view>
 
@@ -26,6 +29,7 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +362,80 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+namespace {
+// Wordpiece by trying every end of the subword from the longest, with a substring and a vocab lookup for each
+std::vector<std::string> WordpieceByLookup(const Vocab &vocab, const std::string &token) {
+  RuneStrArray runes;
+  EXPECT_TRUE(DecodeRunesInString(token.data(), token.size(), runes));
+  std::vector<std::string> out;
+  size_t start = 0;
+  while (start < token.size()) {
+    std::string found;
+    for (int i = runes.size() - 1; i >= 0 && runes[i].offset + runes[i].len > start; i--) {
+      std::string word = (start > 0 ? "##" : "") + token.substr(start, runes[i].offset + runes[i].len - start);
+      if (vocab.Lookup(word) != Vocab::kNoTokenExists) {
+        found = word;
+        start = runes[i].offset + runes[i].len;
+        break;
+      }
+    }
+    if (found.empty()) {
+      return {"[UNK]"};
+    }
+    out.push_back(found);
+  }
+  return out;
+}
+}  // namespace
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  const std::vector<std::string> letters = {"a", "b", "c", "d", "e", "f", "中", "国"};
+  std::mt19937 gen(1234);
+  auto random_word = [&letters, &gen](int max_len) {
+    std::string word;
+    for (int i = std::uniform_int_distribution<int>(1, max_len)(gen); i > 0; i--) {
+      word += letters[gen() % letters.size()];
+    }
+    return word;
+  };
+  std::set<std::string> words;
+  for (int i = 0; i < 3000; i++) {
+    words.insert((i % 2 ? "##" : "") + random_word(6));
+  }
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector({words.begin(), words.end()}, {"[UNK]"}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<std::string> tokens;
+  for (int i = 0; i < 20000; i++) {
+    tokens.push_back(random_word(16));
+  }
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(tokens, &input);
+
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab));
+  TensorRow output;
+  auto begin = std::chrono::steady_clock::now();
+  s = op->Compute(TensorRow(0, {input}), &output);
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_TRUE(s.IsOk());
+  double trie_seconds = std::chrono::duration<double>(end - begin).count();
+
+  std::vector<std::string> expect;
+  begin = std::chrono::steady_clock::now();
+  for (const auto &token : tokens) {
+    auto subwords = WordpieceByLookup(*vocab, token);
+    expect.insert(expect.end(), subwords.begin(), subwords.end());
+  }
+  end = std::chrono::steady_clock::now();
+  double lookup_seconds = std::chrono::duration<double>(end - begin).count();
+  MS_LOG(INFO) << "Wordpiece tokens/sec, trie: " << tokens.size() / trie_seconds
+               << ", lookup: " << tokens.size() / lookup_seconds;
+
+  ASSERT_EQ(output[0]->Size(), expect.size());
+  for (size_t i = 0; i < expect.size(); i++) {
+    CheckEqual(output[0], {static_cast<dsize_t>(i)}, expect[i]);
+  }
+}
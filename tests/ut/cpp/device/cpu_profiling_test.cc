@@ -0,0 +1,138 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "nlohmann/json.hpp"
+#include "profiler/device/cpu/cpu_profiling.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+class TestCPUProfiling : public UT::Common {
+ public:
+  TestCPUProfiling() : dir_("./cpu_profiling_test_" + std::to_string(getpid())) {}
+
+  void SetUp() {
+    (void)mkdir(dir_.c_str(), S_IRWXU);
+    device_id_ = std::to_string(MsContext::GetInstance()->get_param<uint32_t>(MS_CTX_DEVICE_ID));
+  }
+
+  // The profiler writes its files straight into dir_, there are no sub directories to remove
+  void TearDown() {
+    DIR *dir = opendir(dir_.c_str());
+    if (dir != nullptr) {
+      for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+          (void)remove((dir_ + "/" + name).c_str());
+        }
+      }
+      (void)closedir(dir);
+    }
+    (void)rmdir(dir_.c_str());
+  }
+
+  std::string FilePath(const std::string &prefix, const std::string &ext) {
+    return dir_ + "/" + prefix + device_id_ + ext;
+  }
+
+  static std::vector<std::string> ReadLines(const std::string &file_path) {
+    std::ifstream ifs(file_path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(ifs, line)) {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+ protected:
+  std::string dir_;
+  std::string device_id_;
+};
+
+TEST_F(TestCPUProfiling, test_op_data_files) {
+  auto profiler = CPUProfiler::GetInstance();
+  profiler->Init(dir_);
+  profiler->StepProfilingEnable(true);
+  for (int i = 0; i < 2; i++) {
+    profiler->OpDataProducerBegin("Default/network/Conv2D-op1", {{1, 3, 8, 8}, {4, 3, 3, 3}}, 1024);
+    profiler->OpDataProducerEnd();
+  }
+  profiler->OpDataProducerBegin("Default/network/ReLU-op2", {{1, 4, 6, 6}}, 256);
+  profiler->OpDataProducerEnd();
+  profiler->Stop();
+
+  // the op detail file has the gpu columns, with the memory of the ops in place of the cuda activities
+  auto op_detail = ReadLines(FilePath("cpu_op_detail_info_", ".csv"));
+  ASSERT_EQ(op_detail.size(), 3);
+  ASSERT_EQ(op_detail[0],
+            "op_side,op_type,op_name,op_full_name,op_occurrences,op_total_time(us),op_avg_time(us),total_proportion,"
+            "op_total_memory(bytes),op_avg_memory(bytes)");
+  size_t conv_row = op_detail[1].find("Conv2D-op1") != std::string::npos ? 1 : 2;
+  ASSERT_EQ(op_detail[conv_row].find("Device,Conv2D,Conv2D-op1,Default/network/Conv2D-op1,2,"), 0);
+  std::string conv_memory = ",2048,1024";
+  ASSERT_EQ(op_detail[conv_row].substr(op_detail[conv_row].size() - conv_memory.size()), conv_memory);
+  ASSERT_EQ(op_detail[3 - conv_row].find("Device,ReLU,ReLU-op2,Default/network/ReLU-op2,1,"), 0);
+
+  auto op_type = ReadLines(FilePath("cpu_op_type_info_", ".csv"));
+  ASSERT_EQ(op_type.size(), 3);
+  ASSERT_EQ(op_type[0], "op_type,type_occurrences,total_time(us),total_proportion,avg_time(us)");
+
+  // one line per op with the start and duration of each launch
+  auto op_timestamp = ReadLines(FilePath("cpu_op_execute_timestamp_", ".txt"));
+  ASSERT_EQ(op_timestamp.size(), 2);
+  size_t conv_line = op_timestamp[0].find("Conv2D-op1") != std::string::npos ? 0 : 1;
+  ASSERT_EQ(op_timestamp[conv_line].find("Default/network/Conv2D-op1;Ops;"), 0);
+  ASSERT_EQ(std::count(op_timestamp[conv_line].begin(), op_timestamp[conv_line].end(), ','), 2);
+  ASSERT_EQ(std::count(op_timestamp[1 - conv_line].begin(), op_timestamp[1 - conv_line].end(), ','), 1);
+
+  // the timeline has a chrome trace complete event per launch, in the launch order
+  std::ifstream timeline_ifs(FilePath("cpu_timeline_display_", ".json"));
+  auto timeline = nlohmann::json::parse(timeline_ifs);
+  ASSERT_TRUE(timeline.is_array());
+  ASSERT_EQ(timeline.size(), 3);
+  for (auto &event : timeline) {
+    ASSERT_EQ(event["ph"], "X");
+    ASSERT_EQ(event["pid"], std::stoi(device_id_));
+    ASSERT_EQ(event["tid"], timeline[0]["tid"]);
+    ASSERT_GE(event["dur"].get<double>(), 0);
+  }
+  ASSERT_EQ(timeline[0]["name"], "Default/network/Conv2D-op1");
+  ASSERT_EQ(timeline[0]["args"]["input_shapes"], "[1,3,8,8];[4,3,3,3]");
+  ASSERT_EQ(timeline[0]["args"]["memory(bytes)"], 1024);
+  ASSERT_LE(timeline[0]["ts"].get<double>(), timeline[1]["ts"].get<double>());
+  ASSERT_EQ(timeline[2]["name"], "Default/network/ReLU-op2");
+  ASSERT_EQ(timeline[2]["args"]["input_shapes"], "[1,4,6,6]");
+
+  std::ifstream summary_ifs(FilePath("cpu_timeline_summary_", ".json"));
+  auto summary = nlohmann::json::parse(summary_ifs);
+  ASSERT_EQ(summary["num_of_streams"], 1);
+  ASSERT_EQ(summary["num_of_ops"], 2);
+  ASSERT_EQ(summary["op_exe_times"], 3);
+}
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
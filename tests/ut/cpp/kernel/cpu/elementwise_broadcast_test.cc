@@ -0,0 +1,138 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/elementwise_broadcast.h"
+
+namespace mindspore {
+namespace kernel {
+class ElementwiseBroadcastTest : public UT::Common {
+ public:
+  ElementwiseBroadcastTest() = default;
+
+  // reference output of input0 - input1 computed one element at a time
+  template <typename T>
+  static std::vector<T> ReferenceSub(const std::vector<size_t> &shape0, const std::vector<T> &input0,
+                                     const std::vector<size_t> &shape1, const std::vector<T> &input1,
+                                     const std::vector<size_t> &output_shape) {
+    size_t rank = output_shape.size();
+    size_t output_size = 1;
+    for (auto dim : output_shape) {
+      output_size *= dim;
+    }
+    std::vector<T> output(output_size);
+    for (size_t pos = 0; pos < output_size; ++pos) {
+      size_t remain = pos;
+      size_t offset0 = 0;
+      size_t offset1 = 0;
+      size_t stride0 = 1;
+      size_t stride1 = 1;
+      for (size_t i = rank; i > 0; --i) {
+        size_t index = remain % output_shape[i - 1];
+        remain /= output_shape[i - 1];
+        size_t j0 = i - 1 + shape0.size();
+        if (j0 >= rank) {
+          size_t dim = shape0[j0 - rank];
+          offset0 += (dim == 1 ? 0 : index) * stride0;
+          stride0 *= dim;
+        }
+        size_t j1 = i - 1 + shape1.size();
+        if (j1 >= rank) {
+          size_t dim = shape1[j1 - rank];
+          offset1 += (dim == 1 ? 0 : index) * stride1;
+          stride1 *= dim;
+        }
+      }
+      output[pos] = input0[offset0] - input1[offset1];
+    }
+    return output;
+  }
+
+  template <typename T>
+  static void CheckSub(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                       const std::vector<size_t> &expect_shape) {
+    BroadcastPlan plan;
+    ASSERT_TRUE(plan.Init(shape0, shape1));
+    ASSERT_EQ(plan.output_shape(), expect_shape);
+    std::vector<T> input0(ElementNum(shape0));
+    std::vector<T> input1(ElementNum(shape1));
+    for (size_t i = 0; i < input0.size(); ++i) {
+      input0[i] = static_cast<T>(i * 3 + 1);
+    }
+    for (size_t i = 0; i < input1.size(); ++i) {
+      input1[i] = static_cast<T>(i * 2);
+    }
+    auto expect = ReferenceSub(shape0, input0, shape1, input1, expect_shape);
+    ASSERT_EQ(plan.output_size(), expect.size());
+    // split the output into uneven ranges the way ParallelFor does
+    std::vector<T> output(expect.size());
+    size_t step = expect.size() / 3 + 1;
+    for (size_t start = 0; start < output.size(); start += step) {
+      plan.Run(input0.data(), input1.data(), output.data(), start, std::min(start + step, output.size()), SubFunc());
+    }
+    EXPECT_EQ(output, expect);
+  }
+
+  static size_t ElementNum(const std::vector<size_t> &shape) {
+    size_t num = 1;
+    for (auto dim : shape) {
+      num *= dim;
+    }
+    return num;
+  }
+};
+
+TEST_F(ElementwiseBroadcastTest, SameShape) {
+  CheckSub<float>({2, 3, 5}, {2, 3, 5}, {2, 3, 5});
+  CheckSub<int32_t>({37}, {37}, {37});
+}
+
+TEST_F(ElementwiseBroadcastTest, Scalar) {
+  CheckSub<float>({4, 7}, {}, {4, 7});
+  CheckSub<int64_t>({1}, {3, 9}, {3, 9});
+}
+
+TEST_F(ElementwiseBroadcastTest, BiasBroadcast) {
+  CheckSub<float>({2, 3, 4, 5}, {5}, {2, 3, 4, 5});
+  CheckSub<float>({2, 3, 4, 5}, {3, 1, 1}, {2, 3, 4, 5});
+  CheckSub<int32_t>({6, 1}, {6, 10}, {6, 10});
+}
+
+TEST_F(ElementwiseBroadcastTest, BothBroadcast) {
+  CheckSub<float>({3, 1}, {1, 5}, {3, 5});
+  CheckSub<int64_t>({2, 1, 3, 1}, {4, 1, 6}, {2, 4, 3, 6});
+}
+
+TEST_F(ElementwiseBroadcastTest, Incompatible) {
+  BroadcastPlan plan;
+  EXPECT_FALSE(plan.Init({2, 3}, {4}));
+  EXPECT_FALSE(plan.Init({2, 3}, {3, 3}));
+}
+
+TEST_F(ElementwiseBroadcastTest, Unary) {
+  std::vector<float> input(19);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i) - 9;
+  }
+  std::vector<float> output(input.size());
+  ElementwiseUnary(input.data(), output.data(), input.size(), SquareFunc());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output[i], input[i] * input[i]);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include <atomic>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelForTest : public UT::Common {
+ public:
+  ParallelForTest() = default;
+};
+
+TEST_F(ParallelForTest, CoverEachElementOnce) {
+  std::vector<size_t> counts = {0, 1, 7, 100, 100000};
+  for (auto count : counts) {
+    std::vector<int> visit(count, 0);
+    CPUKernelUtils::ParallelFor(
+      [&visit](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          visit[i]++;
+        }
+      },
+      count, 8);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(visit[i], 1);
+    }
+  }
+}
+
+TEST_F(ParallelForTest, SmallInputRunOnCallingThread) {
+  std::atomic<size_t> task_num{0};
+  CPUKernelUtils::ParallelFor([&task_num](size_t start, size_t end) { task_num++; }, 100, 1000);
+  EXPECT_EQ(task_num, 1);
+}
+
+TEST_F(ParallelForTest, NestedSyncRun) {
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  std::atomic<size_t> sum{0};
+  std::vector<common::Task> tasks;
+  for (size_t i = 0; i < 16; ++i) {
+    tasks.emplace_back([&sum]() {
+      CPUKernelUtils::ParallelFor([&sum](size_t start, size_t end) { sum += end - start; }, 64, 1);
+      return common::SUCCESS;
+    });
+  }
+  EXPECT_TRUE(thread_pool.SyncRun(tasks));
+  EXPECT_EQ(sum, 16 * 64);
+}
+}  // namespace kernel
+}  // namespace mindspore
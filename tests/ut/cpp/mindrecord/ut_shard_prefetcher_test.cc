@@ -0,0 +1,111 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_prefetcher.h"
+#include "ut_common.h"
+
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardPrefetcher : public UT::Common {
+ public:
+  TestShardPrefetcher() {}
+
+  void SetUp() override {
+    content_.resize(1 << 20);
+    for (size_t i = 0; i < content_.size(); ++i) {
+      content_[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    std::ofstream out(file_name_, std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(content_.data()), content_.size());
+    out.close();
+  }
+
+  void TearDown() override { (void)remove(file_name_.c_str()); }
+
+  bool Check(const BlobRequest &request, const BlobView &view) {
+    return view.size() == request.length &&
+           memcmp(view.data(), content_.data() + request.offset, request.length) == 0;
+  }
+
+  std::string file_name_ = "./prefetcher.bin";
+  std::vector<uint8_t> content_;
+};
+
+TEST_F(TestShardPrefetcher, TestScheduledBlobs) {
+  MS_LOG(INFO) << FormatInfo("Test ShardPrefetcher scheduled blobs");
+  ShardPrefetcher prefetcher({file_name_}, 2);
+  ASSERT_EQ(prefetcher.Open(), SUCCESS);
+
+  // Blobs scattered in the file, some of them close enough to be merged into one read
+  std::vector<BlobRequest> requests;
+  for (int i = 0; i < 100; ++i) {
+    uint64_t offset = (i * 7919) % (content_.size() - 4096);
+    requests.push_back(BlobRequest{i, 0, offset, static_cast<uint64_t>(i * 37 % 4000 + 1)});
+  }
+  prefetcher.Schedule(requests);
+  EXPECT_GT(prefetcher.GetPendingBytes(), 0);
+  for (const auto &request : requests) {
+    auto ret = prefetcher.Get(request);
+    ASSERT_EQ(ret.first, SUCCESS);
+    EXPECT_TRUE(Check(request, ret.second));
+  }
+  EXPECT_EQ(prefetcher.GetPendingBytes(), 0);
+  prefetcher.Close();
+}
+
+TEST_F(TestShardPrefetcher, TestUnscheduledBlobs) {
+  MS_LOG(INFO) << FormatInfo("Test ShardPrefetcher unscheduled and dropped blobs");
+  ShardPrefetcher prefetcher({file_name_}, 1);
+  ASSERT_EQ(prefetcher.Open(), SUCCESS);
+
+  BlobRequest unscheduled{1000, 0, 10, 20};
+  auto ret = prefetcher.Get(unscheduled);
+  ASSERT_EQ(ret.first, SUCCESS);
+  EXPECT_TRUE(Check(unscheduled, ret.second));
+
+  // A key scheduled with another position is read at the requested position
+  prefetcher.Schedule({BlobRequest{1, 0, 100, 10}});
+  BlobRequest moved{1, 0, 200, 10};
+  ret = prefetcher.Get(moved);
+  ASSERT_EQ(ret.first, SUCCESS);
+  EXPECT_TRUE(Check(moved, ret.second));
+
+  BlobRequest dropped{2, 0, 300, 10};
+  prefetcher.Schedule({dropped});
+  prefetcher.Reset();
+  EXPECT_EQ(prefetcher.GetPendingBytes(), 0);
+  ret = prefetcher.Get(dropped);
+  ASSERT_EQ(ret.first, SUCCESS);
+  EXPECT_TRUE(Check(dropped, ret.second));
+
+  EXPECT_EQ(prefetcher.Get(BlobRequest{3, 5, 0, 1}).first, FAILED);
+  EXPECT_EQ(prefetcher.Get(BlobRequest{4, 0, content_.size(), 1}).first, FAILED);
+  prefetcher.Close();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
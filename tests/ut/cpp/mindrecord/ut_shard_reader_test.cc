@@ -24,6 +24,7 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -43,8 +44,10 @@ class TestShardReader : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string idx_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(idx_name));
     }
   }
 };
@@ -70,6 +73,47 @@ TEST_F(TestShardReader, TestShardReaderGeneral) {
   dataset.Close();
 }
 
+TEST_F(TestShardReader, TestShardReaderIndexFile) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with and without index file");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  auto read_all = [&](const std::vector<std::shared_ptr<ShardOperator>> &ops) {
+    std::vector<std::string> rows;
+    ShardReader dataset;
+    dataset.Open({file_name}, true, 4, column_list, ops);
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        rows.emplace_back(std::get<1>(j).dump());
+      }
+    }
+    dataset.Close();
+    return rows;
+  };
+  std::vector<std::pair<std::string, std::string>> categories = {{"label", "257"}, {"label", "302"}};
+  std::vector<std::shared_ptr<ShardOperator>> category_ops = {std::make_shared<ShardCategory>(categories)};
+
+  auto rows = read_all({});
+  auto category_rows = read_all(category_ops);
+  ASSERT_FALSE(rows.empty());
+  ASSERT_FALSE(category_rows.empty());
+
+  // Without the index files the reader falls back to the sqlite databases
+  for (int i = 1; i <= 4; i++) {
+    string idx_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
+    ASSERT_EQ(rename(common::SafeCStr(idx_name), common::SafeCStr(idx_name + ".bak")), 0);
+  }
+  ASSERT_EQ(read_all({}), rows);
+  ASSERT_EQ(read_all(category_ops), category_rows);
+  for (int i = 1; i <= 4; i++) {
+    string idx_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
+    ASSERT_EQ(rename(common::SafeCStr(idx_name + ".bak"), common::SafeCStr(idx_name)), 0);
+  }
+}
+
 TEST_F(TestShardReader, TestShardReaderSample) {
   MS_LOG(INFO) << FormatInfo("Test read imageNet");
   std::string file_name = "./imagenet.shard01";
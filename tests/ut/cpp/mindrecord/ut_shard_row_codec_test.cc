@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_row_codec.h"
+#include "ut_common.h"
+
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardRowCodec : public UT::Common {
+ public:
+  TestShardRowCodec() {}
+
+  json schema_ = json::parse(R"({"file_name": {"type": "string"}, "label": {"type": "int32"},
+                                 "id": {"type": "int64"}, "score": {"type": "float32"},
+                                 "weight": {"type": "float64"}, "data": {"type": "bytes"},
+                                 "boxes": {"type": "int32", "shape": [-1]}})");
+};
+
+TEST_F(TestShardRowCodec, TestTypedRow) {
+  MS_LOG(INFO) << FormatInfo("Test ShardRowCodec typed row");
+  ShardRowCodec codec(schema_);
+  std::vector<json> rows = {
+    json::parse(R"({"file_name": "001.jpg", "label": 3, "id": -5000000000, "score": 0.1, "weight": 2.5})"),
+    json::parse(R"({"file_name": "", "label": -2147483648})"), json::object()};
+  for (const auto &row : rows) {
+    auto bin = codec.Encode(row);
+    ASSERT_FALSE(bin.empty());
+    EXPECT_EQ(bin[0], kTypedRowMarker);
+    auto ret = codec.Decode(bin);
+    ASSERT_EQ(ret.first, SUCCESS);
+    EXPECT_EQ(ret.second, row);
+  }
+
+  std::vector<std::string> columns = {"label", "file_name", "data"};
+  auto ret = codec.Decode(codec.Encode(rows[0]), columns, codec.GetFieldIds(columns));
+  ASSERT_EQ(ret.first, SUCCESS);
+  EXPECT_EQ(ret.second, json::parse(R"({"file_name": "001.jpg", "label": 3})"));
+
+  auto truncated = codec.Encode(rows[0]);
+  truncated.pop_back();
+  EXPECT_EQ(codec.Decode(truncated).first, FAILED);
+}
+
+TEST_F(TestShardRowCodec, TestMsgpackRow) {
+  MS_LOG(INFO) << FormatInfo("Test ShardRowCodec msgpack row");
+  ShardRowCodec codec(schema_);
+  // Rows which do not fit the schema are kept as they are
+  std::vector<json> rows = {json::parse(R"({"file_name": "002.jpg", "label": 1, "extra": 2})"),
+                            json::parse(R"({"label": 3000000000})"), json::parse(R"({"score": 1})")};
+  for (const auto &row : rows) {
+    auto bin = codec.Encode(row);
+    EXPECT_EQ(bin, json::to_msgpack(row));
+    auto ret = codec.Decode(bin);
+    ASSERT_EQ(ret.first, SUCCESS);
+    EXPECT_EQ(ret.second, row);
+  }
+
+  std::vector<std::string> columns = {"label"};
+  auto ret = codec.Decode(json::to_msgpack(rows[0]), columns, codec.GetFieldIds(columns));
+  ASSERT_EQ(ret.first, SUCCESS);
+  EXPECT_EQ(ret.second, json::parse(R"({"label": 1})"));
+
+  std::vector<uint8_t> invalid = {0x01, 0x02};
+  EXPECT_EQ(codec.Decode(invalid).first, FAILED);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
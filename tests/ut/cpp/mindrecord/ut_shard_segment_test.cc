@@ -48,8 +48,10 @@ class TestShardSegment : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string idx_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(idx_name));
     }
   }
 };
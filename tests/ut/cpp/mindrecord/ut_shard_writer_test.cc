@@ -49,8 +49,10 @@ TEST_F(TestShardWriter, TestShardWriterBench) {
   for (int i = 1; i <= 4; i++) {
     string filename = std::string("./imagenet.shard0") + std::to_string(i);
     string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+    string idx_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(idx_name));
   }
 }
 
@@ -78,8 +80,10 @@ TEST_F(TestShardWriter, TestShardWriterOneSample) {
   for (int i = 1; i <= 4; i++) {
     string filename = std::string("./OneSample.shard0") + std::to_string(i);
     string db_name = std::string("./OneSample.shard0") + std::to_string(i) + ".db";
+    string idx_name = std::string("./OneSample.shard0") + std::to_string(i) + ".idx";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(idx_name));
   }
 }
 
@@ -349,7 +353,9 @@ TEST_F(TestShardWriter, TestShardWriterTrial) {
   MS_LOG(INFO) << "Done create index";
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -485,7 +491,9 @@ TEST_F(TestShardWriter, TestShardWriterTrialNoFields) {
   MS_LOG(INFO) << "Done create index";
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -586,7 +594,9 @@ TEST_F(TestShardWriter, DataCheck) {
   MS_LOG(INFO) << "Done create index";
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -679,7 +689,9 @@ TEST_F(TestShardWriter, AllRawDataWrong) {
   ASSERT_EQ(res, SUCCESS);
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -779,7 +791,9 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberColumnInIndex) {
 
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -861,7 +875,9 @@ TEST_F(TestShardWriter, TestShardNoBlob) {
   dataset.Close();
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -955,7 +971,9 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberNotColumnInIndex) {
   dataset.Close();
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1063,7 +1081,9 @@ TEST_F(TestShardWriter, TestShardWriter10Sample40Shard) {
   dataset.Close();
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
+    auto filename_idx = filename + ".idx";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename_idx));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1131,8 +1151,10 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   for (int i = 1; i <= 4; i++) {
     string filename = std::string("./OpenForAppendSample.shard0") + std::to_string(i);
     string db_name = std::string("./OpenForAppendSample.shard0") + std::to_string(i) + ".db";
+    string idx_name = std::string("./OpenForAppendSample.shard0") + std::to_string(i) + ".idx";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(idx_name));
   }
 }
 
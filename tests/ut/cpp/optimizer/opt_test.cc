@@ -177,6 +177,21 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, MultiPattern) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_multi_pattern", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_multi_pattern", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_R, idempotent_P, Qct_to_P})));
+
+  // each transform is only given the nodes of its primitive
+  ASSERT_EQ(elim_R->match_count_, 3);
+  ASSERT_EQ(elim_R->hit_count_, 3);
+  ASSERT_EQ(Qct_to_P->hit_count_, 1);
+  ASSERT_GE(idempotent_P->hit_count_, 2);
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
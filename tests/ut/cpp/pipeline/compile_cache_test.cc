@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "common/common_test.h"
+#include "pipeline/jit/compile_cache.h"
+#include "base/core_ops.h"
+#include "ir/graph_utils.h"
+#include "frontend/optimizer/py_pass_manager.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() : dir_("./compile_cache_test_" + std::to_string(getpid())) {}
+
+  void SetUp() { (void)mkdir(dir_.c_str(), S_IRWXU); }
+
+  void TearDown() {
+    (void)system(("rm -rf " + dir_).c_str());
+    MsContext::GetInstance()->set_param<std::string>(MS_CTX_COMPILE_CACHE_PATH, "");
+  }
+
+  // A graph computing prim(x, y) on two float32 tensors of the given shape
+  static FuncGraphPtr MakeGraph(const PrimitivePtr &prim, const ShapeVector &shape) {
+    auto fg = std::make_shared<FuncGraph>();
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    auto x = fg->add_parameter();
+    x->set_name("x");
+    x->set_abstract(abs);
+    auto y = fg->add_parameter();
+    y->set_name("y");
+    y->set_abstract(abs);
+    auto out = fg->NewCNode({NewValueNode(prim), x, y});
+    out->set_abstract(abs);
+    fg->set_output(out);
+    fg->get_return()->set_abstract(abs);
+    return fg;
+  }
+
+  static abstract::AbstractBasePtrList MakeArgs(const ShapeVector &shape) {
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    return {abs, abs};
+  }
+
+ protected:
+  std::string dir_;
+};
+
+TEST_F(TestCompileCache, test_key_stability) {
+  CompileCache cache(dir_);
+  auto key = cache.GenerateKey(MakeGraph(prim::kPrimTensorAdd, {2, 3}), MakeArgs({2, 3}));
+  // the key depends on the content of the graph, not on the addresses of its nodes
+  ASSERT_EQ(key, cache.GenerateKey(MakeGraph(prim::kPrimTensorAdd, {2, 3}), MakeArgs({2, 3})));
+  ASSERT_EQ(key.size(), 32);
+  ASSERT_NE(key, cache.GenerateKey(MakeGraph(prim::kPrimMul, {2, 3}), MakeArgs({2, 3})));
+  ASSERT_NE(key, cache.GenerateKey(MakeGraph(prim::kPrimTensorAdd, {2, 3}), MakeArgs({4, 3})));
+
+  // the context options which change the optimized graph are part of the key
+  auto ms_context = MsContext::GetInstance();
+  bool enable_sparse = ms_context->get_param<bool>(MS_CTX_ENABLE_SPARSE);
+  ms_context->set_param<bool>(MS_CTX_ENABLE_SPARSE, !enable_sparse);
+  auto sparse_key = cache.GenerateKey(MakeGraph(prim::kPrimTensorAdd, {2, 3}), MakeArgs({2, 3}));
+  ms_context->set_param<bool>(MS_CTX_ENABLE_SPARSE, enable_sparse);
+  ASSERT_NE(key, sparse_key);
+}
+
+TEST_F(TestCompileCache, test_store_and_load) {
+  CompileCache cache(dir_);
+  auto graph = MakeGraph(prim::kPrimTensorAdd, {2, 3});
+  auto key = cache.GenerateKey(graph, MakeArgs({2, 3}));
+  ASSERT_TRUE(cache.Load(key, graph) == nullptr);
+  ASSERT_TRUE(cache.Store(key, graph));
+
+  auto loaded = cache.Load(key, MakeGraph(prim::kPrimTensorAdd, {2, 3}));
+  ASSERT_TRUE(loaded != nullptr);
+  ASSERT_EQ(loaded->parameters().size(), 2);
+  auto output = loaded->output()->cast<CNodePtr>();
+  ASSERT_TRUE(output != nullptr);
+  ASSERT_TRUE(IsPrimitiveCNode(output, prim::kPrimTensorAdd));
+  ASSERT_EQ(output->abstract()->BuildShape()->ToString(), graph->output()->abstract()->BuildShape()->ToString());
+
+  // an entry is only loaded for its own key
+  auto other_key = cache.GenerateKey(MakeGraph(prim::kPrimMul, {2, 3}), MakeArgs({2, 3}));
+  ASSERT_TRUE(cache.Load(other_key, graph) == nullptr);
+  ASSERT_EQ(rename((dir_ + "/" + key + ".mindir").c_str(), (dir_ + "/" + other_key + ".mindir").c_str()), 0);
+  ASSERT_TRUE(cache.Load(other_key, graph) == nullptr);
+}
+
+TEST_F(TestCompileCache, test_disabled_by_python_pass) {
+  MsContext::GetInstance()->set_param<std::string>(MS_CTX_COMPILE_CACHE_PATH, dir_);
+  bool enabled = CompileCache::IsEnabled("train");
+  auto ppm = opt::python_pass::PyPassManager::GetInstance();
+  ppm->Registe("compile_cache_test_pass", std::make_shared<opt::python_pass::Any>(),
+               std::make_shared<opt::python_pass::Any>(), false, false);
+  ASSERT_FALSE(CompileCache::IsEnabled("train"));
+  ppm->Unregiste("compile_cache_test_pass");
+  ASSERT_EQ(CompileCache::IsEnabled("train"), enabled);
+}
+}  // namespace pipeline
+}  // namespace mindspore
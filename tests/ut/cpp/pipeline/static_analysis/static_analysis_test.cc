@@ -27,7 +27,9 @@
 #include "pipeline/jit/parse/data_converter.h"
 #include "pipeline/jit/resource.h"
 #include "debug/draw.h"
+#include "debug/trace.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace abstract {
@@ -395,6 +397,93 @@ TEST_F(TestInferUniform, test_inferred_scalar_add) {
   ASSERT_TRUE(abs_base_got->GetTypeTrack()->type_id() == kNumberTypeInt32);
 }
 
+class TestInferParallel : public UT::Common {
+ public:
+  void SetUp();
+  void TearDown();
+};
+
+void TestInferParallel::SetUp() {}
+
+void TestInferParallel::TearDown() {
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER, false);
+}
+
+static FuncGraphPtr MakeIndependentTuplesGraph() {
+  // build the func_graph manually.
+  /* python source code:
+   * def f(x, y):
+   *     return ((x, y), [x, y], (x, y), [x, y], ...)
+   */
+  FuncGraphPtr func_graph = std::make_shared<FuncGraph>();
+  ParameterPtr x = func_graph->add_parameter();
+  ParameterPtr y = func_graph->add_parameter();
+  std::vector<AnfNodePtr> outputs{NewValueNode(prim::kPrimMakeTuple)};
+  for (size_t i = 0; i < 16; i++) {
+    auto prim = (i % 2 == 0) ? prim::kPrimMakeTuple : prim::kPrimMakeList;
+    outputs.push_back(func_graph->NewCNode({NewValueNode(prim), x, y}));
+  }
+  func_graph->set_output(func_graph->NewCNode(outputs));
+  return func_graph;
+}
+
+TEST_F(TestInferParallel, test_same_result_as_sequential) {
+  AbstractBasePtrList args_spec_list = {FromValue(1, false), FromValue(2.5f, true)};
+
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER, false);
+  AnalysisEnginePtr engine = SetupAnalysisEngine();
+  AbstractBasePtr sequential = engine->Run(MakeIndependentTuplesGraph(), args_spec_list).inferred->abstract();
+  ASSERT_EQ(engine->parallel_inferred_count(), 0);
+
+  // the independent tuples and lists are inferred on the worker threads
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER, true);
+  engine = SetupAnalysisEngine();
+  AbstractBasePtr parallel = engine->Run(MakeIndependentTuplesGraph(), args_spec_list).inferred->abstract();
+  ASSERT_EQ(engine->parallel_inferred_count(), 16);
+
+  ASSERT_TRUE(sequential != nullptr);
+  ASSERT_TRUE(parallel != nullptr);
+  ASSERT_EQ(*sequential, *parallel);
+  auto tuple = dyn_cast<AbstractTuple>(parallel);
+  ASSERT_TRUE(tuple != nullptr);
+  ASSERT_EQ(tuple->size(), 16);
+  ASSERT_TRUE(tuple->elements()[1]->isa<AbstractList>());
+}
+
+static FuncGraphPtr MakeTupleGetItemsGraph() {
+  // build the func_graph manually.
+  /* python source code:
+   * def f(x, i, j):
+   *     return (x[i], x[i], ..., x[j])
+   */
+  FuncGraphPtr func_graph = std::make_shared<FuncGraph>();
+  ParameterPtr x = func_graph->add_parameter();
+  ParameterPtr i = func_graph->add_parameter();
+  ParameterPtr j = func_graph->add_parameter();
+  std::vector<AnfNodePtr> outputs{NewValueNode(prim::kPrimMakeTuple)};
+  for (size_t k = 0; k < 16; k++) {
+    auto index = (k == 15) ? j : i;
+    outputs.push_back(func_graph->NewCNode({NewValueNode(prim::kPrimTupleGetItem), x, index}));
+  }
+  func_graph->set_output(func_graph->NewCNode(outputs));
+  return func_graph;
+}
+
+TEST_F(TestInferParallel, test_failed_infer_raised_sequentially) {
+  auto x = std::make_shared<AbstractTuple>(AbstractBasePtrList{FromValue(1, false), FromValue(2.5f, false)});
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_PARALLEL_INFER, true);
+  AnalysisEnginePtr engine = SetupAnalysisEngine();
+  AbstractBasePtrList args_spec_list = {x, FromValue(0, false), FromValue(1, false)};
+  ASSERT_TRUE(engine->Run(MakeTupleGetItemsGraph(), args_spec_list).inferred->abstract() != nullptr);
+  ASSERT_EQ(engine->parallel_inferred_count(), 16);
+
+  // the out of range index fails on its worker thread, the error is raised by the evaluation of its cnode
+  engine = SetupAnalysisEngine();
+  args_spec_list = {x, FromValue(0, false), FromValue(5, false)};
+  ASSERT_ANY_THROW(engine->Run(MakeTupleGetItemsGraph(), args_spec_list));
+  ASSERT_EQ(engine->parallel_inferred_count(), 15);
+  trace::ClearTraceStack();
+}
 
 class TestEvalOnePrim : public UT::Common {
  public:
@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/lock_stripes.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+class LockStripesTest : public UT::Common {
+ public:
+  LockStripesTest() = default;
+};
+
+namespace {
+// The request handling of ParameterServer on dense tables: pushes accumulate gradients and pulls copy weights through
+// LockStripes::RunOnKey, and an update thread applies the gradients under the stripes, like UpdateWeights.
+class TableServer {
+ public:
+  TableServer(size_t key_num, size_t row_size, size_t stripe_num = kDefaultLockStripeNum)
+      : locks_(stripe_num),
+        weights_(key_num, std::vector<float>(row_size, 0)),
+        grads_(key_num, std::vector<float>(row_size, 0)),
+        push_counts_(key_num, 0),
+        pull_counts_(key_num, 0) {}
+
+  void Push(size_t key) {
+    std::vector<float> *grad = nullptr;
+    locks_.RunOnKey(
+      &mutex_, key,
+      [&]() {
+        grad = &grads_[key];
+        return true;
+      },
+      [&]() {
+        for (auto &value : *grad) {
+          value += 1;
+        }
+      },
+      [&]() { push_counts_[key]++; });
+  }
+
+  // Returns false if the pulled row was torn by a concurrent update
+  bool Pull(size_t key) {
+    std::vector<float> *weight = nullptr;
+    std::vector<float> copy;
+    locks_.RunOnKey(
+      &mutex_, key,
+      [&]() {
+        weight = &weights_[key];
+        return true;
+      },
+      [&]() { copy = *weight; }, [&]() { pull_counts_[key]++; });
+    return std::all_of(copy.begin(), copy.end(), [&copy](float value) { return value == copy[0]; });
+  }
+
+  void Update() {
+    for (size_t key = 0; key < weights_.size(); ++key) {
+      std::lock_guard<std::mutex> key_lock(locks_.GetLock(key));
+      for (size_t i = 0; i < weights_[key].size(); ++i) {
+        weights_[key][i] += grads_[key][i];
+        grads_[key][i] = 0;
+      }
+    }
+  }
+
+  size_t key_num() const { return weights_.size(); }
+  size_t stripe_num() const { return locks_.stripe_num(); }
+  const std::vector<float> &weight(size_t key) const { return weights_[key]; }
+  size_t push_count(size_t key) const { return push_counts_[key]; }
+  size_t pull_count(size_t key) const { return pull_counts_[key]; }
+
+ private:
+  std::mutex mutex_;
+  LockStripes locks_;
+  std::vector<std::vector<float>> weights_;
+  std::vector<std::vector<float>> grads_;
+  std::vector<size_t> push_counts_;
+  std::vector<size_t> pull_counts_;
+};
+
+struct PushPullQps {
+  double push_qps;
+  double pull_qps;
+};
+
+// Worker threads push to and pull from random keys of the server while an update thread applies the gradients.
+// Checks that no push is lost and that no pull sees a row in the middle of an update, and returns the throughput.
+PushPullQps RunPushPull(TableServer *server, size_t worker_num, size_t op_num) {
+  size_t key_num = server->key_num();
+  std::atomic<bool> running{true};
+  std::thread update_thread([server, &running]() {
+    while (running) {
+      server->Update();
+    }
+  });
+
+  std::vector<size_t> pushes(key_num, 0);
+  std::mutex pushes_mutex;
+  std::atomic<size_t> torn_pulls{0};
+  std::chrono::steady_clock::duration push_time{0};
+  std::chrono::steady_clock::duration pull_time{0};
+  std::vector<std::thread> workers;
+  for (size_t worker = 0; worker < worker_num; ++worker) {
+    workers.emplace_back([&, worker]() {
+      std::mt19937 engine(worker);
+      std::uniform_int_distribution<size_t> key_dist(0, key_num - 1);
+      std::vector<size_t> worker_pushes(key_num, 0);
+      std::chrono::steady_clock::duration worker_push_time{0};
+      std::chrono::steady_clock::duration worker_pull_time{0};
+      for (size_t op = 0; op < op_num; ++op) {
+        size_t key = key_dist(engine);
+        auto op_start = std::chrono::steady_clock::now();
+        if (op % 2 == 0) {
+          server->Push(key);
+          worker_push_time += std::chrono::steady_clock::now() - op_start;
+          worker_pushes[key]++;
+        } else {
+          bool intact = server->Pull(key);
+          worker_pull_time += std::chrono::steady_clock::now() - op_start;
+          if (!intact) {
+            torn_pulls++;
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(pushes_mutex);
+      push_time += worker_push_time;
+      pull_time += worker_pull_time;
+      for (size_t key = 0; key < key_num; ++key) {
+        pushes[key] += worker_pushes[key];
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  running = false;
+  update_thread.join();
+  server->Update();
+
+  EXPECT_EQ(torn_pulls, 0);
+  size_t total_pushes = 0;
+  size_t total_pulls = 0;
+  for (size_t key = 0; key < key_num; ++key) {
+    EXPECT_EQ(server->push_count(key), pushes[key]);
+    for (auto value : server->weight(key)) {
+      EXPECT_EQ(value, static_cast<float>(pushes[key]));
+    }
+    total_pushes += pushes[key];
+    total_pulls += server->pull_count(key);
+  }
+  EXPECT_EQ(total_pulls, worker_num * op_num / 2);
+  // the workers run side by side, so the wall time of each kind of request is its summed time over the workers
+  double push_seconds = std::chrono::duration<double>(push_time).count() / worker_num + 1e-9;
+  double pull_seconds = std::chrono::duration<double>(pull_time).count() / worker_num + 1e-9;
+  return {total_pushes / push_seconds, total_pulls / pull_seconds};
+}
+}  // namespace
+
+TEST_F(LockStripesTest, SpreadKeys) {
+  LockStripes locks;
+  std::set<size_t> used;
+  for (uint64_t key = 0; key < locks.stripe_num(); ++key) {
+    size_t index = locks.StripeIndex(key);
+    EXPECT_LT(index, locks.stripe_num());
+    EXPECT_EQ(&locks.GetLock(key), &locks.GetLock(key));
+    used.insert(index);
+  }
+  // consecutive keys should not pile up on a few stripes
+  EXPECT_GT(used.size(), locks.stripe_num() / 2);
+}
+
+TEST_F(LockStripesTest, RunOnKeySkipsAccessWhenLookupFails) {
+  LockStripes locks;
+  std::mutex mutex;
+  bool accessed = false;
+  bool committed = false;
+  locks.RunOnKey(
+    &mutex, 1, []() { return false; }, [&accessed]() { accessed = true; }, [&committed]() { committed = true; });
+  EXPECT_FALSE(accessed);
+  EXPECT_FALSE(committed);
+}
+
+TEST_F(LockStripesTest, ConcurrentPushPull) {
+  size_t worker_num = std::max<size_t>(4, std::thread::hardware_concurrency());
+  TableServer server(32, 256);
+  (void)RunPushPull(&server, worker_num, 20000);
+}
+
+// Local stress benchmark of the push and pull paths, one lock for every key against the striped locks
+TEST_F(LockStripesTest, PushPullQps) {
+  constexpr size_t kOpNum = 20000;
+  constexpr size_t kKeyNum = 32;
+  constexpr size_t kRowSize = 256;
+  size_t worker_num = std::max<size_t>(4, std::thread::hardware_concurrency());
+  TableServer single_lock_server(kKeyNum, kRowSize, 1);
+  TableServer striped_server(kKeyNum, kRowSize);
+  auto single = RunPushPull(&single_lock_server, worker_num, kOpNum);
+  auto striped = RunPushPull(&striped_server, worker_num, kOpNum);
+  MS_LOG(INFO) << "PS push/pull stress with " << worker_num << " workers and " << kKeyNum << " keys, single lock: push "
+               << single.push_qps << " qps, pull " << single.pull_qps << " qps; " << striped_server.stripe_num()
+               << " stripes: push " << striped.push_qps << " qps, pull " << striped.pull_qps << " qps";
+}
+}  // namespace ps
+}  // namespace mindspore
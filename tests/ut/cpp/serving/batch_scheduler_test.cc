@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "include/inference.h"
+#include "include/infer_tensor.h"
+#include "serving/core/batch_scheduler.h"
+
+using mindspore::inference::FAILED;
+using mindspore::inference::InferTensor;
+using mindspore::inference::ReplyBase;
+using mindspore::inference::RequestBase;
+using mindspore::inference::Status;
+using mindspore::inference::SUCCESS;
+using mindspore::inference::VectorInferTensorWrapReply;
+using mindspore::inference::VectorInferTensorWrapRequest;
+
+namespace mindspore {
+namespace serving {
+// output = input * 2, rejects batches with more rows than max_rows_
+class StubInferSession : public inference::InferSession {
+ public:
+  explicit StubInferSession(int64_t max_rows = INT64_MAX) : max_rows_(max_rows) {}
+  Status InitEnv(const std::string &, uint32_t) override { return SUCCESS; }
+  Status FinalizeEnv() override { return SUCCESS; }
+  Status LoadModelFromFile(const std::string &, uint32_t &model_id) override {
+    model_id = 0;
+    return SUCCESS;
+  }
+  Status UnloadModel(uint32_t) override { return SUCCESS; }
+  Status ExecuteModel(uint32_t, const RequestBase &request, ReplyBase &reply) override {
+    execute_count_++;
+    auto input = request[0];
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      executed_shapes_.push_back(input->shape());
+    }
+    if (input->shape()[0] > max_rows_) {
+      return FAILED;
+    }
+    reply.clear();
+    auto output = reply.add();
+    output->set_data_type(input->data_type());
+    output->set_shape(input->shape());
+    output->resize_data(input->data_size());
+    auto src = reinterpret_cast<const float *>(input->data());
+    auto dst = reinterpret_cast<float *>(output->mutable_data());
+    for (int64_t i = 0; i < input->ElementNum(); i++) {
+      dst[i] = src[i] * 2;
+    }
+    return SUCCESS;
+  }
+  std::vector<std::vector<int64_t>> executed_shapes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return executed_shapes_;
+  }
+  std::atomic<int> execute_count_{0};
+
+ private:
+  int64_t max_rows_;
+  std::mutex mutex_;
+  std::vector<std::vector<int64_t>> executed_shapes_;  // input shape of each execution
+};
+
+class BatchSchedulerTest : public testing::Test {
+ public:
+  BatchSchedulerTest() = default;
+  static BatchScheduler::ExecuteFunc ExecuteFunc(const std::shared_ptr<StubInferSession> &session) {
+    return [session](const RequestBase &request, ReplyBase &reply) { return session->ExecuteModel(0, request, reply); };
+  }
+  static std::vector<InferTensor> CreateInputs(int64_t rows, int64_t cols, float start) {
+    std::vector<float> data(rows * cols);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = start + i;
+    }
+    return {InferTensor(inference::kMSI_Float32, {rows, cols}, data.data(), data.size() * sizeof(float))};
+  }
+  static void CheckOutputs(const std::vector<InferTensor> &outputs, int64_t rows, int64_t cols, float start) {
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_EQ(outputs[0].shape(), std::vector<int64_t>({rows, cols}));
+    ASSERT_EQ(outputs[0].data_size(), rows * cols * sizeof(float));
+    auto data = reinterpret_cast<const float *>(outputs[0].data());
+    for (int64_t i = 0; i < rows * cols; i++) {
+      EXPECT_EQ(data[i], (start + i) * 2);
+    }
+  }
+};
+
+TEST_F(BatchSchedulerTest, TestMergeConcurrentRequests) {
+  auto session = std::make_shared<StubInferSession>();
+  BatchOptions options;
+  options.max_batch_size = 8;
+  options.max_queue_delay_us = 10 * 1000 * 1000;
+  BatchScheduler scheduler(ExecuteFunc(session), options);
+
+  constexpr int kRequestNum = 4;
+  std::vector<std::vector<InferTensor>> outputs(kRequestNum);
+  std::vector<Status> status(kRequestNum);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kRequestNum; i++) {
+    threads.emplace_back([&, i]() {
+      auto inputs = CreateInputs(2, 3, i * 100);
+      VectorInferTensorWrapRequest request(inputs);
+      VectorInferTensorWrapReply reply(outputs[i]);
+      status[i] = scheduler.Predict(request, reply);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // the batch is executed as soon as it is full, long before the queue delay expires
+  EXPECT_EQ(session->execute_count_, 1);
+  for (int i = 0; i < kRequestNum; i++) {
+    EXPECT_EQ(status[i], SUCCESS);
+    CheckOutputs(outputs[i], 2, 3, i * 100);
+  }
+  EXPECT_EQ(scheduler.request_latency().Count(), kRequestNum);
+  EXPECT_EQ(scheduler.batch_count(), 1);
+}
+
+TEST_F(BatchSchedulerTest, TestFallbackWhenModelRejectsBatch) {
+  auto session = std::make_shared<StubInferSession>(2);
+  BatchOptions options;
+  options.max_batch_size = 4;
+  options.max_queue_delay_us = 10 * 1000 * 1000;
+  BatchScheduler scheduler(ExecuteFunc(session), options);
+
+  std::vector<InferTensor> outputs0;
+  std::vector<InferTensor> outputs1;
+  Status status0;
+  Status status1;
+  std::thread thread0([&]() {
+    auto inputs = CreateInputs(2, 3, 0);
+    VectorInferTensorWrapRequest request(inputs);
+    VectorInferTensorWrapReply reply(outputs0);
+    status0 = scheduler.Predict(request, reply);
+  });
+  std::thread thread1([&]() {
+    auto inputs = CreateInputs(2, 3, 100);
+    VectorInferTensorWrapRequest request(inputs);
+    VectorInferTensorWrapReply reply(outputs1);
+    status1 = scheduler.Predict(request, reply);
+  });
+  thread0.join();
+  thread1.join();
+  // one merged execution rejected by the model, then one execution per request
+  EXPECT_EQ(session->execute_count_, 3);
+  EXPECT_EQ(status0, SUCCESS);
+  EXPECT_EQ(status1, SUCCESS);
+  CheckOutputs(outputs0, 2, 3, 0);
+  CheckOutputs(outputs1, 2, 3, 100);
+  EXPECT_FALSE(scheduler.merge_enabled());
+}
+
+TEST_F(BatchSchedulerTest, TestIncompatibleRequestsNotMerged) {
+  auto session = std::make_shared<StubInferSession>();
+  BatchOptions options;
+  options.max_batch_size = 8;
+  // long enough for both requests to be queued while the first one waits for more rows
+  options.max_queue_delay_us = 500 * 1000;
+  BatchScheduler scheduler(ExecuteFunc(session), options);
+
+  std::vector<InferTensor> outputs0;
+  std::vector<InferTensor> outputs1;
+  Status status0;
+  Status status1;
+  std::thread thread0([&]() {
+    auto inputs = CreateInputs(1, 3, 0);
+    VectorInferTensorWrapRequest request(inputs);
+    VectorInferTensorWrapReply reply(outputs0);
+    status0 = scheduler.Predict(request, reply);
+  });
+  std::thread thread1([&]() {
+    auto inputs = CreateInputs(1, 4, 100);
+    VectorInferTensorWrapRequest request(inputs);
+    VectorInferTensorWrapReply reply(outputs1);
+    status1 = scheduler.Predict(request, reply);
+  });
+  thread0.join();
+  thread1.join();
+  // the shapes differ beyond the batch dimension, so each request runs on its own with its original shape
+  EXPECT_EQ(session->execute_count_, 2);
+  auto executed_shapes = session->executed_shapes();
+  std::sort(executed_shapes.begin(), executed_shapes.end());
+  EXPECT_EQ(executed_shapes, std::vector<std::vector<int64_t>>({{1, 3}, {1, 4}}));
+  EXPECT_EQ(status0, SUCCESS);
+  EXPECT_EQ(status1, SUCCESS);
+  CheckOutputs(outputs0, 1, 3, 0);
+  CheckOutputs(outputs1, 1, 4, 100);
+  EXPECT_EQ(scheduler.batch_count(), 2);
+  EXPECT_TRUE(scheduler.merge_enabled());
+}
+
+TEST_F(BatchSchedulerTest, TestLatencyHistogram) {
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 100; i++) {
+    histogram.Record(i);
+  }
+  EXPECT_EQ(histogram.Count(), 100);
+  // buckets are powers of two, a percentile reports the upper bound of its bucket
+  EXPECT_EQ(histogram.Percentile(50), 63);
+  EXPECT_EQ(histogram.Percentile(99), 100);
+  EXPECT_EQ(histogram.Percentile(1), 1);
+}
+}  // namespace serving
+}  // namespace mindspore
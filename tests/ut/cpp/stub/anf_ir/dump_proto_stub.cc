@@ -22,6 +22,4 @@ void DumpIRProto(const FuncGraphPtr &func_graph, const std::string &suffix) { re
 std::string GetFuncGraphProtoString(const FuncGraphPtr &func_graph) { return ""; }
 
 std::string GetOnnxProtoString(const FuncGraphPtr &func_graph) { return ""; }
-
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph) { return ""; }
 }  // namespace mindspore
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "utils/mem_plan.h"
+
+namespace mindspore {
+class TestMemPlan : public UT::Common {
+ public:
+  TestMemPlan() {}
+};
+
+struct TestMemBlock {
+  size_t size_{0};
+  size_t first_use_{0};
+  size_t last_use_{0};
+  size_t offset_{0};
+};
+
+TestMemBlock NewMemBlock(size_t size, size_t first_use, size_t last_use) {
+  TestMemBlock mem_block;
+  mem_block.size_ = size;
+  mem_block.first_use_ = first_use;
+  mem_block.last_use_ = last_use;
+  return mem_block;
+}
+
+bool IsOverlapped(const TestMemBlock &a, const TestMemBlock &b) {
+  bool life_overlapped = a.first_use_ <= b.last_use_ && b.first_use_ <= a.last_use_;
+  bool mem_overlapped = a.offset_ < b.offset_ + b.size_ && b.offset_ < a.offset_ + a.size_;
+  return life_overlapped && mem_overlapped;
+}
+
+TEST_F(TestMemPlan, test_chain_reuse) {
+  // a -> b -> c -> d, each output only used by the next kernel
+  std::vector<TestMemBlock> mem_blocks = {NewMemBlock(1000, 0, 1), NewMemBlock(1000, 1, 2), NewMemBlock(1000, 2, 3),
+                                          NewMemBlock(1000, 3, 4)};
+  size_t total_size = AssignMemBlockOffsets(&mem_blocks, 64, true);
+  ASSERT_EQ(total_size, 2048);
+  ASSERT_EQ(mem_blocks[0].offset_, mem_blocks[2].offset_);
+  ASSERT_EQ(mem_blocks[1].offset_, mem_blocks[3].offset_);
+}
+
+TEST_F(TestMemPlan, test_disable_reuse) {
+  std::vector<TestMemBlock> mem_blocks = {NewMemBlock(1024, 0, 1), NewMemBlock(1000, 1, 2), NewMemBlock(1024, 2, 3)};
+  size_t total_size = AssignMemBlockOffsets(&mem_blocks, 64, false);
+  ASSERT_EQ(total_size, 3072);
+  ASSERT_EQ(mem_blocks[0].offset_, 0);
+  ASSERT_EQ(mem_blocks[1].offset_, 1024);
+  ASSERT_EQ(mem_blocks[2].offset_, 2048);
+}
+
+TEST_F(TestMemPlan, test_no_overlap) {
+  std::vector<TestMemBlock> mem_blocks = {NewMemBlock(4096, 0, 3), NewMemBlock(100, 1, 2),  NewMemBlock(2000, 2, 5),
+                                          NewMemBlock(64, 3, 3),   NewMemBlock(3000, 4, 6), NewMemBlock(512, 0, 6),
+                                          NewMemBlock(800, 5, 6),  NewMemBlock(4096, 6, 7)};
+  size_t total_size = AssignMemBlockOffsets(&mem_blocks, 64, true);
+  size_t naive_size = 0;
+  for (size_t i = 0; i < mem_blocks.size(); ++i) {
+    naive_size += AlignMemBlockSize(mem_blocks[i].size_, 64);
+    ASSERT_EQ(mem_blocks[i].offset_ % 64, 0);
+    ASSERT_LE(mem_blocks[i].offset_ + mem_blocks[i].size_, total_size);
+    for (size_t j = i + 1; j < mem_blocks.size(); ++j) {
+      ASSERT_FALSE(IsOverlapped(mem_blocks[i], mem_blocks[j]));
+    }
+  }
+  ASSERT_LT(total_size, naive_size);
+}
+}  // namespace mindspore
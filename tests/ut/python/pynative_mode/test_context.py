@@ -124,6 +124,29 @@ def test_print_file_path():
         context.set_context(print_file_path="./")
 
 
+def test_compile_cache_path():
+    """test_compile_cache_path"""
+    assert context.get_context("compile_cache_path") == ""
+    context.set_context(compile_cache_path="mindspore_compile_cache")
+    assert os.path.exists("mindspore_compile_cache")
+    assert context.get_context("compile_cache_path").find("mindspore_compile_cache") > 0
+    context.set_context(compile_cache_path="")
+    assert context.get_context("compile_cache_path") == ""
+    with pytest.raises(TypeError):
+        context.set_context(compile_cache_path=1)
+
+
+def test_enable_parallel_infer():
+    """test_enable_parallel_infer"""
+    assert not context.get_context("enable_parallel_infer")
+    context.set_context(enable_parallel_infer=True)
+    assert context.get_context("enable_parallel_infer")
+    context.set_context(enable_parallel_infer=False)
+    assert not context.get_context("enable_parallel_infer")
+    with pytest.raises(TypeError):
+        context.set_context(enable_parallel_infer=1)
+
+
 def test_set_context():
     """ test_set_context """
     context.set_context(mode=context.GRAPH_MODE, device_target="Ascend",
@@ -144,7 +167,7 @@ def test_set_context():
 
 
 def teardown_module():
-    dirs = ['mindspore_ir_path']
+    dirs = ['mindspore_ir_path', 'mindspore_compile_cache']
     for item in dirs:
         item_name = './' + item
         if not os.path.exists(item_name):
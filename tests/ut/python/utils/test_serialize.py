@@ -293,6 +293,113 @@ def test_save_checkpoint_for_network():
     load_checkpoint("new_ckpt.ckpt")
 
 
+def test_save_and_load_native_checkpoint():
+    """ test save_checkpoint and load_checkpoint in the native format"""
+    data1 = np.random.randint(0, 255, [1, 3, 224, 224]).astype(np.float32)
+    data2 = np.random.randint(0, 255, [12, 1024]).astype(np.int32)
+    parameter_list = [{'name': "param_test", 'data': Tensor(data1)},
+                      {'name': "param", 'data': Tensor(data2)},
+                      {'name': "scalar", 'data': Tensor(np.array(2.5, np.float16))}]
+    ckpt_file_name = os.path.join(_cur_dir, './native_parameters.ckpt')
+    save_checkpoint(parameter_list, ckpt_file_name, file_format="NATIVE")
+
+    par_dict = load_checkpoint(ckpt_file_name, verify=True)
+    assert list(par_dict.keys()) == ["param_test", "param", "scalar"]
+    assert par_dict['param_test'].name == 'param_test'
+    assert par_dict['param_test'].data.dtype == mstype.float32
+    assert (par_dict['param_test'].data.asnumpy() == data1).all()
+    assert par_dict['param'].data.dtype == mstype.int32
+    assert (par_dict['param'].data.asnumpy() == data2).all()
+    assert par_dict['scalar'].data.shape == ()
+    assert par_dict['scalar'].data.asnumpy() == np.float16(2.5)
+
+    par_dict = load_checkpoint(ckpt_file_name, param_names=["param"])
+    assert list(par_dict.keys()) == ["param"]
+    assert (par_dict['param'].data.asnumpy() == data2).all()
+
+    with pytest.raises(RuntimeError):
+        load_checkpoint(ckpt_file_name, param_names=["not_exist"])
+    os.chmod(ckpt_file_name, stat.S_IWRITE)
+    os.remove(ckpt_file_name)
+
+
+def _mapped_ranges(file_name):
+    """ the address ranges of the mappings of a file in this process"""
+    ranges = []
+    real_path = os.path.realpath(file_name)
+    with open("/proc/self/maps") as maps:
+        for line in maps:
+            fields = line.split()
+            if len(fields) == 6 and fields[5] == real_path:
+                begin, end = fields[0].split('-')
+                ranges.append((int(begin, 16), int(end, 16)))
+    return ranges
+
+
+@pytest.mark.skipif(not os.path.exists("/proc/self/maps"), reason="needs the mappings of the process")
+def test_load_native_checkpoint_without_copy():
+    """ test the parameters loaded from a native checkpoint use the mapped data of the file"""
+    data = np.random.randint(0, 255, [64, 1024]).astype(np.float32)
+    parameter_list = [{'name': "param", 'data': Tensor(data)}]
+    ckpt_file_name = os.path.join(_cur_dir, './native_no_copy.ckpt')
+    save_checkpoint(parameter_list, ckpt_file_name, file_format="NATIVE")
+
+    par_dict = load_checkpoint(ckpt_file_name)
+    array = par_dict['param'].asnumpy()
+    address = array.__array_interface__['data'][0]
+    assert any(begin <= address and address + array.nbytes <= end
+               for begin, end in _mapped_ranges(ckpt_file_name))
+    assert (array == data).all()
+    os.chmod(ckpt_file_name, stat.S_IWRITE)
+    os.remove(ckpt_file_name)
+
+
+def test_load_native_checkpoint_corrupted():
+    """ test a native checkpoint whose data was modified fails the verification"""
+    data = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "param", 'data': Tensor(data)}]
+    ckpt_file_name = os.path.join(_cur_dir, './native_corrupted.ckpt')
+    save_checkpoint(parameter_list, ckpt_file_name, file_format="NATIVE")
+
+    # the first blob starts at the first 64 bytes boundary after the header
+    os.chmod(ckpt_file_name, stat.S_IRUSR | stat.S_IWUSR)
+    with open(ckpt_file_name, "r+b") as f:
+        f.seek(64)
+        value = f.read(1)
+        f.seek(64)
+        f.write(bytes([value[0] ^ 0xff]))
+
+    with pytest.raises(RuntimeError):
+        load_checkpoint(ckpt_file_name, verify=True)
+    par_dict = load_checkpoint(ckpt_file_name)
+    assert not (par_dict['param'].data.asnumpy() == data).all()
+    os.remove(ckpt_file_name)
+
+
+def test_load_checkpoint_param_names():
+    """ test load_checkpoint of a subset of the parameters of a protobuf checkpoint"""
+    data = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "param", 'data': Tensor(data)},
+                      {'name': "new_param", 'data': Tensor(np.ones([12, 1024, 1]), dtype=mstype.float32)}]
+    ckpt_file_name = os.path.join(_cur_dir, './part_parameters.ckpt')
+    save_checkpoint(parameter_list, ckpt_file_name)
+
+    par_dict = load_checkpoint(ckpt_file_name, param_names=["param"])
+    assert list(par_dict.keys()) == ["param"]
+    assert (par_dict['param'].data.asnumpy() == data).all()
+
+    with pytest.raises(RuntimeError):
+        load_checkpoint(ckpt_file_name, param_names=["not_exist"])
+    os.chmod(ckpt_file_name, stat.S_IWRITE)
+    os.remove(ckpt_file_name)
+
+
+def test_save_checkpoint_error_format():
+    parameter_list = [{'name': "param", 'data': Tensor(np.ones([2, 2]), dtype=mstype.float32)}]
+    with pytest.raises(ValueError):
+        save_checkpoint(parameter_list, "./error_format.ckpt", file_format="JSON")
+
+
 def test_load_checkpoint_empty_file():
     os.mknod("empty.ckpt")
     with pytest.raises(ValueError):